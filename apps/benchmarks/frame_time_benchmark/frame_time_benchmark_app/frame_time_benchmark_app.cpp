@@ -0,0 +1,819 @@
+#include "frame_time_benchmark_app.h"
+
+#include "le_renderer.hpp"
+#include "le_backend_vk.h"
+#include "le_pipeline_builder.h"
+#include "le_camera.h"
+#include "le_2d.h"
+#include "le_stage.h"
+#include "le_gltf.h"
+#include "le_log.h"
+
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE // vulkan clip space is from 0 to 1
+#define GLM_FORCE_RIGHT_HANDED      // glTF uses right handed coordinate system, and we're following its lead.
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+static constexpr auto LOGGER_LABEL = "frame_time_benchmark";
+
+struct frame_time_benchmark_app_o;
+
+// We use this local typedef so spare us lots of typing
+typedef frame_time_benchmark_app_o app_o;
+
+// A workload adds its renderpasses to the rendergraph once per frame.
+// `setup` is called once, before the first frame of the workload - if
+// it returns false, the workload can't run, and is skipped.
+struct workload_t {
+	char const* name;
+	bool ( *setup )( app_o* self );
+	void ( *add_passes )( app_o* self, le::RenderGraph& rendergraph );
+};
+
+struct workload_result_t {
+	workload_t const*   workload;
+	bool                did_run = false;
+	std::vector<double> frame_ms; // wall-clock time between successive frames
+	std::vector<double> cpu_ms;   // renderer cpu time: record + acquire + process + dispatch
+	std::vector<double> gpu_ms;   // sum of gpu time over all passes of a frame
+};
+
+struct frame_time_benchmark_app_o {
+	le::Renderer renderer;
+	LeCamera     camera;
+
+	// Settings - these may be set via command line arguments
+	uint32_t                       width             = 1280;
+	uint32_t                       height            = 720;
+	uint32_t                       num_frames        = 300; // measured frames per workload
+	uint32_t                       num_warmup_frames = 30;  // frames per workload which are rendered before we start measuring
+	std::string                    gltf_path;               // empty means: generate a default scene
+	std::string                    output_path;             // empty means: write to stdout
+	std::vector<workload_t const*> workloads;               // workloads to run, in order
+
+	// Progress
+	size_t                                workload_index = 0; // index into workloads
+	uint32_t                              frame_index    = 0; // frame index within current workload
+	std::chrono::steady_clock::time_point last_frame_time;
+	uint64_t                              last_cpu_frame_number = ~uint64_t( 0 );
+	uint64_t                              last_gpu_frame_number = ~uint64_t( 0 );
+	std::vector<workload_result_t>        results;
+	bool                                  has_error = false;
+
+	// Workload state
+	le_img_resource_handle      swapchain_image;
+	le_stage_o*                 stage = nullptr; // owning
+	le_stage_api::draw_params_t stage_draw_params{};
+	le_buf_resource_handle      sort_buffer             = LE_BUF_RESOURCE( "Benchmark-Sort-Data" );
+	uint32_t                    sort_num_elements       = 1 << 18; // must be a power of two
+	bool                        sort_buffer_initialized = false;
+};
+
+// ----------------------------------------------------------------------
+
+static void app_initialize(){};
+
+// ----------------------------------------------------------------------
+
+static void app_terminate(){};
+
+// ----------------------------------------------------------------------
+// Workload: hello_triangle - a single draw call, with inline vertex data.
+// This measures the fixed cost per frame.
+
+static bool workload_triangle_setup( app_o* ) {
+	return true;
+}
+
+static void pass_triangle_exec( le_command_buffer_encoder_o* encoder_, void* user_data ) {
+	auto        app = static_cast<app_o*>( user_data );
+	le::Encoder encoder{ encoder_ };
+
+	auto extents = encoder.getRenderpassExtent();
+
+	app->camera.setViewport( { 0.f, 0.f, float( extents.width ), float( extents.height ), 0.f, 1.f } );
+
+	struct MvpUbo {
+		glm::mat4 model;
+		glm::mat4 view;
+		glm::mat4 projection;
+	};
+
+	static auto pipeline =
+	    LeGraphicsPipelineBuilder( encoder.getPipelineManager() )
+	        .addShaderStage(
+	            LeShaderModuleBuilder( encoder.getPipelineManager() )
+	                .setShaderStage( le::ShaderStage::eVertex )
+	                .setSourceFilePath( "./resources/shaders/default.vert" )
+	                .build() )
+	        .addShaderStage(
+	            LeShaderModuleBuilder( encoder.getPipelineManager() )
+	                .setShaderStage( le::ShaderStage::eFragment )
+	                .setSourceFilePath( "./resources/shaders/default.frag" )
+	                .build() )
+	        .build();
+
+	MvpUbo mvp;
+	mvp.model = glm::scale( glm::mat4( 1.f ), glm::vec3( 4.5 ) );
+	app->camera.getViewMatrix( ( float* )( &mvp.view ) );
+	app->camera.getProjectionMatrix( ( float* )( &mvp.projection ) );
+
+	glm::vec3 vertexPositions[] = {
+	    { -50, -50, 0 },
+	    { 50, -50, 0 },
+	    { 0, 50, 0 },
+	};
+
+	glm::vec4 vertexColors[] = {
+	    { 1, 0, 0, 1.f },
+	    { 0, 1, 0, 1.f },
+	    { 0, 0, 1, 1.f },
+	};
+
+	encoder
+	    .bindGraphicsPipeline( pipeline )
+	    .setArgumentData( LE_ARGUMENT_NAME( "Mvp" ), &mvp, sizeof( MvpUbo ) )
+	    .setVertexData( vertexPositions, sizeof( vertexPositions ), 0 )
+	    .setVertexData( vertexColors, sizeof( vertexColors ), 1 )
+	    .draw( 3 );
+}
+
+static void workload_triangle_add_passes( app_o* self, le::RenderGraph& rendergraph ) {
+	rendergraph.addRenderPass(
+	    le::RenderPass( "hello_triangle", le::QueueFlagBits::eGraphics )
+	        .addColorAttachment( self->swapchain_image )
+	        .setExecuteCallback( self, pass_triangle_exec ) );
+}
+
+// ----------------------------------------------------------------------
+// Workload: le_2d_stress - thousands of 2d primitives, which le_2d must
+// tessellate, and draw, every frame. This stresses cpu-side encoding.
+
+static bool workload_2d_setup( app_o* ) {
+	return true;
+}
+
+static void pass_2d_exec( le_command_buffer_encoder_o* encoder_, void* user_data ) {
+	auto app     = static_cast<app_o*>( user_data );
+	auto extents = le::Encoder{ encoder_ }.getRenderpassExtent();
+
+	static constexpr uint32_t NUM_PRIMITIVES = 2000;
+
+	float const w = float( extents.width );
+	float const h = float( extents.height );
+	float const t = float( app->frame_index ) * 0.01f;
+
+	Le2D le2d{ encoder_ }; // primitives are drawn when le2d goes out of scope
+
+	for ( uint32_t i = 0; i != NUM_PRIMITIVES; i++ ) {
+		float const     phase = float( i ) * 0.618034f + t;
+		glm::vec2 const pos{ w * ( 0.5f + 0.45f * sinf( phase * 1.3f ) ), h * ( 0.5f + 0.45f * cosf( phase * 0.7f ) ) };
+		uint8_t const   c = uint8_t( i % 256 );
+
+		if ( i % 2 ) {
+			le2d.circle()
+			    .set_node_position( pos )
+			    .set_radius( 4.f + float( i % 16 ) )
+			    .set_filled( i % 4 == 1 )
+			    .set_stroke_weight( 2.f )
+			    .set_color( c, 255 - c, 128 )
+			    .draw();
+		} else {
+			le2d.line()
+			    .set_p0( pos )
+			    .set_p1( pos + glm::vec2{ 40.f * cosf( phase ), 40.f * sinf( phase ) } )
+			    .set_stroke_weight( 3.f )
+			    .set_color( 255 - c, c, 255 )
+			    .draw();
+		}
+	}
+}
+
+static void workload_2d_add_passes( app_o* self, le::RenderGraph& rendergraph ) {
+	rendergraph.addRenderPass(
+	    le::RenderPass( "le_2d_stress", le::QueueFlagBits::eGraphics )
+	        .addColorAttachment( self->swapchain_image )
+	        .setExecuteCallback( self, pass_2d_exec ) );
+}
+
+// ----------------------------------------------------------------------
+// Workload: le_stage_gltf - a glTF scene, drawn via le_stage. If no glTF
+// file was given, we generate a scene: a grid of lit cubes, with a camera.
+
+static std::string base64_encode( uint8_t const* data, size_t num_bytes ) {
+	static constexpr char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	std::string result;
+	result.reserve( ( ( num_bytes + 2 ) / 3 ) * 4 );
+
+	for ( size_t i = 0; i < num_bytes; i += 3 ) {
+		uint32_t n = uint32_t( data[ i ] ) << 16;
+		if ( i + 1 < num_bytes ) n |= uint32_t( data[ i + 1 ] ) << 8;
+		if ( i + 2 < num_bytes ) n |= uint32_t( data[ i + 2 ] );
+		result.push_back( ALPHABET[ ( n >> 18 ) & 63 ] );
+		result.push_back( ALPHABET[ ( n >> 12 ) & 63 ] );
+		result.push_back( i + 1 < num_bytes ? ALPHABET[ ( n >> 6 ) & 63 ] : '=' );
+		result.push_back( i + 2 < num_bytes ? ALPHABET[ n & 63 ] : '=' );
+	}
+
+	return result;
+}
+
+static bool write_default_gltf_scene( char const* path ) {
+
+	static constexpr int GRID_SIZE = 16; // cubes per row, and per column
+
+	// -- Cube geometry: 4 vertices per face, so that each face gets its own normal.
+
+	glm::vec3 positions[ 24 ];
+	glm::vec3 normals[ 24 ];
+	uint16_t  indices[ 36 ];
+
+	// For each face: normal n, and tangents u, v so that cross(u,v) == n,
+	// which gives us counter-clockwise winding when seen from outside.
+	glm::vec3 const faces[ 6 ][ 3 ] = {
+	    { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } },
+	    { { -1, 0, 0 }, { 0, 0, 1 }, { 0, 1, 0 } },
+	    { { 0, 1, 0 }, { 0, 0, 1 }, { 1, 0, 0 } },
+	    { { 0, -1, 0 }, { 1, 0, 0 }, { 0, 0, 1 } },
+	    { { 0, 0, 1 }, { 1, 0, 0 }, { 0, 1, 0 } },
+	    { { 0, 0, -1 }, { 0, 1, 0 }, { 1, 0, 0 } },
+	};
+
+	for ( int f = 0; f != 6; f++ ) {
+		auto const& n = faces[ f ][ 0 ];
+		auto const& u = faces[ f ][ 1 ];
+		auto const& v = faces[ f ][ 2 ];
+
+		positions[ f * 4 + 0 ] = 0.5f * ( n - u - v );
+		positions[ f * 4 + 1 ] = 0.5f * ( n + u - v );
+		positions[ f * 4 + 2 ] = 0.5f * ( n + u + v );
+		positions[ f * 4 + 3 ] = 0.5f * ( n - u + v );
+
+		for ( int i = 0; i != 4; i++ ) {
+			normals[ f * 4 + i ] = n;
+		}
+
+		uint16_t const quad[ 6 ] = { 0, 1, 2, 0, 2, 3 };
+		for ( int i = 0; i != 6; i++ ) {
+			indices[ f * 6 + i ] = uint16_t( f * 4 + quad[ i ] );
+		}
+	}
+
+	std::vector<uint8_t> buffer;
+	buffer.insert( buffer.end(), ( uint8_t const* )positions, ( uint8_t const* )positions + sizeof( positions ) );
+	buffer.insert( buffer.end(), ( uint8_t const* )normals, ( uint8_t const* )normals + sizeof( normals ) );
+	buffer.insert( buffer.end(), ( uint8_t const* )indices, ( uint8_t const* )indices + sizeof( indices ) );
+
+	// -- Nodes: one per cube, plus one for the camera, which comes last.
+
+	std::string nodes;
+	std::string scene_nodes;
+	char        str[ 256 ];
+
+	for ( int y = 0; y != GRID_SIZE; y++ ) {
+		for ( int x = 0; x != GRID_SIZE; x++ ) {
+			snprintf( str, sizeof( str ), "{\"mesh\":0,\"translation\":[%f,%f,0]},",
+			          2.f * ( float( x ) - 0.5f * float( GRID_SIZE - 1 ) ),
+			          2.f * ( float( y ) - 0.5f * float( GRID_SIZE - 1 ) ) );
+			nodes += str;
+			snprintf( str, sizeof( str ), "%d,", y * GRID_SIZE + x );
+			scene_nodes += str;
+		}
+	}
+
+	nodes += "{\"camera\":0,\"translation\":[0,0,40]}";
+	snprintf( str, sizeof( str ), "%d", GRID_SIZE * GRID_SIZE );
+	scene_nodes += str;
+
+	// clang-format off
+	std::string gltf =
+	    "{\"asset\":{\"version\":\"2.0\"},"
+	    "\"scene\":0,"
+	    "\"scenes\":[{\"nodes\":[" + scene_nodes + "]}],"
+	    "\"nodes\":[" + nodes + "],"
+	    "\"cameras\":[{\"type\":\"perspective\",\"perspective\":{\"yfov\":0.8,\"znear\":0.1,\"zfar\":1000}}],"
+	    "\"materials\":[{\"pbrMetallicRoughness\":{\"baseColorFactor\":[0.8,0.5,0.2,1],\"metallicFactor\":0.1,\"roughnessFactor\":0.6}}],"
+	    "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1},\"indices\":2,\"material\":0}]}],"
+	    "\"accessors\":["
+	        "{\"bufferView\":0,\"componentType\":5126,\"count\":24,\"type\":\"VEC3\",\"min\":[-0.5,-0.5,-0.5],\"max\":[0.5,0.5,0.5]},"
+	        "{\"bufferView\":1,\"componentType\":5126,\"count\":24,\"type\":\"VEC3\"},"
+	        "{\"bufferView\":2,\"componentType\":5123,\"count\":36,\"type\":\"SCALAR\"}],"
+	    "\"bufferViews\":["
+	        "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":" + std::to_string( sizeof( positions ) ) + ",\"target\":34962},"
+	        "{\"buffer\":0,\"byteOffset\":" + std::to_string( sizeof( positions ) ) + ",\"byteLength\":" + std::to_string( sizeof( normals ) ) + ",\"target\":34962},"
+	        "{\"buffer\":0,\"byteOffset\":" + std::to_string( sizeof( positions ) + sizeof( normals ) ) + ",\"byteLength\":" + std::to_string( sizeof( indices ) ) + ",\"target\":34963}],"
+	    "\"buffers\":[{\"byteLength\":" + std::to_string( buffer.size() ) + ",\"uri\":\"data:application/octet-stream;base64," + base64_encode( buffer.data(), buffer.size() ) + "\"}]"
+	    "}";
+	// clang-format on
+
+	FILE* file = fopen( path, "wb" );
+
+	if ( nullptr == file ) {
+		return false;
+	}
+
+	bool const success = fwrite( gltf.data(), 1, gltf.size(), file ) == gltf.size();
+	fclose( file );
+
+	return success;
+}
+
+static bool workload_stage_setup( app_o* self ) {
+	static auto logger = LeLog( LOGGER_LABEL );
+	using namespace le_stage;
+
+	if ( self->gltf_path.empty() ) {
+		self->gltf_path = "./frame_time_benchmark_scene.gltf";
+		if ( !write_default_gltf_scene( self->gltf_path.c_str() ) ) {
+			logger.error( "Could not write default glTF scene to '%s'", self->gltf_path.c_str() );
+			return false;
+		}
+	}
+
+	self->stage = le_stage_i.create( self->renderer, nullptr );
+
+	{
+		LeGltf gltf( self->gltf_path.c_str() );
+		if ( !gltf.import( self->stage ) ) {
+			logger.error( "Could not import glTF file '%s'", self->gltf_path.c_str() );
+			return false;
+		}
+	}
+
+	le_stage_i.setup_pipelines( self->stage );
+
+	// No camera means: use the first camera in the scene.
+	self->stage_draw_params = { self->stage, nullptr };
+
+	return true;
+}
+
+static void workload_stage_add_passes( app_o* self, le::RenderGraph& rendergraph ) {
+	using namespace le_stage;
+
+	static le_img_resource_handle const DEPTH_IMAGE = LE_IMG_RESOURCE( "Benchmark-Depth-Buffer" );
+
+	le_stage_i.update( self->stage );
+	le_stage_i.update_rendermodule( self->stage, rendergraph );
+	le_stage_i.draw_into_module( &self->stage_draw_params, rendergraph, self->swapchain_image, DEPTH_IMAGE );
+
+	rendergraph.declareResource( DEPTH_IMAGE, le::ImageInfoBuilder().setUsageFlags( le::ImageUsageFlags( le::ImageUsageFlagBits::eDepthStencilAttachment ) ).build() );
+}
+
+// ----------------------------------------------------------------------
+// Workload: bitonic_sort - sorts a buffer on the gpu via compute shader,
+// every frame. The sorting network does the same amount of work, no matter
+// whether its input is sorted or not, which means we only need to fill the
+// buffer with noise once.
+
+static bool workload_sort_setup( app_o* self ) {
+	self->sort_buffer_initialized = false;
+	return true;
+}
+
+static bool pass_sort_init_setup( le_renderpass_o* rp_, void* user_data ) {
+	auto app = static_cast<app_o*>( user_data );
+
+	if ( app->sort_buffer_initialized ) {
+		return false;
+	}
+
+	le::RenderPass{ rp_ }.useBufferResource( app->sort_buffer, le::AccessFlagBits2::eTransferWrite );
+	return true;
+}
+
+static void pass_sort_init_exec( le_command_buffer_encoder_o* encoder_, void* user_data ) {
+	auto app = static_cast<app_o*>( user_data );
+
+	std::vector<uint32_t> noise( app->sort_num_elements );
+
+	srand( 10 ); // same seed for every run, so that runs are comparable
+	for ( auto& n : noise ) {
+		n = uint32_t( rand() );
+	}
+
+	le::Encoder{ encoder_ }.writeToBuffer( app->sort_buffer, 0, noise.data(), noise.size() * sizeof( uint32_t ) );
+
+	app->sort_buffer_initialized = true;
+}
+
+static void pass_sort_exec( le_command_buffer_encoder_o* encoder_, void* user_data ) {
+	auto        app = static_cast<app_o*>( user_data );
+	le::Encoder encoder{ encoder_ };
+
+	uint32_t const n                = app->sort_num_elements;
+	uint32_t const workgroup_size_x = std::min<uint32_t>( 1024, n / 2 );
+
+	static auto pipeline =
+	    LeComputePipelineBuilder( encoder.getPipelineManager() )
+	        .setShaderStage(
+	            LeShaderModuleBuilder( encoder.getPipelineManager() )
+	                .setShaderStage( le::ShaderStage::eCompute )
+	                .setSourceFilePath( "./local_resources/shaders/compute.glsl" ) // shared with bitonic_merge_sort_example
+	                .setSpecializationConstant( 1, workgroup_size_x )
+	                .build() )
+	        .build();
+
+	// Must match uniform `Parameters` in compute.glsl
+	struct Parameters {
+		enum eAlgorithmVariant : uint32_t {
+			eLocalBitonicMergeSort = 0,
+			eLocalDisperse         = 1,
+			eBigFlip               = 2,
+			eBigDisperse           = 3,
+		};
+		uint32_t          h;
+		eAlgorithmVariant algorithm;
+	};
+
+	encoder
+	    .bindComputePipeline( pipeline )
+	    .bindArgumentBuffer( LE_ARGUMENT_NAME( "SortData" ), app->sort_buffer );
+
+	uint32_t const workgroup_count = n / ( workgroup_size_x * 2 );
+
+	auto dispatch = [ & ]( uint32_t h, Parameters::eAlgorithmVariant algorithm ) {
+		Parameters params{ h, algorithm };
+		encoder
+		    .setArgumentData( LE_ARGUMENT_NAME( "Parameters" ), &params, sizeof( params ) )
+		    .dispatch( workgroup_count )
+		    .bufferMemoryBarrier( le::PipelineStageFlags2( le::PipelineStageFlagBits2::eComputeShader ),
+		                          le::PipelineStageFlags2( le::PipelineStageFlagBits2::eComputeShader ),
+		                          le::AccessFlags2( le::AccessFlagBits2::eShaderRead ),
+		                          app->sort_buffer );
+	};
+
+	uint32_t h = workgroup_size_x * 2;
+
+	dispatch( h, Parameters::eLocalBitonicMergeSort );
+
+	for ( h *= 2; h <= n; h *= 2 ) {
+		dispatch( h, Parameters::eBigFlip );
+		for ( uint32_t hh = h / 2; hh > 1; hh /= 2 ) {
+			if ( hh <= workgroup_size_x * 2 ) {
+				dispatch( hh, Parameters::eLocalDisperse );
+				break;
+			}
+			dispatch( hh, Parameters::eBigDisperse );
+		}
+	}
+}
+
+static void workload_sort_add_passes( app_o* self, le::RenderGraph& rendergraph ) {
+
+	rendergraph
+	    .addRenderPass(
+	        le::RenderPass( "bitonic_sort_init", le::QueueFlagBits::eTransfer )
+	            .setSetupCallback( self, pass_sort_init_setup )
+	            .setExecuteCallback( self, pass_sort_init_exec ) )
+	    .addRenderPass(
+	        le::RenderPass( "bitonic_sort", le::QueueFlagBits::eCompute )
+	            .useBufferResource( self->sort_buffer, le::AccessFlagBits2::eShaderRead, le::AccessFlagBits2::eShaderWrite )
+	            .setExecuteCallback( self, pass_sort_exec ) )
+	    .addRenderPass(
+	        // This pass only exists so that the sort pass contributes to the swapchain image.
+	        le::RenderPass( "bitonic_sort_root", le::QueueFlagBits::eGraphics )
+	            .useBufferResource( self->sort_buffer, le::AccessFlagBits2::eShaderStorageRead )
+	            .addColorAttachment( self->swapchain_image ) );
+
+	rendergraph.declareResource(
+	    self->sort_buffer,
+	    le::BufferInfoBuilder()
+	        .setSize( self->sort_num_elements * sizeof( uint32_t ) )
+	        .addUsageFlags( le::BufferUsageFlagBits::eStorageBuffer | le::BufferUsageFlagBits::eTransferDst )
+	        .build() );
+}
+
+// ----------------------------------------------------------------------
+
+static workload_t const WORKLOADS[] = {
+    { "hello_triangle", workload_triangle_setup, workload_triangle_add_passes },
+    { "le_2d_stress", workload_2d_setup, workload_2d_add_passes },
+    { "le_stage_gltf", workload_stage_setup, workload_stage_add_passes },
+    { "bitonic_sort", workload_sort_setup, workload_sort_add_passes },
+};
+
+static workload_t const* workload_find( char const* name, size_t name_len ) {
+	for ( auto const& w : WORKLOADS ) {
+		if ( strlen( w.name ) == name_len && 0 == strncmp( w.name, name, name_len ) ) {
+			return &w;
+		}
+	}
+	return nullptr;
+}
+
+// ----------------------------------------------------------------------
+
+static bool app_parse_arguments( app_o* self, int argc, char const* const* argv ) {
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	std::string workloads_list;
+
+	for ( int i = 1; i < argc; i++ ) {
+
+		bool const has_value = i + 1 < argc;
+
+		if ( 0 == strcmp( argv[ i ], "--frames" ) && has_value ) {
+			self->num_frames = uint32_t( strtoul( argv[ ++i ], nullptr, 10 ) );
+		} else if ( 0 == strcmp( argv[ i ], "--warmup" ) && has_value ) {
+			self->num_warmup_frames = uint32_t( strtoul( argv[ ++i ], nullptr, 10 ) );
+		} else if ( 0 == strcmp( argv[ i ], "--width" ) && has_value ) {
+			self->width = uint32_t( strtoul( argv[ ++i ], nullptr, 10 ) );
+		} else if ( 0 == strcmp( argv[ i ], "--height" ) && has_value ) {
+			self->height = uint32_t( strtoul( argv[ ++i ], nullptr, 10 ) );
+		} else if ( 0 == strcmp( argv[ i ], "--gltf" ) && has_value ) {
+			self->gltf_path = argv[ ++i ];
+		} else if ( 0 == strcmp( argv[ i ], "--output" ) && has_value ) {
+			self->output_path = argv[ ++i ];
+		} else if ( 0 == strcmp( argv[ i ], "--workloads" ) && has_value ) {
+			workloads_list = argv[ ++i ];
+		} else {
+			logger.error( "Unknown or incomplete argument: '%s'", argv[ i ] );
+			return false;
+		}
+	}
+
+	if ( self->num_frames == 0 || self->width == 0 || self->height == 0 ) {
+		logger.error( "Number of frames, width and height must be larger than zero." );
+		return false;
+	}
+
+	if ( workloads_list.empty() ) {
+		for ( auto const& w : WORKLOADS ) {
+			self->workloads.push_back( &w );
+		}
+		return true;
+	}
+
+	// ---------| invariant: workloads were given as a comma-separated list
+
+	for ( size_t start = 0; start <= workloads_list.size(); ) {
+		size_t end = workloads_list.find( ',', start );
+		if ( end == std::string::npos ) {
+			end = workloads_list.size();
+		}
+		workload_t const* w = workload_find( workloads_list.c_str() + start, end - start );
+		if ( nullptr == w ) {
+			logger.error( "Unknown workload: '%s'", workloads_list.substr( start, end - start ).c_str() );
+			return false;
+		}
+		self->workloads.push_back( w );
+		start = end + 1;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+static app_o* app_create( int argc, char const* const* argv ) {
+	auto app = new ( app_o );
+
+	// Benchmarks must run unattended, possibly on a software driver -
+	// validation layers would distort measurements.
+	LE_SETTING( const bool, LE_SETTING_SHOULD_USE_VALIDATION_LAYERS, false );
+
+	// We need cpu timings from the renderer, and gpu timings from the backend.
+	LE_SETTING( bool, LE_SETTING_RENDERER_ENABLE_FRAME_TIMINGS, true );
+	LE_SETTING( bool, LE_SETTING_BACKEND_ENABLE_GPU_TIMESTAMPS, true );
+	*LE_SETTING_RENDERER_ENABLE_FRAME_TIMINGS = true;
+	*LE_SETTING_BACKEND_ENABLE_GPU_TIMESTAMPS = true;
+
+	if ( !app_parse_arguments( app, argc, argv ) ) {
+		app->has_error = true;
+		app->workloads.clear();
+		return app;
+	}
+
+	// We render into an image swapchain which discards its images - this
+	// means we don't need a window, or a display.
+	le::RendererInfoBuilder renderer_info;
+	renderer_info
+	    .addSwapchain()
+	    .setWidthHint( app->width )
+	    .setHeightHint( app->height )
+	    .asImgSwapchain()
+	    .setDiscardOutput()
+	    .end()
+	    .end();
+
+	app->renderer.setup( renderer_info.build() );
+
+	app->swapchain_image = app->renderer.getSwapchainResource();
+
+	// Set up the camera
+	le::Extent2D extents{};
+	app->renderer.getSwapchainExtent( &extents.width, &extents.height );
+	app->camera.setViewport( { 0, 0, float( extents.width ), float( extents.height ), 0.f, 1.f } );
+	app->camera.setFovRadians( glm::radians( 60.f ) ); // glm::radians converts degrees to radians
+	glm::mat4 camMatrix = glm::lookAt( glm::vec3{ 0, 0, app->camera.getUnitDistance() }, glm::vec3{ 0 }, glm::vec3{ 0, 1, 0 } );
+	app->camera.setViewMatrix( ( float* )( &camMatrix ) );
+
+	return app;
+}
+
+// ----------------------------------------------------------------------
+// Fetches timings for the most recently completed frame - frames complete
+// with some delay, which is why we must check whether we have seen a frame
+// before.
+static void app_collect_timings( app_o* self, workload_result_t& result ) {
+	using namespace le_renderer;
+	using namespace le_backend_vk;
+
+	le_renderer_frame_timing_t timing{};
+
+	if ( renderer_i.get_frame_timings( self->renderer, 0, &timing, nullptr, nullptr ) &&
+	     timing.frame_number != self->last_cpu_frame_number ) {
+		self->last_cpu_frame_number = timing.frame_number;
+		result.cpu_ms.push_back( timing.record_ms + timing.acquire_ms + timing.process_ms + timing.dispatch_ms );
+	}
+
+	static std::vector<le_backend_pass_gpu_timing_t> gpu_timings;
+
+	le_backend_o* backend      = renderer_i.get_backend( self->renderer );
+	size_t        count        = gpu_timings.size();
+	uint64_t      frame_number = 0;
+
+	if ( !vk_backend_i.get_pass_gpu_timings( backend, &count, gpu_timings.data(), &frame_number ) ) {
+		gpu_timings.resize( count );
+		if ( !vk_backend_i.get_pass_gpu_timings( backend, &count, gpu_timings.data(), &frame_number ) ) {
+			return;
+		}
+	}
+
+	if ( count == 0 || frame_number == self->last_gpu_frame_number ) {
+		return;
+	}
+
+	self->last_gpu_frame_number = frame_number;
+
+	double gpu_ms = 0;
+	for ( size_t i = 0; i != count; i++ ) {
+		gpu_ms += gpu_timings[ i ].gpu_ms;
+	}
+	result.gpu_ms.push_back( gpu_ms );
+}
+
+// ----------------------------------------------------------------------
+
+static void write_stats_json( FILE* file, char const* name, std::vector<double> const& samples ) {
+
+	if ( samples.empty() ) {
+		fprintf( file, "\"%s\": null", name );
+		return;
+	}
+
+	std::vector<double> sorted = samples;
+	std::sort( sorted.begin(), sorted.end() );
+
+	double sum = 0;
+	for ( auto const& s : sorted ) {
+		sum += s;
+	}
+
+	auto percentile = [ & ]( double p ) -> double {
+		return sorted[ std::min( sorted.size() - 1, size_t( p * double( sorted.size() ) ) ) ];
+	};
+
+	fprintf( file, "\"%s\": { \"mean\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"samples\": %zu }",
+	         name, sum / double( sorted.size() ), percentile( 0.95 ), percentile( 0.99 ), sorted.size() );
+}
+
+static void app_write_results( app_o* self ) {
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	FILE* file = stdout;
+
+	if ( !self->output_path.empty() ) {
+		file = fopen( self->output_path.c_str(), "wb" );
+		if ( nullptr == file ) {
+			logger.error( "Could not open output file '%s'", self->output_path.c_str() );
+			self->has_error = true;
+			return;
+		}
+	}
+
+	fprintf( file, "{\n" );
+	fprintf( file, "  \"width\": %u,\n  \"height\": %u,\n  \"frames\": %u,\n  \"warmup_frames\": %u,\n",
+	         self->width, self->height, self->num_frames, self->num_warmup_frames );
+	fprintf( file, "  \"workloads\": [" );
+
+	for ( size_t i = 0; i != self->results.size(); i++ ) {
+		auto const& r = self->results[ i ];
+		fprintf( file, "%s\n    { \"name\": \"%s\", \"ok\": %s,\n      ", i ? "," : "", r.workload->name, r.did_run ? "true" : "false" );
+		write_stats_json( file, "frame_ms", r.frame_ms );
+		fprintf( file, ",\n      " );
+		write_stats_json( file, "cpu_ms", r.cpu_ms );
+		fprintf( file, ",\n      " );
+		write_stats_json( file, "gpu_ms", r.gpu_ms );
+		fprintf( file, " }" );
+	}
+
+	fprintf( file, "\n  ]\n}\n" );
+
+	if ( file != stdout ) {
+		fclose( file );
+		logger.info( "Wrote results to '%s'", self->output_path.c_str() );
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static bool app_update( app_o* self ) {
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	if ( self->workload_index >= self->workloads.size() ) {
+		if ( !self->results.empty() ) {
+			app_write_results( self );
+		}
+		return false;
+	}
+
+	// ---------| invariant: there is a workload left to run
+
+	workload_t const* workload = self->workloads[ self->workload_index ];
+
+	if ( self->frame_index == 0 ) {
+
+		self->results.push_back( { workload } );
+
+		logger.info( "Running workload '%s': %u warmup frames, %u frames", workload->name, self->num_warmup_frames, self->num_frames );
+
+		if ( !workload->setup( self ) ) {
+			logger.error( "Could not set up workload '%s' - skipping.", workload->name );
+			self->has_error = true;
+			self->workload_index++;
+			return true;
+		}
+
+		self->results.back().did_run = true;
+	}
+
+	le::RenderGraph renderGraph{};
+
+	workload->add_passes( self, renderGraph );
+
+	self->renderer.update( renderGraph );
+
+	auto       now          = std::chrono::steady_clock::now();
+	auto&      result       = self->results.back();
+	bool const is_measuring = self->frame_index > self->num_warmup_frames;
+
+	if ( is_measuring ) {
+		result.frame_ms.push_back( std::chrono::duration<double, std::milli>( now - self->last_frame_time ).count() );
+		app_collect_timings( self, result );
+	}
+
+	self->last_frame_time = now;
+	self->frame_index++;
+
+	if ( self->frame_index > self->num_warmup_frames + self->num_frames ) {
+		self->workload_index++;
+		self->frame_index = 0;
+	}
+
+	return true; // keep app alive
+}
+
+// ----------------------------------------------------------------------
+
+static int app_get_result( app_o* self ) {
+	return self->has_error ? 1 : 0;
+}
+
+// ----------------------------------------------------------------------
+
+static void app_destroy( app_o* self ) {
+	using namespace le_stage;
+
+	if ( self->stage ) {
+		le_stage_i.destroy( self->stage );
+	}
+
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( frame_time_benchmark_app, api ) {
+	auto  frame_time_benchmark_app_api_i = static_cast<frame_time_benchmark_app_api*>( api );
+	auto& frame_time_benchmark_app_i     = frame_time_benchmark_app_api_i->frame_time_benchmark_app_i;
+
+	frame_time_benchmark_app_i.initialize = app_initialize;
+	frame_time_benchmark_app_i.terminate  = app_terminate;
+
+	frame_time_benchmark_app_i.create     = app_create;
+	frame_time_benchmark_app_i.destroy    = app_destroy;
+	frame_time_benchmark_app_i.update     = app_update;
+	frame_time_benchmark_app_i.get_result = app_get_result;
+}
@@ -0,0 +1,67 @@
+#ifndef GUARD_frame_time_benchmark_app_H
+#define GUARD_frame_time_benchmark_app_H
+#endif
+
+#include "le_core.h"
+
+// depends on le_backend_vk. le_backend_vk must be loaded before this class is used.
+
+struct frame_time_benchmark_app_o;
+
+// clang-format off
+struct frame_time_benchmark_app_api {
+
+	struct frame_time_benchmark_app_interface_t {
+		frame_time_benchmark_app_o * ( *create     )( int argc, char const* const* argv );
+		void                         ( *destroy    )( frame_time_benchmark_app_o *self );
+		bool                         ( *update     )( frame_time_benchmark_app_o *self );
+		int                          ( *get_result )( frame_time_benchmark_app_o *self ); // 0 if all requested workloads ran
+		void                         ( *initialize )(); // static methods
+		void                         ( *terminate  )(); // static methods
+	};
+
+	frame_time_benchmark_app_interface_t frame_time_benchmark_app_i;
+};
+// clang-format on
+
+LE_MODULE( frame_time_benchmark_app );
+LE_MODULE_LOAD_DEFAULT( frame_time_benchmark_app );
+
+#ifdef __cplusplus
+
+namespace frame_time_benchmark_app {
+static const auto& api                        = frame_time_benchmark_app_api_i;
+static const auto& frame_time_benchmark_app_i = api -> frame_time_benchmark_app_i;
+} // namespace frame_time_benchmark_app
+
+class FrameTimeBenchmarkApp : NoCopy, NoMove {
+
+	frame_time_benchmark_app_o* self;
+
+  public:
+	FrameTimeBenchmarkApp( int argc, char const* const* argv )
+	    : self( frame_time_benchmark_app::frame_time_benchmark_app_i.create( argc, argv ) ) {
+	}
+
+	bool update() {
+		return frame_time_benchmark_app::frame_time_benchmark_app_i.update( self );
+	}
+
+	int getResult() {
+		return frame_time_benchmark_app::frame_time_benchmark_app_i.get_result( self );
+	}
+
+	~FrameTimeBenchmarkApp() {
+		frame_time_benchmark_app::frame_time_benchmark_app_i.destroy( self );
+	}
+
+	static void initialize() {
+		frame_time_benchmark_app::frame_time_benchmark_app_i.initialize();
+	}
+
+	static void terminate() {
+		frame_time_benchmark_app::frame_time_benchmark_app_i.terminate();
+	}
+};
+
+#endif
@@ -0,0 +1,50 @@
+#include "frame_time_benchmark_app/frame_time_benchmark_app.h"
+
+/*
+
+Headless frame time benchmark.
+
+Renders a set of workloads into an image swapchain - no window needed - for
+a fixed number of frames each, and writes cpu and gpu frame time statistics
+as JSON. See README.md for command line options.
+
+The exit code is non-zero if any of the requested workloads could not run,
+so that this may be used to gate merges.
+
+*/
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const* argv[] ) {
+
+	int exit_code = 0;
+
+	FrameTimeBenchmarkApp::initialize();
+
+	{
+		// We instantiate FrameTimeBenchmarkApp in its own scope - so that
+		// it will be destroyed before FrameTimeBenchmarkApp::terminate
+		// is called.
+
+		FrameTimeBenchmarkApp frameTimeBenchmarkApp{ argc, argv };
+
+		for ( ;; ) {
+
+#ifdef PLUGINS_DYNAMIC
+			le_core_poll_for_module_reloads();
+#endif
+			auto result = frameTimeBenchmarkApp.update();
+
+			if ( !result ) {
+				break;
+			}
+		}
+
+		exit_code = frameTimeBenchmarkApp.getResult();
+	}
+
+	// Must only be called once last FrameTimeBenchmarkApp is destroyed
+	FrameTimeBenchmarkApp::terminate();
+
+	return exit_code;
+}
@@ -0,0 +1,182 @@
+#include "private/le_backend_vk/le_concurrent_hash_map.inl"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+/*
+
+Pipeline cache map microbenchmark.
+
+Measures lookup cost of the map which the pipeline manager uses for its
+caches (`ConcurrentHashMap`, see `le_backend_vk/private/le_backend_vk/le_concurrent_hash_map.inl`),
+against the linear-scan table behind a shared mutex which it replaced,
+for 10, 100, and 10000 entries - with one, and with several reader threads.
+
+Results are written to stdout as JSON. See README.md.
+
+*/
+
+// ----------------------------------------------------------------------
+// Baseline: the table which the pipeline manager used before - lookups scan
+// all handles linearly, under a shared lock.
+template <typename T, typename U>
+class LinearScanTable {
+
+	std::shared_mutex mtx;
+	std::vector<T>    handles;
+	std::vector<U*>   objects; // owning
+
+  public:
+	bool try_insert( T const& handle, U* obj ) {
+		auto lock = std::unique_lock( mtx );
+		for ( auto const& h : handles ) {
+			if ( h == handle ) {
+				return false;
+			}
+		}
+		handles.push_back( handle );
+		objects.emplace_back( new U( *obj ) );
+		return true;
+	}
+
+	U* try_find( T const& needle ) {
+		auto      lock = std::shared_lock( mtx );
+		U* const* obj  = objects.data();
+		for ( auto const& h : handles ) {
+			if ( h == needle ) {
+				return *obj;
+			}
+			obj++;
+		}
+		return nullptr;
+	}
+
+	~LinearScanTable() {
+		for ( auto& obj : objects ) {
+			delete obj;
+		}
+	}
+};
+
+// ----------------------------------------------------------------------
+
+struct Result {
+	double ns_per_lookup;
+	double lookups_per_second; // summed over all threads
+};
+
+// ----------------------------------------------------------------------
+// Looks up `num_lookups` random keys which are present in `map`, from each of
+// `num_threads` threads, and returns the mean time per lookup.
+template <typename Map>
+static Result benchmark_lookups( Map& map, std::vector<uint64_t> const& keys, uint32_t num_threads, uint64_t num_lookups ) {
+
+	std::atomic<uint64_t> checksum = 0; // so that lookups cannot be optimised away
+	std::vector<std::thread> threads;
+
+	auto t_start = std::chrono::steady_clock::now();
+
+	for ( uint32_t t = 0; t != num_threads; t++ ) {
+		threads.emplace_back( [ & ]( uint32_t seed ) {
+			std::minstd_rand rng( seed );
+			uint64_t         sum = 0;
+			for ( uint64_t i = 0; i != num_lookups; i++ ) {
+				uint64_t* v = map.try_find( keys[ rng() % keys.size() ] );
+				sum += *v;
+			}
+			checksum += sum;
+		},
+		                      t + 1 );
+	}
+
+	for ( auto& t : threads ) {
+		t.join();
+	}
+
+	auto t_end = std::chrono::steady_clock::now();
+
+	if ( checksum == 0 ) {
+		fprintf( stderr, "unexpected checksum\n" );
+	}
+
+	double ns = std::chrono::duration<double, std::nano>( t_end - t_start ).count();
+
+	return {
+	    ns / double( num_lookups ),
+	    double( num_lookups * num_threads ) / ( ns * 1e-9 ),
+	};
+}
+
+// ----------------------------------------------------------------------
+
+template <typename Map>
+static Result run( uint32_t num_entries, uint32_t num_threads, uint64_t num_lookups ) {
+
+	Map                   map;
+	std::vector<uint64_t> keys;
+	std::mt19937_64       rng( num_entries );
+
+	keys.reserve( num_entries );
+
+	while ( keys.size() != num_entries ) {
+		uint64_t k = rng();
+		if ( k != 0 && map.try_insert( k, &k ) ) {
+			keys.push_back( k );
+		}
+	}
+
+	return benchmark_lookups( map, keys, num_threads, num_lookups );
+}
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const* argv[] ) {
+
+	uint64_t num_lookups = 200000; // per thread
+	uint32_t num_threads = std::max( 2u, std::thread::hardware_concurrency() );
+
+	for ( int i = 1; i + 1 < argc; i += 2 ) {
+		if ( 0 == strcmp( argv[ i ], "--lookups" ) ) {
+			num_lookups = strtoull( argv[ i + 1 ], nullptr, 10 );
+		} else if ( 0 == strcmp( argv[ i ], "--threads" ) ) {
+			num_threads = uint32_t( strtoul( argv[ i + 1 ], nullptr, 10 ) );
+		}
+	}
+
+	uint32_t const entry_counts[]  = { 10, 100, 10000 };
+	uint32_t const thread_counts[] = { 1, num_threads };
+
+	printf( "{\n  \"lookups_per_thread\": %lu,\n  \"results\": [\n", num_lookups );
+
+	bool first = true;
+
+	for ( auto num_entries : entry_counts ) {
+		for ( auto threads : thread_counts ) {
+
+			Result concurrent  = run<ConcurrentHashMap<uint64_t, uint64_t>>( num_entries, threads, num_lookups );
+			Result linear_scan = run<LinearScanTable<uint64_t, uint64_t>>( num_entries, threads, num_lookups );
+
+			printf( "%s    { \"entries\": %u, \"threads\": %u,\n"
+			        "      \"concurrent_hash_map\": { \"ns_per_lookup\": %.2f, \"lookups_per_second\": %.0f },\n"
+			        "      \"linear_scan_table\": { \"ns_per_lookup\": %.2f, \"lookups_per_second\": %.0f } }",
+			        first ? "" : ",\n",
+			        num_entries, threads,
+			        concurrent.ns_per_lookup, concurrent.lookups_per_second,
+			        linear_scan.ns_per_lookup, linear_scan.lookups_per_second );
+
+			first = false;
+		}
+	}
+
+	printf( "\n  ]\n}\n" );
+
+	return 0;
+}
@@ -23,8 +23,12 @@
 
 constexpr size_t cNumDataElements = 64;
 
+// Vertex positions are double-buffered: while the draw pass reads vertices which
+// were simulated in the previous frame, the compute pass simulates vertices for
+// the next frame. As the two passes don't access the same buffer, the rendergraph
+// schedules the compute pass as async compute, which may overlap with drawing.
 struct GpuMeshData {
-	le_buf_resource_handle vertex_handle;
+	le_buf_resource_handle vertex_handle[ 2 ];
 	le_buf_resource_handle index_handle;
 	uint32_t               vertex_num_bytes;
 	uint32_t               index_num_bytes;
@@ -82,7 +86,7 @@ static compute_example_app_o* compute_example_app_create() {
 	reset_camera( app );
 
 	app->gpu_mesh = new GpuMeshData{
-	    LE_BUF_RESOURCE( "vertex_buffer" ),
+	    { LE_BUF_RESOURCE( "vertex_buffer_0" ), LE_BUF_RESOURCE( "vertex_buffer_1" ) },
 	    LE_BUF_RESOURCE( "index_buffer" ),
 	    ( cNumDataElements + 1 ) * ( cNumDataElements + 1 ) * sizeof( glm::vec4 ),    // vertex_num_bytes
 	    ( cNumDataElements + 1 ) * ( cNumDataElements + 1 ) * 6 * sizeof( uint16_t ), // indices_num_bytes
@@ -106,6 +110,18 @@ static void reset_camera( compute_example_app_o* self ) {
 	self->camera.setViewMatrix( ( float* )( &camMatrix ) );
 }
 
+// ----------------------------------------------------------------------
+// Vertex buffer which the draw pass reads from in the current frame
+static le_buf_resource_handle const& get_vertex_buffer_for_draw( compute_example_app_o const* self ) {
+	return self->gpu_mesh->vertex_handle[ self->frame_counter % 2 ];
+}
+
+// ----------------------------------------------------------------------
+// Vertex buffer which the compute pass writes to in the current frame - the draw pass reads from it in the next frame
+static le_buf_resource_handle const& get_vertex_buffer_for_compute( compute_example_app_o const* self ) {
+	return self->gpu_mesh->vertex_handle[ ( self->frame_counter + 1 ) % 2 ];
+}
+
 // ----------------------------------------------------------------------
 
 static bool pass_initialise_setup( le_renderpass_o* pRp, void* user_data ) {
@@ -116,7 +132,7 @@ static bool pass_initialise_setup( le_renderpass_o* pRp, void* user_data ) {
 
 	le::RenderPass rp( pRp );
 	rp
-	    .useBufferResource( app->gpu_mesh->vertex_handle, le::AccessFlagBits2::eTransferWrite ) //
+	    .useBufferResource( get_vertex_buffer_for_draw( app ), le::AccessFlagBits2::eTransferWrite ) //
 	    .useBufferResource( app->gpu_mesh->index_handle, le::AccessFlagBits2::eTransferWrite )  //
 	    ;
 
@@ -160,7 +176,7 @@ static void pass_initialise_exec( le_command_buffer_encoder_o* encoder_, void* u
 			tmp_vertices.emplace_back( 1 );
 		}
 
-		encoder.writeToBuffer( app->gpu_mesh->vertex_handle, 0, tmp_vertices.data(), tmp_vertices.size() * sizeof( float ) );
+		encoder.writeToBuffer( get_vertex_buffer_for_draw( app ), 0, tmp_vertices.data(), tmp_vertices.size() * sizeof( float ) );
 	}
 	{
 		uint16_t const* indexData  = nullptr;
@@ -195,7 +211,7 @@ static void pass_compute_exec( le_command_buffer_encoder_o* encoder_, void* user
 
 	encoder
 	    .bindComputePipeline( psoCompute )
-	    .bindArgumentBuffer( LE_ARGUMENT_NAME( "ParticleBuf" ), app->gpu_mesh->vertex_handle )
+	    .bindArgumentBuffer( LE_ARGUMENT_NAME( "ParticleBuf" ), get_vertex_buffer_for_compute( app ) )
 	    .setArgumentData( LE_ARGUMENT_NAME( "Uniforms" ), &t_val, sizeof( float ) )
 	    .dispatch( ( cNumDataElements + 1 ) * ( cNumDataElements + 1 ), 1, 1 );
 }
@@ -213,7 +229,7 @@ static bool pass_draw_setup( le_renderpass_o* pRp, void* user_data ) {
 	        .build();
 	rp
 	    .addColorAttachment( app->renderer.getSwapchainResource(), attachment_info ) // color attachment
-	    .useBufferResource( app->gpu_mesh->vertex_handle )
+	    .useBufferResource( get_vertex_buffer_for_draw( app ) )
 	    .useBufferResource( app->gpu_mesh->index_handle, le::AccessFlagBits2::eIndexRead ) //
 	    ;
 
@@ -274,7 +290,7 @@ static void pass_draw_exec( le_command_buffer_encoder_o* encoder_, void* user_da
 	    .setLineWidth( 1 )
 	    .bindGraphicsPipeline( psoDefaultGraphics )
 	    .setArgumentData( LE_ARGUMENT_NAME( "Mvp" ), &mvp, sizeof( MvpUbo_t ) )
-	    .bindVertexBuffers( 0, 1, &app->gpu_mesh->vertex_handle, bufferOffsets )
+	    .bindVertexBuffers( 0, 1, &get_vertex_buffer_for_draw( app ), bufferOffsets )
 	    .bindIndexBuffer( app->gpu_mesh->index_handle, 0 )
 	    .drawIndexed( 6 * ( cNumDataElements + 1 ) * ( cNumDataElements + 1 ) );
 }
@@ -365,6 +381,14 @@ static bool compute_example_app_update( compute_example_app_o* self ) {
 
 	compute_example_app_process_ui_events( self );
 
+	if ( self->frame_counter == 10 ) {
+		// Generate a queue sync .dot file (debug builds only): if the device offers a second
+		// compute-capable queue, the async compute submission shows up as overlapping with
+		// the main submission.
+		LE_SETTING( uint32_t, LE_SETTING_GENERATE_QUEUE_SYNC_DOT_FILES, 0 );
+		*LE_SETTING_GENERATE_QUEUE_SYNC_DOT_FILES = 1; // generate 1 .dot file
+	}
+
 	le::RenderGraph renderGraph{};
 	{
 		// This pass will typically only get executed once - it will upload
@@ -376,7 +400,7 @@ static bool compute_example_app_update( compute_example_app_o* self ) {
 		        .setExecuteCallback( self, pass_initialise_exec );
 		auto passCompute =
 		    le::RenderPass( "compute", le::QueueFlagBits::eCompute )
-		        .useBufferResource( self->gpu_mesh->vertex_handle, le::AccessFlagBits2::eShaderStorageRead, le::AccessFlagBits2::eShaderStorageWrite )
+		        .useBufferResource( get_vertex_buffer_for_compute( self ), le::AccessFlagBits2::eShaderStorageWrite ) // compute shader only writes vertices
 		        .setExecuteCallback( self, pass_compute_exec );
 		auto passDraw =
 		    le::RenderPass( "draw", le::QueueFlagBits::eGraphics )
@@ -389,7 +413,13 @@ static bool compute_example_app_update( compute_example_app_o* self ) {
 		    .addRenderPass( passCompute )
 		    .addRenderPass( passDraw )
 		    .declareResource(
-		        self->gpu_mesh->vertex_handle,
+		        self->gpu_mesh->vertex_handle[ 0 ],
+		        le::BufferInfoBuilder()
+		            .setSize( self->gpu_mesh->vertex_num_bytes )
+		            .addUsageFlags( le::BufferUsageFlagBits::eVertexBuffer | le::BufferUsageFlagBits::eStorageBuffer | le::BufferUsageFlagBits::eTransferDst )
+		            .build() )
+		    .declareResource(
+		        self->gpu_mesh->vertex_handle[ 1 ],
 		        le::BufferInfoBuilder()
 		            .setSize( self->gpu_mesh->vertex_num_bytes )
 		            .addUsageFlags( le::BufferUsageFlagBits::eVertexBuffer | le::BufferUsageFlagBits::eStorageBuffer | le::BufferUsageFlagBits::eTransferDst )
@@ -0,0 +1,159 @@
+#include "frame_capture_replay_app.h"
+
+#include "le_renderer.hpp"
+#include "le_log.h"
+
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+static constexpr auto LOGGER_LABEL = "frame_capture_replay_app";
+
+struct frame_capture_replay_app_o {
+	le::Renderer        renderer;
+	le_frame_capture_o* capture        = nullptr;
+	uint32_t            num_iterations = 0;
+	uint64_t            frame_counter  = 0;
+
+	std::chrono::steady_clock::time_point last_frame_time;
+	std::vector<double>                   frame_times_ms; // one entry per replayed frame
+};
+
+// We use this local typedef so spare us lots of typing
+typedef frame_capture_replay_app_o app_o;
+
+// ----------------------------------------------------------------------
+
+static void app_initialize(){};
+
+// ----------------------------------------------------------------------
+
+static void app_terminate(){};
+
+// ----------------------------------------------------------------------
+
+static app_o* app_create( char const* capture_path, uint32_t num_iterations ) {
+	using namespace le_renderer;
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	auto app = new ( app_o );
+
+	app->capture        = frame_capture_i.load( capture_path );
+	app->num_iterations = num_iterations;
+
+	if ( nullptr == app->capture ) {
+		logger.error( "Could not load frame capture: '%s'", capture_path );
+		return app;
+	}
+
+	// Replay into an image swapchain which has the same extent as the
+	// swapchain of the captured app - we don't need a window, and we
+	// discard the rendered images.
+	uint32_t width  = 640;
+	uint32_t height = 480;
+	frame_capture_i.get_swapchain_extent( app->capture, 0, &width, &height );
+
+	le::RendererInfoBuilder renderer_info;
+	renderer_info
+	    .addSwapchain()
+	    .setWidthHint( width )
+	    .setHeightHint( height )
+	    .asImgSwapchain()
+	    .setDiscardOutput()
+	    .end()
+	    .end();
+
+	app->renderer.setup( renderer_info.build() );
+
+	app->frame_times_ms.reserve( num_iterations );
+
+	logger.info( "Replaying %d captured frame(s) from '%s' for %d iterations", frame_capture_i.get_num_frames( app->capture ), capture_path, num_iterations );
+
+	return app;
+}
+
+// ----------------------------------------------------------------------
+
+static void app_print_stats( app_o* self ) {
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	if ( self->frame_times_ms.empty() ) {
+		return;
+	}
+
+	std::vector<double> sorted = self->frame_times_ms;
+	std::sort( sorted.begin(), sorted.end() );
+
+	double sum = 0;
+	for ( auto const& t : sorted ) {
+		sum += t;
+	}
+
+	auto percentile = [ & ]( double p ) -> double {
+		return sorted[ std::min( sorted.size() - 1, size_t( p * double( sorted.size() ) ) ) ];
+	};
+
+	logger.info( "Frame time over %zu frames: mean %.3f ms, p50 %.3f ms, p95 %.3f ms, p99 %.3f ms",
+	             sorted.size(), sum / double( sorted.size() ), percentile( 0.50 ), percentile( 0.95 ), percentile( 0.99 ) );
+}
+
+// ----------------------------------------------------------------------
+
+static bool app_update( app_o* self ) {
+	using namespace le_renderer;
+
+	if ( nullptr == self->capture || self->frame_counter >= self->num_iterations ) {
+		app_print_stats( self );
+		return false;
+	}
+
+	uint32_t num_frames = frame_capture_i.get_num_frames( self->capture );
+
+	if ( num_frames == 0 ) {
+		return false;
+	}
+
+	le::RenderGraph renderGraph{};
+
+	frame_capture_i.add_frame_to_rendergraph( self->capture, uint32_t( self->frame_counter % num_frames ), renderGraph, self->renderer.getSwapchainResource() );
+
+	self->renderer.update( renderGraph );
+
+	auto now = std::chrono::steady_clock::now();
+
+	// The first frame includes setup costs (shader compilation, allocations) - don't count it.
+	if ( self->frame_counter > 0 ) {
+		self->frame_times_ms.push_back( std::chrono::duration<double, std::milli>( now - self->last_frame_time ).count() );
+	}
+
+	self->last_frame_time = now;
+	self->frame_counter++;
+
+	return true; // keep app alive
+}
+
+// ----------------------------------------------------------------------
+
+static void app_destroy( app_o* self ) {
+	using namespace le_renderer;
+
+	if ( self->capture ) {
+		frame_capture_i.destroy( self->capture );
+	}
+
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( frame_capture_replay_app, api ) {
+	auto  frame_capture_replay_app_api_i = static_cast<frame_capture_replay_app_api*>( api );
+	auto& frame_capture_replay_app_i     = frame_capture_replay_app_api_i->frame_capture_replay_app_i;
+
+	frame_capture_replay_app_i.initialize = app_initialize;
+	frame_capture_replay_app_i.terminate  = app_terminate;
+
+	frame_capture_replay_app_i.create  = app_create;
+	frame_capture_replay_app_i.destroy = app_destroy;
+	frame_capture_replay_app_i.update  = app_update;
+}
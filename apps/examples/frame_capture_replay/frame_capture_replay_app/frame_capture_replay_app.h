@@ -0,0 +1,62 @@
+#ifndef GUARD_frame_capture_replay_app_H
+#define GUARD_frame_capture_replay_app_H
+#endif
+
+#include "le_core.h"
+
+// depends on le_backend_vk. le_backend_vk must be loaded before this class is used.
+
+struct frame_capture_replay_app_o;
+
+// clang-format off
+struct frame_capture_replay_app_api {
+
+	struct frame_capture_replay_app_interface_t {
+		frame_capture_replay_app_o * ( *create     )( char const* capture_path, uint32_t num_iterations );
+		void                         ( *destroy    )( frame_capture_replay_app_o *self );
+		bool                         ( *update     )( frame_capture_replay_app_o *self );
+		void                         ( *initialize )(); // static methods
+		void                         ( *terminate  )(); // static methods
+	};
+
+	frame_capture_replay_app_interface_t frame_capture_replay_app_i;
+};
+// clang-format on
+
+LE_MODULE( frame_capture_replay_app );
+LE_MODULE_LOAD_DEFAULT( frame_capture_replay_app );
+
+#ifdef __cplusplus
+
+namespace frame_capture_replay_app {
+static const auto& api                        = frame_capture_replay_app_api_i;
+static const auto& frame_capture_replay_app_i = api -> frame_capture_replay_app_i;
+} // namespace frame_capture_replay_app
+
+class FrameCaptureReplayApp : NoCopy, NoMove {
+
+	frame_capture_replay_app_o* self;
+
+  public:
+	FrameCaptureReplayApp( char const* capture_path, uint32_t num_iterations )
+	    : self( frame_capture_replay_app::frame_capture_replay_app_i.create( capture_path, num_iterations ) ) {
+	}
+
+	bool update() {
+		return frame_capture_replay_app::frame_capture_replay_app_i.update( self );
+	}
+
+	~FrameCaptureReplayApp() {
+		frame_capture_replay_app::frame_capture_replay_app_i.destroy( self );
+	}
+
+	static void initialize() {
+		frame_capture_replay_app::frame_capture_replay_app_i.initialize();
+	}
+
+	static void terminate() {
+		frame_capture_replay_app::frame_capture_replay_app_i.terminate();
+	}
+};
+
+#endif
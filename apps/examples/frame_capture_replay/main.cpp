@@ -0,0 +1,52 @@
+#include "frame_capture_replay_app/frame_capture_replay_app.h"
+
+#include <cstdlib>
+
+/*
+
+Replays a frame capture, as written by `le::Renderer::requestFrameCapture()`.
+
+Usage:
+
+    Island-FrameCaptureReplay [capture_file] [num_iterations]
+
+Captured frames are replayed in a loop into an image swapchain - no window
+is needed. Once `num_iterations` frames have been rendered, the app prints
+frame timings and exits.
+
+*/
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const* argv[] ) {
+
+	char const* capture_path   = argc > 1 ? argv[ 1 ] : "./capture.lecap";
+	uint32_t    num_iterations = argc > 2 ? uint32_t( strtoul( argv[ 2 ], nullptr, 10 ) ) : 1000;
+
+	FrameCaptureReplayApp::initialize();
+
+	{
+		// We instantiate FrameCaptureReplayApp in its own scope - so that
+		// it will be destroyed before FrameCaptureReplayApp::terminate
+		// is called.
+
+		FrameCaptureReplayApp frameCaptureReplayApp{ capture_path, num_iterations };
+
+		for ( ;; ) {
+
+#ifdef PLUGINS_DYNAMIC
+			le_core_poll_for_module_reloads();
+#endif
+			auto result = frameCaptureReplayApp.update();
+
+			if ( !result ) {
+				break;
+			}
+		}
+	}
+
+	// Must only be called once last FrameCaptureReplayApp is destroyed
+	FrameCaptureReplayApp::terminate();
+
+	return 0;
+}
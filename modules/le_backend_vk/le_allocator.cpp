@@ -3,6 +3,8 @@
 
 #include "util/vk_mem_alloc/vk_mem_alloc.h"
 #include <cstring> // for memcpy
+#include <vector>
+#include <algorithm>
 
 /*
 
@@ -16,43 +18,76 @@ Linear sub-allocator
     the resource-system, we only need to know the LE-api specific handle for the
     buffer
 
+    + If a grow callback is set, the allocator chains further blocks (each held by
+    its own buffer) once its current block is exhausted. Chained blocks get
+    dropped on reset.
+
 */
 
 struct le_allocator_o {
 
-	le_buf_resource_handle resourceId = {}; // for transient allocators, this must contain index of transient allocator
+	struct Block {
+		le_buf_resource_handle resourceId = {}; // for transient allocators, this must contain index of transient buffer which holds this block
+
+		uint8_t* bufferBaseMemoryAddress = nullptr; // mapped memory address
+		uint64_t bufferBaseOffsetInBytes = 0;       // offset into buffer for first address belonging to this block
+		uint64_t capacity                = 0;       //
+		uint64_t bufferOffsetInBytes     = 0;       // offset into buffer for next allocation, initially: bufferBaseOffsetInBytes
+	};
+
+	std::vector<Block> blocks; // blocks[0] is permanent, further blocks get chained on demand, and dropped on reset. We allocate from the last block.
 
-	uint8_t* bufferBaseMemoryAddress = nullptr; // mapped memory address
-	uint64_t bufferBaseOffsetInBytes = 0;       // offset into buffer for first address belonging to this allocator
-	uint64_t capacity                = 0;
-	uint64_t alignment               = 256; // 1<<8== 256, minimum allocation chunk size (should proabbly be VkPhysicalDeviceLimits::minTexelBufferOffsetAlignment - see bufferView offset "valid use" in Spec: 11.2 )
+	uint64_t alignment = 256; // 1<<8== 256, minimum allocation chunk size (should proabbly be VkPhysicalDeviceLimits::minTexelBufferOffsetAlignment - see bufferView offset "valid use" in Spec: 11.2 )
 
-	uint8_t* pData               = bufferBaseMemoryAddress; // address of last allocation, initially: (bufferBaseMemoryAddress + bufferBaseOffsetInBytes)
-	uint64_t bufferOffsetInBytes = bufferBaseOffsetInBytes;
+	le_allocator_linear_grow_fn grow_fn        = nullptr; // optional: provides further blocks once the current block is exhausted
+	void*                       grow_user_data = nullptr; //
+
+	uint64_t bytes_used_peak = 0; // highest number of bytes handed out between two resets
 };
 
 // ----------------------------------------------------------------------
 
-static void allocator_reset( le_allocator_o* self ) {
-	self->bufferOffsetInBytes = self->bufferBaseOffsetInBytes;
-	self->pData               = self->bufferBaseMemoryAddress + self->bufferBaseOffsetInBytes;
+static le_allocator_o::Block allocator_block_from_allocation_info( VmaAllocationInfo const* info ) {
+	le_allocator_o::Block block{};
+
+	block.bufferBaseMemoryAddress = static_cast<uint8_t*>( info->pMappedData );
+	block.bufferBaseOffsetInBytes = info->offset;
+	block.capacity                = info->size;
+	block.bufferOffsetInBytes     = info->offset;
+
+	// -- Fetch resource handle of underlying buffer from VmaAllocation info
+	memcpy( &block.resourceId, &info->pUserData, sizeof( void* ) ); // note we copy pUserData as a value
+
+	return block;
 }
 
 // ----------------------------------------------------------------------
 
-static le_allocator_o* allocator_create( VmaAllocationInfo const* info, uint16_t alignment ) {
-	auto self = new le_allocator_o{};
+static uint64_t allocator_get_bytes_used( le_allocator_o const* self ) {
+	uint64_t bytes_used = 0;
+	for ( auto const& b : self->blocks ) {
+		bytes_used += b.bufferOffsetInBytes - b.bufferBaseOffsetInBytes;
+	}
+	return bytes_used;
+}
 
-	self->bufferBaseMemoryAddress = static_cast<uint8_t*>( info->pMappedData );
+// ----------------------------------------------------------------------
+// Drops any chained blocks - whoever provided these blocks via the grow callback
+// is responsible for freeing them once the frame which used them has been cleared.
+static void allocator_reset( le_allocator_o* self ) {
+	self->bytes_used_peak = std::max( self->bytes_used_peak, allocator_get_bytes_used( self ) );
 
-	self->bufferBaseOffsetInBytes = info->offset;
-	self->capacity                = info->size;
-	self->alignment               = alignment;
+	self->blocks.resize( 1 );
+	self->blocks[ 0 ].bufferOffsetInBytes = self->blocks[ 0 ].bufferBaseOffsetInBytes;
+}
 
-	// -- Fetch resource handle of underlying buffer from VmaAllocation info
-	memcpy( &self->resourceId, &info->pUserData, sizeof( void* ) ); // note we copy pUserData as a value
+// ----------------------------------------------------------------------
+
+static le_allocator_o* allocator_create( VmaAllocationInfo const* info, uint16_t alignment ) {
+	auto self = new le_allocator_o{};
 
-	//	self->resourceId = reinterpret_cast<le_buf_resource_handle const &>( info->pUserData );
+	self->blocks.push_back( allocator_block_from_allocation_info( info ) );
+	self->alignment = alignment;
 
 	allocator_reset( self );
 
@@ -66,35 +101,83 @@ static void allocator_destroy( le_allocator_o* self ) {
 }
 
 // ----------------------------------------------------------------------
+// Once set, the allocator calls `grow_fn` whenever an allocation does not fit into
+// its current block - the callback must provide a mapped block of at least `min_capacity` bytes.
+static void allocator_set_grow_callback( le_allocator_o* self, le_allocator_linear_grow_fn grow_fn, void* user_data ) {
+	self->grow_fn        = grow_fn;
+	self->grow_user_data = user_data;
+}
 
+// ----------------------------------------------------------------------
+// Note that the block from which we allocate may change with an allocation: you must
+// query `get_le_resource_id` *after* each allocation to find out which buffer holds the
+// allocated memory.
 static bool allocator_allocate( le_allocator_o* self, uint64_t numBytes, void** pData, uint64_t* bufferOffset ) {
 
 	// Calculate allocation size as a multiple (rounded up) of alignment
 
 	auto allocationSizeInBytes = self->alignment * ( ( numBytes + ( self->alignment - 1 ) ) / self->alignment );
 
-	auto addressAfterAllocation = self->pData + allocationSizeInBytes;
+	auto* block = &self->blocks.back();
+
+	if ( block->bufferOffsetInBytes + allocationSizeInBytes > block->bufferBaseOffsetInBytes + block->capacity ) {
 
-	if ( ( addressAfterAllocation ) > ( self->bufferBaseMemoryAddress + self->bufferBaseOffsetInBytes + self->capacity ) ) {
-		return false;
+		// -- Current block is exhausted - chain a new block, if we can.
+
+		VmaAllocationInfo info{};
+
+		if ( nullptr == self->grow_fn ||
+		     false == self->grow_fn( self->grow_user_data, std::max( allocationSizeInBytes, block->capacity ), &info ) ) {
+			return false;
+		}
+
+		self->blocks.push_back( allocator_block_from_allocation_info( &info ) );
+		block = &self->blocks.back();
+
+		if ( block->bufferOffsetInBytes + allocationSizeInBytes > block->bufferBaseOffsetInBytes + block->capacity ) {
+			return false;
+		}
 	}
 
 	// ----------| invariant: enough capacity to accomodate numBytes
 
-	*pData        = self->pData; // point to next free memory address
-	*bufferOffset = self->bufferOffsetInBytes;
-
-	self->pData = addressAfterAllocation;
+	*pData        = block->bufferBaseMemoryAddress + block->bufferOffsetInBytes; // point to next free memory address
+	*bufferOffset = block->bufferOffsetInBytes;
 
-	self->bufferOffsetInBytes += allocationSizeInBytes;
+	block->bufferOffsetInBytes += allocationSizeInBytes;
 
 	return true;
 }
 
 // ----------------------------------------------------------------------
-
+// Returns resource handle for the buffer which holds the most recent allocation.
 static le_buf_resource_handle allocator_get_le_resource_id( le_allocator_o* self ) {
-	return self->resourceId;
+	return self->blocks.back().resourceId;
+}
+
+// ----------------------------------------------------------------------
+// Returns memory which has been handed out from the block held by buffer `resource` since
+// the allocator was last reset, together with its offset into the buffer.
+// Returns false if `resource` does not refer to a block of this allocator.
+static bool allocator_get_used_data( le_allocator_o* self, le_buf_resource_handle resource, void const** data, uint64_t* buffer_offset, uint64_t* num_bytes ) {
+	for ( auto const& b : self->blocks ) {
+		if ( b.resourceId == resource ) {
+			*data          = b.bufferBaseMemoryAddress + b.bufferBaseOffsetInBytes;
+			*buffer_offset = b.bufferBaseOffsetInBytes;
+			*num_bytes     = b.bufferOffsetInBytes - b.bufferBaseOffsetInBytes;
+			return true;
+		}
+	}
+	return false;
+}
+
+// ----------------------------------------------------------------------
+
+static void allocator_get_stats( le_allocator_o* self, le_allocator_linear_stats_t* stats ) {
+	stats->bytes_used      = allocator_get_bytes_used( self );
+	stats->bytes_used_peak = std::max( self->bytes_used_peak, stats->bytes_used );
+	stats->capacity        = self->blocks.front().capacity;
+	stats->num_blocks      = uint32_t( self->blocks.size() );
 }
 
 // ----------------------------------------------------------------------
@@ -109,6 +192,9 @@ void register_le_allocator_linear_api( void* api_ ) {
 	le_allocator_linear_i.get_le_resource_id = allocator_get_le_resource_id;
 	le_allocator_linear_i.allocate           = allocator_allocate;
 	le_allocator_linear_i.reset              = allocator_reset;
+	le_allocator_linear_i.get_used_data      = allocator_get_used_data;
+	le_allocator_linear_i.set_grow_callback  = allocator_set_grow_callback;
+	le_allocator_linear_i.get_stats          = allocator_get_stats;
 }
 
 // ----------------------------------------------------------------------
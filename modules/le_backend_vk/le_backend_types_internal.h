@@ -5,6 +5,7 @@
 //       may share the same types for creating pipelines.
 
 #include <vector>
+#include <memory_resource>
 #include "util/volk/volk.h"
 #include "private/le_renderer/le_renderer_types.h" // for `le_vertex_input_attribute_description`, `le_vertex_input_binding_description`, `le_resource_handle`, `LeRenderPassType`
 
@@ -50,6 +51,25 @@ struct le_shader_binding_info {
 		       name_hash == lhs.name_hash;
 	}
 };
+
+// ----------------------------------------------------------------------
+// Bindless descriptor mode - opt-in, via backend settings `set_bindless_enabled`.
+//
+// Shaders may declare a descriptor set (at any set index) which holds either or both of:
+//
+//     layout ( set = N, binding = 0 ) uniform sampler2D le_bindless_textures[];
+//     layout ( set = N, binding = 1 ) readonly buffer le_bindless_buffers { ... } buffers[];
+//
+// For such a set, the pipeline manager uses one global descriptor set layout, and the
+// backend binds a descriptor set which holds descriptors for all textures, and buffers
+// which have been assigned a bindless index - see backend `get_bindless_texture_index`,
+// `get_bindless_buffer_index`. Shaders receive indices via push constants, or argument data.
+//
+constexpr uint32_t LE_BINDLESS_BINDING_TEXTURES = 0;     // combined image samplers
+constexpr uint32_t LE_BINDLESS_BINDING_BUFFERS  = 1;     // storage buffers
+constexpr uint32_t LE_BINDLESS_MAX_TEXTURES     = 16384; // number of elements in bindless texture array
+constexpr uint32_t LE_BINDLESS_MAX_BUFFERS      = 4096;  // number of elements in bindless buffer array
+
 // ----------------------------------------------------------------------
 struct le_descriptor_set_layout_t {
 	std::vector<le_shader_binding_info> binding_info;                  // binding info for this set
@@ -133,6 +153,7 @@ struct AttachmentInfo {
 		eResolveAttachment,
 	};
 	le_img_resource_handle  resource;           ///< which resource to look up for resource state
+	uint32_t                resource_index;     ///< dense per-frame index of resource - index into per-frame resource tables, such as the sync chain table
 	le::Format              format;             ///
 	le::AttachmentLoadOp    loadOp;             ///
 	le::AttachmentStoreOp   storeOp;            ///
@@ -145,6 +166,7 @@ struct AttachmentInfo {
 
 struct ExplicitSyncOp {
 	le_resource_handle resource;                  // image used as texture, or buffer resource used in this pass
+	uint32_t           resource_index;            // dense per-frame index of resource - index into per-frame resource tables, such as the sync chain table
 	uint32_t           sync_chain_offset_initial; // offset when entering this pass
 	uint32_t           sync_chain_offset_final;   // offset when this pass has completed
 	uint32_t           active;
@@ -156,6 +178,7 @@ struct BackendQueueInfo {
 	VkSemaphore  semaphore;            // owning, Per-queue timeline semaphore
 	uint64_t     semaphore_wait_value; // Highest value which this semaphore is going to signal - others may wait on this, defaults to 0
 	uint32_t     queue_family_index;   // queue family index for this queue - all queues with the same family index have the same capabilities, multiple queues may share the same family index (when they belong to the same family)
+	uint32_t     timestamp_valid_bits; // number of valid bits for timestamp queries on this queue - 0 means that this queue does not support timestamps
 	uint64_t     semaphore_get_next_signal_value() {
 		    return ++semaphore_wait_value;
 	};
@@ -170,6 +193,8 @@ struct BackendRenderPass {
 
 	le::QueueFlagBits   type;
 	le::RootPassesField root_passes_affinity; // key used to assign pass to queue submission
+	bool                is_async_compute;     // whether pass may be submitted to an async compute queue
+	bool                waits_for_async;      // whether pass must wait for async compute passes of its subgraph
 
 	VkFramebuffer           framebuffer;
 	VkRenderPass            renderPass;
@@ -178,10 +203,10 @@ struct BackendRenderPass {
 	le::SampleCountFlagBits sampleCount;    // We store this with renderpass, as sampleCount must be same for all color/depth attachments
 	uint64_t                renderpassHash; ///< spooky hash of elements that could influence renderpass compatibility
 
-	std::vector<le_resource_handle> resources; // resources used with this renderpass
+	std::pmr::vector<le_resource_handle> resources; // resources used with this renderpass - allocated from frame arena
 
 	struct le_command_buffer_encoder_o* encoder;
 
-	char                        debugName[ 256 ] = ""; // Debug name for renderpass
-	std::vector<ExplicitSyncOp> explicit_sync_ops;     // explicit sync operations for renderpass, these execute before renderpass begins.
+	char                             debugName[ 256 ] = ""; // Debug name for renderpass
+	std::pmr::vector<ExplicitSyncOp> explicit_sync_ops;     // explicit sync operations for renderpass, these execute before renderpass begins - allocated from frame arena
 };
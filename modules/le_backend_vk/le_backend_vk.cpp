@@ -7,6 +7,7 @@
 #include "le_window.h"
 #include "le_renderer.h"
 #include "private/le_renderer/le_resource_handle_t.inl"
+#include "private/le_renderer/le_linear_arena.h"
 #include "3rdparty/src/spooky/SpookyV2.h" // for hashing renderpass gestalt
 
 #include <bitset>
@@ -16,6 +17,7 @@
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <forward_list>
 #include <sstream>
 #include <iomanip>
@@ -27,6 +29,7 @@
 #include <cstring> // for memcpy
 #include <array>
 #include <algorithm> // for std::find, for std::max
+#include <limits>
 
 #include "util/volk/volk.h"
 
@@ -178,7 +181,8 @@ struct ResourceCreateInfo {
 	// We use this operator to see whether we can re-use an existing resource
 	// based on the currently allocated version of a resource.
 	//
-	// Note that we are only fuzzy where it is safe to be so - which is flags.
+	// Note that we are only fuzzy where it is safe to be so - which is flags, and
+	// sharing mode: a resource which is shared concurrently may be used exclusively.
 	bool operator>=( const ResourceCreateInfo& rhs ) const {
 
 		if ( type != rhs.type ) {
@@ -190,9 +194,9 @@ struct ResourceCreateInfo {
 			return ( bufferInfo.flags == rhs.bufferInfo.flags &&
 			         bufferInfo.size == rhs.bufferInfo.size &&
 			         ( ( bufferInfo.usage & rhs.bufferInfo.usage ) == rhs.bufferInfo.usage ) &&
-			         bufferInfo.sharingMode == rhs.bufferInfo.sharingMode
+			         ( bufferInfo.sharingMode == rhs.bufferInfo.sharingMode || bufferInfo.sharingMode == VK_SHARING_MODE_CONCURRENT )
 			         // bufferInfo.queueFamilyIndexCount == rhs.bufferInfo.queueFamilyIndexCount &&
-			         // bufferInfo.pQueueFamilyIndices == rhs.bufferInfo.pQueueFamilyIndices // ignored, as we assume sharingMode to be EXCLUSIVE
+			         // bufferInfo.pQueueFamilyIndices == rhs.bufferInfo.pQueueFamilyIndices // ignored, as concurrent resources are always shared between the same queue families
 			);
 
 		} else if ( isImage() ) {
@@ -216,10 +220,10 @@ struct ResourceCreateInfo {
 			         imageInfo.samples == rhs.imageInfo.samples &&
 			         imageInfo.tiling == rhs.imageInfo.tiling &&
 			         ( ( imageInfo.usage & rhs.imageInfo.usage ) == rhs.imageInfo.usage ) &&
-			         imageInfo.sharingMode == rhs.imageInfo.sharingMode &&
+			         ( imageInfo.sharingMode == rhs.imageInfo.sharingMode || imageInfo.sharingMode == VK_SHARING_MODE_CONCURRENT ) &&
 			         imageInfo.initialLayout == rhs.imageInfo.initialLayout
 			         // imageInfo.queueFamilyIndexCount == rhs.imageInfo.queueFamilyIndexCount &&
-			         //( void* )imageInfo.pQueueFamilyIndices == ( void* )rhs.imageInfo.pQueueFamilyIndices // ignored, as we assume sharingMode to be EXCLUSIVE
+			         //( void* )imageInfo.pQueueFamilyIndices == ( void* )rhs.imageInfo.pQueueFamilyIndices // ignored, as concurrent resources are always shared between the same queue families
 			);
 		} else if ( isBlas() ) {
 			// NOTE: we don't compare scratch_buffer_sz, as scratch buffer sz is only available
@@ -255,6 +259,25 @@ struct ResourceCreateInfo {
 		return type == LeResourceType::eRtxTlas;
 	}
 
+	// Shares buffer or image concurrently between queue families - the array of
+	// queue family indices must outlive this create info.
+	void set_sharing_mode_concurrent( uint32_t const* queue_family_indices, uint32_t queue_family_index_count ) {
+		if ( isBuffer() ) {
+			bufferInfo.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+			bufferInfo.queueFamilyIndexCount = queue_family_index_count;
+			bufferInfo.pQueueFamilyIndices   = queue_family_indices;
+		} else if ( isImage() ) {
+			imageInfo.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+			imageInfo.queueFamilyIndexCount = queue_family_index_count;
+			imageInfo.pQueueFamilyIndices   = queue_family_indices;
+		}
+	}
+
+	bool isSharedConcurrently() const {
+		return ( isBuffer() && bufferInfo.sharingMode == VK_SHARING_MODE_CONCURRENT ) ||
+		       ( isImage() && imageInfo.sharingMode == VK_SHARING_MODE_CONCURRENT );
+	}
+
 	static ResourceCreateInfo from_le_resource_info( const le_resource_info_t& info );
 };
 
@@ -403,10 +426,17 @@ struct ResourceState {
 	VkImageLayout layout;                 // Current layout (for images)
 	uint32_t      renderpass_index;       // which renderpass currently uses this resource  -1 being outside of scope (e.g. swapchain)
 
+	// Buffers only: most recent write access, and its stage. Reads after a write accumulate in
+	// stage and visible_access - any read which these don't cover yet must wait for this write.
+	VkPipelineStageFlags2 last_write_stage;
+	VkAccessFlags2        last_write_access;
+
 	bool operator==( const ResourceState& rhs ) const {
 		return visible_access == rhs.visible_access &&
 		       stage == rhs.stage &&
-		       layout == rhs.layout;
+		       layout == rhs.layout &&
+		       last_write_stage == rhs.last_write_stage &&
+		       last_write_access == rhs.last_write_access;
 	}
 
 	bool operator!=( const ResourceState& rhs ) const {
@@ -415,6 +445,16 @@ struct ResourceState {
 };
 
 // ------------------------------------------------------------
+// Device memory which is shared by transient images.
+//
+// Images flagged as transient may be bound to the same block of memory
+// as long as their lifetimes within a frame don't overlap.
+struct TransientMemoryBlock {
+	VmaAllocation        allocation;         // owning
+	VmaAllocationInfo    allocationInfo;     //
+	VkMemoryRequirements memoryRequirements; // requirements with which this block was allocated
+	uint32_t             num_images;         // number of images bound to this block - once this drops to zero, the block may be freed
+};
 
 struct AllocatedResourceVk {
 	VmaAllocation     allocation;
@@ -425,20 +465,138 @@ struct AllocatedResourceVk {
 		VkAccelerationStructureKHR blas; // bottom level acceleration structure
 		VkAccelerationStructureKHR tlas; // top level acceleration structure
 	} as;
-	ResourceCreateInfo info;  // Creation info for resource
-	ResourceState      state; // sync state for resource
-	uint32_t           padding__;
+	ResourceCreateInfo    info;        // Creation info for resource
+	ResourceState         state;       // sync state for resource
+	uint32_t              padding__;   //
+	TransientMemoryBlock* alias_block; // non-owning, nullptr unless resource is a transient image: memory is owned by this block, and `allocation` must not be freed.
+};
+
+// Staging memory is sub-allocated from one persistent, persistently mapped ring buffer,
+// which the staging allocators of all frames share. Sub-allocations are lock-free atomic
+// bumps of `head`. Memory gets released in bulk, by advancing `tail`, once the frame which
+// allocated it has crossed its fence - see staging_allocator_map, staging_allocator_reset.
+struct le_staging_ring_o {
+	VmaAllocator          allocator;   // non-owning, refers to backend allocator object
+	VkBuffer              buffer;      // owning
+	VmaAllocation         allocation;  // owning
+	char*                 mapped_data; // persistently mapped memory of buffer
+	uint64_t              capacity;    // number of bytes in buffer
+	std::atomic<uint64_t> head = 0;    // monotonic: end of most recent sub-allocation, in bytes since creation - position in buffer is head % capacity
+	std::atomic<uint64_t> tail = 0;    // monotonic: all bytes before tail have been released
 };
 
 struct le_staging_allocator_o {
-	VmaAllocator                   allocator;      // non-owning, refers to backend allocator object
-	VkDevice                       device;         // non-owning, refers to vulkan device object
-	std::mutex                     mtx;            // protects all staging* elements
-	std::vector<VkBuffer>          buffers;        // 0..n staging buffers used with the current frame (freed on frame clear)
-	std::vector<VmaAllocation>     allocations;    // SOA: counterpart to buffers[]
-	std::vector<VmaAllocationInfo> allocationInfo; // SOA: counterpart to buffers[]
+	VmaAllocator               allocator;                   // non-owning, refers to backend allocator object
+	VkDevice                   device;                      // non-owning, refers to vulkan device object
+	le_staging_ring_o*         ring              = nullptr; // non-owning, shared between frames - nullptr means that all allocations use dedicated buffers
+	std::atomic<uint64_t>      ring_release_mark = 0;       // end of most recent ring sub-allocation via this allocator - ring memory up to here gets released on reset
+	std::mutex                 mtx;                         // protects all staging* elements
+	std::vector<VkBuffer>      buffers;                     // 0..n staging buffers used with the current frame: either the ring buffer, or a dedicated buffer
+	std::vector<uint64_t>      offsets;                     // SOA: counterpart to buffers[], offset into buffer at which staging memory starts
+	std::vector<VmaAllocation> allocations;                 // SOA: counterpart to buffers[], nullptr for ring sub-allocations - dedicated buffers get freed on frame clear
+	std::vector<void*>         mappedData;                  // SOA: counterpart to buffers[], address of mapped memory
+	std::vector<uint64_t>      mappedSize;                  // SOA: counterpart to buffers[], number of bytes requested via map()
 };
 
+// vkCmdCopyBufferToImage requires buffer offsets to be multiples of the texel block size of the
+// target image, which we don't know when we allocate - 96 is a multiple of all texel block sizes
+// (1, 2, 3, 4, 6, 8, 12, 16, 24, and 32 bytes).
+constexpr uint64_t LE_STAGING_RING_ALIGNMENT = 96;
+
+// ----------------------------------------------------------------------
+
+static le_staging_ring_o* staging_ring_create( VmaAllocator const allocator, uint64_t capacity ) {
+
+	VkBufferCreateInfo bufferCreateInfo{
+	    .sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+	    .pNext                 = nullptr, // optional
+	    .flags                 = 0,       // optional
+	    .size                  = capacity,
+	    .usage                 = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+	    .sharingMode           = VK_SHARING_MODE_EXCLUSIVE,
+	    .queueFamilyIndexCount = 0, // optional
+	    .pQueueFamilyIndices   = 0,
+	};
+
+	VmaAllocationCreateInfo allocationCreateInfo{};
+	allocationCreateInfo.flags          = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+	allocationCreateInfo.usage          = VMA_MEMORY_USAGE_CPU_ONLY;
+	allocationCreateInfo.preferredFlags = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+	auto              self = new le_staging_ring_o{};
+	VmaAllocationInfo allocationInfo{};
+
+	auto result = vmaCreateBuffer( allocator, &bufferCreateInfo, &allocationCreateInfo, &self->buffer, &self->allocation, &allocationInfo );
+
+	if ( result != VK_SUCCESS ) {
+		static auto logger = LeLog( LOGGER_LABEL );
+		logger.error( "Could not create staging ring of %lu bytes - staging allocations will use dedicated buffers.", capacity );
+		delete self;
+		return nullptr;
+	}
+
+	self->allocator   = allocator;
+	self->mapped_data = static_cast<char*>( allocationInfo.pMappedData );
+	self->capacity    = capacity;
+
+	return self;
+}
+
+// ----------------------------------------------------------------------
+
+static void staging_ring_destroy( le_staging_ring_o* self ) {
+	vmaDestroyBuffer( self->allocator, self->buffer, self->allocation );
+	delete self;
+}
+
+// ----------------------------------------------------------------------
+// Sub-allocates `num_bytes` from the ring, without locking. Allocations never straddle the
+// end of the buffer - if an allocation does not fit, it starts at the beginning of the buffer.
+//
+// Returns false if there is not enough free memory in the ring.
+// On success, `offset` receives the offset into the ring buffer, and `ring_end` receives
+// the value which must be passed to staging_ring_release, to release this allocation.
+static bool staging_ring_allocate( le_staging_ring_o* self, uint64_t num_bytes, uint64_t* offset, uint64_t* ring_end ) {
+
+	if ( num_bytes > self->capacity ) {
+		return false;
+	}
+
+	uint64_t head = self->head.load( std::memory_order_relaxed );
+
+	for ( ;; ) {
+		uint64_t const position = head % self->capacity;
+		uint64_t       begin    = ( ( position + LE_STAGING_RING_ALIGNMENT - 1 ) / LE_STAGING_RING_ALIGNMENT ) * LE_STAGING_RING_ALIGNMENT;
+
+		if ( begin + num_bytes > self->capacity ) {
+			begin = self->capacity; // wrap around: allocation starts at the beginning of the next lap
+		}
+
+		uint64_t const end = head - position + begin + num_bytes;
+
+		if ( end - self->tail.load( std::memory_order_acquire ) > self->capacity ) {
+			return false; // ring is full
+		}
+
+		if ( self->head.compare_exchange_weak( head, end, std::memory_order_relaxed ) ) {
+			*offset   = begin % self->capacity;
+			*ring_end = end;
+			return true;
+		}
+
+		// Another thread allocated in the meantime - `head` now holds its updated value, try again.
+	}
+}
+
+// ----------------------------------------------------------------------
+// Releases all ring memory up to `ring_end`. Frames release their allocations in the same
+// order in which they allocated them, so that everything before `ring_end` is free.
+static void staging_ring_release( le_staging_ring_o* self, uint64_t ring_end ) {
+	uint64_t tail = self->tail.load( std::memory_order_relaxed );
+	while ( tail < ring_end && !self->tail.compare_exchange_weak( tail, ring_end, std::memory_order_release, std::memory_order_relaxed ) ) {
+	}
+}
+
 // ------------------------------------------------------------
 
 struct SemaphoreContainer {
@@ -514,6 +672,24 @@ struct swapchain_state_t {
 	swapchain_data_t                    swapchain_data;
 };
 
+// Descriptor types for which we reserve space in descriptor pools.
+static constexpr VkDescriptorType DESCRIPTOR_POOL_TYPES[] = {
+    VK_DESCRIPTOR_TYPE_SAMPLER,
+    VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+    VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,
+    VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER,
+    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
+    VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT,
+    VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
+};
+
+static constexpr size_t DESCRIPTOR_POOL_TYPE_COUNT = sizeof( DESCRIPTOR_POOL_TYPES ) / sizeof( VkDescriptorType );
+
 // Herein goes all data which is associated with the current frame.
 // Backend keeps track of multiple frames, exactly one per renderer::FrameData frame.
 //
@@ -533,12 +709,16 @@ struct BackendFrameData {
 	};
 
 	struct PerQueueSubmissionData {
-		uint32_t              queue_idx;               // backend device queue index
-		VkQueueFlags          queue_flags;             // queue flags for this submission
-		std::vector<uint32_t> pass_indices;            // which passes from the current frame to add to this submission, count tells us about number of command buffers that need to be alloated
-		CommandPool*          command_pool;            // non-owning. which command pool from the list of available command pools
-		std::string           debug_root_passes_names; // name of root passes
-	};                                                 //
+		uint32_t                   queue_idx;               // backend device queue index
+		VkQueueFlags               queue_flags;             // queue flags for this submission
+		std::pmr::vector<uint32_t> pass_indices;            // which passes from the current frame to add to this submission, count tells us about number of command buffers that need to be alloated - allocated from frame arena
+		CommandPool*               command_pool;            // non-owning. which command pool from the list of available command pools
+		std::pmr::string           debug_root_passes_names; // name of root passes - allocated from frame arena
+		bool                       is_async_compute;        // whether this submission holds async compute passes of a subgraph
+		uint32_t                   main_submission_idx;     // for async compute submissions, and their continuations: index of submission holding the first non-async passes of the same subgraph, ~0 if none
+		uint32_t                   wait_submission_idx;     // index of async compute submission which this submission must wait for, ~0 if none
+		uint64_t                   signal_value;            // timeline semaphore value which gets signalled once this submission completes, set on dispatch
+	};                                                      //
 	std::vector<PerQueueSubmissionData> queue_submission_data;
 	std::vector<CommandPool*>           available_command_pools; // Owning. reset on frame recycle, delete all objects on BackendFrameData::destroy
 
@@ -549,24 +729,36 @@ struct BackendFrameData {
 		VkImageView imageView;
 	};
 
-	using texture_map_t = std::unordered_map<le_texture_handle, Texture>;
+	using texture_map_t = std::pmr::unordered_map<le_texture_handle, Texture>; // allocated from frame arena
+
+	// Each resource which this frame uses receives a dense, per-frame index, once the frame's resources
+	// have been allocated - see frame_assign_resource_indices. Per-resource tables which we walk while
+	// tracking resource state, and while generating barriers, are flat arrays indexed by this index.
+	// AttachmentInfo and ExplicitSyncOp store the index of their resource, so that we don't need to
+	// look up resources by handle once indices have been assigned.
+	//
+	// Tables keep their capacity across frames, so that we don't re-allocate for every frame.
+
+	struct ResourceIndexSlot {
+		le_resource_handle handle; // nullptr means: slot is empty
+		uint32_t           index;  // dense index for handle
+	};
+
+	std::vector<ResourceIndexSlot>          resourceIndexSlots;  // resource handle -> dense index, for all resources in availableResources - open addressing hash table, see frame_assign_resource_indices
+	std::vector<le_resource_handle>         resourceHandles;     // per dense index: resource handle
+	std::vector<AllocatedResourceVk const*> resourceAllocations; // per dense index: non-owning, entry in availableResources
 
-	std::unordered_map<le_img_resource_handle, VkImageView> imageViews; // non-owning, references to frame-local textures, cleared on frame fence.
+	std::vector<VkImageView> imageViews; // per dense index: non-owning default image view, or nullptr - references to frame-local textures, cleared on frame fence.
 
 	// With `syncChainTable` and image_attachment_info_o.syncState, we should
 	// be able to create renderpasses. Each resource has a sync chain, and each attachment_info
 	// has a struct which holds indices into the sync chain telling us where to look
 	// up the sync state for a resource at different stages of renderpass construction.
-	using sync_chain_table_t = std::unordered_map<le_resource_handle, std::vector<ResourceState>>;
+	using sync_chain_table_t = std::vector<std::vector<ResourceState>>; // per dense index: sync chain
 	sync_chain_table_t syncChainTable;
 
 	static_assert( sizeof( VkBuffer ) == sizeof( VkImageView ) && sizeof( VkBuffer ) == sizeof( VkImage ), "size of AbstractPhysicalResource components must be identical" );
 
-	// Map from renderer resource id to physical resources - only contains resources this frame uses.
-	// Q: Does this table actually own the resources?
-	// A: It must not: as it is used to map external resources as well.
-	std::unordered_map<le_resource_handle, AbstractPhysicalResource> physicalResources;
-
 	/// \brief vk resources retained and destroyed with BackendFrameData.
 	/// These resources (such as samplers, imageviews, framebuffers) are transient,
 	/// and lifetime of these resources is tied to the frame fence.
@@ -575,7 +767,7 @@ struct BackendFrameData {
 	/// \brief if user provides explicit resource info, we collect this here, so that we can make sure
 	/// that any inferred resourceInfo is compatible with what the user selected.
 	/// there is no guarantee that declared resources are unique, which means we must consolidate.
-	std::unordered_map<le_resource_handle, le_resource_info_t> declared_resources; // | pre-declared resources (explicitly declared via rendergraph)
+	std::pmr::unordered_map<le_resource_handle, le_resource_info_t> declared_resources; // | pre-declared resources (explicitly declared via rendergraph) - allocated from frame arena
 
 	std::vector<BackendRenderPass>   passes;
 	std::vector<le::RootPassesField> queue_submission_keys; // One key per isolated queue invocation,
@@ -583,16 +775,47 @@ struct BackendFrameData {
 	                                                        // with each bit representing a contributing root node index.
 	                                                        // Passes internally store to which root node they contribute,
 	                                                        // which allows us to associate passes with each entry in this vector.
-	std::vector<std::string> debug_root_passes_names;       // names for root passis in RootPassesField
+	std::vector<char const*> debug_root_passes_names;       // non-owning: names for root passes in RootPassesField, owned by rendergraph passes, which outlive the frame
 
 	std::vector<texture_map_t> textures_per_pass; // non-owning, references to frame-local textures, cleared on frame fence.
 
-	std::vector<VkDescriptorPool> descriptorPools; // one descriptor pool per pass
+	struct DescriptorSetCacheEntry {
+		VkDescriptorSet             set;             // non-owning: allocated from descriptorPools
+		VkDescriptorSetLayout       layout;          //
+		std::vector<DescriptorData> set_data;        // descriptors which were written to set
+		uint64_t                    last_used_frame; // frame number of the most recent frame which used this descriptor set
+	};
+
+	// Descriptor sets are cached with the frame, and only get written once - they stay valid until
+	// descriptorPools get reset. Pools get sized based on the number of descriptors which previous
+	// frames actually used. See backend_create_descriptor_pools.
+	//
+	// Only accessed from the dispatch frame.
+
+	std::vector<VkDescriptorPool>                         descriptorPools;                   // owning: usually one; more if the first pool ran out of space during a frame
+	std::unordered_map<uint64_t, DescriptorSetCacheEntry> descriptorSetCache;                // indexed by hash over set layout and descriptor data
+	uint64_t                                              descriptorSetCacheGeneration = 0;  // backend descriptor resource generation for which descriptorSetCache is valid
+	uint32_t                                              descriptorPoolMaxSets        = 0;  // number of sets which fit into descriptorPools[0]
+	std::array<uint32_t, DESCRIPTOR_POOL_TYPE_COUNT>      descriptorPoolCapacity       = {}; // number of descriptors per type which fit into descriptorPools[0]
+	uint32_t                                              descriptorSetDemand          = 0;  // number of descriptor sets used by the current frame
+	std::array<uint32_t, DESCRIPTOR_POOL_TYPE_COUNT>      descriptorDemand             = {}; // number of descriptors per type used by the current frame
+
+	// Bindless mode only: each frame has its own bindless descriptor set, so that we never write to
+	// a set which a frame in flight may be using. Slots get written when their contents change - see
+	// frame_update_bindless_descriptors. A slot stays written for as long as its vk objects are alive.
 
-	typedef std::unordered_map<le_resource_handle, AllocatedResourceVk> ResourceMap_T;
+	VkDescriptorPool      bindlessDescriptorPool      = nullptr; // owning: update-after-bind pool from which bindlessDescriptorSet is allocated
+	VkDescriptorSet       bindlessDescriptorSet       = nullptr; // non-owning: allocated from bindlessDescriptorPool, nullptr unless bindless mode is enabled
+	VkDescriptorSetLayout bindlessDescriptorSetLayout = nullptr; // non-owning: owned by pipeline manager
+	std::vector<Texture>  bindlessTextures;                      // per bindless texture slot: descriptor which was last written to bindlessDescriptorSet
+	std::vector<VkBuffer> bindlessBuffers;                       // per bindless buffer slot: buffer which was last written to bindlessDescriptorSet
+	uint64_t              bindlessGeneration = 0;                // backend descriptor resource generation for which bindless slots are valid
 
-	ResourceMap_T availableResources; // resources this frame may use - each entry represents an association between a le_resource_handle and a vk resource
-	ResourceMap_T binnedResources;    // resources to delete when this frame comes round to clear()
+	typedef std::unordered_map<le_resource_handle, AllocatedResourceVk>      ResourceMap_T;
+	typedef std::pmr::unordered_map<le_resource_handle, AllocatedResourceVk> FrameResourceMap_T; // allocated from frame arena
+
+	FrameResourceMap_T availableResources; // resources this frame may use - each entry represents an association between a le_resource_handle and a vk resource
+	ResourceMap_T      binnedResources;    // resources to delete when this frame comes round to clear()
 
 	/*
 
@@ -602,19 +825,87 @@ struct BackendFrameData {
 	  independent block of memory allcated from the frame pool. This way, encoders can work on their
 	  own thread.
 
+	  Once a sub-allocator has exhausted its block, it chains further blocks, each of which is held
+	  by its own transient buffer. These chained buffers live until the frame gets cleared.
+
 	 */
 	VmaPool allocationPool; // pool from which allocations for this frame come from
 
+	// Provides chained blocks to the transient allocators of a frame, see frame_transient_allocator_grow
+	struct TransientBlockProvider {
+		le_backend_o*     backend;
+		BackendFrameData* frame;
+		std::mutex        mtx; // protects transient buffer vectors of frame while allocators may grow, i.e. while encoders record
+	};
+
 	std::vector<le_allocator_o*>   allocators;       // owning; typically one per `le_worker_thread`.
-	std::vector<VkBuffer>          allocatorBuffers; // per allocator: one vkBuffer
-	std::vector<VmaAllocation>     allocations;      // per allocator: one allocation
-	std::vector<VmaAllocationInfo> allocationInfos;  // per allocator: one allocationInfo
+	std::vector<VkBuffer>          allocatorBuffers; // per transient buffer: one vkBuffer - first allocators.size() buffers hold first blocks of allocators, any further buffers hold chained blocks
+	std::vector<VmaAllocation>     allocations;      // per transient buffer: one allocation
+	std::vector<VmaAllocationInfo> allocationInfos;  // per transient buffer: one allocationInfo
+
+	TransientBlockProvider* transientBlockProvider = nullptr; // owning
 
 	le_staging_allocator_o* stagingAllocator; // owning: allocator for large objects to GPU memory
 
+	LinearArena* frameArena = nullptr; // owning: for temporary allocations while processing the frame, reset when frame gets cleared
+
+	struct GpuTimestampQuery {
+		uint32_t pass_index;  // index into passes, two queries per pass: [2*pass_index, 2*pass_index+1]
+		uint32_t queue_index; // backend queue onto which the pass was submitted
+	};
+
+	VkQueryPool                               timestampQueryPool         = nullptr; // owning: two timestamp queries per pass, created on demand
+	uint32_t                                  timestampQueryPoolCapacity = 0;       // number of queries in timestampQueryPool
+	std::vector<GpuTimestampQuery>            timestampQueries;                     // passes for which timestamps were written this frame, cleared when frame gets cleared
+	std::vector<le_backend_pass_gpu_timing_t> gpuPassTimings;                       // scratch: gets swapped with backend gpu_pass_timings, so that we re-use its capacity
+
 	bool must_create_queues_dot_graph = false;
 };
 
+// Render passes, framebuffers, image views and samplers are cached across frames, so that
+// we don't need to create (and destroy) them for every pass of every frame. Objects which
+// have not been used for a number of frames get evicted, as do framebuffers and image views
+// which refer to images which are about to be destroyed. See backend_create_renderpasses,
+// backend_create_frame_buffers, frame_allocate_transient_resources.
+struct RenderObjectCache {
+
+	struct RenderPassEntry {
+		VkRenderPass render_pass;     // owning
+		uint64_t     last_used_frame; // frame number of the most recent frame which used this render pass
+	};
+
+	struct FramebufferEntry {
+		VkFramebuffer            framebuffer;     // owning
+		VkRenderPass             render_pass;     // non-owning: render pass this framebuffer was created for
+		std::vector<VkImage>     images;          // non-owning: one per attachment, images which image_views refer to
+		std::vector<VkImageView> image_views;     // owning: one per attachment
+		uint64_t                 last_used_frame; // frame number of the most recent frame which used this framebuffer
+	};
+
+	struct ImageViewEntry {
+		VkImageView image_view;      // owning
+		VkImage     image;           // non-owning: image which image_view refers to
+		uint64_t    last_used_frame; // frame number of the most recent frame which used this image view
+	};
+
+	struct SamplerEntry {
+		VkSampler sampler;         // owning
+		uint64_t  last_used_frame; // frame number of the most recent frame which used this sampler
+	};
+
+	struct RetiredObject {
+		AbstractPhysicalResource object;
+		uint64_t                 retired_at_frame; // object may be destroyed once no frame which may have used it is in flight anymore
+	};
+
+	std::mutex                                     mtx;             // protects all members
+	std::unordered_map<uint64_t, RenderPassEntry>  render_passes;   // indexed by hash over render pass create info
+	std::unordered_map<uint64_t, FramebufferEntry> framebuffers;    // indexed by hash over render pass, extent, and attachment images
+	std::unordered_map<uint64_t, ImageViewEntry>   image_views;     // indexed by hash over image view create info (which includes the image)
+	std::unordered_map<uint64_t, SamplerEntry>     samplers;        // indexed by hash over sampler create info
+	std::vector<RetiredObject>                     retired_objects; // evicted objects which may still be used by frames in flight
+};
+
 /// \brief backend data object
 struct le_backend_o {
 
@@ -644,15 +935,43 @@ struct le_backend_o {
 
 	le_pipeline_manager_o* pipelineCache = nullptr;
 
+	RenderObjectCache render_object_cache; // render passes, framebuffers, image views, and samplers, cached across frames
+
+	std::atomic<uint64_t> descriptor_resource_generation = 0; // incremented whenever a vk object which descriptors may refer to gets destroyed - invalidates cached descriptor sets
+
+	struct BindlessIndices {
+		std::mutex                                       mtx;             // protects all members - indices may be requested from any thread
+		std::unordered_map<le_texture_handle, uint32_t>  texture_indices; // slot index per texture - slots are assigned in order, and never re-assigned
+		std::unordered_map<le_resource_handle, uint32_t> buffer_indices;  // slot index per buffer - slots are assigned in order, and never re-assigned
+	} bindless;
+
+	VkDescriptorSetLayout bindless_set_layout = nullptr; // non-owning: owned by pipeline manager, nullptr unless bindless mode is enabled
+
 	VmaAllocator mAllocator = nullptr;
 
-	uint32_t queueFamilyIndexGraphics = 0; // inferred during setup
+	le_staging_ring_o* staging_ring = nullptr; // owning: staging memory, shared by the staging allocators of all frames
+
+	uint32_t queueFamilyIndexGraphics = uint32_t( ~0 ); // inferred during setup
+
+	bool     must_share_async_compute_resources_concurrently = false; // whether async compute queue is of a different family than the default graphics queue
+	uint32_t async_compute_sharing_queue_family_indices[ 2 ]  = {};    // { graphics, async compute } queue family: resources which async compute passes use are shared concurrently between these
 
 	KillList<le_rtx_blas_info_o> rtx_blas_info_kill_list; // used to keep track rtx_blas_infos.
 	KillList<le_rtx_tlas_info_o> rtx_tlas_info_kill_list; // used to keep track rtx_blas_infos.
 
 	std::unordered_map<le_resource_handle, uint64_t> resource_queue_family_ownership[ 2 ]; // per-resource queue family ownership - we use this to detect queue family ownership change for resources
 
+	std::vector<TransientMemoryBlock*> transient_memory_blocks; // owning, memory blocks shared by transient images - see backend_allocate_resources
+
+	std::vector<le_backend_pass_gpu_timing_t> gpu_pass_timings;              // protected by gpu_pass_timings_mutex. gpu timings for passes of the most recently cleared frame
+	uint64_t                                  gpu_pass_timings_frame_number = 0; // protected by gpu_pass_timings_mutex. frame number to which gpu_pass_timings belong
+	std::mutex                                gpu_pass_timings_mutex;        // timings are written when a frame gets cleared, which may happen on a different thread
+
+	uint32_t                    transient_memory_type_index    = 0;                        // memory type for transient buffers, i.e. blocks for transient allocators
+	uint64_t                    transient_allocator_block_size = LE_LINEAR_ALLOCATOR_SIZE; // protected by transient_allocators_mutex. size for first blocks of transient allocators, grows with high-water mark of per-allocator usage
+	le_allocator_linear_stats_t transient_allocators_stats     = {};                       // protected by transient_allocators_mutex. usage of transient allocators, summed over all allocators of the most recently cleared frame
+	std::mutex                  transient_allocators_mutex;                                // transient allocator stats are written when a frame gets cleared, which may happen on a different thread
+
   private:
 	// Vulkan resources which are available to all frames.
 	// Generally, a resource needs to stay alive until the last frame that uses it has crossed its fence.
@@ -755,6 +1074,275 @@ static VkBufferUsageFlags defaults_get_buffer_usage_scratch() {
 
 // ----------------------------------------------------------------------
 
+static void render_object_cache_destroy_object( le_backend_o* self, VkDevice device, AbstractPhysicalResource const& r ) {
+	switch ( r.type ) {
+	case AbstractPhysicalResource::eFramebuffer:
+		vkDestroyFramebuffer( device, r.asFramebuffer, nullptr );
+		break;
+	case AbstractPhysicalResource::eImageView:
+		vkDestroyImageView( device, r.asImageView, nullptr );
+		self->descriptor_resource_generation++;
+		break;
+	case AbstractPhysicalResource::eSampler:
+		vkDestroySampler( device, r.asSampler, nullptr );
+		self->descriptor_resource_generation++;
+		break;
+	case AbstractPhysicalResource::eRenderPass:
+		if ( self->pipelineCache ) {
+			// Pipelines which are compiled in the background may still reference this renderpass.
+			le_backend_vk::le_pipeline_manager_i.release_render_pass( self->pipelineCache, r.asRenderPass );
+		}
+		vkDestroyRenderPass( device, r.asRenderPass, nullptr );
+		break;
+	default:
+		assert( false && "render object cache only holds framebuffers, image views, samplers, and render passes" );
+		break;
+	}
+}
+
+// ----------------------------------------------------------------------
+// Moves a framebuffer, and its image views, to the list of retired objects.
+// Cache mutex must be held.
+static void render_object_cache_retire_framebuffer( RenderObjectCache& cache, RenderObjectCache::FramebufferEntry const& entry, uint64_t frame_number ) {
+
+	AbstractPhysicalResource fb;
+	fb.type          = AbstractPhysicalResource::eFramebuffer;
+	fb.asFramebuffer = entry.framebuffer;
+	cache.retired_objects.push_back( { fb, frame_number } );
+
+	for ( auto const& image_view : entry.image_views ) {
+		AbstractPhysicalResource iv;
+		iv.type        = AbstractPhysicalResource::eImageView;
+		iv.asImageView = image_view;
+		cache.retired_objects.push_back( { iv, frame_number } );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Cache mutex must be held.
+static void render_object_cache_retire_image_view( RenderObjectCache& cache, RenderObjectCache::ImageViewEntry const& entry, uint64_t frame_number ) {
+	AbstractPhysicalResource iv;
+	iv.type        = AbstractPhysicalResource::eImageView;
+	iv.asImageView = entry.image_view;
+	cache.retired_objects.push_back( { iv, frame_number } );
+}
+
+// ----------------------------------------------------------------------
+// Cache mutex must be held.
+static void render_object_cache_retire_sampler( RenderObjectCache& cache, RenderObjectCache::SamplerEntry const& entry, uint64_t frame_number ) {
+	AbstractPhysicalResource s;
+	s.type      = AbstractPhysicalResource::eSampler;
+	s.asSampler = entry.sampler;
+	cache.retired_objects.push_back( { s, frame_number } );
+}
+
+// ----------------------------------------------------------------------
+// Returns a cached image view matching `create_info`, creates and caches it if not yet cached.
+// Cache mutex must be held.
+static VkImageView render_object_cache_produce_image_view( RenderObjectCache& cache, VkDevice device, VkImageViewCreateInfo const& create_info, uint64_t frame_number ) {
+
+	// Fields from `image` up to and including `subresourceRange` are tightly packed, we can hash them in one go.
+	static_assert( offsetof( VkImageViewCreateInfo, subresourceRange ) + sizeof( VkImageSubresourceRange ) - offsetof( VkImageViewCreateInfo, image ) ==
+	                   sizeof( VkImage ) + sizeof( VkImageViewType ) + sizeof( VkFormat ) + sizeof( VkComponentMapping ) + sizeof( VkImageSubresourceRange ),
+	               "VkImageViewCreateInfo must not contain padding between image and subresourceRange" );
+
+	assert( create_info.pNext == nullptr && create_info.flags == 0 && "image view cache does not account for pNext, or flags" );
+
+	uint64_t key = SpookyHash::Hash64(
+	    &create_info.image,
+	    offsetof( VkImageViewCreateInfo, subresourceRange ) + sizeof( VkImageSubresourceRange ) - offsetof( VkImageViewCreateInfo, image ),
+	    0 );
+
+	auto [ entry, was_inserted ] = cache.image_views.try_emplace( key );
+
+	entry->second.last_used_frame = frame_number;
+
+	if ( was_inserted ) {
+		entry->second.image = create_info.image;
+		vkCreateImageView( device, &create_info, nullptr, &entry->second.image_view );
+	}
+
+	return entry->second.image_view;
+}
+
+// ----------------------------------------------------------------------
+// Returns a cached sampler matching `create_info`, creates and caches it if not yet cached.
+// Cache mutex must be held.
+static VkSampler render_object_cache_produce_sampler( RenderObjectCache& cache, VkDevice device, VkSamplerCreateInfo const& create_info, uint64_t frame_number ) {
+
+	// Fields from `magFilter` up to and including `unnormalizedCoordinates` are all 32 bit wide, we can hash them in one go.
+	static_assert( offsetof( VkSamplerCreateInfo, unnormalizedCoordinates ) + sizeof( VkBool32 ) - offsetof( VkSamplerCreateInfo, magFilter ) == 15 * sizeof( uint32_t ),
+	               "VkSamplerCreateInfo must not contain padding between magFilter and unnormalizedCoordinates" );
+
+	assert( create_info.pNext == nullptr && create_info.flags == 0 && "sampler cache does not account for pNext, or flags" );
+
+	uint64_t key = SpookyHash::Hash64(
+	    &create_info.magFilter,
+	    offsetof( VkSamplerCreateInfo, unnormalizedCoordinates ) + sizeof( VkBool32 ) - offsetof( VkSamplerCreateInfo, magFilter ),
+	    0 );
+
+	auto [ entry, was_inserted ] = cache.samplers.try_emplace( key );
+
+	entry->second.last_used_frame = frame_number;
+
+	if ( was_inserted ) {
+		vkCreateSampler( device, &create_info, nullptr, &entry->second.sampler );
+	}
+
+	return entry->second.sampler;
+}
+
+// ----------------------------------------------------------------------
+// Evicts any cached framebuffers and image views which refer to `image` - call this before
+// `image` gets destroyed, so that a new image which happens to re-use the same handle does
+// not match stale image views.
+static void backend_render_object_cache_evict_image( le_backend_o* self, VkImage image ) {
+
+	auto& cache = self->render_object_cache;
+	auto  lock  = std::unique_lock( cache.mtx );
+
+	for ( auto it = cache.framebuffers.begin(); it != cache.framebuffers.end(); ) {
+		if ( std::find( it->second.images.begin(), it->second.images.end(), image ) != it->second.images.end() ) {
+			render_object_cache_retire_framebuffer( cache, it->second, self->mFramesCount );
+			it = cache.framebuffers.erase( it );
+		} else {
+			++it;
+		}
+	}
+
+	for ( auto it = cache.image_views.begin(); it != cache.image_views.end(); ) {
+		if ( it->second.image == image ) {
+			render_object_cache_retire_image_view( cache, it->second, self->mFramesCount );
+			it = cache.image_views.erase( it );
+		} else {
+			++it;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+// Evicts any cached framebuffers which refer to images owned by `swapchain`:
+// call this before a swapchain gets released.
+static void backend_render_object_cache_evict_swapchain_images( le_backend_o* self, le_swapchain_o* swapchain ) {
+	using namespace le_swapchain_vk;
+	if ( nullptr == swapchain ) {
+		return;
+	}
+	size_t image_count = swapchain_i.get_image_count( swapchain );
+	for ( uint32_t i = 0; i != image_count; i++ ) {
+		backend_render_object_cache_evict_image( self, swapchain_i.get_image( swapchain, i ) );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Evicts cached objects which have not been used for a number of frames,
+// and destroys evicted objects once no frame which may have used them is in flight.
+//
+// `frame_number` is the number of the frame which is currently being processed - by the
+// time we process a frame, all frames but the previous (data_frames_count - 1) frames
+// have crossed their fence.
+static void backend_render_object_cache_collect_garbage( le_backend_o* self, VkDevice device, uint64_t frame_number ) {
+
+	// Number of frames during which a cached object must not have been used before it gets evicted.
+	LE_SETTING( uint32_t, LE_SETTING_RENDER_OBJECT_CACHE_MAX_UNUSED_FRAMES, 60 );
+
+	auto&    cache             = self->render_object_cache;
+	auto     lock              = std::unique_lock( cache.mtx );
+	uint64_t max_unused_frames = *LE_SETTING_RENDER_OBJECT_CACHE_MAX_UNUSED_FRAMES;
+	uint64_t frames_in_flight  = self->mFrames.size();
+	uint64_t completed_frames  = frame_number > frames_in_flight ? frame_number - frames_in_flight : 0; // frames with a lower number have crossed their fence
+
+	// -- evict framebuffers which have not been used for a while
+	for ( auto it = cache.framebuffers.begin(); it != cache.framebuffers.end(); ) {
+		if ( it->second.last_used_frame + max_unused_frames < frame_number ) {
+			render_object_cache_retire_framebuffer( cache, it->second, self->mFramesCount );
+			it = cache.framebuffers.erase( it );
+		} else {
+			++it;
+		}
+	}
+
+	// -- evict image views and samplers which have not been used for a while
+	for ( auto it = cache.image_views.begin(); it != cache.image_views.end(); ) {
+		if ( it->second.last_used_frame + max_unused_frames < frame_number ) {
+			render_object_cache_retire_image_view( cache, it->second, self->mFramesCount );
+			it = cache.image_views.erase( it );
+		} else {
+			++it;
+		}
+	}
+
+	for ( auto it = cache.samplers.begin(); it != cache.samplers.end(); ) {
+		if ( it->second.last_used_frame + max_unused_frames < frame_number ) {
+			render_object_cache_retire_sampler( cache, it->second, self->mFramesCount );
+			it = cache.samplers.erase( it );
+		} else {
+			++it;
+		}
+	}
+
+	// -- evict render passes which have not been used for a while - any framebuffers which were
+	// created for such a render pass have not been used for at least as long, and are gone by now.
+	for ( auto it = cache.render_passes.begin(); it != cache.render_passes.end(); ) {
+		if ( it->second.last_used_frame + max_unused_frames < frame_number ) {
+			AbstractPhysicalResource rp;
+			rp.type         = AbstractPhysicalResource::eRenderPass;
+			rp.asRenderPass = it->second.render_pass;
+			cache.retired_objects.push_back( { rp, self->mFramesCount } );
+			it = cache.render_passes.erase( it );
+		} else {
+			++it;
+		}
+	}
+
+	// -- destroy retired objects which cannot be in use anymore
+	auto it = std::remove_if( cache.retired_objects.begin(), cache.retired_objects.end(),
+	                          [ & ]( RenderObjectCache::RetiredObject const& r ) -> bool {
+		                          if ( r.retired_at_frame < completed_frames ) {
+			                          render_object_cache_destroy_object( self, device, r.object );
+			                          return true;
+		                          }
+		                          return false;
+	                          } );
+
+	cache.retired_objects.erase( it, cache.retired_objects.end() );
+}
+
+// ----------------------------------------------------------------------
+// Destroys all cached and retired objects - device must be idle.
+static void backend_render_object_cache_clear( le_backend_o* self, VkDevice device ) {
+
+	auto& cache = self->render_object_cache;
+	auto  lock  = std::unique_lock( cache.mtx );
+
+	for ( auto const& [ key, entry ] : cache.framebuffers ) {
+		render_object_cache_retire_framebuffer( cache, entry, 0 );
+	}
+	for ( auto const& [ key, entry ] : cache.image_views ) {
+		render_object_cache_retire_image_view( cache, entry, 0 );
+	}
+	for ( auto const& [ key, entry ] : cache.samplers ) {
+		render_object_cache_retire_sampler( cache, entry, 0 );
+	}
+	for ( auto const& [ key, entry ] : cache.render_passes ) {
+		AbstractPhysicalResource rp;
+		rp.type         = AbstractPhysicalResource::eRenderPass;
+		rp.asRenderPass = entry.render_pass;
+		cache.retired_objects.push_back( { rp, 0 } );
+	}
+	for ( auto const& r : cache.retired_objects ) {
+		render_object_cache_destroy_object( self, device, r.object );
+	}
+
+	cache.framebuffers.clear();
+	cache.image_views.clear();
+	cache.samplers.clear();
+	cache.render_passes.clear();
+	cache.retired_objects.clear();
+}
+
+// ----------------------------------------------------------------------
+
 static le_backend_o* backend_create() {
 	auto self = new le_backend_o;
 	return self;
@@ -785,6 +1373,9 @@ static void backend_destroy( le_backend_o* self ) {
 
 	vkDeviceWaitIdle( self->device.get()->getVkDevice() );
 
+	// -- destroy cached render passes, framebuffers, and their image views
+	backend_render_object_cache_clear( self, device );
+
 	for ( auto& frameData : self->mFrames ) {
 
 		using namespace le_backend_vk;
@@ -808,24 +1399,31 @@ static void backend_destroy( le_backend_o* self ) {
 			vkDestroyDescriptorPool( device, d, nullptr );
 		}
 
+		if ( frameData.bindlessDescriptorPool ) {
+			vkDestroyDescriptorPool( device, frameData.bindlessDescriptorPool, nullptr );
+		}
+
 		{
-			// Destroy linear allocators, and the buffers allocated for them.
-			assert( frameData.allocatorBuffers.size() == frameData.allocators.size() &&
+			// Destroy linear allocators, and the buffers allocated for them - including any chained buffers.
+			assert( frameData.allocatorBuffers.size() >= frameData.allocators.size() &&
 			        frameData.allocatorBuffers.size() == frameData.allocations.size() &&
 			        frameData.allocatorBuffers.size() == frameData.allocationInfos.size() );
 
-			VkBuffer*      buffer     = frameData.allocatorBuffers.data();
-			VmaAllocation* allocation = frameData.allocations.data();
+			for ( auto& allocator : frameData.allocators ) {
+				le_allocator_linear_i.destroy( allocator );
+			}
 
-			for ( auto allocator = frameData.allocators.begin(); allocator != frameData.allocators.end(); allocator++, buffer++, allocation++ ) {
-				le_allocator_linear_i.destroy( *allocator );
-				vmaDestroyBuffer( self->mAllocator, *buffer, *allocation );
+			for ( size_t j = 0; j != frameData.allocatorBuffers.size(); j++ ) {
+				vmaDestroyBuffer( self->mAllocator, frameData.allocatorBuffers[ j ], frameData.allocations[ j ] );
 			}
 
 			frameData.allocators.clear();
 			frameData.allocatorBuffers.clear();
 			frameData.allocations.clear();
 			frameData.allocationInfos.clear();
+
+			delete frameData.transientBlockProvider;
+			frameData.transientBlockProvider = nullptr;
 		}
 
 		vmaDestroyPool( self->mAllocator, frameData.allocationPool );
@@ -833,6 +1431,16 @@ static void backend_destroy( le_backend_o* self ) {
 		// destroy staging allocator
 		le_staging_allocator_i.destroy( frameData.stagingAllocator );
 
+		// containers which allocate from the frame arena must not outlive it
+		frameData.passes.clear();
+		frameData.textures_per_pass.clear();
+		frame_recreate_arena_containers( frameData, std::pmr::get_default_resource() );
+		delete frameData.frameArena;
+
+		if ( frameData.timestampQueryPool ) {
+			vkDestroyQueryPool( device, frameData.timestampQueryPool, nullptr );
+		}
+
 		// remove any binned resources
 		for ( auto& a : frameData.binnedResources ) {
 
@@ -849,7 +1457,11 @@ static void backend_destroy( le_backend_o* self ) {
 				vkDestroyBuffer( device, a.second.info.tlasInfo.buffer, nullptr );
 				vkDestroyAccelerationStructureKHR( device, a.second.as.tlas, nullptr );
 			}
-			vmaFreeMemory( self->mAllocator, a.second.allocation );
+			if ( a.second.alias_block ) {
+				a.second.alias_block->num_images--;
+			} else {
+				vmaFreeMemory( self->mAllocator, a.second.allocation );
+			}
 		}
 		frameData.binnedResources.clear();
 	}
@@ -884,11 +1496,29 @@ static void backend_destroy( le_backend_o* self ) {
 				assert( false && "Unknown resource type" );
 			}
 
-			vmaFreeMemory( self->mAllocator, a.second.allocation );
+			if ( a.second.alias_block ) {
+				a.second.alias_block->num_images--;
+			} else {
+				vmaFreeMemory( self->mAllocator, a.second.allocation );
+			}
 		}
 
 		allocated_resources.clear();
+
+		// Now that no more images are bound to them, we can free memory blocks used for aliasing.
+		for ( auto& b : self->transient_memory_blocks ) {
+			assert( b->num_images == 0 && "transient memory block must not be in use" );
+			vmaFreeMemory( self->mAllocator, b->allocation );
+			delete b;
+		}
+		self->transient_memory_blocks.clear();
 	}
+	if ( self->staging_ring ) {
+		// Staging allocators of all frames have been reset with their frames - no-one uses the ring anymore.
+		staging_ring_destroy( self->staging_ring );
+		self->staging_ring = nullptr;
+	}
+
 	if ( self->mAllocator ) {
 		vmaDestroyAllocator( self->mAllocator );
 		self->mAllocator = nullptr;
@@ -1035,6 +1665,7 @@ static bool backend_remove_swapchain( le_backend_o* self, le_swapchain_handle sw
 	auto it = self->swapchains.find( reinterpret_cast<uint64_t>( swapchain_handle ) );
 
 	if ( it != self->swapchains.end() ) {
+		backend_render_object_cache_evict_swapchain_images( self, it->second.get_swapchain() );
 		self->swapchains.erase( it );
 		return true;
 	} else {
@@ -1146,7 +1777,7 @@ static le_img_resource_handle backend_get_swapchain_resource_default( le_backend
 /// Vulkan buffer backing. Instead, they use their Frame's buffer for storage. Virtual buffers
 /// are used to store Frame-local transient data such as values for shader parameters.
 /// Each Encoder uses its own virtual buffer for such purposes.
-static le_buf_resource_handle declare_resource_virtual_buffer( uint8_t index ) {
+static le_buf_resource_handle declare_resource_virtual_buffer( uint16_t index ) {
 
 	le_buf_resource_handle resource =
 	    le_renderer::renderer_i.produce_buf_resource_handle( "Encoder-Virtual", le_buf_resource_usage_flags_t::eIsVirtual, index );
@@ -1182,6 +1813,10 @@ static le_backend_vk_instance_o* backend_get_instance( le_backend_o* self ) {
 // ffdecl.
 static le_allocator_o** backend_create_transient_allocators( le_backend_o* self, size_t frameIndex, size_t numAllocators );
 
+// ----------------------------------------------------------------------
+// ffdecl.
+static uint32_t backend_find_queue_family_index_from_requirements( le_backend_o* self, VkQueueFlags flags );
+
 // ----------------------------------------------------------------------
 
 static inline uint32_t getMemoryIndexForGraphicsScratchBuffer( VmaAllocator const& allocator, uint32_t queueFamilyGraphics ) {
@@ -1266,6 +1901,12 @@ static void backend_initialise( le_backend_o* self ) {
 
 		vk_device_i.get_queues_info( *self->device, &num_queues, queues.data(), queues_family_index.data(), queues_flags.data() );
 
+		// We need queue family properties so that we know which queues support timestamp queries.
+		uint32_t num_queue_families = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties( self->device->getVkPhysicalDevice(), &num_queue_families, nullptr );
+		std::vector<VkQueueFamilyProperties> queue_family_properties( num_queue_families );
+		vkGetPhysicalDeviceQueueFamilyProperties( self->device->getVkPhysicalDevice(), &num_queue_families, queue_family_properties.data() );
+
 		VkSemaphoreTypeCreateInfo type_info = {
 		    .sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
 		    .pNext         = nullptr, // optional
@@ -1285,6 +1926,9 @@ static void backend_initialise( le_backend_o* self ) {
 			    .semaphore            = nullptr,
 			    .semaphore_wait_value = 0,
 			    .queue_family_index   = queues_family_index[ i ],
+			    .timestamp_valid_bits = queues_family_index[ i ] < num_queue_families
+			                                ? queue_family_properties[ queues_family_index[ i ] ].timestampValidBits
+			                                : 0,
 			};
 
 			{
@@ -1315,6 +1959,23 @@ static void backend_initialise( le_backend_o* self ) {
 	if ( self->must_track_resources_queue_family_ownership ) {
 		le::Log( LOGGER_LABEL ).info( "Multiple queue families detected - tracking queue ownership per-resource." );
 	}
+
+	{
+		// Async compute submissions go to the family which best matches compute. If this is not the
+		// graphics family (e.g. because it is a dedicated compute family), resources which async
+		// compute passes use must be shared concurrently, so that they don't need ownership transfers.
+
+		uint32_t const async_compute_queue_family_index = backend_find_queue_family_index_from_requirements( self, VK_QUEUE_COMPUTE_BIT );
+
+		if ( async_compute_queue_family_index != ~uint32_t( 0 ) &&
+		     async_compute_queue_family_index != self->queueFamilyIndexGraphics ) {
+			self->must_share_async_compute_resources_concurrently = true;
+			self->async_compute_sharing_queue_family_indices[ 0 ] = self->queueFamilyIndexGraphics;
+			self->async_compute_sharing_queue_family_indices[ 1 ] = async_compute_queue_family_index;
+			le::Log( LOGGER_LABEL ).info( "Async compute uses queue family %d - resources used by async compute passes are shared concurrently with queue family %d.",
+			                              async_compute_queue_family_index, self->queueFamilyIndexGraphics );
+		}
+	}
 	self->pipelineCache = le_pipeline_manager_i.create( *self->device );
 }
 // ----------------------------------------------------------------------
@@ -1342,6 +2003,59 @@ static void backend_create_main_allocator( VkInstance instance, VkPhysicalDevice
 	vmaCreateAllocator( &createInfo, allocator );
 }
 
+// ----------------------------------------------------------------------
+// (Re-)creates per-frame hash maps so that they allocate from `resource` - usually the frame arena.
+// We must call this before the arena gets reset: clearing a hash map does not release its
+// buckets, which would otherwise point into recycled arena memory.
+static void frame_recreate_arena_containers( BackendFrameData& frame, std::pmr::memory_resource* resource ) {
+	std::destroy_at( &frame.availableResources );
+	std::construct_at( &frame.availableResources, resource );
+	std::destroy_at( &frame.declared_resources );
+	std::construct_at( &frame.declared_resources, resource );
+}
+
+// ----------------------------------------------------------------------
+// Bindless mode only: creates the frame's bindless descriptor set, and the
+// update-after-bind descriptor pool from which it is allocated.
+static void frame_create_bindless_descriptor_set( BackendFrameData& frame, VkDevice device, VkDescriptorSetLayout layout ) {
+
+	VkDescriptorPoolSize pool_sizes[ 2 ] = {
+	    {
+	        .type            = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+	        .descriptorCount = LE_BINDLESS_MAX_TEXTURES,
+	    },
+	    {
+	        .type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+	        .descriptorCount = LE_BINDLESS_MAX_BUFFERS,
+	    },
+	};
+
+	VkDescriptorPoolCreateInfo pool_info = {
+	    .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+	    .pNext         = nullptr, // optional
+	    .flags         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+	    .maxSets       = 1,
+	    .poolSizeCount = 2,
+	    .pPoolSizes    = pool_sizes,
+	};
+
+	auto result = vkCreateDescriptorPool( device, &pool_info, nullptr, &frame.bindlessDescriptorPool );
+	assert( result == VK_SUCCESS );
+
+	VkDescriptorSetAllocateInfo allocate_info = {
+	    .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+	    .pNext              = nullptr, // optional
+	    .descriptorPool     = frame.bindlessDescriptorPool,
+	    .descriptorSetCount = 1,
+	    .pSetLayouts        = &layout,
+	};
+
+	result = vkAllocateDescriptorSets( device, &allocate_info, &frame.bindlessDescriptorSet );
+	assert( result == VK_SUCCESS );
+
+	frame.bindlessDescriptorSetLayout = layout;
+}
+
 // ----------------------------------------------------------------------
 // Note: you must call backend initialise before backend setup!
 static void backend_setup( le_backend_o* self ) {
@@ -1378,14 +2092,30 @@ static void backend_setup( le_backend_o* self ) {
 
 	backend_create_main_allocator( vkInstance, vkPhysicalDevice, vkDevice, &self->mAllocator );
 
-	// -- setup backend memory objects
-
-	self->mFrames.reserve( settings->data_frames_count );
+	{
+		// -- Create staging ring, from which staging allocators of all frames sub-allocate.
+		// A ring size of 0 means that all staging allocations use dedicated buffers.
+		LE_SETTING( uint32_t, LE_SETTING_STAGING_RING_SIZE_MB, 64 );
+
+		if ( *LE_SETTING_STAGING_RING_SIZE_MB ) {
+			self->staging_ring = staging_ring_create( self->mAllocator, uint64_t( *LE_SETTING_STAGING_RING_SIZE_MB ) << 20 );
+		}
+	}
+
+	// -- setup backend memory objects
+
+	self->mFrames.reserve( settings->data_frames_count );
 
 	uint32_t memIndexScratchBufferGraphics = getMemoryIndexForGraphicsScratchBuffer( self->mAllocator, self->queueFamilyIndexGraphics ); // used for transient command buffer allocations
 
+	self->transient_memory_type_index = memIndexScratchBufferGraphics;
+
 	assert( vkDevice ); // device must come from somewhere! It must have been introduced to backend before, or backend must create device used by everyone else...
 
+	if ( settings->bindless_enabled ) {
+		self->bindless_set_layout = le_pipeline_manager_i.get_bindless_descriptor_set_layout( self->pipelineCache );
+	}
+
 	for ( size_t i = 0; i != settings->data_frames_count; ++i ) {
 
 		// -- Set up per-frame resources
@@ -1418,7 +2148,15 @@ static void backend_setup( le_backend_o* self ) {
 
 		// -- create a staging allocator for this frame
 		using namespace le_backend_vk;
-		frameData.stagingAllocator = le_staging_allocator_i.create( self->mAllocator, vkDevice );
+		frameData.stagingAllocator       = le_staging_allocator_i.create( self->mAllocator, vkDevice );
+		frameData.stagingAllocator->ring = self->staging_ring;
+
+		frameData.frameArena = new LinearArena();
+		frame_recreate_arena_containers( frameData, frameData.frameArena );
+
+		if ( self->bindless_set_layout ) {
+			frame_create_bindless_descriptor_set( frameData, vkDevice, self->bindless_set_layout );
+		}
 
 		self->mFrames.emplace_back( std::move( frameData ) );
 	}
@@ -1460,6 +2198,111 @@ static void backend_setup( le_backend_o* self ) {
 	}
 }
 
+// ----------------------------------------------------------------------
+
+static constexpr uint32_t LE_RESOURCE_INDEX_NONE = ~uint32_t( 0 ); // resource is not used by the current frame
+
+// ----------------------------------------------------------------------
+// Resource handles are interned pointers - we mix their bits so that handles
+// which were allocated next to each other don't end up in neighbouring slots.
+static inline size_t resource_index_slot_hash( le_resource_handle const& resource ) {
+	uint64_t h = uint64_t( reinterpret_cast<uintptr_t>( resource ) );
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+	return size_t( h );
+}
+
+// ----------------------------------------------------------------------
+// Assigns a dense per-frame index to each resource which this frame uses - that is, to each
+// resource in availableResources - and sets up per-frame resource tables accordingly.
+// Each sync chain receives the initial state of its resource.
+// Must be called once per frame, after resources for this frame have been allocated.
+static void frame_assign_resource_indices( BackendFrameData& frame ) {
+
+	size_t const num_resources = frame.availableResources.size();
+
+	// Resource index table is an open addressing hash table with linear probing, which we keep
+	// at most half full. Its capacity only ever grows, so that we don't re-allocate for every frame.
+	size_t num_slots = std::max<size_t>( 64, frame.resourceIndexSlots.size() );
+	while ( num_slots < num_resources * 2 ) {
+		num_slots *= 2;
+	}
+	frame.resourceIndexSlots.assign( num_slots, {} );
+
+	frame.resourceHandles.clear();
+	frame.resourceHandles.reserve( num_resources );
+	frame.resourceAllocations.clear();
+	frame.resourceAllocations.reserve( num_resources );
+	frame.imageViews.assign( num_resources, nullptr );
+
+	// Sync chains which we don't need for this frame are kept, so that later frames may re-use their memory.
+	if ( frame.syncChainTable.size() < num_resources ) {
+		frame.syncChainTable.resize( num_resources );
+	}
+
+	uint32_t index = 0;
+
+	for ( auto const& [ handle, resource ] : frame.availableResources ) {
+
+		for ( size_t i = resource_index_slot_hash( handle );; i++ ) {
+			auto& slot = frame.resourceIndexSlots[ i & ( num_slots - 1 ) ];
+			if ( slot.handle == nullptr ) {
+				slot = { handle, index };
+				break;
+			}
+		}
+		frame.resourceHandles.push_back( handle );
+		frame.resourceAllocations.push_back( &resource ); // pointers to map elements stay valid until the element gets erased
+
+		auto& sync_chain = frame.syncChainTable[ index ];
+		sync_chain.clear();
+
+		if ( resource.alias_block ) {
+			// Transient images may share memory with images used earlier in this frame, or
+			// in previous frames: their contents are undefined, and their first use must
+			// wait for any earlier access to their memory to complete - this is our aliasing barrier.
+			ResourceState aliasing_state{ resource.state };
+			aliasing_state.stage          = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+			aliasing_state.visible_access = VK_ACCESS_2_MEMORY_WRITE_BIT;
+			aliasing_state.layout         = VK_IMAGE_LAYOUT_UNDEFINED;
+			sync_chain.push_back( aliasing_state );
+		} else {
+			sync_chain.push_back( resource.state );
+		}
+
+		index++;
+	}
+}
+
+// ----------------------------------------------------------------------
+// Returns dense per-frame index for resource, or LE_RESOURCE_INDEX_NONE if the frame does not use this resource.
+static inline uint32_t frame_get_resource_index( BackendFrameData const& frame, le_resource_handle const& resource ) {
+
+	size_t const num_slots = frame.resourceIndexSlots.size();
+
+	if ( num_slots == 0 ) {
+		return LE_RESOURCE_INDEX_NONE;
+	}
+
+	for ( size_t i = resource_index_slot_hash( resource );; i++ ) {
+		auto const& slot = frame.resourceIndexSlots[ i & ( num_slots - 1 ) ];
+		if ( slot.handle == resource ) {
+			return slot.index;
+		}
+		if ( slot.handle == nullptr ) {
+			return LE_RESOURCE_INDEX_NONE;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+// Returns true if resource is used by this frame, and was allocated to be shared concurrently between queue families.
+static inline bool frame_resource_is_shared_concurrently( BackendFrameData const& frame, le_resource_handle const& resource ) {
+	uint32_t const resource_index = frame_get_resource_index( frame, resource );
+	return resource_index != LE_RESOURCE_INDEX_NONE && frame.resourceAllocations[ resource_index ]->info.isSharedConcurrently();
+}
+
 // ----------------------------------------------------------------------
 // Add image attachments to leRenderPass
 // Update syncchain for images affected.
@@ -1494,11 +2337,17 @@ static void le_renderpass_add_attachments( le_renderpass_o const* pass, BackendR
 			    img_resource->data->debug_name, uint8_t( numSamplesLog2 ), img_resource, 0 );
 		}
 
-		auto& syncChain = frame.syncChainTable[ img_resource ];
+		uint32_t const resource_index = frame_get_resource_index( frame, img_resource );
+
+		assert( resource_index != LE_RESOURCE_INDEX_NONE && "Attachment image must be available to frame" );
+
+		auto& syncChain = frame.syncChainTable[ resource_index ];
 
 		assert( !syncChain.empty() && "SyncChain must not be empty" );
 
-		auto const& attachmentFormat = le::Format( frame.availableResources[ img_resource ].info.imageInfo.format );
+		AllocatedResourceVk const& allocated_resource = *frame.resourceAllocations[ resource_index ];
+
+		auto const& attachmentFormat = le::Format( allocated_resource.info.imageInfo.format );
 
 		bool isDepth = false, isStencil = false;
 		le_format_get_is_depth_stencil( attachmentFormat, isDepth, isStencil );
@@ -1518,12 +2367,13 @@ static void le_renderpass_add_attachments( le_renderpass_o const* pass, BackendR
 			currentAttachment->type = AttachmentInfo::Type::eColorAttachment;
 		}
 
-		currentAttachment->resource   = img_resource;
-		currentAttachment->format     = le::Format( attachmentFormat );
-		currentAttachment->numSamples = sampleCount;
-		currentAttachment->loadOp     = image_attachment_info.loadOp;
-		currentAttachment->storeOp    = image_attachment_info.storeOp;
-		currentAttachment->clearValue = image_attachment_info.clearValue;
+		currentAttachment->resource       = img_resource;
+		currentAttachment->resource_index = resource_index;
+		currentAttachment->format         = le::Format( attachmentFormat );
+		currentAttachment->numSamples     = sampleCount;
+		currentAttachment->loadOp         = image_attachment_info.loadOp;
+		currentAttachment->storeOp        = image_attachment_info.storeOp;
+		currentAttachment->clearValue     = image_attachment_info.clearValue;
 
 		{
 			// track resource state before entering a subpass
@@ -1551,6 +2401,13 @@ static void le_renderpass_add_attachments( le_renderpass_o const* pass, BackendR
 				beforeFirstUse.visible_access = VkAccessFlagBits2( 0 );
 			}
 
+			if ( syncChain.size() == 1 && allocated_resource.alias_block ) {
+				// First use of an aliased image in this frame: keep the aliasing barrier from the
+				// initial state, so that any earlier access to the image's memory must complete first.
+				beforeFirstUse.stage          = previousSyncState.stage;
+				beforeFirstUse.visible_access = previousSyncState.visible_access;
+			}
+
 			currentAttachment->initialStateOffset = uint16_t( syncChain.size() );
 			syncChain.emplace_back( std::move( beforeFirstUse ) ); // attachment initial state for a renderpass - may be loaded/cleared on first use
 			                                                       // * sync state: ready for load/store *
@@ -1623,10 +2480,14 @@ static void le_renderpass_add_attachments( le_renderpass_o const* pass, BackendR
 
 		auto const& image_attachment_info = pImageAttachments[ i ];
 
-		le_img_resource_handle img_resource = pResources[ i ];
-		auto&                  syncChain    = frame.syncChainTable[ img_resource ];
+		le_img_resource_handle img_resource   = pResources[ i ];
+		uint32_t const         resource_index = frame_get_resource_index( frame, img_resource );
+
+		assert( resource_index != LE_RESOURCE_INDEX_NONE && "Attachment image must be available to frame" );
+
+		auto& syncChain = frame.syncChainTable[ resource_index ];
 
-		auto const& attachmentFormat = le::Format( frame.availableResources[ img_resource ].info.imageInfo.format );
+		auto const& attachmentFormat = le::Format( frame.resourceAllocations[ resource_index ]->info.imageInfo.format );
 
 		bool isDepth = false, isStencil = false;
 		le_format_get_is_depth_stencil( attachmentFormat, isDepth, isStencil );
@@ -1640,13 +2501,14 @@ static void le_renderpass_add_attachments( le_renderpass_o const* pass, BackendR
 		// we're dealing with a resolve attachment here.
 		currentPass.numResolveAttachments++;
 
-		currentAttachment->resource   = img_resource;
-		currentAttachment->format     = le::Format( attachmentFormat );
-		currentAttachment->numSamples = le::SampleCountFlagBits::e1; // this is a requirement for resolve passes.
-		currentAttachment->loadOp     = le::AttachmentLoadOp::eDontCare;
-		currentAttachment->storeOp    = image_attachment_info.storeOp;
-		currentAttachment->clearValue = image_attachment_info.clearValue;
-		currentAttachment->type       = AttachmentInfo::Type::eResolveAttachment;
+		currentAttachment->resource       = img_resource;
+		currentAttachment->resource_index = resource_index;
+		currentAttachment->format         = le::Format( attachmentFormat );
+		currentAttachment->numSamples     = le::SampleCountFlagBits::e1; // this is a requirement for resolve passes.
+		currentAttachment->loadOp         = le::AttachmentLoadOp::eDontCare;
+		currentAttachment->storeOp        = image_attachment_info.storeOp;
+		currentAttachment->clearValue     = image_attachment_info.clearValue;
+		currentAttachment->type           = AttachmentInfo::Type::eResolveAttachment;
 
 		{
 			// track resource state before entering a subpass
@@ -1709,12 +2571,54 @@ static std::string to_string_le_access_flags2( const le::AccessFlags2& tp ) {
 	}
 	return result;
 }
+// ----------------------------------------------------------------------
+// we use this to mask out any reads in srcAccess, as it never makes sense to flush reads
+static constexpr auto ANY_WRITE_VK_ACCESS_2_FLAGS =
+    ( VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+      VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+      VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR |
+      VK_ACCESS_2_HOST_WRITE_BIT |
+      VK_ACCESS_2_MEMORY_WRITE_BIT |
+      VK_ACCESS_2_SHADER_WRITE_BIT |
+      VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT |
+      VK_ACCESS_2_TRANSFER_WRITE_BIT |
+      VK_ACCESS_2_COMMAND_PREPROCESS_WRITE_BIT_NV |
+      VK_ACCESS_2_TRANSFORM_FEEDBACK_COUNTER_WRITE_BIT_EXT );
+
+// ----------------------------------------------------------------------
+// Pipeline stages and access flags which are only supported on queues with graphics capabilities.
+// We mask these out of barriers which we record on other queues (e.g. a dedicated compute queue):
+// any such access must have happened on another queue, which we have already waited for via semaphore.
+static constexpr VkPipelineStageFlags2 GRAPHICS_ONLY_VK_PIPELINE_STAGE_2_FLAGS =
+    ( VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT |
+      VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT |
+      VK_PIPELINE_STAGE_2_TESSELLATION_CONTROL_SHADER_BIT |
+      VK_PIPELINE_STAGE_2_TESSELLATION_EVALUATION_SHADER_BIT |
+      VK_PIPELINE_STAGE_2_GEOMETRY_SHADER_BIT |
+      VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT |
+      VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
+      VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT |
+      VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT |
+      VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT |
+      VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT |
+      VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT |
+      VK_PIPELINE_STAGE_2_PRE_RASTERIZATION_SHADERS_BIT );
+
+static constexpr VkAccessFlags2 GRAPHICS_ONLY_VK_ACCESS_2_FLAGS =
+    ( VK_ACCESS_2_INDEX_READ_BIT |
+      VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT |
+      VK_ACCESS_2_INPUT_ATTACHMENT_READ_BIT |
+      VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT |
+      VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+      VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+      VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT );
+
 // ----------------------------------------------------------------------
 // Updates sync chain for resourcess referenced in rendergraph
 // each renderpass contains offsets into sync chain for given resource used by renderpass.
 // resource sync state for images used as renderpass attachments is chosen so that they
 // can be implicitly synced using subpass dependencies.
-static void le_renderpass_add_explicit_sync( le_renderpass_o const* pass, BackendRenderPass& currentPass, BackendFrameData::sync_chain_table_t& syncChainTable ) {
+static void le_renderpass_add_explicit_sync( le_renderpass_o const* pass, BackendRenderPass& currentPass, BackendFrameData& frame ) {
 	using namespace le_renderer;
 	le_resource_handle const* resources        = nullptr;
 	le::AccessFlags2 const*   resources_access = nullptr;
@@ -1739,15 +2643,45 @@ static void le_renderpass_add_explicit_sync( le_renderpass_o const* pass, Backen
 		}
 	};
 
+	auto get_stage_flags_for_buffer_access = [ &get_stage_flags_based_on_renderpass_type ]( le::AccessFlags2 const& access, le::QueueFlagBits const& rp_type ) -> VkPipelineStageFlags2 {
+		VkPipelineStageFlags2 stage = 0;
+
+		if ( access & VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT ) {
+			stage |= VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+		}
+		if ( access & ( VK_ACCESS_2_INDEX_READ_BIT | VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT ) ) {
+			stage |= VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT;
+		}
+		if ( access & ( VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT ) ) {
+			stage |= VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+		}
+		if ( access & ( VK_ACCESS_2_UNIFORM_READ_BIT |
+		                VK_ACCESS_2_SHADER_READ_BIT |
+		                VK_ACCESS_2_SHADER_WRITE_BIT |
+		                VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+		                VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT ) ) {
+			// Shaders in a draw pass may access buffers from any shader stage.
+			stage |= ( rp_type == le::QueueFlagBits::eGraphics )
+			             ? ( VK_PIPELINE_STAGE_2_PRE_RASTERIZATION_SHADERS_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT )
+			             : get_stage_flags_based_on_renderpass_type( rp_type );
+		}
+
+		return stage ? stage : get_stage_flags_based_on_renderpass_type( rp_type );
+	};
+
 	for ( size_t i = 0; i != resources_count; ++i ) {
 		auto const& resource = resources[ i ];
 
-		auto& syncChain = syncChainTable[ resource ];
+		uint32_t const resource_index = frame_get_resource_index( frame, resource );
+		assert( resource_index != LE_RESOURCE_INDEX_NONE ); // this resource must exist, and have an initial sync state
+
+		auto& syncChain = frame.syncChainTable[ resource_index ];
 		assert( !syncChain.empty() ); // must not be empty - this resource must exist, and have an initial sync state
 
 		ExplicitSyncOp syncOp{};
 
 		syncOp.resource                  = resource;
+		syncOp.resource_index            = resource_index;
 		syncOp.active                    = true;
 		syncOp.sync_chain_offset_initial = uint32_t( syncChain.size() - 1 );
 
@@ -1778,11 +2712,43 @@ static void le_renderpass_add_explicit_sync( le_renderpass_o const* pass, Backen
 				continue;
 			}
 
-		} else {
-			// Resources other than Images are ignored.
+		} else if ( resource->data->type == LeResourceType::eBuffer ) {
+
+			// Buffers have no layout - we track which stages access them, and how,
+			// so that we can issue a barrier if there is a hazard with a previous access.
+			//
+			// This is what allows buffers written by one pass to be used as e.g. vertex,
+			// or indirect argument buffers by a later pass without manual barriers.
+
+			if ( resources_access[ i ] == 0 ) {
+				continue;
+			}
+
+			requestedState.visible_access = resources_access[ i ];
+			requestedState.stage          = get_stage_flags_for_buffer_access( resources_access[ i ], currentPass.type );
 
-			// TODO: whe should probably process buffers here, as skipping the loop here
-			// means that Buffers don't ever get added to explicit_sync_ops.
+			auto const& previousState = syncChain.back();
+
+			if ( requestedState.visible_access & ANY_WRITE_VK_ACCESS_2_FLAGS ) {
+				// Write: this becomes the write which any later reads must wait for.
+				requestedState.last_write_stage  = requestedState.stage;
+				requestedState.last_write_access = requestedState.visible_access & ANY_WRITE_VK_ACCESS_2_FLAGS;
+			} else {
+				requestedState.last_write_stage  = previousState.last_write_stage;
+				requestedState.last_write_access = previousState.last_write_access;
+
+				if ( 0 == ( previousState.visible_access & ANY_WRITE_VK_ACCESS_2_FLAGS ) ) {
+					// Read-after-read: we accumulate stages and accesses, so that any later write waits for
+					// all reads to complete. If the previous reads already cover this read, the state does
+					// not change, and no barrier is issued. Otherwise, this read gets a barrier which waits
+					// for the most recent write - see backend_process_frame.
+					requestedState.stage |= previousState.stage;
+					requestedState.visible_access |= previousState.visible_access;
+				}
+			}
+
+		} else {
+			// Resources other than Images and Buffers are ignored.
 			continue;
 		}
 
@@ -1799,7 +2765,7 @@ static void le_renderpass_add_explicit_sync( le_renderpass_o const* pass, Backen
 
 static void frame_track_resource_state(
     BackendFrameData& frame, le_renderpass_o** ppPasses,
-    size_t numRenderPasses, const std::vector<le_img_resource_handle>& swapchain_images ) {
+    size_t numRenderPasses, const std::pmr::vector<le_img_resource_handle>& swapchain_images ) {
 
 	// A pipeline barrier is defined as a combination of EXECUTION dependency and MEMORY dependency:
 	//
@@ -1835,9 +2801,9 @@ static void frame_track_resource_state(
 
 		le_img_resource_handle backbuffer = swapchain_image;
 
-		auto backbufferIt = syncChainTable.find( backbuffer );
-		if ( backbufferIt != syncChainTable.end() ) {
-			auto& backbufferState          = backbufferIt->second.front();
+		uint32_t const backbuffer_index = frame_get_resource_index( frame, backbuffer );
+		if ( backbuffer_index != LE_RESOURCE_INDEX_NONE ) {
+			auto& backbufferState          = syncChainTable[ backbuffer_index ].front();
 			backbufferState.stage          = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT; // we need this, since semaphore waits on this stage
 			backbufferState.visible_access = VkAccessFlagBits2( 0 );                          // semaphore took care of availability - we can assume memory is already available
 		} else {
@@ -1851,9 +2817,13 @@ static void frame_track_resource_state(
 
 	for ( auto pass = ppPasses; pass != ppPasses + numRenderPasses; pass++ ) {
 
-		BackendRenderPass currentPass{};
+		BackendRenderPass currentPass{
+		    .resources         = std::pmr::vector<le_resource_handle>( frame.frameArena ),
+		    .explicit_sync_ops = std::pmr::vector<ExplicitSyncOp>( frame.frameArena ),
+		};
 
 		renderpass_i.get_queue_sumbission_info( *pass, &currentPass.type, &currentPass.root_passes_affinity );
+		renderpass_i.get_async_compute_info( *pass, &currentPass.is_async_compute, &currentPass.waits_for_async );
 
 		memcpy( currentPass.debugName, renderpass_i.get_debug_name( *pass ), sizeof( currentPass.debugName ) );
 
@@ -1861,7 +2831,7 @@ static void frame_track_resource_state(
 
 		// Find explicit sync ops needed for resources which are not attachments
 		//
-		le_renderpass_add_explicit_sync( *pass, currentPass, syncChainTable );
+		le_renderpass_add_explicit_sync( *pass, currentPass, frame );
 
 		// Iterate over all image attachments
 		le_renderpass_add_attachments( *pass, currentPass, frame, currentPass.sampleCount );
@@ -1873,9 +2843,9 @@ static void frame_track_resource_state(
 		frame.passes.emplace_back( std::move( currentPass ) );
 	} // end for all passes
 
-	for ( auto& s_entry : syncChainTable ) {
-		const auto& resource_handle = s_entry.first;
-		auto&       sync_chain      = s_entry.second;
+	for ( size_t i = 0; i != frame.resourceHandles.size(); i++ ) {
+		const auto& resource_handle = frame.resourceHandles[ i ];
+		auto&       sync_chain      = syncChainTable[ i ];
 
 		auto finalState{ sync_chain.back() };
 
@@ -1883,6 +2853,9 @@ static void frame_track_resource_state(
 			finalState.stage          = VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT; // Everything: Drain the pipeline
 			finalState.visible_access = VK_ACCESS_2_MEMORY_READ_BIT;            // Cached memory must be made visible to memory read access ...
 			finalState.layout         = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;        // ... so that it can perform layout transition to present_src
+		} else if ( resource_handle->data->type == LeResourceType::eBuffer ) {
+			// Buffers keep the state of their last access, so that the first access in a
+			// later frame can wait for it - persistent buffers may be rewritten by later frames.
 		} else {
 			// we mimick implicit dependency here, which exists for a final subpass
 			// see p.210 vk spec (chapter 7, render pass)
@@ -1904,14 +2877,13 @@ static void frame_track_resource_state(
 	//
 	// Note that only resources of type image may be implicitly synced.
 
-	typedef std::unordered_map<le_resource_handle, uint32_t> SyncChainMap;
+	// Per dense resource index: highest sync chain index so far, or LE_RESOURCE_INDEX_NONE if none
+	std::vector<uint32_t> max_sync_index( frame.resourceHandles.size(), LE_RESOURCE_INDEX_NONE );
 
-	SyncChainMap max_sync_index;
-
-	auto insert_if_greater = [ &max_sync_index ]( le_resource_handle const& key, uint32_t value ) {
-		// Updates map entry to highest value
-		auto& element = max_sync_index[ key ];
-		element       = std::max( element, value );
+	auto insert_if_greater = [ &max_sync_index ]( uint32_t resource_index, uint32_t value ) {
+		// Updates entry to highest value
+		auto& element = max_sync_index[ resource_index ];
+		element       = ( element == LE_RESOURCE_INDEX_NONE ) ? value : std::max( element, value );
 	};
 
 	for ( auto& p : frame.passes ) {
@@ -1936,15 +2908,15 @@ static void frame_track_resource_state(
 			// We can skip checks for buffer barriers, as we assume they are
 			// all needed.
 
-			auto found_it = max_sync_index.find( op.resource );
-			if ( found_it != max_sync_index.end() && found_it->second >= op.sync_chain_offset_final ) {
+			auto& max_index = max_sync_index[ op.resource_index ];
+			if ( max_index != LE_RESOURCE_INDEX_NONE && max_index >= op.sync_chain_offset_final ) {
 				// found an element, and current index is already higher than barrier index.
 				op.active = false;
 			} else {
 				// no element found, or max index is smaller.
 				op.active = true;
 				// store the current max index, then.
-				max_sync_index[ op.resource ] = op.sync_chain_offset_final;
+				max_index = op.sync_chain_offset_final;
 			}
 		}
 
@@ -1956,7 +2928,7 @@ static void frame_track_resource_state(
 
 		for ( size_t a = 0; a != numAttachments; a++ ) {
 			auto const& attachmentInfo = p.attachments[ a ];
-			insert_if_greater( attachmentInfo.resource, attachmentInfo.finalStateOffset );
+			insert_if_greater( attachmentInfo.resource_index, attachmentInfo.finalStateOffset );
 		}
 	}
 }
@@ -2007,6 +2979,319 @@ static bool backend_poll_frame_fence( le_backend_o* self, size_t frameIndex ) {
 	}
 }
 
+// ----------------------------------------------------------------------
+/// \brief Reads back timestamp queries which were written while processing this frame,
+/// and publishes per-pass gpu timings so that they may be queried via get_pass_gpu_timings.
+/// \preliminary: frame fence must have been crossed.
+static void backend_collect_gpu_timestamps( le_backend_o* self, BackendFrameData& frame ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	using namespace le_backend_vk;
+
+	VkDevice device           = self->device->getVkDevice();
+	double   timestamp_period = vk_device_i.get_vk_physical_device_properties( *self->device )->limits.timestampPeriod; // nanoseconds per tick
+
+	auto& timings = frame.gpuPassTimings;
+	timings.clear();
+	timings.reserve( frame.timestampQueries.size() );
+
+	for ( auto const& q : frame.timestampQueries ) {
+
+		uint64_t ticks[ 2 ] = {};
+
+		// Fence has been crossed, so results must be available - we don't wait.
+		VkResult result = vkGetQueryPoolResults( device, frame.timestampQueryPool, q.pass_index * 2, 2, sizeof( ticks ), ticks, sizeof( uint64_t ), VK_QUERY_RESULT_64_BIT );
+
+		if ( result != VK_SUCCESS ) {
+			continue;
+		}
+
+		// Mask out any bits which are not valid for this queue - timestamps may wrap around.
+		uint32_t const valid_bits = self->queues[ q.queue_index ]->timestamp_valid_bits;
+		uint64_t const mask       = valid_bits >= 64 ? ~uint64_t( 0 ) : ( ( uint64_t( 1 ) << valid_bits ) - 1 );
+		uint64_t const delta      = ( ticks[ 1 ] - ticks[ 0 ] ) & mask;
+
+		le_backend_pass_gpu_timing_t timing{};
+		strncpy( timing.debug_name, frame.passes[ q.pass_index ].debugName, sizeof( timing.debug_name ) - 1 );
+		timing.gpu_ms = double( delta ) * timestamp_period * 1e-6;
+
+		timings.emplace_back( timing );
+	}
+
+	LE_SETTING( bool, LE_SETTING_BACKEND_PRINT_GPU_TIMESTAMPS, false );
+
+	if ( *LE_SETTING_BACKEND_PRINT_GPU_TIMESTAMPS ) [[unlikely]] {
+		for ( auto const& t : timings ) {
+			logger.info( "Frame %8d gpu time: %8.3f ms - pass '%s'", frame.frameNumber, t.gpu_ms, t.debug_name );
+		}
+	}
+
+	{
+		std::scoped_lock lock( self->gpu_pass_timings_mutex );
+		self->gpu_pass_timings.swap( timings );
+		self->gpu_pass_timings_frame_number = frame.frameNumber;
+	}
+
+	// Queries must be reset before they may be written again. We do this on the host, so that we
+	// don't need to record a reset into command buffers - which is not allowed on transfer-only queues.
+	vkResetQueryPool( device, frame.timestampQueryPool, 0, frame.timestampQueryPoolCapacity );
+
+	frame.timestampQueries.clear();
+}
+
+// ----------------------------------------------------------------------
+
+static bool backend_get_pass_gpu_timings( le_backend_o* self, size_t* count, le_backend_pass_gpu_timing_t* p_timings, uint64_t* frame_number ) {
+
+	std::scoped_lock lock( self->gpu_pass_timings_mutex );
+
+	if ( *count < self->gpu_pass_timings.size() || p_timings == nullptr ) {
+		*count = self->gpu_pass_timings.size();
+		return false;
+	}
+
+	// ---------| invariant: count is equal or larger than number of timings
+
+	*count = self->gpu_pass_timings.size();
+
+	std::copy( self->gpu_pass_timings.begin(), self->gpu_pass_timings.end(), p_timings );
+
+	if ( frame_number ) {
+		*frame_number = self->gpu_pass_timings_frame_number;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+static bool backend_get_pass_gpu_time( le_backend_o* self, char const* pass_debug_name, double* gpu_ms ) {
+
+	std::scoped_lock lock( self->gpu_pass_timings_mutex );
+
+	for ( auto const& t : self->gpu_pass_timings ) {
+		if ( 0 == strncmp( t.debug_name, pass_debug_name, sizeof( t.debug_name ) - 1 ) ) {
+			*gpu_ms = t.gpu_ms;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// ----------------------------------------------------------------------
+// Creates a mapped transient buffer of `size` bytes, and appends it to the transient buffers of `frame`.
+// Buffers which fit into a block of the frame pool come from the frame pool, larger buffers get their own
+// allocation. The buffer's allocation info holds, as pUserData, the virtual resource handle for the buffer.
+// Returns false if the buffer could not be created.
+static bool frame_create_transient_buffer( le_backend_o* self, BackendFrameData& frame, uint64_t size, size_t buffer_index ) {
+
+	using namespace le_backend_vk;
+
+	static auto                     logger                        = LeLog( LOGGER_LABEL );
+	static const VkBufferUsageFlags LE_BUFFER_USAGE_FLAGS_SCRATCH = defaults_get_buffer_usage_scratch();
+
+	if ( buffer_index > std::numeric_limits<uint16_t>::max() ) {
+		logger.error( "Too many transient buffers - cannot store index %lu in resource handle.", buffer_index );
+		return false;
+	}
+
+	// ----------| invariant: buffer index fits into resource handle
+
+	VkBuffer          buffer = nullptr;
+	VmaAllocation     allocation;
+	VmaAllocationInfo allocationInfo;
+
+	VmaAllocationCreateInfo createInfo{};
+	createInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+	if ( size <= LE_FRAME_DATA_POOL_BLOCK_SIZE ) {
+		createInfo.pool = frame.allocationPool; // Since we're allocating from a pool all fields but .flags will be taken from the pool
+	} else {
+		createInfo.memoryTypeBits = 1u << self->transient_memory_type_index;
+	}
+
+	le_buf_resource_handle res = declare_resource_virtual_buffer( uint16_t( buffer_index ) );
+
+	createInfo.pUserData = res;
+
+	VkBufferCreateInfo bufferCreateInfo{
+	    .sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+	    .pNext                 = nullptr, // optional
+	    .flags                 = 0,       // optional
+	    .size                  = size,
+	    .usage                 = LE_BUFFER_USAGE_FLAGS_SCRATCH,
+	    .sharingMode           = VK_SHARING_MODE_EXCLUSIVE,
+	    .queueFamilyIndexCount = 0,
+	    .pQueueFamilyIndices   = nullptr,
+	};
+
+	if ( self->must_share_async_compute_resources_concurrently ) {
+		// Async compute passes may read argument data from transient buffers, too.
+		bufferCreateInfo.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+		bufferCreateInfo.queueFamilyIndexCount = 2;
+		bufferCreateInfo.pQueueFamilyIndices   = self->async_compute_sharing_queue_family_indices;
+	}
+
+	auto result = vmaCreateBuffer( self->mAllocator, &bufferCreateInfo, &createInfo, &buffer, &allocation, &allocationInfo );
+
+	if ( result != VK_SUCCESS ) {
+		logger.error( "Could not create transient buffer of %lu bytes: '%s'", size, to_str_vk_result( result ) );
+		return false;
+	}
+
+	// ----------| invariant: buffer was created
+
+	if ( buffer_index == frame.allocatorBuffers.size() ) {
+		frame.allocatorBuffers.emplace_back( buffer );
+		frame.allocations.emplace_back( allocation );
+		frame.allocationInfos.emplace_back( allocationInfo );
+	} else {
+		// Buffer replaces an existing buffer, which must have been destroyed already.
+		frame.allocatorBuffers[ buffer_index ] = buffer;
+		frame.allocations[ buffer_index ]      = allocation;
+		frame.allocationInfos[ buffer_index ]  = allocationInfo;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Called by a transient allocator, possibly from a worker thread, once its current block is exhausted:
+// provides a further block of at least `min_capacity` bytes, held by a new transient buffer.
+static bool frame_transient_allocator_grow( void* user_data, uint64_t min_capacity, VmaAllocationInfo* info ) {
+
+	auto  provider = static_cast<BackendFrameData::TransientBlockProvider*>( user_data );
+	auto& frame    = *provider->frame;
+
+	std::scoped_lock lock( provider->mtx );
+
+	size_t buffer_index = frame.allocatorBuffers.size();
+
+	if ( !frame_create_transient_buffer( provider->backend, frame, min_capacity, buffer_index ) ) {
+		return false;
+	}
+
+	*info = frame.allocationInfos[ buffer_index ];
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Creates a transient allocator, and its first block, at `index`, which may either be a new
+// index, or the index of an allocator which has been destroyed together with its buffer.
+static bool frame_create_transient_allocator( le_backend_o* self, BackendFrameData& frame, size_t index, uint64_t block_size ) {
+
+	using namespace le_backend_vk;
+
+	assert( index < 256 ); // must not have more than 255 allocators, otherwise we cannot store index in LeResourceHandleMeta.
+
+	if ( !frame_create_transient_buffer( self, frame, block_size, index ) ) {
+		return false;
+	}
+
+	// Create a new allocator - note that we assume an alignment of 256 bytes
+	le_allocator_o* allocator = le_allocator_linear_i.create( &frame.allocationInfos[ index ], 256 );
+	le_allocator_linear_i.set_grow_callback( allocator, frame_transient_allocator_grow, frame.transientBlockProvider );
+
+	if ( index == frame.allocators.size() ) {
+		frame.allocators.emplace_back( allocator );
+	} else {
+		frame.allocators[ index ] = allocator;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Resets transient allocators of a frame, and releases any blocks which they chained.
+//
+// We keep track of how much memory any single allocator used during a frame: first blocks
+// which are smaller than this high-water mark get re-created with the larger size, so that
+// future frames will most likely not need to chain blocks.
+static void frame_reset_transient_allocators( le_backend_o* self, BackendFrameData& frame ) {
+
+	using namespace le_backend_vk;
+
+	le_allocator_linear_stats_t frame_stats{};
+
+	uint64_t max_bytes_used = 0; // highest number of bytes used by any single allocator
+
+	for ( auto& alloc : frame.allocators ) {
+		le_allocator_linear_stats_t stats{};
+		le_allocator_linear_i.get_stats( alloc, &stats );
+		le_allocator_linear_i.reset( alloc );
+
+		frame_stats.bytes_used += stats.bytes_used;
+		frame_stats.capacity += stats.capacity;
+		frame_stats.num_blocks += stats.num_blocks;
+		max_bytes_used = std::max( max_bytes_used, stats.bytes_used );
+	}
+
+	uint64_t block_size;
+
+	{
+		std::scoped_lock lock( self->transient_allocators_mutex );
+
+		// Block size only ever grows, and only in powers of two, so that we don't keep re-creating blocks.
+		while ( self->transient_allocator_block_size < max_bytes_used ) {
+			self->transient_allocator_block_size *= 2;
+		}
+
+		block_size = self->transient_allocator_block_size;
+
+		frame_stats.bytes_used_peak = std::max( self->transient_allocators_stats.bytes_used_peak, frame_stats.bytes_used );
+
+		self->transient_allocators_stats = frame_stats;
+	}
+
+	// -- Destroy chained buffers - these are the buffers past the first block of each allocator.
+
+	size_t const num_allocators = frame.allocators.size();
+
+	if ( frame.allocatorBuffers.size() > num_allocators ) {
+
+		for ( size_t i = num_allocators; i != frame.allocatorBuffers.size(); i++ ) {
+			vmaDestroyBuffer( self->mAllocator, frame.allocatorBuffers[ i ], frame.allocations[ i ] );
+		}
+
+		frame.allocatorBuffers.resize( num_allocators );
+		frame.allocations.resize( num_allocators );
+		frame.allocationInfos.resize( num_allocators );
+
+		self->descriptor_resource_generation++;
+	}
+
+	// -- Re-create allocators whose first block is smaller than the current block size.
+
+	for ( size_t i = 0; i != num_allocators; i++ ) {
+
+		if ( frame.allocationInfos[ i ].size >= block_size ) {
+			continue;
+		}
+
+		le_allocator_linear_i.destroy( frame.allocators[ i ] );
+		vmaDestroyBuffer( self->mAllocator, frame.allocatorBuffers[ i ], frame.allocations[ i ] );
+
+		self->descriptor_resource_generation++;
+
+		if ( !frame_create_transient_allocator( self, frame, i, block_size ) ) {
+			// We must not leave the allocator missing - fall back to the default block size.
+			bool result = frame_create_transient_allocator( self, frame, i, LE_LINEAR_ALLOCATOR_SIZE );
+			assert( result && "could not re-create transient allocator" );
+			(void)result;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static void backend_get_transient_allocators_stats( le_backend_o* self, le_allocator_linear_stats_t* stats ) {
+	std::scoped_lock lock( self->transient_allocators_mutex );
+	*stats = self->transient_allocators_stats;
+}
+
 // ----------------------------------------------------------------------
 /// \brief: Frees all frame local resources
 /// \preliminary: frame fence must have been crossed.
@@ -2026,9 +3311,37 @@ static bool backend_clear_frame( le_backend_o* self, size_t frameIndex ) {
 
 	vkResetFences( device, 1, &frame.frameFence );
 
-	// -- reset all frame-local sub-allocators
-	for ( auto& alloc : frame.allocators ) {
-		le_allocator_linear_i.reset( alloc );
+	// -- read back gpu timestamps - this must happen before we clear passes, as we need pass names.
+	if ( !frame.timestampQueries.empty() ) {
+		backend_collect_gpu_timestamps( self, frame );
+	}
+
+	// -- reset all frame-local sub-allocators, and release any blocks which they chained
+	frame_reset_transient_allocators( self, frame );
+
+	// -- evict cached descriptor sets which refer to staging buffers, as these are about to be
+	// destroyed, and new staging buffers may re-use their handles.
+	if ( !frame.stagingAllocator->buffers.empty() ) {
+		auto const& staging_buffers = frame.stagingAllocator->buffers;
+		for ( auto it = frame.descriptorSetCache.begin(); it != frame.descriptorSetCache.end(); ) {
+			bool refers_to_staging_buffer =
+			    std::any_of( it->second.set_data.begin(), it->second.set_data.end(), [ &staging_buffers ]( DescriptorData const& d ) {
+				    switch ( d.type ) {
+				    case le::DescriptorType::eUniformBuffer:
+				    case le::DescriptorType::eStorageBuffer:
+				    case le::DescriptorType::eUniformBufferDynamic:
+				    case le::DescriptorType::eStorageBufferDynamic:
+					    return std::find( staging_buffers.begin(), staging_buffers.end(), d.bufferInfo.buffer ) != staging_buffers.end();
+				    default:
+					    return false;
+				    }
+			    } );
+			if ( refers_to_staging_buffer ) {
+				it = frame.descriptorSetCache.erase( it );
+			} else {
+				++it;
+			}
+		}
 	}
 
 	// -- reset frame-local staging allocator
@@ -2037,20 +3350,18 @@ static bool backend_clear_frame( le_backend_o* self, size_t frameIndex ) {
 	// -- remove any texture references
 	frame.textures_per_pass.clear();
 
-	// -- remove any image view references
+	// -- remove any image view references, and dense resource indices
 	frame.imageViews.clear();
+	frame.resourceIndexSlots.assign( frame.resourceIndexSlots.size(), {} ); // note: keeps capacity
+	frame.resourceHandles.clear();
+	frame.resourceAllocations.clear();
 
 	// -- remove any frame-local copy of allocated resources
-	frame.availableResources.clear();
-	frame.declared_resources.clear();
+	frame_recreate_arena_containers( frame, frame.frameArena );
 
 	frame.must_create_queues_dot_graph = false;
 	frame.debug_root_passes_names.clear();
 
-	for ( auto& d : frame.descriptorPools ) {
-		vkResetDescriptorPool( device, d, VkDescriptorPoolResetFlags() );
-	}
-
 	{ // clear resources owned exclusively by this frame
 
 		for ( auto& r : frame.ownedResources ) {
@@ -2068,6 +3379,8 @@ static bool backend_clear_frame( le_backend_o* self, size_t frameIndex ) {
 				vkDestroyImageView( device, r.asImageView, nullptr );
 				break;
 			case AbstractPhysicalResource::eRenderPass:
+				// Pipelines which are compiled in the background may still reference this renderpass.
+				le_backend_vk::le_pipeline_manager_i.release_render_pass( self->pipelineCache, r.asRenderPass );
 				vkDestroyRenderPass( device, r.asRenderPass, nullptr );
 				break;
 			case AbstractPhysicalResource::eSampler:
@@ -2093,8 +3406,10 @@ static bool backend_clear_frame( le_backend_o* self, size_t frameIndex ) {
 	}
 	frame.queue_submission_data.clear();
 
-	frame.physicalResources.clear();
-	frame.syncChainTable.clear();
+	// We keep sync chains allocated, so that the next frame may re-use their memory.
+	for ( auto& sync_chain : frame.syncChainTable ) {
+		sync_chain.clear();
+	}
 
 	for ( auto& f : frame.passes ) {
 		if ( f.encoder ) {
@@ -2105,30 +3420,32 @@ static bool backend_clear_frame( le_backend_o* self, size_t frameIndex ) {
 	}
 	frame.passes.clear();
 
+	// -- recycle frame arena: any containers which used the arena have been cleared by now.
+	frame.frameArena->reset();
+
+	LE_SETTING( bool, LE_SETTING_PRINT_FRAME_ARENA_STATS, false );
+
+	if ( *LE_SETTING_PRINT_FRAME_ARENA_STATS ) [[unlikely]] {
+		logger.info( "Backend frame arena    : %8zu Bytes used, %8zu Bytes capacity, %zu arena block allocations",
+		             frame.frameArena->get_num_bytes_used(),
+		             frame.frameArena->get_capacity(),
+		             frame.frameArena->get_num_heap_allocations() );
+	}
+
 	frame.frameNumber = self->mFramesCount++; // note post-increment
 
 	return true;
 };
-// ----------------------------------------------------------------------
-// we use this to mask out any reads in srcAccess, as it never makes sense to flush reads
-static constexpr auto ANY_WRITE_VK_ACCESS_2_FLAGS =
-    ( VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
-      VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
-      VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR |
-      VK_ACCESS_2_HOST_WRITE_BIT |
-      VK_ACCESS_2_MEMORY_WRITE_BIT |
-      VK_ACCESS_2_SHADER_WRITE_BIT |
-      VK_ACCESS_2_TRANSFER_WRITE_BIT |
-      VK_ACCESS_2_COMMAND_PREPROCESS_WRITE_BIT_NV |
-      VK_ACCESS_2_TRANSFORM_FEEDBACK_COUNTER_WRITE_BIT_EXT );
-
 // ----------------------------------------------------------------------
 // Executes on the DISPATCH FRAME
 //
-static void backend_create_renderpasses( BackendFrameData& frame, VkDevice& device ) {
+static void backend_create_renderpasses( le_backend_o* self, BackendFrameData& frame, VkDevice& device ) {
 
 	static auto logger = LeLog( LOGGER_LABEL );
 
+	// -- evict cached objects which have not been used for a while
+	backend_render_object_cache_collect_garbage( self, device, frame.frameNumber );
+
 	// create renderpasses
 	const auto& syncChainTable = frame.syncChainTable;
 
@@ -2143,12 +3460,13 @@ static void backend_create_renderpasses( BackendFrameData& frame, VkDevice& devi
 
 		// ---------| Invariant: current pass is a draw pass.
 
-		std::vector<VkAttachmentDescription2> attachments;
+		std::pmr::vector<VkAttachmentDescription2> attachments( frame.frameArena );
 		attachments.reserve( pass.numColorAttachments + pass.numDepthStencilAttachments );
 
-		std::vector<VkAttachmentReference2> colorAttachmentReferences;
-		std::vector<VkAttachmentReference2> resolveAttachmentReferences;
-		VkAttachmentReference2*             dsAttachmentReference = nullptr;
+		std::pmr::vector<VkAttachmentReference2> colorAttachmentReferences( frame.frameArena );
+		std::pmr::vector<VkAttachmentReference2> resolveAttachmentReferences( frame.frameArena );
+		VkAttachmentReference2                   dsAttachmentReferenceStorage{};
+		VkAttachmentReference2*                  dsAttachmentReference = nullptr; // points to dsAttachmentReferenceStorage if pass has a depth stencil attachment
 
 		// We must accumulate these flags over all attachments - they are the
 		// union of all flags required by all attachments in a pass.
@@ -2174,7 +3492,7 @@ static void backend_create_renderpasses( BackendFrameData& frame, VkDevice& devi
 
 		for ( AttachmentInfo const* attachment = pass.attachments; attachment != attachments_end; attachment++ ) {
 
-			auto& syncChain = syncChainTable.at( attachment->resource );
+			auto& syncChain = syncChainTable[ attachment->resource_index ];
 
 			const auto& syncInitial = syncChain.at( attachment->initialStateOffset );
 			const auto& syncSubpass = syncChain.at( attachment->initialStateOffset + 1 );
@@ -2213,13 +3531,14 @@ static void backend_create_renderpasses( BackendFrameData& frame, VkDevice& devi
 
 			switch ( attachment->type ) {
 			case AttachmentInfo::Type::eDepthStencilAttachment:
-				dsAttachmentReference = new VkAttachmentReference2{
+				dsAttachmentReferenceStorage = {
 				    .sType      = VK_STRUCTURE_TYPE_ATTACHMENT_REFERENCE_2,
 				    .pNext      = nullptr, // optional
 				    .attachment = uint32_t( attachments.size() - 1 ),
 				    .layout     = syncSubpass.layout,
 				    .aspectMask = 0,
-				}; // cleanup at the end of loop
+				};
+				dsAttachmentReference = &dsAttachmentReferenceStorage;
 				break;
 			case AttachmentInfo::Type::eColorAttachment:
 				colorAttachmentReferences.push_back( {
@@ -2264,7 +3583,7 @@ static void backend_create_renderpasses( BackendFrameData& frame, VkDevice& devi
 			logger.info( "" );
 		}
 
-		std::vector<VkSubpassDescription2> subpasses;
+		std::pmr::vector<VkSubpassDescription2> subpasses( frame.frameArena );
 		subpasses.reserve( 1 );
 
 		{
@@ -2453,21 +3772,59 @@ static void backend_create_renderpasses( BackendFrameData& frame, VkDevice& devi
 			    .pCorrelatedViewMasks    = 0,
 			};
 
-			// Create vulkan renderpass object
+			// -- Build hash over everything which goes into the renderpass create info
+			//
+			// Unlike the hash for compatible renderpasses, this must include load and store
+			// ops, layouts, and subpass dependencies: two renderpasses with the same key are
+			// identical, and we may use one in place of the other.
 
-			vkCreateRenderPass2( device, &renderpassCreateInfo, nullptr, &pass.renderPass );
+			uint64_t rp_cache_key = pass.renderpassHash;
 
-			delete dsAttachmentReference; // noo-op if nullptr; we clean up here in case we allocated a
-			                              // depth stencil attachment reference above.
-			                              // Once createRenderPass has consumed the data, we can safely delete.
+			for ( auto const& a : attachments ) {
+				rp_cache_key = SpookyHash::Hash64(
+				    &a.flags,
+				    offsetof( VkAttachmentDescription2, finalLayout ) + sizeof( VkAttachmentDescription2::finalLayout ) - offsetof( VkAttachmentDescription2, flags ),
+				    rp_cache_key );
+			}
 
-			AbstractPhysicalResource rp;
-			rp.type         = AbstractPhysicalResource::eRenderPass;
-			rp.asRenderPass = pass.renderPass;
+			for ( auto const& s : subpasses ) {
+				auto hash_attachment_references = []( VkAttachmentReference2 const* pAttachmentRefs, uint32_t count, uint64_t seed ) -> uint64_t {
+					if ( pAttachmentRefs == nullptr ) {
+						return seed;
+					}
+					for ( auto const* pAr = pAttachmentRefs; pAr != pAttachmentRefs + count; pAr++ ) {
+						seed = SpookyHash::Hash64( &pAr->attachment, sizeof( VkAttachmentReference2::attachment ), seed );
+						seed = SpookyHash::Hash64( &pAr->layout, sizeof( VkAttachmentReference2::layout ), seed );
+					}
+					return seed;
+				};
+				rp_cache_key = hash_attachment_references( s.pColorAttachments, s.colorAttachmentCount, rp_cache_key );
+				rp_cache_key = hash_attachment_references( s.pResolveAttachments, s.colorAttachmentCount, rp_cache_key );
+				rp_cache_key = hash_attachment_references( s.pDepthStencilAttachment, 1, rp_cache_key );
+			}
+
+			for ( auto const& b : memoryBarriers ) {
+				rp_cache_key = SpookyHash::Hash64(
+				    &b.srcStageMask,
+				    offsetof( VkMemoryBarrier2, dstAccessMask ) + sizeof( VkMemoryBarrier2::dstAccessMask ) - offsetof( VkMemoryBarrier2, srcStageMask ),
+				    rp_cache_key );
+			}
+
+			{
+				auto& cache = self->render_object_cache;
+				auto  lock  = std::unique_lock( cache.mtx );
+
+				auto [ entry, was_inserted ] = cache.render_passes.try_emplace( rp_cache_key );
 
-			// Add vulkan renderpass object to list of owned and life-time tracked resources, so that
-			// it can be recycled when not needed anymore.
-			frame.ownedResources.emplace_front( std::move( rp ) );
+				if ( was_inserted ) {
+					// Create vulkan renderpass object - it is owned by the cache, which destroys it
+					// once it has not been used for a number of frames.
+					vkCreateRenderPass2( device, &renderpassCreateInfo, nullptr, &entry->second.render_pass );
+				}
+
+				entry->second.last_used_frame = frame.frameNumber;
+				pass.renderPass               = entry->second.render_pass;
+			}
 		}
 	} // end for each pass
 }
@@ -2489,6 +3846,14 @@ static inline VkBuffer frame_data_get_buffer_from_le_resource_id( const BackendF
 	}
 }
 
+// ----------------------------------------------------------------------
+/// \brief offset into vkBuffer at which memory for the given staging resource starts -
+/// staging memory may be sub-allocated from the staging ring.
+static inline uint64_t frame_data_get_staging_buffer_offset( const BackendFrameData& frame, const le_buf_resource_handle& buffer ) {
+	assert( buffer->data->flags == uint8_t( le_buf_resource_usage_flags_t::eIsStaging ) );
+	return frame.stagingAllocator->offsets[ buffer->data->index ];
+}
+
 // ----------------------------------------------------------------------
 static inline VkImage frame_data_get_image_from_le_resource_id( const BackendFrameData& frame, const le_img_resource_handle& img ) {
 	return frame.availableResources.at( img ).as.image;
@@ -2499,12 +3864,6 @@ static inline VkFormat frame_data_get_image_format_from_resource_id( BackendFram
 	return frame.availableResources.at( img ).info.imageInfo.format;
 }
 
-// ----------------------------------------------------------------------
-
-static inline AllocatedResourceVk const& frame_data_get_allocated_resource_from_resource_id( BackendFrameData& frame, const le_resource_handle& rsp ) {
-	return frame.availableResources.at( rsp );
-}
-
 // ----------------------------------------------------------------------
 // if specific format for texture was not specified, return format of referenced image
 static inline VkFormat frame_data_get_image_format_from_texture_info( BackendFrameData const& frame, le_image_sampler_info_t const& texInfo ) {
@@ -2542,8 +3901,13 @@ VkImageAspectFlags get_aspect_flags_from_format( le::Format const& format ) {
 // Executes on the DISPATCH FRAME
 //
 // input: Pass
-// output: framebuffer, append newly created imageViews to retained resources list.
-static void backend_create_frame_buffers( BackendFrameData& frame, VkDevice& device ) {
+// output: framebuffer
+//
+// Framebuffers, and the image views for their attachments, are cached across frames,
+// indexed by renderpass, extent, and attachment images. Cached framebuffers get
+// evicted if they have not been used for a while, or if any of their images are
+// about to be destroyed.
+static void backend_create_frame_buffers( le_backend_o* self, BackendFrameData& frame, VkDevice& device ) {
 
 	for ( auto& pass : frame.passes ) {
 
@@ -2555,10 +3919,46 @@ static void backend_create_frame_buffers( BackendFrameData& frame, VkDevice& dev
 		                           pass.numResolveAttachments +
 		                           pass.numDepthStencilAttachments;
 
-		std::vector<VkImageView> framebufferAttachments;
-		framebufferAttachments.reserve( attachmentCount );
-
 		auto const attachment_end = pass.attachments + attachmentCount;
+
+		// -- Build cache key for this framebuffer
+
+		uint64_t fb_cache_key = 0;
+		{
+			uint64_t key_data[ 3 ] = {
+			    reinterpret_cast<uint64_t>( pass.renderPass ),
+			    pass.width,
+			    pass.height,
+			};
+			fb_cache_key = SpookyHash::Hash64( key_data, sizeof( key_data ), 0 );
+
+			for ( AttachmentInfo const* attachment = pass.attachments; attachment != attachment_end; attachment++ ) {
+				uint64_t attachment_data[ 2 ] = {
+				    reinterpret_cast<uint64_t>( frame.resourceAllocations[ attachment->resource_index ]->as.image ),
+				    uint64_t( attachment->format ),
+				};
+				fb_cache_key = SpookyHash::Hash64( attachment_data, sizeof( attachment_data ), fb_cache_key );
+			}
+		}
+
+		auto& cache = self->render_object_cache;
+		auto  lock  = std::unique_lock( cache.mtx );
+
+		auto [ entry, was_inserted ] = cache.framebuffers.try_emplace( fb_cache_key );
+
+		entry->second.last_used_frame = frame.frameNumber;
+
+		if ( !was_inserted ) {
+			pass.framebuffer = entry->second.framebuffer;
+			continue;
+		}
+
+		// ---------| invariant: framebuffer is not in cache - we must create it
+
+		entry->second.render_pass = pass.renderPass;
+		entry->second.images.reserve( attachmentCount );
+		entry->second.image_views.reserve( attachmentCount );
+
 		for ( AttachmentInfo const* attachment = pass.attachments; attachment != attachment_end; attachment++ ) {
 
 			VkImageSubresourceRange subresourceRange{
@@ -2569,7 +3969,7 @@ static void backend_create_frame_buffers( BackendFrameData& frame, VkDevice& dev
 			    .layerCount     = 1,
 			};
 
-			VkImage img = frame_data_get_image_from_le_resource_id( frame, attachment->resource );
+			VkImage img = frame.resourceAllocations[ attachment->resource_index ]->as.image;
 
 			VkImageViewCreateInfo imageViewCreateInfo{
 			    .sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
@@ -2588,18 +3988,9 @@ static void backend_create_frame_buffers( BackendFrameData& frame, VkDevice& dev
 				assert( result == VK_SUCCESS );
 			}
 
-			framebufferAttachments.push_back( imageView );
-
-			{
-				// Retain imageviews in owned resources - they will be released
-				// once not needed anymore.
-
-				AbstractPhysicalResource iv;
-				iv.type        = AbstractPhysicalResource::eImageView;
-				iv.asImageView = imageView;
-
-				frame.ownedResources.emplace_front( std::move( iv ) );
-			}
+			// Image views are owned by the cache entry, and destroyed together with the framebuffer.
+			entry->second.images.push_back( img );
+			entry->second.image_views.push_back( imageView );
 		}
 
 		VkFramebufferCreateInfo framebufferCreateInfo{
@@ -2608,90 +3999,260 @@ static void backend_create_frame_buffers( BackendFrameData& frame, VkDevice& dev
 		    .flags           = 0,       // optional
 		    .renderPass      = pass.renderPass,
 		    .attachmentCount = attachmentCount, // optional
-		    .pAttachments    = framebufferAttachments.data(),
+		    .pAttachments    = entry->second.image_views.data(),
 		    .width           = pass.width,
 		    .height          = pass.height,
 		    .layers          = 1,
 		};
 
-		auto result = vkCreateFramebuffer( device, &framebufferCreateInfo, nullptr, &pass.framebuffer );
+		auto result = vkCreateFramebuffer( device, &framebufferCreateInfo, nullptr, &entry->second.framebuffer );
 		assert( result == VK_SUCCESS && "Framebuffer must be valid" );
-		{
-			// Retain framebuffer
 
-			AbstractPhysicalResource fb;
-			fb.type          = AbstractPhysicalResource::eFramebuffer;
-			fb.asFramebuffer = pass.framebuffer;
+		pass.framebuffer = entry->second.framebuffer;
+	}
+}
 
-			frame.ownedResources.emplace_front( std::move( fb ) );
+// ----------------------------------------------------------------------
+// Creates a descriptor pool with space for `max_sets` descriptor sets, and for
+// `descriptor_counts[i]` descriptors of type DESCRIPTOR_POOL_TYPES[i].
+static VkDescriptorPool descriptor_pool_create( VkDevice device, std::array<uint32_t, DESCRIPTOR_POOL_TYPE_COUNT> const& descriptor_counts, uint32_t max_sets ) {
+
+	std::array<VkDescriptorPoolSize, DESCRIPTOR_POOL_TYPE_COUNT> descriptorPoolSizes;
+	uint32_t                                                     descriptorPoolSizeCount = 0;
+
+	for ( size_t i = 0; i != DESCRIPTOR_POOL_TYPE_COUNT; i++ ) {
+		if ( descriptor_counts[ i ] ) {
+			descriptorPoolSizes[ descriptorPoolSizeCount++ ] = {
+			    .type            = DESCRIPTOR_POOL_TYPES[ i ],
+			    .descriptorCount = descriptor_counts[ i ],
+			};
 		}
 	}
+
+	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{
+	    .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+	    .pNext         = nullptr, // optional
+	    .flags         = 0,       // optional
+	    .maxSets       = max_sets,
+	    .poolSizeCount = descriptorPoolSizeCount,
+	    .pPoolSizes    = descriptorPoolSizes.data(),
+	};
+
+	VkDescriptorPool descriptorPool = nullptr;
+
+	auto result = vkCreateDescriptorPool( device, &descriptorPoolCreateInfo, nullptr, &descriptorPool );
+	assert( result == VK_SUCCESS );
+
+	return descriptorPool;
+}
+
+// ----------------------------------------------------------------------
+// Creates a descriptor pool with space for a generous amount of descriptors - we use this
+// for as long as we don't know how many descriptors a frame is going to use, and when a
+// frame runs out of space in its descriptor pool.
+static VkDescriptorPool descriptor_pool_create_default( VkDevice device, std::array<uint32_t, DESCRIPTOR_POOL_TYPE_COUNT>* capacity = nullptr, uint32_t* max_sets = nullptr ) {
+
+	std::array<uint32_t, DESCRIPTOR_POOL_TYPE_COUNT> descriptor_counts;
+	descriptor_counts.fill( 1000 ); // 1000 descriptors of each type
+
+	if ( capacity ) {
+		*capacity = descriptor_counts;
+	}
+	if ( max_sets ) {
+		*max_sets = 2000;
+	}
+
+	return descriptor_pool_create( device, descriptor_counts, 2000 );
 }
 
 // ----------------------------------------------------------------------
 // Executes on the DISPATCH FRAME
 //
-static void backend_create_descriptor_pools( BackendFrameData& frame, VkDevice& device, size_t numRenderPasses ) {
-
-	// Make sure that there is one descriptorpool for every renderpass.
-	// descriptor pools which were created previously will be re-used,
-	// if we're suddenly rendering more frames, we will add additional
-	// descriptorPools.
-
-	// At this point it would be nice to have an idea for each renderpass
-	// on how many descriptors to expect, but we cannot know that realistically
-	// without going through the command buffer... yuck.
-
-	// This is why we're creating space for a generous amount of descriptors
-	// hoping we're not running out when assembling the command buffer.
-
-	constexpr VkDescriptorType DESCRIPTOR_TYPES[] = {
-	    VK_DESCRIPTOR_TYPE_SAMPLER,
-	    VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-	    VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
-	    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-	    VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,
-	    VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER,
-	    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-	    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-	    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
-	    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
-	    VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT,
-	    VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT,
-	    VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
+// Makes sure that the frame has a descriptor pool which can hold the descriptor
+// sets which this frame is likely to use.
+//
+// Descriptor sets cached with the frame get re-used across frames, and we keep
+// them for as long as we can. We only reset the descriptor pool (which frees all
+// cached descriptor sets) if:
+//
+// + any vk object which descriptors may refer to has been destroyed since the
+//   cache was last validated - a new object might re-use its handle,
+// + the previous frame ran out of space in its pool and had to add more pools,
+// + most cached descriptor sets were not used by the previous frame, or
+// + the pool is much larger than what the previous frame needed.
+//
+// Pools get re-created with a size based on the number of descriptors which the
+// previous frame actually used. Only the first pool of a frame, for which we
+// can't know demand in advance, is created with a generous default size.
+//
+// Must execute after any vk objects which this frame releases have been destroyed,
+// i.e. after backend_create_renderpasses, which collects garbage.
+static void backend_create_descriptor_pools( le_backend_o* self, BackendFrameData& frame, VkDevice& device ) {
+
+	constexpr uint32_t HEADROOM_FACTOR = 2;  // multiple of previously used descriptors which we reserve when we re-create a pool
+	constexpr uint32_t MIN_CAPACITY    = 16; // minimum number of descriptors per type, and of sets, which we reserve when we re-create a pool
+
+	auto get_target_capacity = []( uint32_t demand ) -> uint32_t {
+		return std::max( demand * HEADROOM_FACTOR, MIN_CAPACITY );
 	};
 
-	constexpr size_t DESCRIPTOR_TYPE_COUNT = sizeof( DESCRIPTOR_TYPES ) / sizeof( VkDescriptorType );
+	uint64_t const generation = self->descriptor_resource_generation.load();
 
-	for ( ; frame.descriptorPools.size() < numRenderPasses; ) {
+	bool must_recreate_pool =
+	    frame.descriptorPools.size() != 1 ||
+	    frame.descriptorSetCache.size() > HEADROOM_FACTOR * frame.descriptorSetDemand + MIN_CAPACITY ||
+	    frame.descriptorPoolMaxSets > HEADROOM_FACTOR * get_target_capacity( frame.descriptorSetDemand );
 
-		std::vector<VkDescriptorPoolSize> descriptorPoolSizes;
+	for ( size_t i = 0; i != DESCRIPTOR_POOL_TYPE_COUNT && !must_recreate_pool; i++ ) {
+		must_recreate_pool = frame.descriptorPoolCapacity[ i ] > HEADROOM_FACTOR * get_target_capacity( frame.descriptorDemand[ i ] );
+	}
+
+	if ( must_recreate_pool ) {
 
-		descriptorPoolSizes.reserve( DESCRIPTOR_TYPE_COUNT );
+		bool const is_first_pool = frame.descriptorPools.empty();
 
-		for ( auto i : DESCRIPTOR_TYPES ) {
-			descriptorPoolSizes.push_back( {
-			    .type            = i,
-			    .descriptorCount = 1000,
-			} ); // 1000 descriptors of each type
+		for ( auto& d : frame.descriptorPools ) {
+			vkDestroyDescriptorPool( device, d, nullptr );
 		}
 
-		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{
-		    .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-		    .pNext         = nullptr, // optional
-		    .flags         = 0,       // optional
-		    .maxSets       = 2000,
-		    .poolSizeCount = uint32_t( descriptorPoolSizes.size() ),
-		    .pPoolSizes    = descriptorPoolSizes.data(),
-		};
+		frame.descriptorPools.clear();
+		frame.descriptorSetCache.clear();
 
-		VkDescriptorPool descriptorPool = nullptr;
+		if ( is_first_pool ) {
+			frame.descriptorPools.push_back( descriptor_pool_create_default( device, &frame.descriptorPoolCapacity, &frame.descriptorPoolMaxSets ) );
+		} else {
+			for ( size_t i = 0; i != DESCRIPTOR_POOL_TYPE_COUNT; i++ ) {
+				frame.descriptorPoolCapacity[ i ] = get_target_capacity( frame.descriptorDemand[ i ] );
+			}
+			frame.descriptorPoolMaxSets = get_target_capacity( frame.descriptorSetDemand );
+			frame.descriptorPools.push_back( descriptor_pool_create( device, frame.descriptorPoolCapacity, frame.descriptorPoolMaxSets ) );
+		}
 
-		auto result = vkCreateDescriptorPool( device, &descriptorPoolCreateInfo, nullptr, &descriptorPool );
-		assert( result == VK_SUCCESS );
+	} else if ( generation != frame.descriptorSetCacheGeneration ) {
+		vkResetDescriptorPool( device, frame.descriptorPools.front(), VkDescriptorPoolResetFlags() );
+		frame.descriptorSetCache.clear();
+	}
 
-		frame.descriptorPools.emplace_back( std::move( descriptorPool ) );
+	frame.descriptorSetCacheGeneration = generation;
+	frame.descriptorSetDemand          = 0;
+	frame.descriptorDemand.fill( 0 );
+}
+
+// ----------------------------------------------------------------------
+// Bindless mode only: writes descriptors for all textures, and buffers which have
+// a bindless index, and which this frame uses, into the frame's bindless descriptor set.
+// We only write slots whose contents have changed since the frame was last used.
+//
+// Must execute after backend_create_renderpasses, which collects garbage, so that
+// we can detect whether any vk objects which slots refer to have been destroyed.
+static void frame_update_bindless_descriptors( le_backend_o* self, BackendFrameData& frame, VkDevice const& device ) {
+
+	if ( nullptr == frame.bindlessDescriptorSet ) {
+		return;
+	}
+
+	// ----------| invariant: bindless mode is enabled
+
+	uint64_t const generation = self->descriptor_resource_generation.load();
+
+	if ( generation != frame.bindlessGeneration ) {
+		// Objects which slots refer to may have been destroyed - and their handles re-used:
+		// we must write all slots again. Stale slots don't need clearing, as the set is partially bound.
+		std::fill( frame.bindlessTextures.begin(), frame.bindlessTextures.end(), BackendFrameData::Texture{} );
+		std::fill( frame.bindlessBuffers.begin(), frame.bindlessBuffers.end(), VkBuffer( nullptr ) );
+		frame.bindlessGeneration = generation;
 	}
+
+	std::pmr::vector<std::pair<uint32_t, VkDescriptorImageInfo>>  image_infos( frame.frameArena );  // slot, descriptor
+	std::pmr::vector<std::pair<uint32_t, VkDescriptorBufferInfo>> buffer_infos( frame.frameArena ); // slot, descriptor
+
+	{
+		auto lock = std::unique_lock( self->bindless.mtx );
+
+		frame.bindlessTextures.resize( self->bindless.texture_indices.size() );
+		frame.bindlessBuffers.resize( self->bindless.buffer_indices.size() );
+
+		for ( auto const& textures : frame.textures_per_pass ) {
+			for ( auto const& [ texture, tex ] : textures ) {
+
+				auto found_index = self->bindless.texture_indices.find( texture );
+
+				if ( found_index == self->bindless.texture_indices.end() ) {
+					continue;
+				}
+
+				auto& slot = frame.bindlessTextures[ found_index->second ];
+
+				if ( slot.sampler == tex.sampler && slot.imageView == tex.imageView ) {
+					continue;
+				}
+
+				slot = tex;
+				image_infos.push_back( { found_index->second, { tex.sampler, tex.imageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL } } );
+			}
+		}
+
+		for ( auto const& [ buffer, index ] : self->bindless.buffer_indices ) {
+
+			auto found_resource = frame.availableResources.find( buffer );
+
+			if ( found_resource == frame.availableResources.end() ||
+			     false == found_resource->second.info.isBuffer() ||
+			     0 == ( found_resource->second.info.bufferInfo.usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT ) ) {
+				continue;
+			}
+
+			VkBuffer vk_buffer = found_resource->second.as.buffer;
+
+			if ( frame.bindlessBuffers[ index ] == vk_buffer ) {
+				continue;
+			}
+
+			frame.bindlessBuffers[ index ] = vk_buffer;
+			buffer_infos.push_back( { index, { vk_buffer, 0, VK_WHOLE_SIZE } } );
+		}
+	}
+
+	if ( image_infos.empty() && buffer_infos.empty() ) {
+		return;
+	}
+
+	// ----------| invariant: there are slots to write
+
+	std::pmr::vector<VkWriteDescriptorSet> writes( frame.frameArena );
+	writes.reserve( image_infos.size() + buffer_infos.size() );
+
+	for ( auto const& [ index, info ] : image_infos ) {
+		writes.push_back( {
+		    .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+		    .pNext            = nullptr, // optional
+		    .dstSet           = frame.bindlessDescriptorSet,
+		    .dstBinding       = LE_BINDLESS_BINDING_TEXTURES,
+		    .dstArrayElement  = index,
+		    .descriptorCount  = 1,
+		    .descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+		    .pImageInfo       = &info,
+		    .pBufferInfo      = nullptr,
+		    .pTexelBufferView = nullptr,
+		} );
+	}
+
+	for ( auto const& [ index, info ] : buffer_infos ) {
+		writes.push_back( {
+		    .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+		    .pNext            = nullptr, // optional
+		    .dstSet           = frame.bindlessDescriptorSet,
+		    .dstBinding       = LE_BINDLESS_BINDING_BUFFERS,
+		    .dstArrayElement  = index,
+		    .descriptorCount  = 1,
+		    .descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+		    .pImageInfo       = nullptr,
+		    .pBufferInfo      = &info,
+		    .pTexelBufferView = nullptr,
+		} );
+	}
+
+	vkUpdateDescriptorSets( device, uint32_t( writes.size() ), writes.data(), 0, nullptr );
 }
 
 // ----------------------------------------------------------------------
@@ -2734,7 +4295,9 @@ static int32_t backend_allocate_image( le_backend_o*                  self,
 // ----------------------------------------------------------------------
 
 static void backend_destroy_image( le_backend_o* self, VkImage image, VmaAllocation allocation ) {
+	backend_render_object_cache_evict_image( self, image );
 	vmaDestroyImage( self->mAllocator, image, allocation );
+	self->descriptor_resource_generation++;
 }
 
 // ----------------------------------------------------------------------
@@ -2753,6 +4316,7 @@ static int32_t backend_allocate_buffer( le_backend_o*                  self,
 
 static void backend_destroy_buffer( le_backend_o* self, VkBuffer buffer, VmaAllocation allocation ) {
 	vmaDestroyBuffer( self->mAllocator, buffer, allocation );
+	self->descriptor_resource_generation++;
 }
 
 // ----------------------------------------------------------------------
@@ -3026,11 +4590,15 @@ static le_staging_allocator_o* staging_allocator_create( VmaAllocator const vmaA
 
 // ----------------------------------------------------------------------
 
-// Allocates a chunk of memory from the vulkan free store via vmaAlloc, and maps it
-// for writing at *pData.
+// Allocates a chunk of staging memory, mapped for writing at *pData.
+//
+// Memory is sub-allocated from the staging ring, which is persistent and persistently
+// mapped. Requests which don't fit into the ring (because they are larger than the ring,
+// or because the ring is full) fall back to a dedicated buffer, allocated via vmaAlloc.
 //
 // If successful, `resource_handle` receives a valid `le_resource_handle` referring to
-// this particular chunk of staging memory.
+// this particular chunk of staging memory. Staging memory for a handle does not
+// necessarily start at offset 0 of its vkBuffer - see frame_data_get_staging_buffer_offset.
 //
 // Returns false on error, true on success.
 //
@@ -3040,52 +4608,75 @@ static le_staging_allocator_o* staging_allocator_create( VmaAllocator const vmaA
 // Staging memory is typically cache coherent, ie. does not need to be flushed.
 static bool staging_allocator_map( le_staging_allocator_o* self, uint64_t numBytes, void** pData, le_buf_resource_handle* resource_handle ) {
 
-	auto lock = std::scoped_lock( self->mtx );
+	VmaAllocation allocation = nullptr; // handle to allocation, stays nullptr for ring sub-allocations
+	VkBuffer      buffer     = nullptr; // handle to buffer
+	uint64_t      offset     = 0;       // offset into buffer
+	void*         mappedData = nullptr; //
+	uint64_t      ring_end   = 0;       //
 
-	VmaAllocation     allocation; // handle to allocation
-	VkBuffer          buffer;     // handle to buffer (returned from vmaMemAlloc)
-	VmaAllocationInfo allocationInfo;
+	if ( self->ring && staging_ring_allocate( self->ring, numBytes, &offset, &ring_end ) ) {
 
-	VkBufferCreateInfo bufferCreateInfo{
-	    .sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-	    .pNext                 = nullptr, // optional
-	    .flags                 = 0,       // optional
-	    .size                  = numBytes,
-	    .usage                 = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-	    .sharingMode           = VK_SHARING_MODE_EXCLUSIVE,
-	    .queueFamilyIndexCount = 0, // optional
-	    .pQueueFamilyIndices   = 0,
-	};
+		buffer     = self->ring->buffer;
+		mappedData = self->ring->mapped_data + offset;
+
+		// Remember the end of our most recent sub-allocation, so that we can release ring memory on reset.
+		uint64_t mark = self->ring_release_mark.load( std::memory_order_relaxed );
+		while ( mark < ring_end && !self->ring_release_mark.compare_exchange_weak( mark, ring_end, std::memory_order_relaxed ) ) {
+		}
+
+	} else {
+
+		// -- Fall back to a dedicated buffer
+
+		VkBufferCreateInfo bufferCreateInfo{
+		    .sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+		    .pNext                 = nullptr, // optional
+		    .flags                 = 0,       // optional
+		    .size                  = numBytes,
+		    .usage                 = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		    .sharingMode           = VK_SHARING_MODE_EXCLUSIVE,
+		    .queueFamilyIndexCount = 0, // optional
+		    .pQueueFamilyIndices   = 0,
+		};
+
+		VmaAllocationCreateInfo allocationCreateInfo{};
+		allocationCreateInfo.flags          = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+		allocationCreateInfo.usage          = VMA_MEMORY_USAGE_CPU_ONLY;
+		allocationCreateInfo.preferredFlags = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
 
-	VmaAllocationCreateInfo allocationCreateInfo{};
-	allocationCreateInfo.flags          = VMA_ALLOCATION_CREATE_MAPPED_BIT;
-	allocationCreateInfo.usage          = VMA_MEMORY_USAGE_CPU_ONLY;
-	allocationCreateInfo.preferredFlags = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		VmaAllocationInfo allocationInfo;
 
-	auto result =
-	    vmaCreateBuffer(
-	        self->allocator,
-	        &bufferCreateInfo,
-	        &allocationCreateInfo,
-	        &buffer,
-	        &allocation,
-	        &allocationInfo );
+		auto result =
+		    vmaCreateBuffer(
+		        self->allocator,
+		        &bufferCreateInfo,
+		        &allocationCreateInfo,
+		        &buffer,
+		        &allocation,
+		        &allocationInfo );
 
-	assert( result == VK_SUCCESS );
+		assert( result == VK_SUCCESS );
 
-	if ( result != VK_SUCCESS ) {
-		return false;
+		if ( result != VK_SUCCESS ) {
+			return false;
+		}
+
+		mappedData = allocationInfo.pMappedData; // persistently mapped, because of VMA_ALLOCATION_CREATE_MAPPED_BIT
 	}
 
-	//---------- | Invariant: create buffer was successful.
+	//---------- | Invariant: we have staging memory.
 
 	{
 		// -- Now store our allocation in the allocations vectors.
+		auto lock = std::scoped_lock( self->mtx );
+
 		size_t allocationIndex = self->allocations.size();
 
 		self->allocations.push_back( allocation );
-		self->allocationInfo.push_back( allocationInfo );
 		self->buffers.emplace_back( buffer );
+		self->offsets.push_back( offset );
+		self->mappedData.push_back( mappedData );
+		self->mappedSize.push_back( numBytes );
 
 		// Staging resources share the same name, but their allocation index is different.
 		//
@@ -3111,34 +4702,62 @@ static bool staging_allocator_map( le_staging_allocator_o* self, uint64_t numByt
 		*resource_handle = staging_buffers[ allocationIndex ];
 	}
 
-	// Map memory so that it may be written to
-	vmaMapMemory( self->allocator, allocation, pData );
+	*pData = mappedData;
 
 	return true;
 };
 
+// ----------------------------------------------------------------------
+// Returns mapped memory for a staging buffer which was handed out by `map()` in the current frame.
+// Returns false if the resource handle does not refer to a staging buffer of this allocator.
+static bool staging_allocator_get_mapped_data( le_staging_allocator_o* self, le_buf_resource_handle resource_handle, void const** data, uint64_t* num_bytes ) {
+
+	auto lock = std::scoped_lock( self->mtx );
+
+	if ( resource_handle->data->flags != uint8_t( le_buf_resource_usage_flags_t::eIsStaging ) ||
+	     resource_handle->data->index >= self->mappedData.size() ) {
+		return false;
+	}
+
+	*data      = self->mappedData[ resource_handle->data->index ];
+	*num_bytes = self->mappedSize[ resource_handle->data->index ];
+
+	return true;
+}
+
 // ----------------------------------------------------------------------
 
-/// Frees all allocations held by the staging allocator given in `self`
+/// Frees all allocations held by the staging allocator given in `self` - call this only
+/// once the frame which used these allocations has crossed its fence.
 static void staging_allocator_reset( le_staging_allocator_o* self ) {
 	auto lock = std::scoped_lock( self->mtx );
 
-	assert( self->buffers.size() == self->allocations.size() && self->buffers.size() == self->allocationInfo.size() &&
-	        "buffers, allocations, and allocationInfos sizes must match." );
+	assert( self->buffers.size() == self->allocations.size() && self->buffers.size() == self->offsets.size() &&
+	        "buffers, allocations, and offsets sizes must match." );
 
-	// Since buffers were allocated using the VMA allocator,
+	// Since dedicated buffers were allocated using the VMA allocator,
 	// we cannot delete them directly using the device. We must delete them using the allocator,
 	// so that the allocator can track current allocations.
 
 	auto allocation = self->allocations.begin();
 	for ( auto b = self->buffers.begin(); b != self->buffers.end(); b++, allocation++ ) {
-		vmaUnmapMemory( self->allocator, *allocation );
-		vmaDestroyBuffer( self->allocator, *b, *allocation ); // implicitly calls vmaFreeMemory()
+		if ( *allocation ) {
+			vmaDestroyBuffer( self->allocator, *b, *allocation ); // implicitly calls vmaFreeMemory()
+		}
 	}
 
 	self->buffers.clear();
+	self->offsets.clear();
 	self->allocations.clear();
-	self->allocationInfo.clear();
+	self->mappedData.clear();
+	self->mappedSize.clear();
+
+	// -- release any ring memory which we sub-allocated
+	uint64_t ring_release_mark = self->ring_release_mark.exchange( 0 );
+
+	if ( self->ring && ring_release_mark ) {
+		staging_ring_release( self->ring, ring_release_mark );
+	}
 }
 
 // ----------------------------------------------------------------------
@@ -3155,10 +4774,29 @@ static void staging_allocator_destroy( le_staging_allocator_o* self ) {
 // ----------------------------------------------------------------------
 
 // Frees any resources which are marked for being recycled in the current frame.
-inline void frame_release_binned_resources( BackendFrameData& frame, VmaAllocator& allocator ) {
+inline void frame_release_binned_resources( le_backend_o* self, BackendFrameData& frame, VmaAllocator& allocator ) {
+
+	if ( !frame.binnedResources.empty() ) {
+		// Descriptor sets which were cached by any frame may refer to resources which we are about to destroy.
+		self->descriptor_resource_generation++;
+	}
+
 	for ( auto& a : frame.binnedResources ) {
 		if ( a.second.info.isBuffer() ) {
 			vmaDestroyBuffer( allocator, a.second.as.buffer, a.second.allocation );
+			continue;
+		}
+
+		// --------| invariant: resource is an image
+
+		// Cached framebuffers must not refer to images which get destroyed.
+		backend_render_object_cache_evict_image( self, a.second.as.image );
+
+		if ( a.second.alias_block ) {
+			// Memory for aliased images is owned by their memory block,
+			// which gets freed once no more images are bound to it.
+			vmaDestroyImage( allocator, a.second.as.image, nullptr );
+			a.second.alias_block->num_images--;
 		} else {
 			vmaDestroyImage( allocator, a.second.as.image, a.second.allocation );
 		}
@@ -3251,10 +4889,10 @@ static inline void consolidate_resource_info_into( le_resource_info_t& lhs, le_r
 //
 // should return a map of all resources used in all passes, with consolidated infos per-resource.
 static void collect_resource_infos_per_resource(
-    le_renderpass_o const* const*                                     passes,
-    size_t                                                            numRenderPasses,
-    std::unordered_map<le_resource_handle, le_resource_info_t> const& frame_declared_resources, // | pre-declared resources (declared via module)
-    std::unordered_map<le_resource_handle, le_resource_info_t>&       active_resources ) {
+    le_renderpass_o const* const*                                          passes,
+    size_t                                                                 numRenderPasses,
+    std::pmr::unordered_map<le_resource_handle, le_resource_info_t> const& frame_declared_resources, // | pre-declared resources (declared via module)
+    std::pmr::unordered_map<le_resource_handle, le_resource_info_t>&       active_resources ) {
 
 	using namespace le_renderer;
 
@@ -3337,6 +4975,14 @@ static void collect_resource_infos_per_resource(
 				}
 
 			} else if ( resourceInfo.type == LeResourceType::eBuffer ) {
+
+				auto& bufInfo = resourceInfo.buffer;
+
+				if ( p_resources_access_flags[ i ] & le::AccessFlagBits2::eIndirectCommandRead ) {
+					// automatically detect usage as source of indirect draw parameters
+					bufInfo.usage |= le::BufferUsageFlagBits::eIndirectBuffer;
+				}
+
 			} else if ( resourceInfo.type == LeResourceType::eRtxBlas ) {
 			} else if ( resourceInfo.type == LeResourceType::eRtxTlas ) {
 			} else {
@@ -3375,11 +5021,11 @@ static void collect_resource_infos_per_resource(
 // ----------------------------------------------------------------------
 
 static void insert_msaa_versions(
-    std::unordered_map<le_resource_handle, le_resource_info_t>& active_resources ) {
+    std::pmr::unordered_map<le_resource_handle, le_resource_info_t>& active_resources ) {
 	// For each image resource which is specified with versions of additional sample counts
 	// we create additional resource_ids (by patching in the sample count), and add matching
 	// resource info, so that multisample versions of image resources can be allocated dynamically.
-	std::unordered_map<le_resource_handle, le_resource_info_t> extra_resources;
+	std::pmr::unordered_map<le_resource_handle, le_resource_info_t> extra_resources( active_resources.get_allocator() );
 
 	for ( auto const& ar : active_resources ) {
 		if ( ar.first->data->type != LeResourceType::eImage ) {
@@ -3530,7 +5176,7 @@ static void patchImageUsageForMipLevels( ResourceCreateInfo* createInfo ) {
 
 // ----------------------------------------------------------------------
 
-static void frame_resources_set_debug_names( le_backend_vk_instance_o* instance, VkDevice device_, BackendFrameData::ResourceMap_T& resources ) {
+static void frame_resources_set_debug_names( le_backend_vk_instance_o* instance, VkDevice device_, BackendFrameData::FrameResourceMap_T& resources ) {
 	static auto logger = LeLog( LOGGER_LABEL );
 
 	// We capture the check for extension as a static, as this is not expected to
@@ -3586,6 +5232,327 @@ static void frame_resources_set_debug_names( le_backend_vk_instance_o* instance,
 	}
 }
 
+// ----------------------------------------------------------------------
+// Lifetime of a transient image within the current frame, expressed as
+// a closed interval of indices into the (ordered) list of passes.
+struct TransientImageLifetime {
+	uint32_t            first_pass    = ~0u;
+	uint32_t            last_pass     = 0;
+	le::RootPassesField affinity      = 0;     // union of root affinities of all passes which use this image
+	bool                used_by_async = false; // whether any async compute pass uses this image
+	bool                used_by_main  = false; // whether any pass which is not async compute uses this image
+};
+
+static inline bool transient_image_lifetimes_overlap( TransientImageLifetime const& lhs, TransientImageLifetime const& rhs ) {
+	// Passes which contribute to different roots may end up on different queues, and
+	// therefore may execute concurrently - we treat these as if their lifetimes overlapped.
+	//
+	// The same applies to async compute passes, which execute on a separate queue, concurrently
+	// with main passes of the same subgraph - irrespective of their pass indices.
+	return lhs.affinity != rhs.affinity ||
+	       ( lhs.used_by_async && rhs.used_by_main ) ||
+	       ( lhs.used_by_main && rhs.used_by_async ) ||
+	       !( lhs.last_pass < rhs.first_pass || rhs.last_pass < lhs.first_pass );
+}
+
+// ----------------------------------------------------------------------
+
+static inline bool resource_is_transient_image( le_resource_handle const& resource ) {
+	return resource->data->type == LeResourceType::eImage &&
+	       ( resource->data->flags & le_img_resource_usage_flags_t::eIsTransient );
+}
+
+// ----------------------------------------------------------------------
+// Frees any transient memory blocks which have no images bound to them anymore.
+static void backend_release_unused_transient_memory_blocks( le_backend_o* self ) {
+	auto& blocks = self->transient_memory_blocks;
+	for ( auto it = blocks.begin(); it != blocks.end(); ) {
+		if ( ( *it )->num_images == 0 ) {
+			vmaFreeMemory( self->mAllocator, ( *it )->allocation );
+			delete *it;
+			it = blocks.erase( it );
+		} else {
+			++it;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+// Executes on the DISPATCH FRAME, as part of backend_allocate_resources, while
+// holding the lock on backend resources.
+//
+// Transient images don't need to preserve their contents outside of the passes
+// which use them. We calculate for each transient image the interval of passes
+// during which it is alive, and then pack images with non-overlapping intervals
+// into shared blocks of device memory.
+//
+// Blocks, and the images bound to them, persist across frames. We re-use an
+// image from a previous frame for as long as its create info is compatible and
+// its lifetime does not overlap with any other image which is bound to the same
+// block in the current frame - otherwise, we bin it and bind a new image.
+//
+// Since images sharing memory start their lives in undefined layout, each
+// transient image receives an aliasing barrier before its first use, see
+// backend_acquire_physical_resources.
+static void backend_allocate_transient_images( le_backend_o*                                                          self,
+                                               BackendFrameData&                                                      frame,
+                                               std::unordered_map<le_resource_handle, AllocatedResourceVk>&           backendResources,
+                                               std::pmr::unordered_map<le_resource_handle, le_resource_info_t> const& active_resources,
+                                               le_renderpass_o**                                                      passes,
+                                               size_t                                                                 numRenderPasses ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	LE_SETTING( bool, LE_SETTING_ENABLE_TRANSIENT_IMAGE_ALIASING, true );
+
+	using namespace le_renderer;
+
+	// -- Calculate lifetimes for all transient images used in this frame
+
+	std::pmr::unordered_map<le_resource_handle, TransientImageLifetime> lifetimes( frame.frameArena );
+
+	for ( uint32_t i = 0; i != numRenderPasses; i++ ) {
+
+		le_resource_handle const* resources        = nullptr;
+		le::AccessFlags2 const*   resources_access = nullptr;
+		size_t                    resources_count  = 0;
+		renderpass_i.get_used_resources( passes[ i ], &resources, &resources_access, &resources_count );
+
+		le::QueueFlagBits   pass_type{};
+		le::RootPassesField pass_affinity = 0;
+		renderpass_i.get_queue_sumbission_info( passes[ i ], &pass_type, &pass_affinity );
+
+		bool pass_is_async_compute = false;
+		bool pass_waits_for_async  = false;
+		renderpass_i.get_async_compute_info( passes[ i ], &pass_is_async_compute, &pass_waits_for_async );
+
+		for ( size_t r = 0; r != resources_count; r++ ) {
+			if ( !resource_is_transient_image( resources[ r ] ) ) {
+				continue;
+			}
+			auto& lifetime      = lifetimes[ resources[ r ] ];
+			lifetime.first_pass = std::min( lifetime.first_pass, i );
+			lifetime.last_pass  = std::max( lifetime.last_pass, i );
+			lifetime.affinity |= pass_affinity;
+			lifetime.used_by_async |= pass_is_async_compute;
+			lifetime.used_by_main |= !pass_is_async_compute;
+		}
+	}
+
+	struct TransientImage {
+		le_resource_handle     resource;
+		ResourceCreateInfo     create_info;
+		TransientImageLifetime lifetime;
+		VkImage                image;               // only used for images which need allocating
+		VkMemoryRequirements   memory_requirements; // only used for images which need allocating
+	};
+
+	std::pmr::vector<TransientImage> images_to_keep( frame.frameArena );     // compatible images from an earlier frame
+	std::pmr::vector<TransientImage> images_to_allocate( frame.frameArena ); // images which must be (re-)allocated
+
+	// Occupancy for each block: lifetimes of all images bound to a block in the current frame.
+	std::pmr::unordered_map<TransientMemoryBlock*, std::pmr::vector<TransientImageLifetime>> block_occupancy( frame.frameArena );
+
+	auto block_can_fit_lifetime = [ &block_occupancy ]( TransientMemoryBlock* block, TransientImageLifetime const& lifetime ) -> bool {
+		auto it = block_occupancy.find( block );
+		if ( it == block_occupancy.end() ) {
+			return true;
+		}
+		for ( auto const& occupant : it->second ) {
+			if ( transient_image_lifetimes_overlap( occupant, lifetime ) ) {
+				return false;
+			}
+		}
+		return true;
+	};
+
+	auto block_add_occupant = [ &block_occupancy, &frame ]( TransientMemoryBlock* block, TransientImageLifetime const& lifetime ) {
+		auto it = block_occupancy.try_emplace( block, std::pmr::vector<TransientImageLifetime>( frame.frameArena ) ).first;
+		it->second.push_back( lifetime );
+	};
+
+	for ( auto const& [ resource, resourceInfo ] : active_resources ) {
+
+		if ( !resource_is_transient_image( resource ) ||
+		     frame.availableResources.find( resource ) != frame.availableResources.end() ) {
+			continue;
+		}
+
+		TransientImage img{
+		    .resource    = resource,
+		    .create_info = ResourceCreateInfo::from_le_resource_info( resourceInfo ),
+		    .lifetime    = lifetimes[ resource ],
+		};
+
+		if ( self->must_share_async_compute_resources_concurrently && img.lifetime.used_by_async ) {
+			img.create_info.set_sharing_mode_concurrent( self->async_compute_sharing_queue_family_indices, 2 );
+		}
+
+		patchImageUsageForMipLevels( &img.create_info );
+
+		if ( img.create_info.imageInfo.format == VK_FORMAT_UNDEFINED ) {
+			inferImageFormat( self, static_cast<le_img_resource_handle>( resource ), resourceInfo.image.usage, &img.create_info );
+		}
+
+		auto foundIt = backendResources.find( resource );
+
+		if ( foundIt != backendResources.end() && foundIt->second.info >= img.create_info ) {
+			images_to_keep.emplace_back( img );
+		} else {
+			images_to_allocate.emplace_back( img );
+		}
+	}
+
+	// -- Keep images from earlier frames if they still fit into their block.
+	//
+	// We place images in order of their first use, so that - if there is a conflict -
+	// the image which is used first keeps its memory.
+
+	std::sort( images_to_keep.begin(), images_to_keep.end(), []( TransientImage const& lhs, TransientImage const& rhs ) {
+		return lhs.lifetime.first_pass < rhs.lifetime.first_pass;
+	} );
+
+	// Note that this applies whether or not aliasing is enabled: without aliasing, each block
+	// holds a single image, which therefore always fits.
+
+	for ( auto const& img : images_to_keep ) {
+		auto const& allocated_image = backendResources.at( img.resource );
+		if ( block_can_fit_lifetime( allocated_image.alias_block, img.lifetime ) ) {
+			block_add_occupant( allocated_image.alias_block, img.lifetime );
+			frame.availableResources.emplace( img.resource, allocated_image );
+		} else {
+			images_to_allocate.emplace_back( img );
+		}
+	}
+
+	if ( images_to_allocate.empty() ) {
+		return;
+	}
+
+	// ----------| invariant: some images need to be (re-)allocated.
+
+	VkDevice device = self->device->getVkDevice();
+
+	for ( auto& img : images_to_allocate ) {
+		VkResult result = vkCreateImage( device, &img.create_info.imageInfo, nullptr, &img.image );
+		assert( result == VK_SUCCESS );
+		vkGetImageMemoryRequirements( device, img.image, &img.memory_requirements );
+	}
+
+	// Place largest images first, so that smaller images may share their blocks.
+	std::sort( images_to_allocate.begin(), images_to_allocate.end(), []( TransientImage const& lhs, TransientImage const& rhs ) {
+		return lhs.memory_requirements.size > rhs.memory_requirements.size;
+	} );
+
+	for ( auto const& img : images_to_allocate ) {
+
+		TransientMemoryBlock* block = nullptr;
+
+		if ( *LE_SETTING_ENABLE_TRANSIENT_IMAGE_ALIASING ) {
+			for ( auto const& b : self->transient_memory_blocks ) {
+				if ( ( img.memory_requirements.memoryTypeBits & ( 1u << b->allocationInfo.memoryType ) ) &&
+				     b->allocationInfo.size >= img.memory_requirements.size &&
+				     b->allocationInfo.offset % img.memory_requirements.alignment == 0 &&
+				     block_can_fit_lifetime( b, img.lifetime ) ) {
+					block = b;
+					break;
+				}
+			}
+		}
+
+		if ( nullptr == block ) {
+			// No existing block can take this image - we must allocate a new block.
+
+			VmaAllocationCreateInfo allocationCreateInfo{};
+			allocationCreateInfo.usage          = VMA_MEMORY_USAGE_GPU_ONLY;
+			allocationCreateInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+			block = new TransientMemoryBlock{
+			    .memoryRequirements = img.memory_requirements,
+			    .num_images         = 0,
+			};
+
+			VkResult result = vmaAllocateMemory( self->mAllocator, &img.memory_requirements, &allocationCreateInfo, &block->allocation, &block->allocationInfo );
+			assert( result == VK_SUCCESS );
+
+			self->transient_memory_blocks.push_back( block );
+		}
+
+		VkResult result = vmaBindImageMemory( self->mAllocator, block->allocation, img.image );
+		assert( result == VK_SUCCESS );
+
+		block->num_images++;
+		block_add_occupant( block, img.lifetime );
+
+		AllocatedResourceVk allocatedResource{};
+		allocatedResource.allocation     = block->allocation;
+		allocatedResource.allocationInfo = block->allocationInfo;
+		allocatedResource.as.image       = img.image;
+		allocatedResource.info           = img.create_info;
+		allocatedResource.alias_block    = block;
+
+		printResourceInfo( img.resource, allocatedResource.info, "ALIAS" );
+
+		auto foundIt = backendResources.find( img.resource );
+		if ( foundIt != backendResources.end() ) {
+			// Add old version of resource to the recycling bin - this will also release its claim on its memory block.
+			frame.binnedResources.try_emplace( img.resource, foundIt->second );
+		}
+
+		frame.availableResources.insert_or_assign( img.resource, allocatedResource );
+		backendResources.insert_or_assign( img.resource, allocatedResource );
+	}
+
+	LE_SETTING( bool, LE_SETTING_BACKEND_PRINT_TRANSIENT_IMAGE_STATS, false );
+
+	if ( *LE_SETTING_BACKEND_PRINT_TRANSIENT_IMAGE_STATS ) [[unlikely]] {
+		// Tell how much memory we saved by aliasing.
+
+		VkDeviceSize num_bytes_requested = 0;
+		for ( auto const& [ resource, lifetime ] : lifetimes ) {
+			auto it = frame.availableResources.find( resource );
+			if ( it != frame.availableResources.end() ) {
+				VkMemoryRequirements reqs;
+				vkGetImageMemoryRequirements( device, it->second.as.image, &reqs );
+				num_bytes_requested += reqs.size;
+			}
+		}
+
+		VkDeviceSize num_bytes_allocated = 0;
+		for ( auto const& b : self->transient_memory_blocks ) {
+			num_bytes_allocated += b->allocationInfo.size;
+		}
+
+		logger.info( "Transient images: %zu images requesting %llu bytes are bound to %zu memory blocks using %llu bytes.",
+		             lifetimes.size(), (unsigned long long)num_bytes_requested, self->transient_memory_blocks.size(), (unsigned long long)num_bytes_allocated );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Collects all resources which are used by async compute passes.
+static void collect_async_compute_resources( le_renderpass_o* const* passes, size_t numRenderPasses, std::pmr::unordered_set<le_resource_handle>& async_compute_resources ) {
+
+	using namespace le_renderer;
+
+	for ( auto rp = passes; rp != passes + numRenderPasses; rp++ ) {
+
+		bool is_async_compute = false;
+		renderpass_i.get_async_compute_info( *rp, &is_async_compute, nullptr );
+
+		if ( !is_async_compute ) {
+			continue;
+		}
+
+		le_resource_handle const* p_resources              = nullptr;
+		le::AccessFlags2 const*   p_resources_access_flags = nullptr;
+		size_t                    resources_count          = 0;
+
+		renderpass_i.get_used_resources( *rp, &p_resources, &p_resources_access_flags, &resources_count );
+
+		async_compute_resources.insert( p_resources, p_resources + resources_count );
+	}
+}
+
 // ----------------------------------------------------------------------
 // Executes on the DISPATCH FRAME
 // towards the start of backend_acquire_physical_resources
@@ -3625,7 +5592,7 @@ static void backend_allocate_resources( le_backend_o* self, BackendFrameData& fr
 	// It's possible that this was more than two frames ago,
 	// depending on how many swapchain images there are.
 	//
-	frame_release_binned_resources( frame, self->mAllocator );
+	frame_release_binned_resources( self, frame, self->mAllocator );
 
 	// Iterate over all resource declarations in all passes so that we can collect all resources,
 	// and their usage information. Later, we will consolidate their usages so that resources can
@@ -3636,7 +5603,7 @@ static void backend_allocate_resources( le_backend_o* self, BackendFrameData& fr
 	// before we make sure to we find a valid image format which matches all uses...
 	//
 
-	std::unordered_map<le_resource_handle, le_resource_info_t> active_resources;
+	std::pmr::unordered_map<le_resource_handle, le_resource_info_t> active_resources( frame.frameArena );
 
 	collect_resource_infos_per_resource(
 	    passes, numRenderPasses,
@@ -3657,6 +5624,14 @@ static void backend_allocate_resources( le_backend_o* self, BackendFrameData& fr
 	// resource info, so that multisample versions of image resources can be allocated dynamically.
 	insert_msaa_versions( active_resources );
 
+	// Resources which async compute passes use must be shared concurrently if async compute
+	// executes on a queue of a different family than the graphics queue.
+	std::pmr::unordered_set<le_resource_handle> async_compute_resources( frame.frameArena );
+
+	if ( self->must_share_async_compute_resources_concurrently ) {
+		collect_async_compute_resources( passes, numRenderPasses, async_compute_resources );
+	}
+
 	// Check if all resources declared in this frame are already available in backend.
 	// If a resource is not available yet, this resource must be allocated.
 
@@ -3664,11 +5639,19 @@ static void backend_allocate_resources( le_backend_o* self, BackendFrameData& fr
 
 		auto [ backendResources, backend_resources_lock ] = self->get_allocated_resources();
 
+		// Binned transient images may have been the last images to use their memory block.
+		backend_release_unused_transient_memory_blocks( self );
+
 		for ( auto const& ar : active_resources ) {
 
 			le_resource_handle const& resource     = ar.first;
 			le_resource_info_t const& resourceInfo = ar.second; ///< consolidated resource info for this resource over all passes
 
+			if ( resource_is_transient_image( resource ) ) {
+				// Transient images are allocated separately, so that they may alias each other's memory.
+				continue;
+			}
+
 			// See if a resource with this id is already available to the frame
 			// This may be the case with a swapchain image resource for example,
 			// as it is allocated and managed from within the swapchain, not here.
@@ -3687,6 +5670,12 @@ static void backend_allocate_resources( le_backend_o* self, BackendFrameData& fr
 			auto       foundIt            = backendResources.find( resource );
 			const bool resourceIdNotFound = ( foundIt == backendResources.end() );
 
+			if ( async_compute_resources.count( resource ) ) {
+				// Note that a resource which was allocated for exclusive use earlier gets re-allocated
+				// below, as the found resource does not satisfy concurrent sharing - it loses its contents.
+				resourceCreateInfo.set_sharing_mode_concurrent( self->async_compute_sharing_queue_family_indices, 2 );
+			}
+
 			if ( resourceIdNotFound ) {
 
 				// Resource does not yet exist, we must allocate this resource and add it to the backend.
@@ -3769,6 +5758,9 @@ static void backend_allocate_resources( le_backend_o* self, BackendFrameData& fr
 				}
 			}
 		} // end for all used resources
+
+		backend_allocate_transient_images( self, frame, backendResources, active_resources, passes, numRenderPasses );
+
 		if ( LE_PRINT_DEBUG_MESSAGES ) {
 			logger.info( "" );
 		}
@@ -3864,14 +5856,18 @@ static void backend_allocate_resources( le_backend_o* self, BackendFrameData& fr
 // ----------------------------------------------------------------------
 // Executes on the DISPATCH FRAME
 //
-// Allocates ImageViews, Samplers and Textures requested by individual passes
-// these are tied to the lifetime of the frame, and will be re-created
-static void frame_allocate_transient_resources( BackendFrameData& frame, VkDevice const& device, le_renderpass_o** passes, size_t numRenderPasses ) {
+// Allocates ImageViews, Samplers and Textures requested by individual passes.
+// Image views and samplers are fetched from the backend's render object cache, which
+// keeps them alive across frames, and evicts image views once their image gets destroyed.
+static void frame_allocate_transient_resources( le_backend_o* self, BackendFrameData& frame, VkDevice const& device, le_renderpass_o** passes, size_t numRenderPasses ) {
 
 	using namespace le_renderer;
 	static auto       logger = LeLog( LOGGER_LABEL );
 	le::QueueFlagBits pass_type{};
 
+	auto& cache = self->render_object_cache;
+	auto  lock  = std::unique_lock( cache.mtx );
+
 	// Only for compute passes: Create imageviews for all available
 	// resources which are of type image and which have usage
 	// sampled or storage.
@@ -3899,7 +5895,11 @@ static void frame_allocate_transient_resources( BackendFrameData& frame, VkDevic
 				// We create a default image view for this image and store it with the frame. If no explicit image view
 				// for a particular operation has been specified, this default image view is used.
 
-				if ( frame.imageViews.find( r ) != frame.imageViews.end() ) {
+				uint32_t const resource_index = frame_get_resource_index( frame, r );
+
+				assert( resource_index != LE_RESOURCE_INDEX_NONE && "image must be available to frame" );
+
+				if ( frame.imageViews[ resource_index ] != nullptr ) {
 					continue;
 				}
 
@@ -3910,7 +5910,7 @@ static void frame_allocate_transient_resources( BackendFrameData& frame, VkDevic
 				// to set the format to whatever was inferred when the image was allocated and placed
 				// in available resources.
 
-				AllocatedResourceVk const& vk_resource_info = frame_data_get_allocated_resource_from_resource_id( frame, r );
+				AllocatedResourceVk const& vk_resource_info = *frame.resourceAllocations[ resource_index ];
 
 				auto const& imageFormat = le::Format( vk_resource_info.info.imageInfo.format );
 
@@ -3940,23 +5940,17 @@ static void frame_allocate_transient_resources( BackendFrameData& frame, VkDevic
 				    .subresourceRange = subresourceRange,
 				};
 
-				VkImageView imageView = nullptr;
-				vkCreateImageView( device, &imageViewCreateInfo, nullptr, &imageView );
-
-				// Store image view object with frame, indexed by image resource id,
+				// Store image view object with frame, indexed by dense resource index,
 				// so that it can be found quickly if need be.
-				frame.imageViews[ r ] = imageView;
-
-				AbstractPhysicalResource imgView{};
-				imgView.type        = AbstractPhysicalResource::Type::eImageView;
-				imgView.asImageView = imageView;
-
-				frame.ownedResources.emplace_front( std::move( imgView ) );
+				frame.imageViews[ resource_index ] = render_object_cache_produce_image_view( cache, device, imageViewCreateInfo, frame.frameNumber );
 			}
 		}
 	}
 
-	frame.textures_per_pass.resize( numRenderPasses );
+	frame.textures_per_pass.reserve( numRenderPasses );
+	while ( frame.textures_per_pass.size() < numRenderPasses ) {
+		frame.textures_per_pass.emplace_back( frame.frameArena );
+	}
 
 	// Create Samplers for all images which are used as Textures
 	//
@@ -4014,21 +6008,12 @@ static void frame_allocate_transient_resources( BackendFrameData& frame, VkDevic
 					    .subresourceRange = subresourceRange,
 					};
 
-					vkCreateImageView( device, &imageViewCreateInfo, nullptr, &imageView );
-
-					// Store vk object references with frame-owned resources, so that
-					// the vk objects can be destroyed when frame crosses the fence.
-
-					AbstractPhysicalResource res;
-					res.asImageView = imageView;
-					res.type        = AbstractPhysicalResource::Type::eImageView;
-
-					frame.ownedResources.emplace_front( std::move( res ) );
+					imageView = render_object_cache_produce_image_view( cache, device, imageViewCreateInfo, frame.frameNumber );
 				}
 
 				VkSampler sampler{};
 				{
-					// Create VkSampler object on device.
+					// Fetch VkSampler object from cache, or create it on device.
 
 					VkSamplerCreateInfo samplerCreateInfo{
 					    .sType                   = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
@@ -4051,15 +6036,7 @@ static void frame_allocate_transient_resources( BackendFrameData& frame, VkDevic
 					    .unnormalizedCoordinates = texInfo.sampler.unnormalizedCoordinates,
 					};
 
-					vkCreateSampler( device, &samplerCreateInfo, nullptr, &sampler );
-					// Now store vk object references with frame-owned resources, so that
-					// the vk objects can be destroyed when frame crosses the fence.
-
-					AbstractPhysicalResource res;
-
-					res.asSampler = sampler;
-					res.type      = AbstractPhysicalResource::Type::eSampler;
-					frame.ownedResources.emplace_front( std::move( res ) );
+					sampler = render_object_cache_produce_sampler( cache, device, samplerCreateInfo, frame.frameNumber );
 				}
 
 				// -- Store Texture with frame so that decoder can find references
@@ -4150,17 +6127,15 @@ static bool backend_acquire_physical_resources( le_backend_o*             self,
 	backend_allocate_resources( self, frame, passes, numRenderPasses );
 
 	{
-		// Initialise, then build sync chain table - each resource receives initial state
-		// from current entry in frame.availableResources resource map -
+		// Assign dense indices to all resources which this frame uses, and initialise
+		// sync chain table - each resource receives initial state from current entry in
+		// frame.availableResources resource map -
 
-		frame.syncChainTable.clear();
-		for ( auto const& res : frame.availableResources ) {
-			frame.syncChainTable.insert( { res.first, { res.second.state } } );
-		}
+		frame_assign_resource_indices( frame );
 
 		// -- build sync chain for each resource, create explicit sync barrier requests for resources
 		// which cannot be implicitly synced.
-		std::vector<le_img_resource_handle> tmp_swapchain_resources{};
+		std::pmr::vector<le_img_resource_handle> tmp_swapchain_resources( frame.frameArena );
 		tmp_swapchain_resources.reserve( frame.frame_owned_swapchain_state.size() );
 
 		for ( auto& [ key, swp ] : frame.frame_owned_swapchain_state ) {
@@ -4180,9 +6155,9 @@ static bool backend_acquire_physical_resources( le_backend_o*             self,
 
 			auto [ backend_resources, lock ] = self->get_allocated_resources();
 
-			for ( auto const& tbl : frame.syncChainTable ) {
-				auto const& resId       = tbl.first;
-				auto const& resSyncList = tbl.second;
+			for ( size_t i = 0; i != frame.resourceHandles.size(); i++ ) {
+				auto const& resId       = frame.resourceHandles[ i ];
+				auto const& resSyncList = frame.syncChainTable[ i ];
 
 				assert( !resSyncList.empty() ); // sync list must have entries
 
@@ -4216,18 +6191,21 @@ static bool backend_acquire_physical_resources( le_backend_o*             self,
 	}
 
 	// -- allocate any transient vk objects such as image samplers, and image views
-	frame_allocate_transient_resources( frame, device, passes, numRenderPasses );
+	frame_allocate_transient_resources( self, frame, device, passes, numRenderPasses );
 
 	// create renderpasses - use sync chain to apply implicit syncing for image attachment resources
-	backend_create_renderpasses( frame, device );
+	backend_create_renderpasses( self, frame, device );
 
 	// -- make sure that there is a descriptorpool for every renderpass
-	backend_create_descriptor_pools( frame, device, numRenderPasses );
+	backend_create_descriptor_pools( self, frame, device );
+
+	// -- bindless mode only: write descriptors for bindless textures and buffers which changed
+	frame_update_bindless_descriptors( self, frame, device );
 
 	// patch and retain physical resources in bulk here, so that
 	// each pass may be processed independently
 
-	backend_create_frame_buffers( frame, device );
+	backend_create_frame_buffers( self, frame, device );
 
 	return true;
 };
@@ -4240,54 +6218,42 @@ static le_allocator_o** backend_get_transient_allocators( le_backend_o* self, si
 // ----------------------------------------------------------------------
 static le_allocator_o** backend_create_transient_allocators( le_backend_o* self, size_t frameIndex, size_t numAllocators ) {
 
-	using namespace le_backend_vk;
-
-	auto&                           frame                         = self->mFrames[ frameIndex ];
-	static const VkBufferUsageFlags LE_BUFFER_USAGE_FLAGS_SCRATCH = defaults_get_buffer_usage_scratch();
-
-	for ( size_t i = frame.allocators.size(); i != numAllocators; ++i ) {
-
-		assert( numAllocators < 256 ); // must not have more than 255 allocators, otherwise we cannot store index in LeResourceHandleMeta.
-
-		VkBuffer          buffer = nullptr;
-		VmaAllocation     allocation;
-		VmaAllocationInfo allocationInfo;
-
-		VmaAllocationCreateInfo createInfo{};
-		createInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
-		createInfo.pool  = frame.allocationPool; // Since we're allocating from a pool all fields but .flags will be taken from the pool
-
-		le_buf_resource_handle res = declare_resource_virtual_buffer( uint8_t( i ) );
-
-		createInfo.pUserData = res;
-
-		VkBufferCreateInfo bufferCreateInfo{
-		    .sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-		    .pNext                 = nullptr, // optional
-		    .flags                 = 0,       // optional
-		    .size                  = LE_LINEAR_ALLOCATOR_SIZE,
-		    .usage                 = LE_BUFFER_USAGE_FLAGS_SCRATCH,
-		    .sharingMode           = VK_SHARING_MODE_EXCLUSIVE,
-		    .queueFamilyIndexCount = 0,
-		    .pQueueFamilyIndices   = nullptr,
-		};
+	auto& frame = self->mFrames[ frameIndex ];
 
-		auto result = vmaCreateBuffer( self->mAllocator, &bufferCreateInfo, &createInfo, &buffer, &allocation, &allocationInfo );
+	if ( nullptr == frame.transientBlockProvider ) {
+		frame.transientBlockProvider = new BackendFrameData::TransientBlockProvider{ self, &frame };
+	}
 
-		assert( result == VK_SUCCESS ); // todo: deal with failed allocation
+	// Chained buffers are placed after the buffers for first blocks - we can only add allocators while there are none.
+	assert( frame.allocatorBuffers.size() == frame.allocators.size() );
 
-		// Create a new allocator - note that we assume an alignment of 256 bytes
-		le_allocator_o* allocator = le_allocator_linear_i.create( &allocationInfo, 256 );
+	uint64_t block_size;
+	{
+		std::scoped_lock lock( self->transient_allocators_mutex );
+		block_size = self->transient_allocator_block_size;
+	}
 
-		frame.allocators.emplace_back( allocator );
-		frame.allocatorBuffers.emplace_back( std::move( buffer ) );
-		frame.allocations.emplace_back( std::move( allocation ) );
-		frame.allocationInfos.emplace_back( std::move( allocationInfo ) );
+	for ( size_t i = frame.allocators.size(); i != numAllocators; ++i ) {
+		bool result = frame_create_transient_allocator( self, frame, i, block_size );
+		assert( result ); // todo: deal with failed allocation
+		(void)result;
 	}
 
 	return frame.allocators.data();
 }
 
+// ----------------------------------------------------------------------
+// Returns memory which has been allocated from transient buffer `buffer` during the current frame.
+static bool backend_get_transient_buffer_used_data( le_backend_o* self, size_t frameIndex, le_buf_resource_handle buffer, void const** data, uint64_t* buffer_offset, uint64_t* num_bytes ) {
+	using namespace le_backend_vk;
+	for ( auto& alloc : self->mFrames[ frameIndex ].allocators ) {
+		if ( le_allocator_linear_i.get_used_data( alloc, buffer, data, buffer_offset, num_bytes ) ) {
+			return true;
+		}
+	}
+	return false;
+}
+
 // ----------------------------------------------------------------------
 
 static le_staging_allocator_o* backend_get_staging_allocator( le_backend_o* self, size_t frameIndex ) {
@@ -4302,15 +6268,98 @@ void debug_print_le_pipeline_layout_info( le_pipeline_layout_info* info ) {
 	}
 }
 
-static bool is_equal( le_pipeline_and_layout_info_t const& lhs, le_pipeline_and_layout_info_t const& rhs ) {
-	return lhs.pipeline == rhs.pipeline &&
-	       lhs.layout_info.set_layout_count == rhs.layout_info.set_layout_count &&
-	       0 == memcmp( lhs.layout_info.set_layout_keys, rhs.layout_info.set_layout_keys, sizeof( uint64_t ) * lhs.layout_info.set_layout_count ) &&
-	       lhs.layout_info.active_vk_shader_stages == rhs.layout_info.active_vk_shader_stages;
+static bool is_equal( le_pipeline_and_layout_info_t const& lhs, le_pipeline_and_layout_info_t const& rhs ) {
+	return lhs.pipeline == rhs.pipeline &&
+	       lhs.layout_info.set_layout_count == rhs.layout_info.set_layout_count &&
+	       0 == memcmp( lhs.layout_info.set_layout_keys, rhs.layout_info.set_layout_keys, sizeof( uint64_t ) * lhs.layout_info.set_layout_count ) &&
+	       lhs.layout_info.active_vk_shader_stages == rhs.layout_info.active_vk_shader_stages;
+}
+
+// ----------------------------------------------------------------------
+// Returns index into DESCRIPTOR_POOL_TYPES for descriptor type `type`.
+static size_t descriptor_pool_type_index( le::DescriptorType type ) {
+	auto it = std::find( std::begin( DESCRIPTOR_POOL_TYPES ), std::end( DESCRIPTOR_POOL_TYPES ), VkDescriptorType( type ) );
+	assert( it != std::end( DESCRIPTOR_POOL_TYPES ) && "descriptor type cannot be allocated from descriptor pools" );
+	return size_t( it - std::begin( DESCRIPTOR_POOL_TYPES ) );
+}
+
+// ----------------------------------------------------------------------
+// Accounts for a descriptor set with descriptors `set_data` in the descriptor demand for the
+// current frame - we use this to size descriptor pools when the frame comes round again.
+static void frame_add_descriptor_demand( BackendFrameData& frame, std::vector<DescriptorData> const& set_data ) {
+	frame.descriptorSetDemand++;
+	for ( auto const& d : set_data ) {
+		frame.descriptorDemand[ descriptor_pool_type_index( d.type ) ]++;
+	}
+}
+
+// ----------------------------------------------------------------------
+// Allocates a descriptor set with `layout` from the frame's descriptor pools -
+// adds a descriptor pool if the current pool has run out of space.
+static VkDescriptorSet frame_allocate_descriptor_set( BackendFrameData& frame, VkDevice device, VkDescriptorSetLayout const& layout ) {
+
+	VkDescriptorSetAllocateInfo allocateInfo{
+	    .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+	    .pNext              = nullptr, // optional
+	    .descriptorPool     = frame.descriptorPools.back(),
+	    .descriptorSetCount = 1,
+	    .pSetLayouts        = &layout,
+	};
+
+	VkDescriptorSet descriptorSet = nullptr;
+
+	auto result = vkAllocateDescriptorSets( device, &allocateInfo, &descriptorSet );
+
+	if ( result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL ) {
+		// Pool has run out of space - we add a pool for the remainder of this frame. Since the
+		// frame now has more than one pool, its pools get re-created with a better fitting size
+		// when the frame comes round again. See backend_create_descriptor_pools.
+		frame.descriptorPools.push_back( descriptor_pool_create_default( device ) );
+
+		allocateInfo.descriptorPool = frame.descriptorPools.back();
+
+		result = vkAllocateDescriptorSets( device, &allocateInfo, &descriptorSet );
+	}
+
+	assert( result == VK_SUCCESS && "failed to allocate descriptor set" );
+
+	return descriptorSet;
+}
+
+// ----------------------------------------------------------------------
+// Returns key under which we cache a descriptor set with `layout` and descriptors `set_data`.
+static uint64_t descriptor_set_cache_key( VkDescriptorSetLayout layout, std::vector<DescriptorData> const& set_data ) {
+
+	SpookyHash hash;
+	hash.Init( 0, 0 );
+	hash.Update( &layout, sizeof( layout ) );
+
+	for ( auto const& d : set_data ) {
+		// We can't hash DescriptorData in one go, as it contains padding.
+		uint64_t const d_data[ 5 ] = {
+		    uint64_t( d.type ),
+		    uint64_t( d.bindingNumber ) << 32 | d.arrayIndex,
+		    d.data[ 0 ],
+		    d.data[ 1 ],
+		    d.data[ 2 ],
+		};
+		hash.Update( d_data, sizeof( d_data ) );
+	}
+
+	uint64_t h1, h2;
+	hash.Final( &h1, &h2 );
+
+	return h1;
 }
 
+// ----------------------------------------------------------------------
+// Makes sure that `descriptorSets` match descriptors in `argumentState`.
+//
+// Descriptor sets are cached with the frame, indexed by set layout and descriptor data -
+// we only allocate, and write to, a descriptor set if there is no matching descriptor set
+// in the cache.
 static bool updateArguments( const VkDevice&                    device,
-                             const VkDescriptorPool&            descriptorPool_,
+                             BackendFrameData&                  frame,
                              const ArgumentState&               argumentState,
                              std::array<DescriptorSetState, 8>& previousSetData,
                              VkDescriptorSet*                   descriptorSets ) {
@@ -4341,6 +6390,15 @@ static bool updateArguments( const VkDevice&                    device,
 	// -- write data from descriptorSetData into freshly allocated DescriptorSets
 	for ( size_t setId = 0; setId != argumentState.setCount; ++setId ) {
 
+		if ( frame.bindlessDescriptorSet && argumentState.layouts[ setId ] == frame.bindlessDescriptorSetLayout ) {
+			// Bindless set: there are no per-draw descriptors to write, as the bindless
+			// descriptor set gets updated once per frame - we just bind it.
+			descriptorSets[ setId ]            = frame.bindlessDescriptorSet;
+			previousSetData[ setId ].setData   = argumentState.setData[ setId ];
+			previousSetData[ setId ].setLayout = argumentState.layouts[ setId ];
+			continue;
+		}
+
 		// If argumentState contains invalid information (for example if an uniform has not been set yet)
 		// this will lead to SEGFAULT. You must ensure that argumentState contains valid information.
 		//
@@ -4411,35 +6469,54 @@ static bool updateArguments( const VkDevice&                    device,
 		if ( argumentsOk ) {
 
 			// We test the current argument state of descriptors against the currently bound
-			// descriptors - we only (re-)allocate descriptorsets for when we detect a change
+			// descriptors - we only look up (or allocate) descriptorsets when we detect a change
 			// within one of these sets.
-
-			// FIXME: there is a subtle bug here - if setData is the same between arguments we
-			// should theoretically be able to recycle the descriptorset - but beware! If the
-			// decriptorset requires a different layout, then you must re-allocate. This can
-			// happen when descriptors differ in usage flags, for example (vertex|fragment vs. vertex)
-			// -- in such a case the parameters are the same between two descriptorSets,
-			// but the descriptorSetLayouts will be different, and you must allcate the matching
-			// descriptorSet.
+			//
+			// Note that we must compare layouts, too: descriptors may be identical between two
+			// descriptorSets, but if their descriptorSetLayouts differ (for example, because
+			// descriptors differ in usage flags: vertex|fragment vs. vertex) we must use the
+			// descriptorSet which matches the layout.
 
 			if ( previousSetData[ setId ].setData.empty() ||
 			     previousSetData[ setId ].setData != argumentState.setData[ setId ] ||
 			     previousSetData[ setId ].setLayout != argumentState.layouts[ setId ] ) {
 
-				VkDescriptorSetAllocateInfo allocateInfo{
-				    .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-				    .pNext              = nullptr, // optional
-				    .descriptorPool     = descriptorPool_,
-				    .descriptorSetCount = 1,
-				    .pSetLayouts        = &argumentState.layouts[ setId ],
-				};
+				auto const& setLayout = argumentState.layouts[ setId ];
+				auto const& setData   = argumentState.setData[ setId ];
+
+				uint64_t const cache_key = descriptor_set_cache_key( setLayout, setData );
+
+				auto cached = frame.descriptorSetCache.find( cache_key );
+
+				if ( cached != frame.descriptorSetCache.end() &&
+				     cached->second.layout == setLayout &&
+				     cached->second.set_data == setData ) {
+
+					// -- cache hit: descriptor set has already been written, we can use it as is.
+
+					descriptorSets[ setId ] = cached->second.set;
+
+					if ( cached->second.last_used_frame != frame.frameNumber ) {
+						cached->second.last_used_frame = frame.frameNumber;
+						frame_add_descriptor_demand( frame, setData );
+					}
+
+					previousSetData[ setId ].setData   = setData;
+					previousSetData[ setId ].setLayout = setLayout;
+
+					continue;
+				}
 
-				// -- allocate descriptorSets based on current layout
-				// and place them in the correct position
+				// ---------| invariant: no matching descriptor set in cache - we must allocate and write one
 
-				auto result = vkAllocateDescriptorSets( device, &allocateInfo, &descriptorSets[ setId ] );
+				descriptorSets[ setId ] = frame_allocate_descriptor_set( frame, device, setLayout );
+				frame_add_descriptor_demand( frame, setData );
 
-				assert( result == VK_SUCCESS && "failed to allocate descriptor set" );
+				if ( cached == frame.descriptorSetCache.end() ) {
+					// If there is an entry under the same key with different contents (which
+					// means that the hash collided), we don't cache this descriptor set.
+					frame.descriptorSetCache.emplace( cache_key, BackendFrameData::DescriptorSetCacheEntry{ descriptorSets[ setId ], setLayout, setData, frame.frameNumber } );
+				}
 
 				if ( /* DISABLES CODE */ ( false ) ) {
 					// I wish that this would work - but it appears that accelerator decriptors cannot be updated using templates.
@@ -4569,6 +6646,10 @@ static void debug_print_command( void*& cmd ) {
                 case (le::CommandType::eDrawMeshTasks): os << "eDrawMeshTasks"; break;
                 case (le::CommandType::eTraceRays): os << "eTraceRays"; break;
                 case (le::CommandType::eSetArgumentTlas): os << "eSetArgumentTlas"; break;
+                case (le::CommandType::eDrawIndirect): os << "eDrawIndirect"; break;
+                case (le::CommandType::eDrawIndexedIndirect): os << "eDrawIndexedIndirect"; break;
+                case (le::CommandType::eDrawIndirectCount): os << "eDrawIndirectCount"; break;
+                case (le::CommandType::eDrawIndexedIndirectCount): os << "eDrawIndexedIndirectCount"; break;
 			}
 	// clang-format on
 
@@ -4675,24 +6756,26 @@ static void backend_acquire_swapchain_resources( le_backend_o* self, size_t fram
 	using namespace le_swapchain_vk;
 	static auto logger = LeLog( LOGGER_LABEL );
 
-	decltype( frame.frame_owned_swapchain_state ) previous_swapchain_state;
-
-	std::swap( frame.frame_owned_swapchain_state, previous_swapchain_state ); // we swap into previous so that anything left over in previous will be destroyed at end of scope.
+	// Remove state for any swapchains which have gone away since this frame was last used - this
+	// destroys their semaphores. State for swapchains which still exist is recycled in-place, so
+	// that we don't need to re-allocate map entries for every frame.
+	for ( auto it = frame.frame_owned_swapchain_state.begin(); it != frame.frame_owned_swapchain_state.end(); ) {
+		if ( self->swapchains.find( it->first ) == self->swapchains.end() ) {
+			it = frame.frame_owned_swapchain_state.erase( it );
+		} else {
+			++it;
+		}
+	}
 
 	for ( auto& [ key, backend_swapchain_data ] : self->swapchains ) {
 
-		auto previous_it = previous_swapchain_state.find( key );
-		// Item existed before:
-		// we can recycle the semaphores.
-
-		auto const& [ swapchain_state, was_inserted ] =
-		    ( previous_it != previous_swapchain_state.end() )                                          // if item existed in a previous version of this frame
-		        ? frame.frame_owned_swapchain_state.emplace( previous_it->first, previous_it->second ) // then copy previous swapchain info into the current frame
-		        : frame.frame_owned_swapchain_state.emplace( key, swapchain_state_t{} );               // otherwise generate new swapchain info
+		// If item existed in a previous version of this frame, we can recycle its semaphores -
+		// otherwise we generate new swapchain info.
+		auto const& [ swapchain_state, was_inserted ] = frame.frame_owned_swapchain_state.try_emplace( key );
 
 		swapchain_state_t& local_swapchain_state = swapchain_state->second;
 
-		if ( previous_it == previous_swapchain_state.end() ) {
+		if ( was_inserted ) {
 			// item did not exist before - we must create semaphores.
 
 			VkSemaphoreCreateInfo const create_info = {
@@ -4734,6 +6817,10 @@ static void backend_acquire_swapchain_resources( le_backend_o* self, size_t fram
 			// try to acquire again by creating a new swapchain from the old one
 
 			le_swapchain_o* new_swapchain = swapchain_i.create_from_old_swapchain( local_swapchain_state.swapchain_data.get_swapchain() );
+
+			// Images of the old swapchain are about to go away - cached framebuffers must not refer to them anymore.
+			backend_render_object_cache_evict_swapchain_images( self, local_swapchain_state.swapchain_data.get_swapchain() );
+
 			local_swapchain_state.swapchain_data.replace_swapchain( new_swapchain );
 
 			if ( swapchain_i.acquire_next_image( new_swapchain,
@@ -4869,7 +6956,12 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 
 			auto const& key = frame.queue_submission_keys[ i ];
 
-			BackendFrameData::PerQueueSubmissionData submission_data{};
+			BackendFrameData::PerQueueSubmissionData submission_data{
+			    .pass_indices            = std::pmr::vector<uint32_t>( frame.frameArena ),
+			    .debug_root_passes_names = std::pmr::string( frame.frameArena ),
+			    .main_submission_idx     = ~0u,
+			    .wait_submission_idx     = ~0u,
+			};
 
 			for ( size_t pi = 0; pi != frame.passes.size(); pi++ ) {
 
@@ -4887,17 +6979,93 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 						if ( !submission_data.debug_root_passes_names.empty() ) {
 							submission_data.debug_root_passes_names.append( " | " );
 						}
-						submission_data.debug_root_passes_names.append( frame.debug_root_passes_names[ j ] );
+						submission_data.debug_root_passes_names.append( std::string_view( frame.debug_root_passes_names[ j ] ).substr( 0, 255 ) );
+					}
+				}
+			}
+
+			if ( submission_data.pass_indices.empty() ) {
+				continue;
+			}
+
+			// ---------| invariant: submission has passes
+
+			// -- Split off async compute passes, if there is more than one queue that we could submit to.
+			//
+			// Async compute passes go into their own submission, which may execute concurrently
+			// with the non-async passes that come before the first pass that must wait for
+			// async compute. This first waiting pass, and all passes after it go into a
+			// continuation submission, which waits for the async compute submission.
+			//
+			// Note that all three submissions carry the same queue flags, unless async compute
+			// may go onto a queue of a different family - in which case resources which async
+			// compute passes use are shared concurrently between both families.
+
+			std::pmr::vector<uint32_t> main_pass_indices( frame.frameArena );
+			std::pmr::vector<uint32_t> async_pass_indices( frame.frameArena );
+			std::pmr::vector<uint32_t> continuation_pass_indices( frame.frameArena );
+
+			if ( self->queues.size() > 1 ) {
+				bool found_waiting_pass = false;
+				for ( auto const& pi : submission_data.pass_indices ) {
+					auto const& pass = frame.passes[ pi ];
+					if ( pass.is_async_compute ) {
+						async_pass_indices.push_back( pi );
+					} else if ( found_waiting_pass || pass.waits_for_async ) {
+						found_waiting_pass = true;
+						continuation_pass_indices.push_back( pi );
+					} else {
+						main_pass_indices.push_back( pi );
 					}
 				}
 			}
 
-			if ( !submission_data.pass_indices.empty() ) {
-				frame.queue_submission_data.push_back( submission_data );
+			if ( async_pass_indices.empty() || main_pass_indices.empty() ) {
+				// Nothing would execute concurrently with async compute - we keep all passes in one submission.
+				// Note that we must move, as copying a pmr container would not propagate its allocator
+				frame.queue_submission_data.emplace_back( std::move( submission_data ) );
+				continue;
+			}
+
+			// ---------| invariant: async compute passes may overlap with main passes
+
+			uint32_t const main_submission_idx = uint32_t( frame.queue_submission_data.size() );
+
+			BackendFrameData::PerQueueSubmissionData async_submission_data{
+			    .queue_flags             = self->must_share_async_compute_resources_concurrently
+			                                   ? VkQueueFlags( VK_QUEUE_COMPUTE_BIT )
+			                                   : submission_data.queue_flags,
+			    .pass_indices            = std::move( async_pass_indices ),
+			    .debug_root_passes_names = std::pmr::string( frame.frameArena ),
+			    .is_async_compute        = true,
+			    .main_submission_idx     = main_submission_idx,
+			    .wait_submission_idx     = ~0u,
+			};
+
+			BackendFrameData::PerQueueSubmissionData continuation_submission_data{
+			    .queue_flags             = submission_data.queue_flags,
+			    .pass_indices            = std::move( continuation_pass_indices ),
+			    .debug_root_passes_names = std::pmr::string( frame.frameArena ),
+			    .main_submission_idx     = main_submission_idx,
+			    .wait_submission_idx     = main_submission_idx + 1, // async submission immediately follows main submission
+			};
+
+			if ( needs_to_collect_root_pass_names ) {
+				async_submission_data.debug_root_passes_names.assign( submission_data.debug_root_passes_names ).append( " | async compute" );
+				continuation_submission_data.debug_root_passes_names.assign( submission_data.debug_root_passes_names ).append( " | after async compute" );
+			}
+
+			submission_data.pass_indices = std::move( main_pass_indices );
+
+			frame.queue_submission_data.emplace_back( std::move( submission_data ) );
+			frame.queue_submission_data.emplace_back( std::move( async_submission_data ) );
+
+			if ( !continuation_submission_data.pass_indices.empty() ) {
+				frame.queue_submission_data.emplace_back( std::move( continuation_submission_data ) );
 			}
 		}
 
-		assert( num_invocation_keys == frame.queue_submission_data.size() && "must have one submission data element per invocaton key" );
+		assert( frame.queue_submission_data.size() >= num_invocation_keys && "must have at least one submission data element per invocation key" );
 
 		// -- Control that resources may only be used by the same queue family per-frame.
 		// we adjust for this by making the queue requirements a superset of all resource queue usages,
@@ -4912,12 +7080,16 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 
 			// for each resource, accumulate all queue type flags that it gets used with over all submissions
 
-			std::unordered_map<le_resource_handle, VkQueueFlags> resource_queue_flags;
+			std::pmr::unordered_map<le_resource_handle, VkQueueFlags> resource_queue_flags( frame.frameArena );
+
+			// Resources which are shared concurrently don't constrain queue families, and are skipped.
 
 			for ( auto const& qs : frame.queue_submission_data ) {
 				for ( auto const& pi : qs.pass_indices ) {
 					for ( auto const& r : frame.passes[ pi ].resources ) {
-						resource_queue_flags[ r ] |= qs.queue_flags;
+						if ( !frame_resource_is_shared_concurrently( frame, r ) ) {
+							resource_queue_flags[ r ] |= qs.queue_flags;
+						}
 					}
 				}
 			}
@@ -4928,11 +7100,34 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 				for ( auto const& pi : qs.pass_indices ) {
 					VkQueueFlags flags = qs.queue_flags;
 					for ( auto const& r : frame.passes[ pi ].resources ) {
-						flags |= resource_queue_flags.at( r );
+						auto it = resource_queue_flags.find( r );
+						if ( it != resource_queue_flags.end() ) {
+							flags |= it->second;
+						}
 					}
 					qs.queue_flags = flags;
 				}
 			}
+
+			// Submissions which belong to the same subgraph must share queue flags, so that they
+			// are assigned queues of the same family. Async compute submissions keep their own
+			// flags if they may go onto a queue of a different family.
+
+			auto must_share_flags_with_main_submission = [ self ]( BackendFrameData::PerQueueSubmissionData const& qs ) -> bool {
+				return qs.main_submission_idx != ~0u &&
+				       !( qs.is_async_compute && self->must_share_async_compute_resources_concurrently );
+			};
+
+			for ( auto const& qs : frame.queue_submission_data ) {
+				if ( must_share_flags_with_main_submission( qs ) ) {
+					frame.queue_submission_data[ qs.main_submission_idx ].queue_flags |= qs.queue_flags;
+				}
+			}
+			for ( auto& qs : frame.queue_submission_data ) {
+				if ( must_share_flags_with_main_submission( qs ) ) {
+					qs.queue_flags = frame.queue_submission_data[ qs.main_submission_idx ].queue_flags;
+				}
+			}
 		}
 
 		{
@@ -4943,20 +7138,62 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 			/// from this, we can then go through all queues of the queue family
 			/// and pick the queue with the least submissions.
 			///
-			std::vector<uint32_t> num_submissions_per_queue( num_invocation_keys, 0 );
-			for ( size_t i = 0; i != num_invocation_keys; i++ ) {
+			/// Continuation submissions go onto the same queue as the first submission of their
+			/// subgraph, so that queue submission order is preserved. Async compute submissions
+			/// go onto any other queue, so that they may execute concurrently. This queue must be
+			/// of the same family as the main queue, unless all resources which async compute
+			/// passes use are shared concurrently between the main queue's family and its own.
+			///
+			std::pmr::vector<uint32_t> num_submissions_per_queue( self->queues.size(), 0, frame.frameArena );
+			for ( size_t i = 0; i != frame.queue_submission_data.size(); i++ ) {
+
+				auto&       submission = frame.queue_submission_data[ i ];
+				auto const& queues     = self->queues;
+				auto const& flags      = submission.queue_flags;
 
-				auto const& queues = self->queues;
-				auto const& flags  = frame.queue_submission_data[ i ].queue_flags;
+				if ( submission.main_submission_idx != ~0u && !submission.is_async_compute ) {
+					submission.queue_idx = frame.queue_submission_data[ submission.main_submission_idx ].queue_idx;
+					num_submissions_per_queue[ submission.queue_idx ]++;
+					continue;
+				}
+
+				// ---------| invariant: submission is either the first submission of its subgraph, or async compute
+
+				uint32_t const excluded_queue = submission.is_async_compute
+				                                    ? frame.queue_submission_data[ submission.main_submission_idx ].queue_idx
+				                                    : ~0u;
 
 				int      matching_queue          = -1;
 				uint32_t lowest_submission_count = uint32_t( ~0 );
 
 				uint32_t matching_queue_family_index = backend_find_queue_family_index_from_requirements( self, flags );
 
+				if ( submission.is_async_compute ) {
+					uint32_t const main_queue_family_index = queues[ excluded_queue ]->queue_family_index;
+
+					bool may_use_other_family =
+					    self->must_share_async_compute_resources_concurrently &&
+					    main_queue_family_index == self->async_compute_sharing_queue_family_indices[ 0 ] &&
+					    matching_queue_family_index == self->async_compute_sharing_queue_family_indices[ 1 ];
+
+					for ( auto pi = submission.pass_indices.begin(); may_use_other_family && pi != submission.pass_indices.end(); pi++ ) {
+						for ( auto const& r : frame.passes[ *pi ].resources ) {
+							if ( !frame_resource_is_shared_concurrently( frame, r ) ) {
+								// This may be the case for resources which are not allocated by the backend, e.g. swapchain images.
+								may_use_other_family = false;
+								break;
+							}
+						}
+					}
+
+					if ( !may_use_other_family ) {
+						matching_queue_family_index = main_queue_family_index;
+					}
+				}
+
 				// try to find an exact match with the lowest submissions to it
 				for ( uint32_t j = 0; j != queues.size(); j++ ) {
-					if ( queues[ j ]->queue_family_index == matching_queue_family_index ) {
+					if ( j != excluded_queue && queues[ j ]->queue_family_index == matching_queue_family_index ) {
 						// all flags are contained in q.queue_flags
 						if ( num_submissions_per_queue[ j ] < lowest_submission_count ) {
 							matching_queue          = j;
@@ -4965,6 +7202,17 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 					}
 				}
 
+				if ( matching_queue == -1 && submission.is_async_compute ) {
+					// There is no other queue in this family: async compute passes must share
+					// the main queue. This is still correct, but there won't be any overlap.
+					static bool was_logged = false;
+					if ( !was_logged ) {
+						logger.info( "No second queue available in queue family %d: async compute passes will execute on the main queue.", matching_queue_family_index );
+						was_logged = true;
+					}
+					matching_queue = int( excluded_queue );
+				}
+
 				if ( matching_queue == -1 ) {
 					le::Log( LOGGER_LABEL ).error( "Could not find matching queue with capability: %s\n"
 					                               "This could be caused by one or more queue families claiming ownership of the same resource.",
@@ -4975,7 +7223,7 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 
 				num_submissions_per_queue[ matching_queue ]++;
 
-				frame.queue_submission_data[ i ].queue_idx = matching_queue;
+				submission.queue_idx = matching_queue;
 			}
 		}
 
@@ -5011,6 +7259,41 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 		}
 	}
 
+	LE_SETTING( bool, LE_SETTING_BACKEND_ENABLE_GPU_TIMESTAMPS, false );
+
+	bool const should_write_timestamps = *LE_SETTING_BACKEND_ENABLE_GPU_TIMESTAMPS;
+
+	if ( should_write_timestamps ) {
+		// Make sure the query pool for this frame has space for two timestamps per pass.
+		uint32_t const num_queries = uint32_t( frame.passes.size() * 2 );
+
+		if ( num_queries > frame.timestampQueryPoolCapacity ) {
+
+			if ( frame.timestampQueryPool ) {
+				// Safe to destroy: the frame fence has been crossed, and no command buffer refers to the pool anymore.
+				vkDestroyQueryPool( device, frame.timestampQueryPool, nullptr );
+			}
+
+			VkQueryPoolCreateInfo info = {
+			    .sType              = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+			    .pNext              = nullptr, // optional
+			    .flags              = 0,       // optional
+			    .queryType          = VK_QUERY_TYPE_TIMESTAMP,
+			    .queryCount         = num_queries,
+			    .pipelineStatistics = 0, // optional
+			};
+
+			vkCreateQueryPool( device, &info, nullptr, &frame.timestampQueryPool );
+			frame.timestampQueryPoolCapacity = num_queries;
+
+			// Queries start out in an undefined state, and must be reset before first use.
+			// Once used, queries get reset in backend_collect_gpu_timestamps.
+			vkResetQueryPool( device, frame.timestampQueryPool, 0, num_queries );
+		}
+
+		frame.timestampQueries.clear();
+	}
+
 	for ( auto const& submission : frame.queue_submission_data ) {
 		std::array<VkClearValue, 16> clearValues{};
 		// split graph into separate submissions by filtering by submission key
@@ -5024,11 +7307,17 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 		// note that access to any caches when creating pipelines and layouts and descriptorsets must be
 		// mutex-controlled when processing happens concurrently.
 		uint32_t buffer_index = 0;
+
+		// Barriers recorded on queues without graphics capabilities must not mention graphics stages.
+		bool const queue_supports_graphics = ( self->queues[ submission.queue_idx ]->queue_flags & VK_QUEUE_GRAPHICS_BIT );
+
+		VkPipelineStageFlags2 const supported_stages = queue_supports_graphics ? ~VkPipelineStageFlags2( 0 ) : ~GRAPHICS_ONLY_VK_PIPELINE_STAGE_2_FLAGS;
+		VkAccessFlags2 const        supported_access = queue_supports_graphics ? ~VkAccessFlags2( 0 ) : ~GRAPHICS_ONLY_VK_ACCESS_2_FLAGS;
+
 		for ( auto const& passIndex : submission.pass_indices ) {
 
-			auto& pass           = frame.passes[ passIndex ];
-			auto& cmd            = submission.command_pool->buffers[ buffer_index++ ]; // note that we post-increment, so that next iteration will get next command buffer.
-			auto& descriptorPool = frame.descriptorPools[ passIndex ];
+			auto& pass = frame.passes[ passIndex ];
+			auto& cmd  = submission.command_pool->buffers[ buffer_index++ ]; // note that we post-increment, so that next iteration will get next command buffer.
 
 			// create frame buffer, based on swapchain and renderpass
 
@@ -5043,6 +7332,16 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 				vkBeginCommandBuffer( cmd, &info );
 			}
 
+			// Only write timestamps if the queue onto which this pass gets submitted supports them.
+			bool const should_write_pass_timestamps =
+			    should_write_timestamps && self->queues[ submission.queue_idx ]->timestamp_valid_bits != 0;
+
+			if ( should_write_pass_timestamps ) {
+				// Note that queries have already been reset on the host - see backend_collect_gpu_timestamps.
+				vkCmdWriteTimestamp2( cmd, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, frame.timestampQueryPool, passIndex * 2 );
+				frame.timestampQueries.push_back( { passIndex, submission.queue_idx } );
+			}
+
 			if ( SHOULD_INSERT_DEBUG_LABELS ) {
 				VkDebugUtilsLabelEXT labelInfo{
 				    .sType      = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT,
@@ -5093,11 +7392,61 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 
 					// ---------| invariant: barrier is active.
 
-					auto const& syncChain = frame.syncChainTable[ op.resource ];
+					auto const& syncChain = frame.syncChainTable[ op.resource_index ];
 
 					auto const& stateInitial = syncChain[ op.sync_chain_offset_initial ];
 					auto const& stateFinal   = syncChain[ op.sync_chain_offset_final ];
 
+					if ( op.resource->data->type == LeResourceType::eBuffer ) {
+
+						// Only issue a buffer barrier if there is a hazard: any write access, before or after -
+						// this includes reads which were not covered by reads since the most recent write.
+						// Reads which are already covered leave the sync state unchanged, and need no barrier.
+
+						if ( stateInitial == stateFinal ||
+						     0 == ( ( stateInitial.visible_access | stateFinal.visible_access | stateInitial.last_write_access ) & ANY_WRITE_VK_ACCESS_2_FLAGS ) ) {
+							continue;
+						}
+
+						// We wait for the previous access, and for the most recent write, which may have happened
+						// before any reads that the previous state accumulated.
+
+						VkPipelineStageFlags2 const srcStage  = ( stateInitial.stage | stateInitial.last_write_stage ) & supported_stages;
+						VkAccessFlags2 const        srcAccess = uint64_t( srcStage ) == 0 ? 0 : ( stateInitial.visible_access | stateInitial.last_write_access ) & ANY_WRITE_VK_ACCESS_2_FLAGS & supported_access;
+
+						VkBufferMemoryBarrier2 bufferBarrier{
+						    .sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+						    .pNext               = nullptr,
+						    .srcStageMask        = uint64_t( srcStage ) == 0 ? VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT : srcStage, // happens-before
+						    .srcAccessMask       = srcAccess,                                                                 // make available (only writes need flushing)
+						    .dstStageMask        = stateFinal.stage & supported_stages,                                       // happens-after
+						    .dstAccessMask       = stateFinal.visible_access & supported_access,                              // make visible
+						    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+						    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+						    .buffer              = frame.resourceAllocations[ op.resource_index ]->as.buffer,
+						    .offset              = 0,
+						    .size                = VK_WHOLE_SIZE,
+						};
+
+						VkDependencyInfo dependencyInfo = {
+						    .sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+						    .pNext                    = nullptr, // optional
+						    .dependencyFlags          = 0,       // optional
+						    .memoryBarrierCount       = 0,       // optional
+						    .pMemoryBarriers          = 0,
+						    .bufferMemoryBarrierCount = 1, // optional
+						    .pBufferMemoryBarriers    = &bufferBarrier,
+						    .imageMemoryBarrierCount  = 0, // optional
+						    .pImageMemoryBarriers     = 0,
+						};
+
+						vkCmdPipelineBarrier2( cmd, &dependencyInfo );
+
+						continue;
+					}
+
+					// ---------| invariant: resource is an image
+
 					if ( stateInitial != stateFinal ) {
 						// we must issue an image barrier
 
@@ -5109,8 +7458,6 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 							logger.info( "\t Explicit Barrier for: %s (s: %d)", op.resource->data->debug_name, 1 << op.resource->data->num_samples );
 							logger.info( "\t % 3s : % 30s : % 30s : % 10s", "#", "visible_access", "write_stage", "layout" );
 
-							auto const& syncChain = frame.syncChainTable.at( op.resource );
-
 							for ( size_t i = op.sync_chain_offset_initial; i <= op.sync_chain_offset_final; i++ ) {
 								auto const& s = syncChain[ i ];
 								logger.info( "\t % 3d : % 30s : % 30s : % 10s", i,
@@ -5120,15 +7467,18 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 							}
 						}
 
-						auto dstImage = frame_data_get_image_from_le_resource_id( frame, static_cast<le_img_resource_handle>( op.resource ) );
+						auto dstImage = frame.resourceAllocations[ op.resource_index ]->as.image;
+
+						VkPipelineStageFlags2 const srcStage  = stateInitial.stage & supported_stages;
+						VkAccessFlags2 const        srcAccess = uint64_t( srcStage ) == 0 ? 0 : stateInitial.visible_access & ANY_WRITE_VK_ACCESS_2_FLAGS & supported_access;
 
 						VkImageMemoryBarrier2 imageLayoutTransfer{
 						    .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
 						    .pNext               = nullptr,
-						    .srcStageMask        = uint64_t( stateInitial.stage ) == 0 ? VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT : stateInitial.stage, // happens-before
-						    .srcAccessMask       = ( stateInitial.visible_access & ANY_WRITE_VK_ACCESS_2_FLAGS ),                                  // make available memory update from operation (in case it was a write operation, otherwise don't wait)
-						    .dstStageMask        = stateFinal.stage,                                                                               // happens-after
-						    .dstAccessMask       = stateFinal.visible_access,                                                                      // make visible
+						    .srcStageMask        = uint64_t( srcStage ) == 0 ? VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT : srcStage, // happens-before
+						    .srcAccessMask       = srcAccess,                                                                 // make available memory update from operation (in case it was a write operation, otherwise don't wait)
+						    .dstStageMask        = stateFinal.stage & supported_stages,                                       // happens-after
+						    .dstAccessMask       = stateFinal.visible_access & supported_access,                              // make visible
 						    .oldLayout           = stateInitial.layout,
 						    .newLayout           = stateFinal.layout,
 						    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
@@ -5183,6 +7533,7 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 			size_t   dataSize      = 0;
 			size_t   numCommands   = 0;
 			size_t   commandIndex  = 0;
+			size_t   pageIndex     = 0; // command stream is organised in pages, commands never straddle pages
 			uint32_t subpassIndex  = 0;
 
 			VkPipelineLayout currentPipelineLayout                          = nullptr;
@@ -5201,7 +7552,12 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 			static le_buf_resource_handle LE_RTX_SCRATCH_BUFFER_HANDLE = LE_BUF_RESOURCE( "le_rtx_scratch_buffer_handle" ); // opaque handle for rtx scratch buffer
 
 			if ( pass.encoder ) {
-				encoder_i.get_encoded_data( pass.encoder, &commandStream, &dataSize, &numCommands );
+				encoder_i.get_encoded_data( pass.encoder, pageIndex, &commandStream, &dataSize, &numCommands );
+				// Skip any leading pages which hold no commands, so that an empty first
+				// page does not hide commands on later pages.
+				while ( commandIndex == numCommands &&
+				        encoder_i.get_encoded_data( pass.encoder, ++pageIndex, &commandStream, &dataSize, &numCommands ) ) {
+				}
 			} else {
 				// This is legit behaviour for draw passes which are used only to clear attachments,
 				// in which case they don't need to include any draw commands.
@@ -5211,7 +7567,7 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 
 				le_pipeline_manager_o* pipelineManager = encoder_i.get_pipeline_manager( pass.encoder );
 
-				std::vector<VkBuffer>         vertexInputBindings( maxVertexInputBindings, nullptr );
+				std::pmr::vector<VkBuffer>    vertexInputBindings( maxVertexInputBindings, nullptr, frame.frameArena );
 				void*                         dataIt = commandStream;
 				le_pipeline_and_layout_info_t currentPipeline{};
 
@@ -5310,7 +7666,12 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 									}
 								}
 
-								vkCmdBindPipeline( cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, currentPipeline.pipeline );
+								if ( currentPipeline.pipeline ) {
+									vkCmdBindPipeline( cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, currentPipeline.pipeline );
+								} else {
+									// Pipeline is still being compiled in the background, and there is
+									// no fallback: draws will be skipped until this pipeline is ready.
+								}
 							} else {
 								// Re-using previously bound pipeline. We may keep argumentState state as it is.
 							}
@@ -5403,7 +7764,12 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 								// when we bind a pipeline, we update the descriptorsetstate based
 								// on what the pipeline requires.
 							}
-							vkCmdBindPipeline( cmd, VK_PIPELINE_BIND_POINT_COMPUTE, currentPipeline.pipeline );
+							if ( currentPipeline.pipeline ) {
+								vkCmdBindPipeline( cmd, VK_PIPELINE_BIND_POINT_COMPUTE, currentPipeline.pipeline );
+							} else {
+								// Pipeline is still being compiled in the background: dispatches
+								// will be skipped until this pipeline is ready.
+							}
 
 						} else {
 							// -- TODO: warn that compute pipelines may only be bound within
@@ -5539,7 +7905,7 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 						auto* le_cmd = static_cast<le::CommandTraceRays*>( dataIt );
 
 						// -- update descriptorsets via template if tainted
-						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets );
+						bool argumentsOk = updateArguments( device, frame, argumentState, previousSetState, descriptorSets );
 
 						if ( false == argumentsOk ) {
 							break;
@@ -5590,8 +7956,12 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 					case le::CommandType::eDispatch: {
 						auto* le_cmd = static_cast<le::CommandDispatch*>( dataIt );
 
+						if ( nullptr == currentPipeline.pipeline ) {
+							break; // pipeline is not ready yet - skip this dispatch
+						}
+
 						// -- update descriptorsets via template if tainted
-						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets );
+						bool argumentsOk = updateArguments( device, frame, argumentState, previousSetState, descriptorSets );
 
 						if ( false == argumentsOk ) {
 							break;
@@ -5648,8 +8018,12 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 					case le::CommandType::eDraw: {
 						auto* le_cmd = static_cast<le::CommandDraw*>( dataIt );
 
+						if ( nullptr == currentPipeline.pipeline ) {
+							break; // pipeline is not ready yet - skip this draw
+						}
+
 						// -- update descriptorsets via template if tainted
-						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets );
+						bool argumentsOk = updateArguments( device, frame, argumentState, previousSetState, descriptorSets );
 
 						if ( false == argumentsOk ) {
 							break;
@@ -5676,8 +8050,12 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 					case le::CommandType::eDrawIndexed: {
 						auto* le_cmd = static_cast<le::CommandDrawIndexed*>( dataIt );
 
+						if ( nullptr == currentPipeline.pipeline ) {
+							break; // pipeline is not ready yet - skip this draw
+						}
+
 						// -- update descriptorsets via template if tainted
-						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets );
+						bool argumentsOk = updateArguments( device, frame, argumentState, previousSetState, descriptorSets );
 
 						if ( false == argumentsOk ) {
 							break;
@@ -5710,8 +8088,12 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 					case le::CommandType::eDrawMeshTasks: {
 						auto* le_cmd = static_cast<le::CommandDrawMeshTasks*>( dataIt );
 
+						if ( nullptr == currentPipeline.pipeline ) {
+							break; // pipeline is not ready yet - skip this draw
+						}
+
 						// -- update descriptorsets via template if tainted
-						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets );
+						bool argumentsOk = updateArguments( device, frame, argumentState, previousSetState, descriptorSets );
 
 						if ( false == argumentsOk ) {
 							break;
@@ -5734,6 +8116,64 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 						vkCmdDrawMeshTasksNV( cmd, le_cmd->info.taskCount, le_cmd->info.firstTask );
 					} break;
 
+					case le::CommandType::eDrawIndirect:
+					case le::CommandType::eDrawIndexedIndirect:
+					case le::CommandType::eDrawIndirectCount:
+					case le::CommandType::eDrawIndexedIndirectCount: {
+
+						if ( nullptr == currentPipeline.pipeline ) {
+							break; // pipeline is not ready yet - skip this draw
+						}
+
+						// -- update descriptorsets via template if tainted
+						bool argumentsOk = updateArguments( device, frame, argumentState, previousSetState, descriptorSets );
+
+						if ( false == argumentsOk ) {
+							break;
+						}
+
+						// --------| invariant: arguments were updated successfully
+
+						if ( argumentState.setCount > 0 ) {
+
+							vkCmdBindDescriptorSets( cmd,
+							                         VK_PIPELINE_BIND_POINT_GRAPHICS,
+							                         currentPipelineLayout,
+							                         0,
+							                         argumentState.setCount,
+							                         descriptorSets,
+							                         argumentState.dynamicOffsetCount,
+							                         argumentState.dynamicOffsets.data() );
+						}
+
+						switch ( header->info.type ) {
+						case le::CommandType::eDrawIndirect: {
+							auto* le_cmd = static_cast<le::CommandDrawIndirect*>( dataIt );
+							auto  buffer = frame_data_get_buffer_from_le_resource_id( frame, le_cmd->info.buffer );
+							vkCmdDrawIndirect( cmd, buffer, le_cmd->info.offset, le_cmd->info.drawCount, le_cmd->info.stride );
+						} break;
+						case le::CommandType::eDrawIndexedIndirect: {
+							auto* le_cmd = static_cast<le::CommandDrawIndexedIndirect*>( dataIt );
+							auto  buffer = frame_data_get_buffer_from_le_resource_id( frame, le_cmd->info.buffer );
+							vkCmdDrawIndexedIndirect( cmd, buffer, le_cmd->info.offset, le_cmd->info.drawCount, le_cmd->info.stride );
+						} break;
+						case le::CommandType::eDrawIndirectCount: {
+							auto* le_cmd       = static_cast<le::CommandDrawIndirectCount*>( dataIt );
+							auto  buffer       = frame_data_get_buffer_from_le_resource_id( frame, le_cmd->info.buffer );
+							auto  count_buffer = frame_data_get_buffer_from_le_resource_id( frame, le_cmd->info.count_buffer );
+							vkCmdDrawIndirectCount( cmd, buffer, le_cmd->info.offset, count_buffer, le_cmd->info.count_offset, le_cmd->info.maxDrawCount, le_cmd->info.stride );
+						} break;
+						case le::CommandType::eDrawIndexedIndirectCount: {
+							auto* le_cmd       = static_cast<le::CommandDrawIndexedIndirectCount*>( dataIt );
+							auto  buffer       = frame_data_get_buffer_from_le_resource_id( frame, le_cmd->info.buffer );
+							auto  count_buffer = frame_data_get_buffer_from_le_resource_id( frame, le_cmd->info.count_buffer );
+							vkCmdDrawIndexedIndirectCount( cmd, buffer, le_cmd->info.offset, count_buffer, le_cmd->info.count_offset, le_cmd->info.maxDrawCount, le_cmd->info.stride );
+						} break;
+						default:
+							break;
+						}
+					} break;
+
 					case le::CommandType::eSetLineWidth: {
 						auto* le_cmd = static_cast<le::CommandSetLineWidth*>( dataIt );
 						vkCmdSetLineWidth( cmd, le_cmd->info.width );
@@ -5902,8 +8342,8 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 
 						// fetch texture information based on texture id from command
 
-						auto foundImgView = frame.imageViews.find( le_cmd->info.image_id );
-						if ( foundImgView == frame.imageViews.end() ) {
+						uint32_t const img_resource_index = frame_get_resource_index( frame, le_cmd->info.image_id );
+						if ( img_resource_index == LE_RESOURCE_INDEX_NONE || frame.imageViews[ img_resource_index ] == nullptr ) {
 							logger.error( "Could not find image view for image: '%s', ignoring image binding command.",
 							              le_cmd->info.image_id->data->debug_name );
 							break;
@@ -5913,7 +8353,7 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 
 						// FIXME: (sync) image layout at this point *must* be general, if we wanted to write to this image.
 						bindingData.imageInfo.imageLayout = le::ImageLayout::eGeneral;
-						bindingData.imageInfo.imageView   = foundImgView->second;
+						bindingData.imageInfo.imageView   = frame.imageViews[ img_resource_index ];
 
 						bindingData.type       = le::DescriptorType::eStorageImage;
 						bindingData.arrayIndex = uint32_t( le_cmd->info.array_index );
@@ -5995,7 +8435,7 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 						auto* le_cmd = static_cast<le::CommandWriteToBuffer*>( dataIt );
 
 						VkBufferCopy region{
-						    .srcOffset = le_cmd->info.src_offset,
+						    .srcOffset = le_cmd->info.src_offset + frame_data_get_staging_buffer_offset( frame, le_cmd->info.src_buffer_id ),
 						    .dstOffset = le_cmd->info.dst_offset,
 						    .size      = le_cmd->info.numBytes,
 						};
@@ -6013,6 +8453,7 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 						auto* le_cmd = static_cast<le::CommandWriteToImage*>( dataIt );
 
 						auto srcBuffer = frame_data_get_buffer_from_le_resource_id( frame, le_cmd->info.src_buffer_id );
+						auto srcOffset = frame_data_get_staging_buffer_offset( frame, le_cmd->info.src_buffer_id );
 						auto dstImage  = frame_data_get_image_from_le_resource_id( frame, le_cmd->info.dst_image_id );
 
 						// We define a range that covers all miplevels. this is useful as it allows us to transform
@@ -6038,7 +8479,7 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 							    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
 							    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
 							    .buffer              = srcBuffer,
-							    .offset              = 0, // we assume a fresh buffer was allocated, so offset must be 0
+							    .offset              = srcOffset,
 							    .size                = le_cmd->info.numBytes,
 							};
 
@@ -6088,7 +8529,7 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 							};
 
 							VkBufferImageCopy region{
-							    .bufferOffset      = 0,                                   // buffer offset is 0, since staging buffer is a fresh, specially allocated buffer
+							    .bufferOffset      = srcOffset,                           // staging memory may be sub-allocated from the staging ring
 							    .bufferRowLength   = 0,                                   // 0 means tightly packed
 							    .bufferImageHeight = 0,                                   // 0 means tightly packed
 							    .imageSubresource  = std::move( imageSubresourceLayers ), // stored inline
@@ -6307,10 +8748,10 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 							// Translate geometry info from internal format toVkgeometryKHR format.
 							// We do this for each blas, which in turn may have an array of geometries.
 
-							std::vector<VkAccelerationStructureGeometryKHR> geometries;
+							std::pmr::vector<VkAccelerationStructureGeometryKHR> geometries( frame.frameArena );
 							geometries.reserve( blas_info->geometries.size() );
 
-							std::vector<VkAccelerationStructureBuildRangeInfoKHR> build_ranges;
+							std::pmr::vector<VkAccelerationStructureBuildRangeInfoKHR> build_ranges( frame.frameArena );
 							build_ranges.reserve( blas_info->geometries.size() );
 
 							for ( auto const& g : blas_info->geometries ) {
@@ -6582,6 +9023,14 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 					dataIt = static_cast<char*>( dataIt ) + header->info.size;
 
 					++commandIndex;
+
+					// Once we have processed all commands on the current page,
+					// continue with the next non-empty page in the command stream, if any.
+					while ( commandIndex == numCommands &&
+					        encoder_i.get_encoded_data( pass.encoder, ++pageIndex, &commandStream, &dataSize, &numCommands ) ) {
+						dataIt       = commandStream;
+						commandIndex = 0;
+					}
 				}
 			}
 
@@ -6590,6 +9039,10 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 				vkCmdEndRenderPass( cmd );
 			}
 
+			if ( should_write_pass_timestamps ) {
+				vkCmdWriteTimestamp2( cmd, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, frame.timestampQueryPool, passIndex * 2 + 1 );
+			}
+
 			if ( SHOULD_INSERT_DEBUG_LABELS ) {
 				vkCmdEndDebugUtilsLabelEXT( cmd );
 			}
@@ -6601,10 +9054,12 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 
 // ----------------------------------------------------------------------
 // This method gets called once per frame (via renderer.update()) in order
-// to poll shader modules for updates
+// to poll shader modules for updates - we also use it to periodically persist
+// the pipeline cache.
 static void backend_update_shader_modules( le_backend_o* self ) {
 	using namespace le_backend_vk;
 	le_pipeline_manager_i.update_shader_modules( self->pipelineCache );
+	le_pipeline_manager_i.update_pipeline_cache( self->pipelineCache );
 }
 
 // ----------------------------------------------------------------------
@@ -6671,6 +9126,7 @@ struct QueueSubmissionLoggerData {
 		std::string         label;
 		std::vector<info_t> wait_semaphores;
 		std::vector<info_t> signal_semaphores;
+		uint32_t            overlaps_with_submission = ~0u; // index of submission on another queue which this submission may execute concurrently with, ~0 if none
 	};
 
 	std::vector<submission_t> submissions;
@@ -6857,6 +9313,21 @@ static void backend_emit_queue_sync_dot_file( le_backend_o const* backend, uint6
 		}
 	}
 
+	// show submissions which may execute concurrently (async compute) as overlapping:
+	// we place them on the same rank, and connect them with an undirected edge.
+	{
+		uint32_t i = 0;
+		for ( auto const& s : data->submissions ) {
+			if ( s.overlaps_with_submission != ~0u ) {
+				os << "\t{ rank = same; struct_" << s.overlaps_with_submission << "; struct_" << i << "; }\n";
+				os << "\tstruct_" << s.overlaps_with_submission << ":port_struct_" << s.overlaps_with_submission << " -> "
+				   << "struct_" << i << ":port_struct_" << i
+				   << " [dir = none; style = bold; color = \"#61BBEF\"; label = \"overlap\"; fontname = \"IBM Plex Sans\"; fontsize = 10;];\n";
+			}
+			i++;
+		}
+	}
+
 	// we want to link back to the last submission on the same queue
 	{
 		os << "edge [style=dashed;];\n";
@@ -6910,7 +9381,7 @@ static void backend_emit_queue_sync_dot_file( le_backend_o const* backend, uint6
 
 // ----------------------------------------------------------------------
 // we wrap queue submissions so that we can log all parameters for a queue submission.
-static void backend_queue_submit( BackendQueueInfo* queue, uint32_t submission_count, VkSubmitInfo2 const* submitInfo, VkFence fence, bool should_generate_dot_files, std::string const& debug_info ) {
+static void backend_queue_submit( BackendQueueInfo* queue, uint32_t submission_count, VkSubmitInfo2 const* submitInfo, VkFence fence, bool should_generate_dot_files, std::string_view debug_info ) {
 
 	if ( should_generate_dot_files ) {
 
@@ -6989,6 +9460,11 @@ static void backend_submit_queue_transfer_ops( le_backend_o* self, size_t frameI
 		for ( auto const& i : submission_data.pass_indices ) {
 			for ( auto const& r : frame.passes[ i ].resources ) {
 
+				if ( frame_resource_is_shared_concurrently( frame, r ) ) {
+					// Resources which are shared concurrently need no ownership transfer.
+					continue;
+				}
+
 				// Tentatively write to the front buffer
 				auto found_queue_family_ownership = self->resource_queue_family_ownership[ 0 ].find( r );
 				// definitely write to the back buffer
@@ -7469,8 +9945,8 @@ static bool backend_dispatch_frame( le_backend_o* self, size_t frameIndex ) {
 		backend_submit_queue_transfer_ops( self, frameIndex, frame.must_create_queues_dot_graph );
 	}
 
-	std::vector<VkSemaphoreSubmitInfo> wait_present_complete_semaphore_submit_infos;
-	std::vector<VkSemaphoreSubmitInfo> render_complete_semaphore_submit_infos;
+	std::pmr::vector<VkSemaphoreSubmitInfo> wait_present_complete_semaphore_submit_infos( frame.frameArena );
+	std::pmr::vector<VkSemaphoreSubmitInfo> render_complete_semaphore_submit_infos( frame.frameArena );
 
 	wait_present_complete_semaphore_submit_infos.reserve( frame.frame_owned_swapchain_state.size() );
 	render_complete_semaphore_submit_infos.reserve( frame.frame_owned_swapchain_state.size() );
@@ -7517,10 +9993,13 @@ static bool backend_dispatch_frame( le_backend_o* self, size_t frameIndex ) {
 		backend_queue_submit( self->queues[ self->queue_default_graphics_idx ], 1, &submitInfo, nullptr, frame.must_create_queues_dot_graph, "wait_present_complete" );
 	}
 
-	for ( auto const& current_submission : frame.queue_submission_data ) {
+	// Indices into queue submission logger data, one per submission - only used for queue sync dot graphs, so that we can show overlap.
+	std::pmr::vector<uint32_t> logged_submission_indices( frame.frameArena );
+
+	for ( auto& current_submission : frame.queue_submission_data ) {
 
 		// Prepare command buffers for submission
-		std::vector<VkCommandBufferSubmitInfo> command_buffer_submit_infos;
+		std::pmr::vector<VkCommandBufferSubmitInfo> command_buffer_submit_infos( frame.frameArena );
 		command_buffer_submit_infos.reserve( current_submission.command_pool->buffers.size() ); // one command buffer per pass
 
 		for ( auto const& c : current_submission.command_pool->buffers ) {
@@ -7533,12 +10012,54 @@ static bool backend_dispatch_frame( le_backend_o* self, size_t frameIndex ) {
 			    } );
 		}
 
+		// Async compute, and continuation submissions must synchronise with their sibling submissions
+		// on other queues - we express this via waits on the siblings' timeline semaphores.
+		std::array<VkSemaphoreSubmitInfo, 2> wait_semaphore_timeline_infos;
+		uint32_t                              wait_semaphore_timeline_count = 0;
+
+		auto add_timeline_wait = [ & ]( uint32_t queue_idx, uint64_t value ) {
+			if ( queue_idx == current_submission.queue_idx ) {
+				return; // no need to wait: queue submission order takes care of this
+			}
+			wait_semaphore_timeline_infos[ wait_semaphore_timeline_count++ ] = {
+			    .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+			    .pNext       = nullptr,
+			    .semaphore   = self->queues[ queue_idx ]->semaphore,
+			    .value       = value,
+			    .stageMask   = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, // nothing in this submission may start before the wait has completed
+			    .deviceIndex = 0,
+			};
+		};
+
+		size_t const submission_idx = size_t( &current_submission - frame.queue_submission_data.data() );
+
+		if ( submission_idx + 1 < frame.queue_submission_data.size() &&
+		     frame.queue_submission_data[ submission_idx + 1 ].is_async_compute &&
+		     frame.queue_submission_data[ submission_idx + 1 ].main_submission_idx == submission_idx ) {
+			// Main submission must not overtake async compute work which was submitted in earlier frames.
+			// We wait for the highest value signalled so far, as async compute for this frame has not been submitted yet.
+			auto const& async_submission = frame.queue_submission_data[ submission_idx + 1 ];
+			add_timeline_wait( async_submission.queue_idx, self->queues[ async_submission.queue_idx ]->semaphore_wait_value );
+		} else if ( current_submission.is_async_compute ) {
+			// Async compute must not overtake work which was submitted to the main queue in earlier frames,
+			// as it might write to resources which this work reads.
+			// We wait for the value that was signalled right before the main submission of this frame.
+			auto const& main_submission = frame.queue_submission_data[ current_submission.main_submission_idx ];
+			add_timeline_wait( main_submission.queue_idx, main_submission.signal_value - 1 );
+		} else if ( current_submission.wait_submission_idx != ~0u ) {
+			// Continuation must wait for async compute to complete.
+			auto const& async_submission = frame.queue_submission_data[ current_submission.wait_submission_idx ];
+			add_timeline_wait( async_submission.queue_idx, async_submission.signal_value );
+		}
+
 		// We want to signal a timeline semaphore for each queue submission so that any batch submitted to a queue can be waited upon
+		current_submission.signal_value = self->queues[ current_submission.queue_idx ]->semaphore_get_next_signal_value();
+
 		VkSemaphoreSubmitInfo signal_semaphore_timeline_complete = {
 		    .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
 		    .pNext       = nullptr,
 		    .semaphore   = self->queues[ current_submission.queue_idx ]->semaphore,
-		    .value       = self->queues[ current_submission.queue_idx ]->semaphore_get_next_signal_value(),
+		    .value       = current_submission.signal_value,
 		    .stageMask   = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, // signal semaphore once all commands have been processed
 		    .deviceIndex = 0,
 		};
@@ -7547,8 +10068,8 @@ static bool backend_dispatch_frame( le_backend_o* self, size_t frameIndex ) {
 		    .sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
 		    .pNext                    = nullptr,
 		    .flags                    = 0,
-		    .waitSemaphoreInfoCount   = 0,
-		    .pWaitSemaphoreInfos      = nullptr,
+		    .waitSemaphoreInfoCount   = wait_semaphore_timeline_count,
+		    .pWaitSemaphoreInfos      = wait_semaphore_timeline_infos.data(),
 		    .commandBufferInfoCount   = uint32_t( command_buffer_submit_infos.size() ),
 		    .pCommandBufferInfos      = command_buffer_submit_infos.data(),
 		    .signalSemaphoreInfoCount = 1,
@@ -7557,7 +10078,22 @@ static bool backend_dispatch_frame( le_backend_o* self, size_t frameIndex ) {
 
 		auto queue = self->queues[ current_submission.queue_idx ];
 
-		backend_queue_submit( queue, 1, &submitInfo, nullptr, frame.must_create_queues_dot_graph, " subgraph { " + current_submission.debug_root_passes_names + " }" );
+		std::pmr::string debug_info( frame.frameArena );
+
+		if ( frame.must_create_queues_dot_graph ) {
+			debug_info.append( " subgraph { " ).append( current_submission.debug_root_passes_names ).append( " }" );
+		}
+
+		backend_queue_submit( queue, 1, &submitInfo, nullptr, frame.must_create_queues_dot_graph, debug_info );
+
+		if ( frame.must_create_queues_dot_graph ) {
+			auto logger_data = get_queue_submission_logger_data();
+			logged_submission_indices.push_back( uint32_t( logger_data->submissions.size() - 1 ) );
+			if ( current_submission.is_async_compute && current_submission.queue_idx != frame.queue_submission_data[ current_submission.main_submission_idx ].queue_idx ) {
+				// Async compute may overlap with the main submission of its subgraph - we record this so that it shows up in the dot graph.
+				logger_data->submissions.back().overlaps_with_submission = logged_submission_indices[ current_submission.main_submission_idx ];
+			}
+		}
 	}
 
 	{
@@ -7577,7 +10113,7 @@ static bool backend_dispatch_frame( le_backend_o* self, size_t frameIndex ) {
 		/// If submitted on the same queue, Queue submission order means that batch 1 needs to complete before batch 2
 		/// -- see VkSpec 7.2 (Implicit Synchronization Guarantees)
 
-		std::vector<VkSemaphoreSubmitInfo> timeline_wait_semaphores;
+		std::pmr::vector<VkSemaphoreSubmitInfo> timeline_wait_semaphores( frame.frameArena );
 
 		for ( uint32_t i = 0; i != self->queues.size(); i++ ) {
 			timeline_wait_semaphores.push_back( {
@@ -7665,7 +10201,7 @@ static void backend_set_frame_queue_submission_keys( le_backend_o* self, size_t
 	if ( frame.must_create_queues_dot_graph ) {
 		// only harvest root passes names if we're going to generate a diagram.
 		for ( uint32_t i = 0; i != root_names_count; i++ ) {
-			frame.debug_root_passes_names.emplace_back( std::string( std::string( root_names[ i ] ), 0, 255 ) );
+			frame.debug_root_passes_names.push_back( root_names[ i ] );
 		}
 	}
 
@@ -7692,6 +10228,64 @@ static le_rtx_blas_info_handle backend_create_rtx_blas_info( le_backend_o* self,
 	return reinterpret_cast<le_rtx_blas_info_handle>( blas_info );
 };
 
+// ----------------------------------------------------------------------
+// Returns slot index for `key`, assigns the next free slot if `key` has no slot yet.
+// Returns LE_BINDLESS_INVALID_INDEX if all `max_count` slots are taken.
+template <typename T>
+static uint32_t bindless_produce_index( std::unordered_map<T, uint32_t>& indices, T const& key, uint32_t max_count ) {
+	auto [ it, was_inserted ] = indices.try_emplace( key, uint32_t( indices.size() ) );
+
+	if ( it->second < max_count ) {
+		return it->second;
+	}
+
+	// ----------| invariant: no more free slots - undo insertion
+
+	indices.erase( it );
+
+	return LE_BINDLESS_INVALID_INDEX;
+}
+
+// ----------------------------------------------------------------------
+
+static uint32_t backend_get_bindless_texture_index( le_backend_o* self, le_texture_handle texture ) {
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	if ( nullptr == self->bindless_set_layout ) {
+		logger.error( "Cannot provide bindless texture index: bindless mode is not enabled." );
+		return LE_BINDLESS_INVALID_INDEX;
+	}
+
+	auto     lock  = std::unique_lock( self->bindless.mtx );
+	uint32_t index = bindless_produce_index( self->bindless.texture_indices, texture, LE_BINDLESS_MAX_TEXTURES );
+
+	if ( index == LE_BINDLESS_INVALID_INDEX ) {
+		logger.error( "Cannot provide bindless texture index: all %u bindless texture slots are taken.", LE_BINDLESS_MAX_TEXTURES );
+	}
+
+	return index;
+}
+
+// ----------------------------------------------------------------------
+
+static uint32_t backend_get_bindless_buffer_index( le_backend_o* self, le_buf_resource_handle buffer ) {
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	if ( nullptr == self->bindless_set_layout ) {
+		logger.error( "Cannot provide bindless buffer index: bindless mode is not enabled." );
+		return LE_BINDLESS_INVALID_INDEX;
+	}
+
+	auto     lock  = std::unique_lock( self->bindless.mtx );
+	uint32_t index = bindless_produce_index( self->bindless.buffer_indices, static_cast<le_resource_handle>( buffer ), LE_BINDLESS_MAX_BUFFERS );
+
+	if ( index == LE_BINDLESS_INVALID_INDEX ) {
+		logger.error( "Cannot provide bindless buffer index: all %u bindless buffer slots are taken.", LE_BINDLESS_MAX_BUFFERS );
+	}
+
+	return index;
+}
+
 // ----------------------------------------------------------------------
 
 static le_rtx_tlas_info_handle backend_create_rtx_tlas_info( le_backend_o* self, uint32_t instances_count, le::BuildAccelerationStructureFlagsKHR const* flags ) {
@@ -7730,7 +10324,11 @@ LE_MODULE_REGISTER_IMPL( le_backend_vk, api_ ) {
 	vk_backend_i.destroy                         = backend_destroy;
 	vk_backend_i.setup                           = backend_setup;
 	vk_backend_i.get_data_frames_count           = backend_get_data_frames_count;
+	vk_backend_i.get_pass_gpu_timings            = backend_get_pass_gpu_timings;
+	vk_backend_i.get_pass_gpu_time               = backend_get_pass_gpu_time;
+	vk_backend_i.get_transient_allocators_stats  = backend_get_transient_allocators_stats;
 	vk_backend_i.get_transient_allocators        = backend_get_transient_allocators;
+	vk_backend_i.get_transient_buffer_used_data  = backend_get_transient_buffer_used_data;
 	vk_backend_i.get_staging_allocator           = backend_get_staging_allocator;
 	vk_backend_i.poll_frame_fence                = backend_poll_frame_fence;
 	vk_backend_i.clear_frame                     = backend_clear_frame;
@@ -7755,6 +10353,9 @@ LE_MODULE_REGISTER_IMPL( le_backend_vk, api_ ) {
 	vk_backend_i.create_rtx_blas_info = backend_create_rtx_blas_info;
 	vk_backend_i.create_rtx_tlas_info = backend_create_rtx_tlas_info;
 
+	vk_backend_i.get_bindless_texture_index = backend_get_bindless_texture_index;
+	vk_backend_i.get_bindless_buffer_index  = backend_get_bindless_buffer_index;
+
 	auto& private_backend_i                           = api_i->private_backend_vk_i;
 	private_backend_i.get_vk_device                   = backend_get_vk_device;
 	private_backend_i.get_vk_physical_device          = backend_get_vk_physical_device;
@@ -7766,11 +10367,12 @@ LE_MODULE_REGISTER_IMPL( le_backend_vk, api_ ) {
 	private_backend_i.destroy_buffer                  = backend_destroy_buffer;
 	private_backend_i.get_default_graphics_queue_info = backend_get_default_graphics_queue_info;
 
-	auto& staging_allocator_i   = api_i->le_staging_allocator_i;
-	staging_allocator_i.create  = staging_allocator_create;
-	staging_allocator_i.destroy = staging_allocator_destroy;
-	staging_allocator_i.map     = staging_allocator_map;
-	staging_allocator_i.reset   = staging_allocator_reset;
+	auto& staging_allocator_i           = api_i->le_staging_allocator_i;
+	staging_allocator_i.create          = staging_allocator_create;
+	staging_allocator_i.destroy         = staging_allocator_destroy;
+	staging_allocator_i.map             = staging_allocator_map;
+	staging_allocator_i.reset           = staging_allocator_reset;
+	staging_allocator_i.get_mapped_data = staging_allocator_get_mapped_data;
 
 	// register/update submodules inside this plugin
 	register_le_device_vk_api( api_ );
@@ -7793,9 +10395,12 @@ LE_MODULE_REGISTER_IMPL( le_backend_vk, api_ ) {
 	backend_settings_i.add_required_instance_extension              = le_backend_vk_settings_add_required_instance_extension;
 	backend_settings_i.get_requested_physical_device_features_chain = le_backend_vk_get_requested_physical_device_features_chain;
 	backend_settings_i.set_concurrency_count                        = le_backend_vk_settings_set_concurrency_count;
+	backend_settings_i.get_concurrency_count                        = le_backend_vk_settings_get_concurrency_count;
 	backend_settings_i.get_requested_queue_capabilities             = le_backend_vk_settings_get_requested_queue_capabilities;
 	backend_settings_i.set_requested_queue_capabilities             = le_backend_vk_settings_set_requested_queue_capabilities;
 	backend_settings_i.set_data_frames_count                        = le_backend_vk_settings_set_data_frames_count;
+	backend_settings_i.set_bindless_enabled                         = le_backend_vk_settings_set_bindless_enabled;
+	backend_settings_i.get_bindless_enabled                         = le_backend_vk_settings_get_bindless_enabled;
 
 	void** p_settings_singleton_addr = le_core_produce_dictionary_entry( hash_64_fnv1a_const( "backend_api_settings_singleton" ) );
 
@@ -23,6 +23,8 @@ struct le_pipeline_manager_o;
 constexpr uint8_t LE_MAX_BOUND_DESCRIPTOR_SETS = 8;
 constexpr uint8_t LE_MAX_COLOR_ATTACHMENTS     = 16; // maximum number of color attachments to a renderpass
 
+constexpr uint32_t LE_BINDLESS_INVALID_INDEX = uint32_t( ~0 ); // returned by bindless index queries if there is no bindless index available
+
 struct graphics_pipeline_state_o; // for le_pipeline_builder
 struct compute_pipeline_state_o;  // for le_pipeline_builder
 struct rtx_pipeline_state_o;      // for le_pipeline_builder
@@ -37,6 +39,7 @@ LE_OPAQUE_HANDLE( le_img_resource_handle );
 LE_OPAQUE_HANDLE( le_buf_resource_handle );
 LE_OPAQUE_HANDLE( le_tlas_resource_handle );
 LE_OPAQUE_HANDLE( le_blas_resource_handle );
+LE_OPAQUE_HANDLE( le_texture_handle );
 
 LE_OPAQUE_HANDLE( le_cpso_handle );
 LE_OPAQUE_HANDLE( le_cpso_handle );
@@ -101,6 +104,25 @@ struct le_pipeline_and_layout_info_t {
 	le_pipeline_layout_info layout_info;
 };
 
+// GPU time spent on a renderpass, measured via timestamp queries.
+// Only available if LE_SETTING_BACKEND_ENABLE_GPU_TIMESTAMPS is set.
+struct le_backend_pass_gpu_timing_t {
+	char   debug_name[ 64 ]; // debug name of the renderpass
+	double gpu_ms;           // time between start and end of the pass' command buffer on the gpu, in milliseconds
+};
+
+// Memory usage of linear (transient) allocators.
+struct le_allocator_linear_stats_t {
+	uint64_t bytes_used;      // number of bytes handed out since last reset, over all blocks
+	uint64_t bytes_used_peak; // highest number of bytes handed out between any two resets
+	uint64_t capacity;        // capacity of the first (permanent) block, in bytes
+	uint32_t num_blocks;      // number of blocks in use, including the first block - more than one block means that the first block overflowed
+};
+
+// Provides a further block of mapped memory, of at least `min_capacity` bytes, to a linear allocator.
+// `info->pUserData` must hold the le_buf_resource_handle for the buffer which holds the block.
+typedef bool ( *le_allocator_linear_grow_fn )( void* user_data, uint64_t min_capacity, struct VmaAllocationInfo* info );
+
 struct le_backend_vk_api {
 
 	struct backend_vk_settings_interface_t // global settings for backend - must be set before backend setup- after that, settings are read-only.
@@ -110,8 +132,12 @@ struct le_backend_vk_api {
 		VkPhysicalDeviceFeatures2 const* ( *get_requested_physical_device_features_chain )(); // readonly
 
 		void ( *set_concurrency_count )( uint32_t concurrency_count );
+		uint32_t ( *get_concurrency_count )();
 		bool ( *set_data_frames_count )( uint32_t data_frames_count );
 
+		bool ( *set_bindless_enabled )( bool enabled ); // opt-in: global, update-after-bind descriptor arrays for textures and buffers - requests descriptor indexing features
+		bool ( *get_bindless_enabled )();
+
 		void ( *get_requested_queue_capabilities )( VkQueueFlags* queues, uint32_t* num_queues );
 		bool ( *set_requested_queue_capabilities )( VkQueueFlags* queues, uint32_t num_queues );
 	};
@@ -132,6 +158,7 @@ struct le_backend_vk_api {
 
 		bool                   ( *dispatch_frame             ) ( le_backend_o *self, size_t frameIndex );
 		le_allocator_o**       ( *get_transient_allocators   ) ( le_backend_o* self, size_t frameIndex);
+		bool                   ( *get_transient_buffer_used_data ) ( le_backend_o* self, size_t frameIndex, le_buf_resource_handle buffer, void const** data, uint64_t* buffer_offset, uint64_t* num_bytes );
 		le_staging_allocator_o*( *get_staging_allocator      ) ( le_backend_o* self, size_t frameIndex);
 
 		le_shader_module_handle( *create_shader_module       ) ( le_backend_o* self, char const * path, const LeShaderSourceLanguageEnum& shader_source_language, const le::ShaderStageFlagBits& moduleType, char const * macro_definitions, le_shader_module_handle handle, VkSpecializationMapEntry const * specialization_map_entries, uint32_t specialization_map_entries_count, void * specialization_map_data, uint32_t specialization_map_data_num_bytes);
@@ -155,12 +182,28 @@ struct le_backend_vk_api {
 		// return number of in-flight backend data frames
 		size_t                 ( *get_data_frames_count   ) ( le_backend_o *self );
 
+		// gpu timings for all passes of the most recently completed frame.
+		// if `*count` is smaller than the number of timings, sets `*count` to the number of available timings, and returns false.
+		bool                   ( *get_pass_gpu_timings    ) ( le_backend_o *self, size_t *count, le_backend_pass_gpu_timing_t* p_timings, uint64_t* frame_number );
+		// gpu time for a pass with the given debug name, from the most recently completed frame - returns false if not found.
+		bool                   ( *get_pass_gpu_time       ) ( le_backend_o *self, char const * pass_debug_name, double* gpu_ms );
+
+		// memory usage of transient allocators, summed over all transient allocators of the most recently cleared frame.
+		// bytes_used_peak is the highest per-frame sum seen over the lifetime of the backend.
+		void                   ( *get_transient_allocators_stats ) ( le_backend_o *self, le_allocator_linear_stats_t* stats );
+
 		// this is called from the rendergraph to patch renderpass sizes - it must only be called on the recording thread
 		bool                   ( *get_swapchains_infos        ) ( le_backend_o* self, uint32_t frame_index, uint32_t *count, uint32_t* p_width, uint32_t * p_height, le_img_resource_handle * p_handlle );
 
 
 		le_rtx_blas_info_handle( *create_rtx_blas_info )(le_backend_o* self, le_rtx_geometry_t const * geometries, uint32_t geometries_count,le::BuildAccelerationStructureFlagsKHR const * flags);
 		le_rtx_tlas_info_handle( *create_rtx_tlas_info )(le_backend_o* self,  uint32_t instances_count, le::BuildAccelerationStructureFlagsKHR const * flags);
+
+		// Bindless mode only: index of texture/buffer in the bindless descriptor arrays, stable for the lifetime of the backend.
+		// Returns LE_BINDLESS_INVALID_INDEX if bindless mode is not enabled, or if the array is full.
+		// Passes must still declare textures (via sample_texture), and buffers which they use.
+		uint32_t               ( *get_bindless_texture_index ) ( le_backend_o* self, le_texture_handle texture );
+		uint32_t               ( *get_bindless_buffer_index  ) ( le_backend_o* self, le_buf_resource_handle buffer );
 	};
 
 	struct private_backend_vk_interface_t {
@@ -241,11 +284,25 @@ struct le_backend_vk_api {
 
 		le_shader_module_handle                  ( *create_shader_module              ) ( le_pipeline_manager_o* self, char const * path, const LeShaderSourceLanguageEnum& shader_source_language, const le::ShaderStageFlagBits& moduleType, char const *macro_definitions, le_shader_module_handle handle, VkSpecializationMapEntry const * specialization_map_entries, uint32_t specialization_map_entries_count, void * specialization_map_data, uint32_t specialization_map_data_num_bytes);
 		void                                     ( *update_shader_modules             ) ( le_pipeline_manager_o* self );
+		void                                     ( *update_pipeline_cache             ) ( le_pipeline_manager_o* self ); // persists pipeline cache to disk, if due
+
+		// Background pipeline compilation - only active if the job system is running.
+		void                                     ( *set_graphics_pipeline_fallback    ) ( le_pipeline_manager_o* self, le_gpso_handle gpsoHandle, le_gpso_handle fallbackGpsoHandle ); // draws with gpso use fallback while gpso compiles - fallback nullptr to remove
+		void                                     ( *prewarm_compute_pipelines         ) ( le_pipeline_manager_o* self, le_cpso_handle const* cpsoHandles, uint32_t num_handles ); // schedule compilation, e.g. while showing a loading screen
+		uint32_t                                 ( *get_num_pending_pipelines         ) ( le_pipeline_manager_o* self ); // number of pipelines still being compiled
+		void                                     ( *wait_for_pending_pipelines        ) ( le_pipeline_manager_o* self ); // blocks until all pending pipelines are compiled
+		void                                     ( *release_render_pass               ) ( le_pipeline_manager_o* self, struct VkRenderPass_T* render_pass ); // waits for pending pipelines which use render_pass - call before destroying render_pass
+
+		size_t                                   ( *serialize_graphics_pipeline_state   ) ( le_pipeline_manager_o* self, le_gpso_handle gpsoHandle, void* data, size_t capacity );
+		size_t                                   ( *serialize_compute_pipeline_state    ) ( le_pipeline_manager_o* self, le_cpso_handle cpsoHandle, void* data, size_t capacity );
+		le_gpso_handle                           ( *deserialize_graphics_pipeline_state ) ( le_pipeline_manager_o* self, void const* data, size_t num_bytes );
+		le_cpso_handle                           ( *deserialize_compute_pipeline_state  ) ( le_pipeline_manager_o* self, void const* data, size_t num_bytes );
 
         bool                                     ( *graphics_pipeline_add_shader_stage )(le_pipeline_manager_o* self, le_gpso_handle gpsoHandle, le_shader_module_handle shader_stage);
 
 		struct VkPipelineLayout_T*               ( *get_pipeline_layout               ) ( le_pipeline_manager_o* self, uint64_t pipeline_layout_key);
 		const struct le_descriptor_set_layout_t* ( *get_descriptor_set_layout         ) ( le_pipeline_manager_o* self, uint64_t setlayout_key);
+		struct VkDescriptorSetLayout_T*          ( *get_bindless_descriptor_set_layout) ( le_pipeline_manager_o* self ); // nullptr unless bindless mode is enabled
 	};
 
 	struct allocator_linear_interface_t {
@@ -253,14 +310,18 @@ struct le_backend_vk_api {
 		void                    ( *destroy              ) ( le_allocator_o* self );
 		bool                    ( *allocate             ) ( le_allocator_o* self, uint64_t numBytes, void ** pData, uint64_t* bufferOffset);
 		void                    ( *reset                ) ( le_allocator_o* self );
-		le_buf_resource_handle  ( *get_le_resource_id   ) ( le_allocator_o* self );
+		le_buf_resource_handle  ( *get_le_resource_id   ) ( le_allocator_o* self ); // buffer which holds the most recent allocation - query this after each allocation
+		bool                    ( *get_used_data        ) ( le_allocator_o* self, le_buf_resource_handle buffer, void const** data, uint64_t* buffer_offset, uint64_t* num_bytes );
+		void                    ( *set_grow_callback    ) ( le_allocator_o* self, le_allocator_linear_grow_fn grow_fn, void* user_data );
+		void                    ( *get_stats            ) ( le_allocator_o* self, le_allocator_linear_stats_t* stats );
 	};
 
 	struct staging_allocator_interface_t {
-		le_staging_allocator_o* ( *create  )( VmaAllocator_T* const vmaAlloc, VkDevice_T* const device );
-		void                    ( *destroy )( le_staging_allocator_o* self ) ;
-		void                    ( *reset   )( le_staging_allocator_o* self );
-		bool                    ( *map     )( le_staging_allocator_o* self, uint64_t numBytes, void **pData, le_buf_resource_handle *resource_handle );
+		le_staging_allocator_o* ( *create          )( VmaAllocator_T* const vmaAlloc, VkDevice_T* const device );
+		void                    ( *destroy         )( le_staging_allocator_o* self ) ;
+		void                    ( *reset           )( le_staging_allocator_o* self );
+		bool                    ( *map             )( le_staging_allocator_o* self, uint64_t numBytes, void **pData, le_buf_resource_handle *resource_handle );
+		bool                    ( *get_mapped_data )( le_staging_allocator_o* self, le_buf_resource_handle resource_handle, void const** data, uint64_t* num_bytes );
 	};
 
 	struct shader_module_interface_t {
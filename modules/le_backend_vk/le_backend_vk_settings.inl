@@ -33,8 +33,9 @@ struct le_backend_vk_settings_o {
 	    //	    VK_QUEUE_COMPUTE_BIT,
 	}; // each entry stands for one queue and its capabilities
 
-	uint32_t         data_frames_count = 2; // mumber of backend data frames - must be at minimum 2
-	uint32_t         concurrency_count = 1; // number of potential worker threads
+	uint32_t         data_frames_count = 2;     // mumber of backend data frames - must be at minimum 2
+	uint32_t         concurrency_count = 0;     // number of potential worker threads - 0 means that the job system is not running
+	bool             bindless_enabled  = false; // whether to use bindless descriptor mode
 	std::atomic_bool readonly          = false;
 };
 
@@ -124,8 +125,8 @@ static le_backend_vk_settings_o* le_backend_vk_settings_create() {
 	        .sampleRateShading                       = VK_TRUE, // so that we can use sampleShadingEnable
 	        .dualSrcBlend                            = 0,
 	        .logicOp                                 = 0,
-	        .multiDrawIndirect                       = 0,
-	        .drawIndirectFirstInstance               = 0,
+	        .multiDrawIndirect                       = VK_TRUE, // so that indirect draws may have drawCount > 1
+	        .drawIndirectFirstInstance               = VK_TRUE,
 	        .depthClamp                              = 0,
 	        .depthBiasClamp                          = 0,
 	        .fillModeNonSolid                        = VK_TRUE,
@@ -201,7 +202,9 @@ static le_backend_vk_settings_o* le_backend_vk_settings_create() {
 
 	// Apply some customisations
 
-	self->requested_device_features.vk_13.synchronization2 = VK_TRUE; // use synchronisation2 by default
+	self->requested_device_features.vk_13.synchronization2  = VK_TRUE; // use synchronisation2 by default
+	self->requested_device_features.vk_12.drawIndirectCount = VK_TRUE; // needed for encoder draw_indirect_count
+	self->requested_device_features.vk_12.hostQueryReset    = VK_TRUE; // needed to reset gpu timestamp queries from the host
 
 #ifdef LE_FEATURE_VIDEO
 	le_backend_vk_settings_add_required_device_extension( self, VK_KHR_VIDEO_QUEUE_EXTENSION_NAME );
@@ -265,6 +268,13 @@ static void le_backend_vk_settings_set_concurrency_count( uint32_t concurrency_c
 	self->concurrency_count        = concurrency_count;
 }
 
+// ----------------------------------------------------------------------
+
+static uint32_t le_backend_vk_settings_get_concurrency_count() {
+	le_backend_vk_settings_o* self = le_backend_vk::api->backend_settings_singleton;
+	return self->concurrency_count;
+}
+
 // ----------------------------------------------------------------------
 static bool le_backend_vk_settings_set_data_frames_count( uint32_t data_frames_count ) {
 	le_backend_vk_settings_o* self = le_backend_vk::api->backend_settings_singleton;
@@ -276,6 +286,41 @@ static bool le_backend_vk_settings_set_data_frames_count( uint32_t data_frames_c
 	return true;
 }
 
+// ----------------------------------------------------------------------
+// Bindless descriptor mode needs descriptor indexing - which is core since Vulkan 1.2,
+// so we request the corresponding Vulkan 1.2 features instead of VK_EXT_descriptor_indexing.
+static bool le_backend_vk_settings_set_bindless_enabled( bool enabled ) {
+	le_backend_vk_settings_o* self = le_backend_vk::api->backend_settings_singleton;
+	if ( self->readonly ) {
+		static auto logger = LeLog( "le_backend_vk_settings" );
+		logger.error( "Cannot change bindless mode once the backend has been set up" );
+		return false;
+	}
+	// ----------| invariant: settings is not readonly
+	self->bindless_enabled = enabled;
+
+	if ( enabled ) {
+		auto& vk_12 = self->requested_device_features.vk_12;
+
+		vk_12.descriptorIndexing                            = VK_TRUE;
+		vk_12.runtimeDescriptorArray                        = VK_TRUE;
+		vk_12.descriptorBindingPartiallyBound               = VK_TRUE;
+		vk_12.descriptorBindingSampledImageUpdateAfterBind  = VK_TRUE;
+		vk_12.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+		vk_12.descriptorBindingUpdateUnusedWhilePending     = VK_TRUE;
+		vk_12.shaderSampledImageArrayNonUniformIndexing     = VK_TRUE;
+		vk_12.shaderStorageBufferArrayNonUniformIndexing    = VK_TRUE;
+	}
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+static bool le_backend_vk_settings_get_bindless_enabled() {
+	le_backend_vk_settings_o* self = le_backend_vk::api->backend_settings_singleton;
+	return self->bindless_enabled;
+}
+
 // ----------------------------------------------------------------------
 
 static VkPhysicalDeviceFeatures2 const* le_backend_vk_get_requested_physical_device_features_chain() {
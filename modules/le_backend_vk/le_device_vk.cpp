@@ -11,6 +11,7 @@
 #include <cstring> // for memcpy
 #include <cassert>
 #include <bitset>
+#include <algorithm> // for std::find_if
 
 static constexpr auto LOGGER_LABEL = "le_backend";
 
@@ -178,6 +179,79 @@ std::vector<QueueQueryResult> findBestMatchForRequestedQueues( const std::vector
 	return result;
 }
 
+// ----------------------------------------------------------------------
+/// \brief Add a queue which async compute passes may be submitted to, unless
+///        queues that were requested already include such a queue.
+/// \details Async compute passes must go to a compute-capable queue other than
+///          the first graphics queue (which is the backend's default queue).
+///          We prefer a second queue from the family of the graphics queue, as
+///          resources then don't need to be shared between queue families. If
+///          the graphics family has no spare queue, we pick the compute-capable
+///          family with the fewest extra capabilities, which will typically be a
+///          dedicated compute family.
+///          The new queue goes last, so that indices of requested queues don't change.
+static void addAsyncComputeQueueIfNeeded( const std::vector<VkQueueFamilyProperties2>& props, std::vector<QueueQueryResult>& queues ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	auto graphics_queue = std::find_if( queues.begin(), queues.end(), []( QueueQueryResult const& q ) {
+		return ( q.queue_family_flags & VK_QUEUE_GRAPHICS_BIT );
+	} );
+
+	if ( graphics_queue == queues.end() ) {
+		// No graphics queue: there is no main queue which async compute could overlap with.
+		return;
+	}
+
+	std::vector<uint32_t> usedQueues( props.size(), 0 ); // number of used queues per queue family
+
+	for ( auto const& q : queues ) {
+		usedQueues[ q.queue_family_index ]++;
+		if ( &q != &*graphics_queue && ( q.queue_family_flags & VK_QUEUE_COMPUTE_BIT ) ) {
+			// There is already a compute-capable queue besides the graphics queue.
+			return;
+		}
+	}
+
+	// ---------| invariant: there is no queue that async compute passes could use.
+
+	uint32_t const graphics_family = graphics_queue->queue_family_index;
+
+	uint32_t found_family          = ~uint32_t( 0 );
+	size_t   lowest_num_extra_bits = ~size_t( 0 );
+
+	if ( usedQueues[ graphics_family ] < props[ graphics_family ].queueFamilyProperties.queueCount ) {
+		found_family = graphics_family;
+	} else {
+		for ( uint32_t familyIndex = 0; familyIndex != props.size(); familyIndex++ ) {
+			VkQueueFlags available_flags = props[ familyIndex ].queueFamilyProperties.queueFlags;
+			if ( 0 == ( available_flags & VK_QUEUE_COMPUTE_BIT ) ||
+			     usedQueues[ familyIndex ] >= props[ familyIndex ].queueFamilyProperties.queueCount ) {
+				continue;
+			}
+			size_t num_extra_bits = std::bitset<sizeof( VkQueueFlags ) * 8>( available_flags & ~VkQueueFlags( VK_QUEUE_COMPUTE_BIT ) ).count();
+			if ( num_extra_bits < lowest_num_extra_bits ) {
+				found_family          = familyIndex;
+				lowest_num_extra_bits = num_extra_bits;
+			}
+		}
+	}
+
+	if ( found_family == ~uint32_t( 0 ) ) {
+		logger.info( "No spare compute-capable queue available: async compute passes will execute on the main queue." );
+		return;
+	}
+
+	logger.info( "Adding queue { %s } for async compute.",
+	             le_queue_flags_to_string( le::QueueFlagBits( props[ found_family ].queueFamilyProperties.queueFlags ) ).c_str() );
+
+	queues.push_back( {
+	    .queue_family_index = found_family,
+	    .queue_index        = usedQueues[ found_family ],
+	    .queue_family_flags = props[ found_family ].queueFamilyProperties.queueFlags,
+	} );
+}
+
 // ----------------------------------------------------------------------
 
 static le_device_o* device_create( le_backend_vk_instance_o* backend_instance, const char** extension_names, uint32_t extension_names_count ) {
@@ -289,6 +363,12 @@ static le_device_o* device_create( le_backend_vk_instance_o* backend_instance, c
 	std::vector<QueueQueryResult> available_queues =
 	    findBestMatchForRequestedQueues( self->properties.queue_family_properties, requested_queues );
 
+	LE_SETTING( bool, LE_SETTING_RENDERGRAPH_ENABLE_ASYNC_COMPUTE, true );
+
+	if ( *LE_SETTING_RENDERGRAPH_ENABLE_ASYNC_COMPUTE ) {
+		addAsyncComputeQueueIfNeeded( self->properties.queue_family_properties, available_queues );
+	}
+
 	// Create queues based on available_queues
 	std::vector<VkDeviceQueueCreateInfo> device_queue_creation_infos;
 	// Consolidate queues by queue family type - this will also sort by queue family type.
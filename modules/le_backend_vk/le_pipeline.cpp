@@ -10,12 +10,13 @@
 #include <fstream>    // for reading shader source files
 #include <cstring>    // for memcpy
 #include <mutex>
-#include <shared_mutex>
 #include <atomic>
 #include <algorithm>
+#include <chrono>
 
 #include "le_core.h"
 #include "le_shader_compiler.h"
+#include "le_jobs.h" // for compiling pipelines in the background
 
 #include "util/spirv_reflect/spirv_reflect.h"
 
@@ -25,8 +26,16 @@
 
 static constexpr auto LOGGER_LABEL = "le_pipeline";
 
+#ifdef _MSC_VER
+#	define NOMINMAX     // we do this so that Windows.h does not define min and max macros
+#	include <Windows.h> // for getModule
+#else
+#	include <unistd.h> // for getexepath
+#endif
+
 #include <vulkan/vulkan.h>
 #include "private/le_backend_vk/le_backend_types_pipeline.inl"
+#include "private/le_backend_vk/le_concurrent_hash_map.inl"
 
 typedef void ( *file_watcher_callback_fun_t )( char const*, void* );
 
@@ -53,153 +62,6 @@ struct le_shader_module_o {
 	specialization_map_info_t                      specialization_map_info; ///< information concerning specialization constants for this shader stage
 };
 
-// A table from `handle` -> `object*`, protected by mutex.
-//
-// Access is internally synchronised.
-//
-// lookup time will deteriorate linearly with number of elements,
-// but cache locality is very good for lookups, so this should work
-// fairly well for small number of resources such as pipelines.
-template <typename T, typename U>
-class HashTable : NoCopy, NoMove {
-
-	std::shared_mutex mtx;
-	std::vector<T>    handles;
-	std::vector<U*>   objects; // owning, object is copied on add_entry
-
-  public:
-	// Insert a new obj into table, object is copied.
-	// return true if successful, false if entry aready existed.
-	// in case return value is false, object was not copied.
-	bool try_insert( T const& handle, U* obj ) {
-		mtx.lock();
-		size_t i = 0;
-		for ( auto const& h : handles ) {
-			if ( h == handle ) {
-				break;
-			}
-			i++;
-		}
-		if ( i != handles.size() ) {
-			// entry already existed - this is strange.
-			mtx.unlock();
-			return false;
-		}
-		// -------| invariant: i == handles.size()
-		handles.push_back( handle );
-		objects.emplace_back( new U( *obj ) ); // make a copy
-		mtx.unlock();
-		return true;
-	}
-
-	// Looks up table entry under `needle`,
-	// returns nullptr if not found.
-	U* const try_find( T const& needle ) {
-		mtx.lock_shared();
-		U* const* obj = objects.data();
-		for ( auto const& h : handles ) {
-			if ( h == needle ) {
-				mtx.unlock();
-				return *obj;
-			}
-			obj++;
-		}
-		// --------| Invariant: no handle matching needle found
-		mtx.unlock();
-		return nullptr;
-	}
-
-	typedef void ( *iterator_fun )( U* e, void* user_data );
-
-	// do something on all objects
-	void iterator( iterator_fun fun, void* user_data ) {
-		mtx.lock();
-		for ( auto& e : objects ) {
-			fun( e, user_data );
-		}
-		mtx.unlock();
-	}
-
-	void clear() {
-		mtx.lock();
-		for ( auto& obj : objects ) {
-			delete obj;
-		}
-		handles.clear();
-		objects.clear();
-		mtx.unlock();
-	}
-
-	~HashTable() {
-		clear();
-	}
-};
-
-//
-template <typename S, typename T>
-class HashMap : NoCopy, NoMove {
-
-	std::shared_mutex         mtx;
-	std::unordered_map<S, T*> store; // owning, object is copied on successful try_insert
-
-  public:
-	T* try_find( S needle ) {
-		mtx.lock_shared();
-		auto e = store.find( needle );
-		if ( e == store.end() ) {
-			mtx.unlock();
-			return nullptr;
-		} else {
-			auto ret = e->second;
-			mtx.unlock();
-			return ret;
-		}
-	}
-	// returns true and stores copy of obj in internal hash - or
-	// returns false if element with key already existed.
-	bool try_insert( S handle, T* obj ) {
-
-		mtx.lock();
-
-		// we attempt an insertion - a nullptr will go in as a placeholder
-		// because we cannot tell at this point whether the insertion will
-		// be successful.
-		auto result = store.emplace( handle, nullptr );
-
-		if ( result.second ) {
-			// Insertion was successful - replace the placeholder with a copy of the actual object.
-			result.first->second = new T( *obj );
-		}
-
-		mtx.unlock();
-
-		return result.second;
-	}
-
-	typedef void ( *iterator_fun )( T* e, void* user_data );
-
-	// do something on all objects
-	void iterator( iterator_fun fun, void* user_data ) {
-		mtx.lock();
-		for ( auto& e : store ) {
-			fun( e.second, user_data );
-		}
-		mtx.unlock();
-	}
-
-	void clear() {
-		mtx.lock();
-		for ( auto& e : store ) {
-			delete ( e.second );
-		}
-		store.clear();
-		mtx.unlock();
-	}
-	~HashMap() {
-		clear();
-	}
-};
-
 struct ProtectedModuleDependencies {
 	std::mutex                                                         mtx;
 	std::unordered_map<std::string, std::set<le_shader_module_handle>> moduleDependencies; // map 'canonical shader source file path, watch_id' -> [shader modules]
@@ -210,7 +72,7 @@ struct ProtectedModuleDependencies {
 struct le_shader_manager_o {
 	VkDevice device = nullptr;
 
-	HashMap<le_shader_module_handle, le_shader_module_o> shaderModules; // OWNING. Stores all shader modules used in backend, indexed via shader_module_handle
+	ConcurrentHashMap<le_shader_module_handle, le_shader_module_o> shaderModules; // OWNING. Stores all shader modules used in backend, indexed via shader_module_handle
 
 	ProtectedModuleDependencies protected_module_dependencies; // must lock mutex before using.
 
@@ -220,6 +82,8 @@ struct le_shader_manager_o {
 	le_file_watcher_o*    shaderFileWatcher = nullptr; // owning
 };
 
+struct le_pipeline_compile_request_t; // ffdecl
+
 // NOTE: It might make sense to have one pipeline manager per worker thread, and
 //       to consolidate after the frame has been processed.
 struct le_pipeline_manager_o {
@@ -230,18 +94,28 @@ struct le_pipeline_manager_o {
 
 	VkPipelineCache vulkanCache = nullptr;
 
+	std::filesystem::path                 pipeline_cache_path;                  // file which vulkanCache gets persisted to, empty if pipeline cache is not persistent
+	std::atomic<uint32_t>                 num_pipelines_since_cache_store = 0;  // number of pipelines created since vulkanCache was last written to disk
+	std::chrono::steady_clock::time_point pipeline_cache_store_time       = {}; // when vulkanCache was last written to disk
+
 	le_shader_manager_o* shaderManager = nullptr; // owning: does it make sense to have a shader manager additionally to the pipeline manager?
 
-	HashTable<le_gpso_handle, graphics_pipeline_state_o> graphicsPso;
-	HashTable<le_cpso_handle, compute_pipeline_state_o>  computePso;
-	HashTable<le_rtxpso_handle, rtx_pipeline_state_o>    rtxPso;
+	ConcurrentHashMap<le_gpso_handle, graphics_pipeline_state_o> graphicsPso;
+	ConcurrentHashMap<le_cpso_handle, compute_pipeline_state_o>  computePso;
+	ConcurrentHashMap<le_rtxpso_handle, rtx_pipeline_state_o>    rtxPso;
 
-	HashMap<uint64_t, VkPipeline>              pipelines;             // indexed by pipeline_hash
-	HashTable<uint64_t, char*>                 rtx_shader_group_data; // indexed by pipeline_hash
-	HashMap<uint64_t, le_pipeline_layout_info> pipelineLayoutInfos;
+	ConcurrentHashMap<uint64_t, VkPipeline>              pipelines;             // indexed by pipeline_hash
+	ConcurrentHashMap<uint64_t, char*>                   rtx_shader_group_data; // indexed by pipeline_hash
+	ConcurrentHashMap<uint64_t, le_pipeline_layout_info> pipelineLayoutInfos;
 
-	HashMap<uint64_t, le_descriptor_set_layout_t> descriptorSetLayouts;
-	HashMap<uint64_t, VkPipelineLayout>           pipelineLayouts; // indexed by hash of array of descriptorSetLayoutCache keys per pipeline layout
+	ConcurrentHashMap<uint64_t, le_descriptor_set_layout_t> descriptorSetLayouts;
+	ConcurrentHashMap<uint64_t, VkPipelineLayout>           pipelineLayouts; // indexed by hash of array of descriptorSetLayoutCache keys per pipeline layout
+
+	std::once_flag bindless_set_layout_once; // global bindless descriptor set layout gets created on first use, and lives in descriptorSetLayouts
+
+	std::mutex                                         compile_requests_mtx;        // protects compile_requests, and graphics_pipeline_fallbacks
+	std::vector<le_pipeline_compile_request_t*>        compile_requests;            // owning: pipelines which are being compiled in the background
+	std::unordered_map<le_gpso_handle, le_gpso_handle> graphics_pipeline_fallbacks; // used while the pipeline for a gpso is being compiled
 };
 
 static VkFormat vk_format_from_spv_reflect_format( SpvReflectFormat const& format ) {
@@ -1165,15 +1039,21 @@ static void le_shader_manager_shader_module_update( le_shader_manager_o* self, l
 }
 
 // ----------------------------------------------------------------------
-// this method is called via renderer::update - before frame processing.
-static void le_shader_manager_update_shader_modules( le_shader_manager_o* self ) {
-
-	// -- find out which shader modules have been tainted
+// Finds out which shader modules have been tainted - returns true if any
+// shader modules need updating.
+static bool le_shader_manager_poll_shader_modules( le_shader_manager_o* self ) {
 
 	// this will call callbacks on any watched file objects as a side effect
 	// callbacks will modify le_backend->modifiedShaderModules
 	le_file_watcher::le_file_watcher_i.poll_notifications( self->shaderFileWatcher );
 
+	return !self->modifiedShaderModules.empty();
+}
+
+// ----------------------------------------------------------------------
+// this method is called via renderer::update - before frame processing.
+static void le_shader_manager_update_shader_modules( le_shader_manager_o* self ) {
+
 	// -- update only modules which have been tainted
 
 	for ( auto& s : self->modifiedShaderModules ) {
@@ -1601,6 +1481,7 @@ static VkPipeline le_pipeline_cache_create_graphics_pipeline( le_pipeline_manage
 
 	VkPipeline pipeline = nullptr;
 	auto       result   = vkCreateGraphicsPipelines( self->device, self->vulkanCache, 1, &gpi, nullptr, &pipeline );
+	self->num_pipelines_since_cache_store++;
 
 	// cleanup temporary specialisation info objects
 	for ( auto& p_spec : p_specialization_infos ) {
@@ -1654,6 +1535,7 @@ static VkPipeline le_pipeline_cache_create_compute_pipeline( le_pipeline_manager
 
 	VkPipeline pipeline = nullptr;
 	auto       result   = vkCreateComputePipelines( self->device, self->vulkanCache, 1, &cpi, nullptr, &pipeline );
+	self->num_pipelines_since_cache_store++;
 
 	// cleanup temporary specialisation info objects
 	delete ( p_specialization_info );
@@ -1752,6 +1634,7 @@ static VkPipeline le_pipeline_cache_create_rtx_pipeline( le_pipeline_manager_o*
 
 	VkPipeline pipeline = nullptr;
 	auto       result   = vkCreateRayTracingPipelinesKHR( self->device, nullptr, self->vulkanCache, 1, &create_info, nullptr, &pipeline );
+	self->num_pipelines_since_cache_store++;
 
 	assert( VK_SUCCESS == result );
 	return pipeline;
@@ -1897,11 +1780,97 @@ static uint64_t le_pipeline_cache_produce_descriptor_set_layout( le_pipeline_man
 	return set_layout_hash;
 }
 
+// ----------------------------------------------------------------------
+
+static constexpr uint64_t LE_BINDLESS_SET_LAYOUT_KEY = hash_64_fnv1a_const( "le_bindless_descriptor_set_layout" );
+
+/// \brief returns key for global bindless descriptor set layout, creates layout on first call.
+/// Returns 0 if bindless mode is not enabled.
+static uint64_t le_pipeline_manager_produce_bindless_descriptor_set_layout( le_pipeline_manager_o* self ) {
+	using namespace le_backend_vk;
+
+	if ( false == settings_i.get_bindless_enabled() ) {
+		return 0;
+	}
+
+	// ----------| invariant: bindless mode is enabled
+
+	std::call_once( self->bindless_set_layout_once, [ self ]() {
+		// Descriptors are partially bound: only elements which shaders actually access must be valid.
+		// We use update-after-bind, as this raises per-stage descriptor limits to what we need.
+		VkDescriptorBindingFlags const binding_flags =
+		    VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+		    VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+		    VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+
+		VkDescriptorBindingFlags flags[ 2 ] = { binding_flags, binding_flags };
+
+		VkDescriptorSetLayoutBinding bindings[ 2 ] = {
+		    {
+		        .binding            = LE_BINDLESS_BINDING_TEXTURES,
+		        .descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+		        .descriptorCount    = LE_BINDLESS_MAX_TEXTURES,
+		        .stageFlags         = VK_SHADER_STAGE_ALL,
+		        .pImmutableSamplers = nullptr, // optional
+		    },
+		    {
+		        .binding            = LE_BINDLESS_BINDING_BUFFERS,
+		        .descriptorType     = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+		        .descriptorCount    = LE_BINDLESS_MAX_BUFFERS,
+		        .stageFlags         = VK_SHADER_STAGE_ALL,
+		        .pImmutableSamplers = nullptr, // optional
+		    },
+		};
+
+		VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info = {
+		    .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+		    .pNext         = nullptr, // optional
+		    .bindingCount  = 2,       // optional
+		    .pBindingFlags = flags,
+		};
+
+		VkDescriptorSetLayoutCreateInfo setLayoutInfo = {
+		    .sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+		    .pNext        = &binding_flags_info,
+		    .flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+		    .bindingCount = 2,
+		    .pBindings    = bindings,
+		};
+
+		// Binding info stays empty: the backend does not collect arguments for this set,
+		// it binds its own bindless descriptor set instead. There is no update template either.
+		le_descriptor_set_layout_t le_layout_info{};
+		vkCreateDescriptorSetLayout( self->device, &setLayoutInfo, nullptr, &le_layout_info.vk_descriptor_set_layout );
+		le_layout_info.vk_descriptor_update_template = nullptr;
+
+		bool result = self->descriptorSetLayouts.try_insert( LE_BINDLESS_SET_LAYOUT_KEY, &le_layout_info );
+
+		assert( result && "bindless descriptorSetLayout insertion must be successful" );
+	} );
+
+	return LE_BINDLESS_SET_LAYOUT_KEY;
+}
+
+// ----------------------------------------------------------------------
+// A set is a bindless set if any of its bindings uses one of the reserved bindless names.
+static bool shader_bindings_are_bindless_set( std::vector<le_shader_binding_info> const& bindings ) {
+	static constexpr uint64_t BINDLESS_TEXTURES_NAME_HASH = hash_64_fnv1a_const( "le_bindless_textures" );
+	static constexpr uint64_t BINDLESS_BUFFERS_NAME_HASH  = hash_64_fnv1a_const( "le_bindless_buffers" ); // buffers are named by their block type name
+
+	for ( auto const& b : bindings ) {
+		if ( b.name_hash == BINDLESS_TEXTURES_NAME_HASH || b.name_hash == BINDLESS_BUFFERS_NAME_HASH ) {
+			return true;
+		}
+	}
+	return false;
+}
+
 // ----------------------------------------------------------------------
 // Calculates pipeline layout info by first consolidating all bindings
 // over all referenced shader modules, and then ordering these by descriptor sets.
 //
 static le_pipeline_layout_info le_pipeline_manager_produce_pipeline_layout_info( le_pipeline_manager_o* self, le_shader_module_handle const* shader_modules, size_t shader_modules_count ) {
+	static auto             logger = LeLog( LOGGER_LABEL );
 	le_pipeline_layout_info info{};
 
 	std::vector<le_shader_binding_info> combined_bindings = shader_modules_merge_bindings( self->shaderManager, shader_modules, shader_modules_count );
@@ -1943,6 +1912,11 @@ static le_pipeline_layout_info le_pipeline_manager_produce_pipeline_layout_info(
 			// which combines various shader stages.
 			set_idx = 0;
 			for ( auto const& s : sets ) {
+				if ( shader_bindings_are_bindless_set( s ) ) {
+					// bindless sets use the global bindless layout - their bindings are not ours to check
+					set_idx++;
+					continue;
+				}
 				uint32_t binding = 0;
 				for ( auto const& b : s ) {
 					assert( b.binding == binding );
@@ -1954,6 +1928,19 @@ static le_pipeline_layout_info le_pipeline_manager_produce_pipeline_layout_info(
 		}
 
 		for ( size_t i = 0; i != sets.size(); ++i ) {
+
+			if ( shader_bindings_are_bindless_set( sets[ i ] ) ) {
+				uint64_t bindless_key = le_pipeline_manager_produce_bindless_descriptor_set_layout( self );
+				if ( bindless_key ) {
+					info.set_layout_keys[ i ] = bindless_key;
+					vkLayouts[ i ]            = self->descriptorSetLayouts.try_find( bindless_key )->vk_descriptor_set_layout;
+					continue;
+				}
+				logger.error( "Shader declares bindless descriptor set (set = %zu), but bindless mode is not enabled. "
+				              "Enable it via backend settings: `set_bindless_enabled`.",
+				              i );
+			}
+
 			info.set_layout_keys[ i ] = le_pipeline_cache_produce_descriptor_set_layout( self, sets[ i ], vkLayouts + i );
 		}
 	}
@@ -2023,6 +2010,15 @@ static inline void le_pipeline_manager_produce_pipeline_layout_info(
 	if ( pl ) {
 		*pipeline_layout_info = *pl;
 	} else {
+		// Slow path: we must create the layout - only one thread may do this at a time.
+		auto lock = std::unique_lock( self->mtx );
+
+		// Another thread might have created the layout while we were waiting for the lock.
+		if ( ( pl = self->pipelineLayoutInfos.try_find( *pipeline_layout_hash ) ) ) {
+			*pipeline_layout_info = *pl;
+			return;
+		}
+
 		// this will also create vulkan objects for pipeline layout / descriptor set layout and cache them
 		*pipeline_layout_info = le_pipeline_manager_produce_pipeline_layout_info( self, shader_modules, shader_modules_count );
 		// store in cache
@@ -2031,23 +2027,179 @@ static inline void le_pipeline_manager_produce_pipeline_layout_info(
 	}
 }
 
+// ----------------------------------------------------------------------
+// Background pipeline compilation
+//
+// If the job system is running, pipelines which are not found in the
+// pipeline cache get compiled by a job, instead of inline, while the
+// encoder is recording. Until a pipeline is ready, produce_*_pipeline
+// returns a null pipeline (but a valid layout), and the backend skips
+// draws and dispatches which would use it - or uses the fallback pipeline
+// for the requested gpso, if one was set, and if it is ready.
+
+struct le_pipeline_compile_request_t {
+	le_pipeline_manager_o*           manager       = nullptr;
+	uint64_t                         pipeline_hash = 0;       // key under which the pipeline is stored once compiled
+	graphics_pipeline_state_o const* gpso          = nullptr; // non-owning, set if this is a graphics pipeline
+	compute_pipeline_state_o const*  cpso          = nullptr; // non-owning, set if this is a compute pipeline
+	BackendRenderPass                pass          = {};      // only renderPass, numColorAttachments, and sampleCount are set - that's all that pipeline creation needs
+	uint32_t                         subpass       = 0;       //
+	le_jobs::counter_t*              counter       = nullptr; // owned by job system, freed once we wait for it
+	std::atomic_bool                 is_complete   = false;   // set by job once the pipeline has been stored
+};
+
+// ----------------------------------------------------------------------
+
+static void le_pipeline_compile_job( void* user_data ) {
+	static auto logger  = LeLog( LOGGER_LABEL );
+	auto        request = static_cast<le_pipeline_compile_request_t*>( user_data );
+	auto        self    = request->manager;
+
+	VkPipeline pipeline = request->gpso
+	                          ? le_pipeline_cache_create_graphics_pipeline( self, request->gpso, request->pass, request->subpass )
+	                          : le_pipeline_cache_create_compute_pipeline( self, request->cpso );
+
+	logger.info( "New VK %s Pipeline compiled in background: %p", request->gpso ? "Graphics" : "Compute", request->pipeline_hash );
+
+	if ( !self->pipelines.try_insert( request->pipeline_hash, &pipeline ) ) {
+		// Another request for the same pipeline beat us to it - this can happen if a request
+		// was retired while we were being scheduled. We keep the pipeline which was there first.
+		vkDestroyPipeline( self->device, pipeline, nullptr );
+	}
+
+	request->is_complete = true;
+}
+
+// ----------------------------------------------------------------------
+// Returns whether pipelines get compiled in the background - this is only possible if the job system is running.
+static bool le_pipeline_manager_uses_background_compilation() {
+	LE_SETTING( bool, LE_SETTING_PIPELINE_BACKGROUND_COMPILATION, true );
+	return *LE_SETTING_PIPELINE_BACKGROUND_COMPILATION &&
+	       le_backend_vk::settings_i.get_concurrency_count() > 0;
+}
+
+// ----------------------------------------------------------------------
+// Schedules compilation of a pipeline, unless it is already scheduled.
+static void le_pipeline_manager_request_pipeline_compile( le_pipeline_manager_o* self, uint64_t pipeline_hash, graphics_pipeline_state_o const* gpso, compute_pipeline_state_o const* cpso, BackendRenderPass const* pass, uint32_t subpass ) {
+
+	auto lock = std::unique_lock( self->compile_requests_mtx );
+
+	for ( auto const& r : self->compile_requests ) {
+		if ( r->pipeline_hash == pipeline_hash ) {
+			return; // already scheduled
+		}
+	}
+
+	// A request for this pipeline might have completed, and been retired, since we last looked.
+	if ( self->pipelines.try_find( pipeline_hash ) ) {
+		return;
+	}
+
+	// ---------| invariant: pipeline is neither available, nor scheduled
+
+	auto request           = new le_pipeline_compile_request_t{};
+	request->manager       = self;
+	request->pipeline_hash = pipeline_hash;
+	request->gpso          = gpso;
+	request->cpso          = cpso;
+	request->subpass       = subpass;
+
+	if ( pass ) {
+		request->pass.renderPass          = pass->renderPass;
+		request->pass.numColorAttachments = pass->numColorAttachments;
+		request->pass.sampleCount         = pass->sampleCount;
+	}
+
+	le_jobs::job_t job{ le_pipeline_compile_job, request };
+	le_jobs::run_jobs( &job, 1, &request->counter );
+
+	self->compile_requests.push_back( request );
+}
+
+// ----------------------------------------------------------------------
+// Frees compile requests which have completed. If `wait_for_all` is set, we first
+// wait for all requests to complete. If `render_pass` is set, we only wait for
+// requests which use this render pass.
+static void le_pipeline_manager_retire_compile_requests( le_pipeline_manager_o* self, bool wait_for_all, VkRenderPass render_pass = nullptr ) {
+
+	std::vector<le_pipeline_compile_request_t*> retired_requests;
+
+	{
+		auto lock = std::unique_lock( self->compile_requests_mtx );
+
+		auto it = std::partition( self->compile_requests.begin(), self->compile_requests.end(),
+		                          [ & ]( le_pipeline_compile_request_t const* r ) -> bool {
+			                          bool must_wait = wait_for_all && ( render_pass == nullptr || r->pass.renderPass == render_pass );
+			                          return !( r->is_complete || must_wait ); // true means: keep
+		                          } );
+
+		retired_requests.assign( it, self->compile_requests.end() );
+		self->compile_requests.erase( it, self->compile_requests.end() );
+	}
+
+	// We wait outside the lock, as waiting may yield the current fiber if we're called from within a job.
+	// Note that the counter only drops to zero once the job function has returned, which is why we
+	// must wait even if a request is complete.
+	for ( auto r : retired_requests ) {
+		le_jobs::wait_for_counter_and_free( r->counter, 0 );
+		delete r;
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static uint32_t le_pipeline_manager_get_num_pending_pipelines( le_pipeline_manager_o* self ) {
+	auto lock = std::unique_lock( self->compile_requests_mtx );
+	return uint32_t( std::count_if( self->compile_requests.begin(), self->compile_requests.end(),
+	                                []( le_pipeline_compile_request_t const* r ) { return !r->is_complete; } ) );
+}
+
+// ----------------------------------------------------------------------
+// Blocks until all pipelines which are being compiled in the background are ready.
+static void le_pipeline_manager_wait_for_pending_pipelines( le_pipeline_manager_o* self ) {
+	le_pipeline_manager_retire_compile_requests( self, true );
+}
+
+// ----------------------------------------------------------------------
+// Must be called before a render pass gets destroyed: background compilation may still use it.
+static void le_pipeline_manager_release_render_pass( le_pipeline_manager_o* self, VkRenderPass render_pass ) {
+	le_pipeline_manager_retire_compile_requests( self, true, render_pass );
+}
+
+// ----------------------------------------------------------------------
+// Designates a fallback for a graphics pipeline state: while the pipeline for `gpso`
+// is not ready, draws use the pipeline for `fallback_gpso` instead - if that is ready.
+// Pass nullptr as fallback_gpso to remove the fallback for `gpso`.
+static void le_pipeline_manager_set_graphics_pipeline_fallback( le_pipeline_manager_o* self, le_gpso_handle gpso, le_gpso_handle fallback_gpso ) {
+	auto lock = std::unique_lock( self->compile_requests_mtx );
+	if ( fallback_gpso && fallback_gpso != gpso ) {
+		self->graphics_pipeline_fallbacks[ gpso ] = fallback_gpso;
+	} else {
+		self->graphics_pipeline_fallbacks.erase( gpso );
+	}
+}
+
 // ----------------------------------------------------------------------
 
 /// \brief Creates - or loads a pipeline from cache - based on current pipeline state
-/// \note This method may lock the gpso/cpso cache and is therefore costly.
+/// \note If the pipeline is not in the cache, this method is costly: it either schedules
+///       the pipeline for background compilation, or, if the job system is not running,
+///       creates the pipeline while holding the pipeline manager lock.
 //
 // + Only the 'command buffer recording'-slice of a frame shall be able to modify the cache.
 //   The cache must be exclusively accessed through this method
 //
-// + NOTE: Access to this method must be sequential - no two frames may access this method
-//   at the same time - and no two renderpasses may access this method at the same time.
-static le_pipeline_and_layout_info_t le_pipeline_manager_produce_graphics_pipeline(
+// + If the pipeline is being compiled in the background, the returned pipeline is either
+//   the pipeline for the fallback gpso for `gpso_handle` (with the fallback's layout), or
+//   nullptr (with a valid layout), in which case draws using it must be skipped.
+static le_pipeline_and_layout_info_t le_pipeline_manager_produce_graphics_pipeline_impl(
     le_pipeline_manager_o*   self,
     le_gpso_handle           gpso_handle,
-    const BackendRenderPass& pass, uint32_t subpass ) {
+    const BackendRenderPass& pass, uint32_t subpass,
+    bool                     allow_fallback ) {
 
-	// TODO: Do we need this lock, or are the try_finds with their internal mutexes enough?
-	auto lock = std::unique_lock( self->mtx ); // Enforce sequentiality via scoped lock: no two renderpasses may access cache concurrently.
+	// Note that we don't lock here: lookups into caches are lock-free, and slow paths
+	// which create objects take the lock themselves.
 
 	// TODO: Check whether the current gpso is dirty - if not, we should be able to use a cached version
 	// via self.pipelines
@@ -2100,8 +2252,36 @@ static le_pipeline_and_layout_info_t le_pipeline_manager_produce_graphics_pipeli
 	if ( p ) {
 		// pipeline exists
 		pipeline_and_layout_info.pipeline = *p;
+	} else if ( le_pipeline_manager_uses_background_compilation() ) {
+		// -- if not, compile pipeline in the background - until it is ready, we use the
+		// fallback pipeline, if there is one, otherwise we return a null pipeline.
+		le_pipeline_manager_request_pipeline_compile( self, pipeline_hash, pso, nullptr, &pass, subpass );
+
+		le_gpso_handle fallback_gpso = nullptr;
+		if ( allow_fallback ) {
+			auto lock = std::unique_lock( self->compile_requests_mtx );
+			auto it   = self->graphics_pipeline_fallbacks.find( gpso_handle );
+			if ( it != self->graphics_pipeline_fallbacks.end() ) {
+				fallback_gpso = it->second;
+			}
+		}
+
+		if ( fallback_gpso ) {
+			auto fallback = le_pipeline_manager_produce_graphics_pipeline_impl( self, fallback_gpso, pass, subpass, false );
+			if ( fallback.pipeline ) {
+				return fallback;
+			}
+		}
 	} else {
 		// -- if not, create pipeline in pipeline cache and store / retain it
+		auto lock = std::unique_lock( self->mtx );
+
+		// Another thread might have created the pipeline while we were waiting for the lock.
+		if ( ( p = self->pipelines.try_find( pipeline_hash ) ) ) {
+			pipeline_and_layout_info.pipeline = *p;
+			return pipeline_and_layout_info;
+		}
+
 		pipeline_and_layout_info.pipeline = le_pipeline_cache_create_graphics_pipeline( self, pso, pass, subpass );
 		logger.info( "New VK Graphics Pipeline created: %p", pipeline_hash );
 		bool result = self->pipelines.try_insert( pipeline_hash, &pipeline_and_layout_info.pipeline );
@@ -2111,6 +2291,12 @@ static le_pipeline_and_layout_info_t le_pipeline_manager_produce_graphics_pipeli
 	return pipeline_and_layout_info;
 }
 
+// ----------------------------------------------------------------------
+
+static le_pipeline_and_layout_info_t le_pipeline_manager_produce_graphics_pipeline( le_pipeline_manager_o* self, le_gpso_handle gpso_handle, const BackendRenderPass& pass, uint32_t subpass ) {
+	return le_pipeline_manager_produce_graphics_pipeline_impl( self, gpso_handle, pass, subpass, true );
+}
+
 /// \brief Creates - or loads a pipeline from cache - based on current pipeline state
 /// \note This method may lock the pso cache and is therefore costly.
 //
@@ -2281,8 +2467,19 @@ static le_pipeline_and_layout_info_t le_pipeline_manager_produce_compute_pipelin
 	if ( p ) {
 		// -- if yes, return pipeline found in hash map
 		pipeline_and_layout_info.pipeline = *p;
+	} else if ( le_pipeline_manager_uses_background_compilation() ) {
+		// -- if not, compile pipeline in the background - until it is ready, we return a null pipeline.
+		le_pipeline_manager_request_pipeline_compile( self, pipeline_hash, nullptr, pso, nullptr, 0 );
 	} else {
 		// -- if not, create pipeline in pipeline cache and store / retain it
+		auto lock = std::unique_lock( self->mtx );
+
+		// Another thread might have created the pipeline while we were waiting for the lock.
+		if ( ( p = self->pipelines.try_find( pipeline_hash ) ) ) {
+			pipeline_and_layout_info.pipeline = *p;
+			return pipeline_and_layout_info;
+		}
+
 		pipeline_and_layout_info.pipeline = le_pipeline_cache_create_compute_pipeline( self, pso );
 		logger.info( "New VK Compute Pipeline created: %p", pipeline_hash );
 		bool result = self->pipelines.try_insert( pipeline_hash, &pipeline_and_layout_info.pipeline );
@@ -2418,6 +2615,28 @@ static const le_descriptor_set_layout_t* le_pipeline_manager_get_descriptor_set_
 
 // ----------------------------------------------------------------------
 
+static VkDescriptorSetLayout le_pipeline_manager_get_bindless_descriptor_set_layout( le_pipeline_manager_o* self ) {
+	uint64_t bindless_key = le_pipeline_manager_produce_bindless_descriptor_set_layout( self );
+	if ( 0 == bindless_key ) {
+		return nullptr;
+	}
+	return self->descriptorSetLayouts.try_find( bindless_key )->vk_descriptor_set_layout;
+};
+
+// ----------------------------------------------------------------------
+// Schedules compute pipelines for compilation, so that they are ready by the
+// time they are first used. Use get_num_pending_pipelines, or wait_for_pending_pipelines
+// to find out when they are ready.
+//
+// If the job system is not running, this compiles pipelines immediately.
+static void le_pipeline_manager_prewarm_compute_pipelines( le_pipeline_manager_o* self, le_cpso_handle const* cpso_handles, uint32_t num_handles ) {
+	for ( uint32_t i = 0; i != num_handles; i++ ) {
+		le_pipeline_manager_produce_compute_pipeline( self, cpso_handles[ i ] );
+	}
+}
+
+// ----------------------------------------------------------------------
+
 static le_shader_module_handle le_pipeline_manager_create_shader_module(
     le_pipeline_manager_o*            self,
     char const*                       path,
@@ -2442,10 +2661,428 @@ static le_shader_module_handle le_pipeline_manager_create_shader_module(
 	    specialization_map_data_num_bytes );
 }
 
+// ----------------------------------------------------------------------
+// Pipeline state serialisation
+//
+// Pipeline state objects are serialised together with descriptions of the
+// shader modules they reference, so that they can be re-introduced into a
+// pipeline manager in a different process (e.g. to replay a frame capture).
+//
+// Shader modules are recreated from their source files, using their original
+// handles. Since pipeline handles are derived from pipeline state and shader
+// module hashes, a re-introduced pipeline will have the same handle as the
+// original - as long as the shader sources have not changed.
+//
+// Blobs are only meant to be read by the same build which wrote them.
+
+static void blob_append( std::vector<char>& blob, void const* data, size_t num_bytes ) {
+	blob.insert( blob.end(), static_cast<char const*>( data ), static_cast<char const*>( data ) + num_bytes );
+}
+
+template <typename T>
+static void blob_append_value( std::vector<char>& blob, T const& value ) {
+	blob_append( blob, &value, sizeof( T ) );
+}
+
+// Appends a u32 element count, followed by `count` elements of `element_size` bytes each.
+static void blob_append_array( std::vector<char>& blob, void const* data, uint32_t count, size_t element_size ) {
+	blob_append_value( blob, count );
+	blob_append( blob, data, count * element_size );
+}
+
+struct blob_reader_t {
+	char const* pos;
+	char const* end;
+
+	bool read( void* dst, size_t num_bytes ) {
+		if ( size_t( end - pos ) < num_bytes ) {
+			return false;
+		}
+		memcpy( dst, pos, num_bytes );
+		pos += num_bytes;
+		return true;
+	}
+
+	template <typename T>
+	bool read_value( T& value ) {
+		return read( &value, sizeof( T ) );
+	}
+
+	// Returns a pointer to `count` elements of `element_size` bytes each - pointer is not necessarily aligned.
+	bool read_array( char const** data, uint32_t* count, size_t element_size ) {
+		if ( !read_value( *count ) || size_t( end - pos ) < *count * element_size ) {
+			return false;
+		}
+		*data = pos;
+		pos += *count * element_size;
+		return true;
+	}
+};
+
+// ----------------------------------------------------------------------
+
+static bool shader_manager_serialize_shader_module( le_shader_manager_o* self, le_shader_module_handle handle, std::vector<char>& blob ) {
+
+	le_shader_module_o const* module = self->shaderModules.try_find( handle );
+
+	if ( nullptr == module ) {
+		return false;
+	}
+
+	std::string const path = module->filepath.string();
+
+	blob_append_value( blob, uint64_t( handle ) );
+	blob_append_value( blob, uint32_t( module->stage ) );
+	blob_append_value( blob, uint32_t( module->source_language ) );
+	blob_append_array( blob, path.data(), uint32_t( path.size() ), 1 );
+	blob_append_array( blob, module->macro_defines.data(), uint32_t( module->macro_defines.size() ), 1 );
+	blob_append_array( blob, module->specialization_map_info.entries.data(), uint32_t( module->specialization_map_info.entries.size() ), sizeof( VkSpecializationMapEntry ) );
+	blob_append_array( blob, module->specialization_map_info.data.data(), uint32_t( module->specialization_map_info.data.size() ), 1 );
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Recreates a shader module from its serialised description - returns nullptr on error.
+static le_shader_module_handle shader_manager_deserialize_shader_module( le_shader_manager_o* self, blob_reader_t& reader ) {
+
+	uint64_t    handle;
+	uint32_t    stage;
+	uint32_t    source_language;
+	char const* path;
+	uint32_t    path_size;
+	char const* defines;
+	uint32_t    defines_size;
+	char const* spec_entries;
+	uint32_t    spec_entries_count;
+	char const* spec_data;
+	uint32_t    spec_data_size;
+
+	if ( !reader.read_value( handle ) ||
+	     !reader.read_value( stage ) ||
+	     !reader.read_value( source_language ) ||
+	     !reader.read_array( &path, &path_size, 1 ) ||
+	     !reader.read_array( &defines, &defines_size, 1 ) ||
+	     !reader.read_array( &spec_entries, &spec_entries_count, sizeof( VkSpecializationMapEntry ) ) ||
+	     !reader.read_array( &spec_data, &spec_data_size, 1 ) ) {
+		return nullptr;
+	}
+
+	// Copy into properly aligned storage, as blob data is not necessarily aligned.
+	std::string                           path_str( path, path_size );
+	std::string                           defines_str( defines, defines_size );
+	std::vector<VkSpecializationMapEntry> entries( spec_entries_count );
+	std::vector<char>                     data( spec_data, spec_data + spec_data_size );
+	memcpy( entries.data(), spec_entries, spec_entries_count * sizeof( VkSpecializationMapEntry ) );
+
+	return le_shader_manager_create_shader_module(
+	    self,
+	    path_str.c_str(),
+	    { le::ShaderSourceLanguage( source_language ) },
+	    le::ShaderStage( stage ),
+	    defines_str.c_str(),
+	    reinterpret_cast<le_shader_module_handle>( handle ),
+	    entries.data(),
+	    uint32_t( entries.size() ),
+	    data.data(),
+	    uint32_t( data.size() ) );
+}
+
+// ----------------------------------------------------------------------
+// Copies `blob` to `data` if `capacity` is large enough, returns number of bytes needed.
+static size_t blob_copy_out( std::vector<char> const& blob, void* data, size_t capacity ) {
+	if ( data && capacity >= blob.size() ) {
+		memcpy( data, blob.data(), blob.size() );
+	}
+	return blob.size();
+}
+
+// ----------------------------------------------------------------------
+// Returns number of bytes needed to serialise the pipeline state, or 0 if there is no
+// pipeline state for `handle`. Only writes to `data` if `capacity` is large enough.
+static size_t le_pipeline_manager_serialize_graphics_pipeline_state( le_pipeline_manager_o* self, le_gpso_handle handle, void* data, size_t capacity ) {
+
+	graphics_pipeline_state_o const* pso = self->graphicsPso.try_find( handle );
+
+	if ( nullptr == pso ) {
+		return 0;
+	}
+
+	std::vector<char> blob;
+
+	blob_append_value( blob, pso->data );
+	blob_append_value( blob, uint32_t( pso->shaderModules.size() ) );
+
+	for ( size_t i = 0; i != pso->shaderModules.size(); i++ ) {
+		if ( !shader_manager_serialize_shader_module( self->shaderManager, pso->shaderModules[ i ], blob ) ) {
+			return 0;
+		}
+		blob_append_value( blob, uint32_t( pso->shaderStagePerModule[ i ] ) );
+	}
+
+	blob_append_array( blob, pso->explicitVertexAttributeDescriptions.data(), uint32_t( pso->explicitVertexAttributeDescriptions.size() ), sizeof( le_vertex_input_attribute_description ) );
+	blob_append_array( blob, pso->explicitVertexInputBindingDescriptions.data(), uint32_t( pso->explicitVertexInputBindingDescriptions.size() ), sizeof( le_vertex_input_binding_description ) );
+
+	return blob_copy_out( blob, data, capacity );
+}
+
+// ----------------------------------------------------------------------
+
+static size_t le_pipeline_manager_serialize_compute_pipeline_state( le_pipeline_manager_o* self, le_cpso_handle handle, void* data, size_t capacity ) {
+
+	compute_pipeline_state_o const* pso = self->computePso.try_find( handle );
+
+	if ( nullptr == pso ) {
+		return 0;
+	}
+
+	std::vector<char> blob;
+
+	if ( !shader_manager_serialize_shader_module( self->shaderManager, pso->shaderStage, blob ) ) {
+		return 0;
+	}
+
+	return blob_copy_out( blob, data, capacity );
+}
+
+// ----------------------------------------------------------------------
+// Recreates shader modules and pipeline state from a blob written by serialize_graphics_pipeline_state,
+// and introduces it to the pipeline manager. Returns nullptr on error.
+static le_gpso_handle le_pipeline_manager_deserialize_graphics_pipeline_state( le_pipeline_manager_o* self, void const* data, size_t num_bytes ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	blob_reader_t reader{ static_cast<char const*>( data ), static_cast<char const*>( data ) + num_bytes };
+
+	graphics_pipeline_state_o pso{};
+	uint32_t                  num_modules = 0;
+
+	if ( !reader.read_value( pso.data ) || !reader.read_value( num_modules ) ) {
+		logger.error( "Could not deserialize graphics pipeline state: unexpected end of data." );
+		return nullptr;
+	}
+
+	for ( uint32_t i = 0; i != num_modules; i++ ) {
+		le_shader_module_handle module = shader_manager_deserialize_shader_module( self->shaderManager, reader );
+		uint32_t                stage  = 0;
+		if ( nullptr == module || !reader.read_value( stage ) ) {
+			logger.error( "Could not deserialize shader module for graphics pipeline state." );
+			return nullptr;
+		}
+		pso.shaderModules.push_back( module );
+		pso.shaderStagePerModule.push_back( le::ShaderStage( stage ) );
+	}
+
+	char const* attributes;
+	uint32_t    attributes_count;
+	char const* bindings;
+	uint32_t    bindings_count;
+
+	if ( !reader.read_array( &attributes, &attributes_count, sizeof( le_vertex_input_attribute_description ) ) ||
+	     !reader.read_array( &bindings, &bindings_count, sizeof( le_vertex_input_binding_description ) ) ) {
+		logger.error( "Could not deserialize graphics pipeline state: unexpected end of data." );
+		return nullptr;
+	}
+
+	pso.explicitVertexAttributeDescriptions.resize( attributes_count );
+	pso.explicitVertexInputBindingDescriptions.resize( bindings_count );
+	memcpy( pso.explicitVertexAttributeDescriptions.data(), attributes, attributes_count * sizeof( le_vertex_input_attribute_description ) );
+	memcpy( pso.explicitVertexInputBindingDescriptions.data(), bindings, bindings_count * sizeof( le_vertex_input_binding_description ) );
+
+	le_gpso_handle handle = nullptr;
+	le_pipeline_manager_introduce_graphics_pipeline_state( self, &pso, &handle ); // returns false if pso was already known, which is fine.
+
+	return handle;
+}
+
+// ----------------------------------------------------------------------
+
+static le_cpso_handle le_pipeline_manager_deserialize_compute_pipeline_state( le_pipeline_manager_o* self, void const* data, size_t num_bytes ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	blob_reader_t reader{ static_cast<char const*>( data ), static_cast<char const*>( data ) + num_bytes };
+
+	compute_pipeline_state_o pso{};
+	pso.shaderStage = shader_manager_deserialize_shader_module( self->shaderManager, reader );
+
+	if ( nullptr == pso.shaderStage ) {
+		logger.error( "Could not deserialize shader module for compute pipeline state." );
+		return nullptr;
+	}
+
+	le_cpso_handle handle = nullptr;
+	le_pipeline_manager_introduce_compute_pipeline_state( self, &pso, &handle );
+
+	return handle;
+}
+
 // ----------------------------------------------------------------------
 
 static void le_pipeline_manager_update_shader_modules( le_pipeline_manager_o* self ) {
-	le_shader_manager_update_shader_modules( self->shaderManager );
+
+	// Any shader modules which are about to be updated might be in use by pipelines
+	// which are being compiled in the background - we must wait for these to complete.
+	bool shader_modules_tainted = le_shader_manager_poll_shader_modules( self->shaderManager );
+
+	le_pipeline_manager_retire_compile_requests( self, shader_modules_tainted );
+
+	if ( shader_modules_tainted ) {
+		le_shader_manager_update_shader_modules( self->shaderManager );
+	}
+}
+
+// ----------------------------------------------------------------------
+
+// Returns the path of the file which persists the pipeline cache for a given device.
+// We keep one file per vendor and device id, next to the executable.
+static std::filesystem::path le_pipeline_cache_get_path( VkPhysicalDeviceProperties const* properties ) {
+
+	static std::filesystem::path exe_path = []() {
+		char result[ 1024 ] = { 0 };
+
+#ifdef _MSC_VER
+
+		// When NULL is passed to GetModuleHandle, the handle of the exe itself is returned
+		HMODULE hModule = GetModuleHandle( NULL );
+		if ( hModule != NULL ) {
+			// Use GetModuleFileName() with module handle to get the path
+			GetModuleFileName( hModule, result, ( sizeof( result ) ) );
+		}
+		size_t count = strnlen_s( result, sizeof( result ) );
+#else
+		ssize_t count = readlink( "/proc/self/exe", result, 1024 );
+#endif
+
+		return std::string( result, ( count > 0 ) ? size_t( count ) : 0 );
+	}();
+
+	char filename[ 64 ] = "";
+	snprintf( filename, sizeof( filename ), "pipeline_cache_%08x_%08x.bin", properties->vendorID, properties->deviceID );
+
+	return exe_path.parent_path() / filename;
+}
+
+// ----------------------------------------------------------------------
+// Loads pipeline cache data from disk. Returns empty vector if there is no
+// pipeline cache file, or if the data in the file was not created by the
+// current device and driver - in which case we must not use it.
+static std::vector<char> le_pipeline_cache_load( std::filesystem::path const& path, VkPhysicalDeviceProperties const* properties ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	std::vector<char> data;
+
+	std::ifstream file( path, std::ios::binary | std::ios::ate );
+
+	if ( !file.is_open() ) {
+		return data;
+	}
+
+	// ---------| invariant: file exists
+
+	data.resize( size_t( file.tellg() ) );
+	file.seekg( 0 );
+	file.read( data.data(), std::streamsize( data.size() ) );
+
+	// Validate header - see: VkPipelineCacheHeaderVersionOne. We memcpy elements
+	// since we can't be sure that data is aligned.
+
+	VkPipelineCacheHeaderVersionOne header{};
+
+	bool is_valid = file.good() && data.size() >= sizeof( header );
+
+	if ( is_valid ) {
+		memcpy( &header, data.data(), sizeof( header ) );
+		is_valid = header.headerSize >= sizeof( header ) &&
+		           header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+		           header.vendorID == properties->vendorID &&
+		           header.deviceID == properties->deviceID &&
+		           0 == memcmp( header.pipelineCacheUUID, properties->pipelineCacheUUID, VK_UUID_SIZE );
+	}
+
+	if ( !is_valid ) {
+		logger.warn( "Ignoring pipeline cache file '%s': it was not created by the current device, or driver.", path.string().c_str() );
+		data.clear();
+		return data;
+	}
+
+	logger.info( "Loaded pipeline cache file '%s' (%zu Bytes)", path.string().c_str(), data.size() );
+
+	return data;
+}
+
+// ----------------------------------------------------------------------
+// Writes pipeline cache to disk. We write atomically: data goes into a
+// temporary file first, which then replaces the pipeline cache file, so that
+// readers never see a partially written pipeline cache file.
+static bool le_pipeline_manager_store_pipeline_cache( le_pipeline_manager_o* self ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	if ( self->pipeline_cache_path.empty() || self->vulkanCache == nullptr ) {
+		return false;
+	}
+
+	// Reset counters first: any pipelines created while we store will trigger the next store.
+	self->num_pipelines_since_cache_store = 0;
+	self->pipeline_cache_store_time       = std::chrono::steady_clock::now();
+
+	size_t data_size = 0;
+	vkGetPipelineCacheData( self->device, self->vulkanCache, &data_size, nullptr );
+
+	std::vector<char> data( data_size );
+
+	if ( data_size == 0 ||
+	     VK_SUCCESS != vkGetPipelineCacheData( self->device, self->vulkanCache, &data_size, data.data() ) ) {
+		logger.error( "Could not retrieve pipeline cache data." );
+		return false;
+	}
+
+	std::filesystem::path tmp_path = self->pipeline_cache_path;
+	tmp_path += ".tmp";
+
+	{
+		std::ofstream file( tmp_path, std::ios::binary | std::ios::trunc );
+		file.write( data.data(), std::streamsize( data_size ) );
+		if ( !file.good() ) {
+			logger.error( "Could not write pipeline cache file '%s'", tmp_path.string().c_str() );
+			return false;
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename( tmp_path, self->pipeline_cache_path, ec );
+
+	if ( ec ) {
+		logger.error( "Could not replace pipeline cache file '%s': %s", self->pipeline_cache_path.string().c_str(), ec.message().c_str() );
+		std::filesystem::remove( tmp_path, ec );
+		return false;
+	}
+
+	logger.info( "Stored pipeline cache file '%s' (%zu Bytes)", self->pipeline_cache_path.string().c_str(), data_size );
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Call this once per frame: stores pipeline cache to disk if new pipelines
+// were created, and the store interval has elapsed.
+static void le_pipeline_manager_update_pipeline_cache( le_pipeline_manager_o* self ) {
+
+	LE_SETTING( uint32_t, LE_SETTING_PIPELINE_CACHE_STORE_INTERVAL_SECONDS, 30 ); // 0 means: only store on shutdown
+
+	if ( *LE_SETTING_PIPELINE_CACHE_STORE_INTERVAL_SECONDS == 0 ||
+	     self->num_pipelines_since_cache_store == 0 ) {
+		return;
+	}
+
+	if ( std::chrono::steady_clock::now() - self->pipeline_cache_store_time <
+	     std::chrono::seconds( *LE_SETTING_PIPELINE_CACHE_STORE_INTERVAL_SECONDS ) ) {
+		return;
+	}
+
+	le_pipeline_manager_store_pipeline_cache( self );
 }
 
 // ----------------------------------------------------------------------
@@ -2458,16 +3095,34 @@ static le_pipeline_manager_o* le_pipeline_manager_create( le_device_o* le_device
 	vk_device_i.increase_reference_count( le_device );
 	self->device = vk_device_i.get_vk_device( le_device );
 
+	LE_SETTING( bool, LE_SETTING_PIPELINE_CACHE_PERSISTENT, true );
+
+	std::vector<char> initial_data;
+
+	if ( *LE_SETTING_PIPELINE_CACHE_PERSISTENT ) {
+		VkPhysicalDeviceProperties const* properties = vk_device_i.get_vk_physical_device_properties( le_device );
+
+		self->pipeline_cache_path = le_pipeline_cache_get_path( properties );
+		initial_data              = le_pipeline_cache_load( self->pipeline_cache_path, properties );
+	}
+
 	VkPipelineCacheCreateInfo info = {
 	    .sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
-	    .pNext           = nullptr, // optional
-	    .flags           = 0,       // optional
-	    .initialDataSize = 0,       // optional
-	    .pInitialData    = nullptr,
+	    .pNext           = nullptr,             // optional
+	    .flags           = 0,                   // optional
+	    .initialDataSize = initial_data.size(), // optional
+	    .pInitialData    = initial_data.empty() ? nullptr : initial_data.data(),
 	};
 
-	vkCreatePipelineCache( self->device, &info, nullptr, &self->vulkanCache );
-	self->shaderManager = le_shader_manager_create( self->device );
+	if ( VK_SUCCESS != vkCreatePipelineCache( self->device, &info, nullptr, &self->vulkanCache ) && !initial_data.empty() ) {
+		// Implementation rejected our initial data - start with an empty cache instead.
+		info.initialDataSize = 0;
+		info.pInitialData    = nullptr;
+		vkCreatePipelineCache( self->device, &info, nullptr, &self->vulkanCache );
+	}
+
+	self->pipeline_cache_store_time = std::chrono::steady_clock::now();
+	self->shaderManager             = le_shader_manager_create( self->device );
 
 	return self;
 }
@@ -2478,6 +3133,9 @@ static void le_pipeline_manager_destroy( le_pipeline_manager_o* self ) {
 
 	static auto logger = LeLog( LOGGER_LABEL );
 
+	// -- wait for any pipelines which are still being compiled in the background
+	le_pipeline_manager_retire_compile_requests( self, true );
+
 	le_shader_manager_destroy( self->shaderManager );
 	self->shaderManager = nullptr;
 
@@ -2527,9 +3185,12 @@ static void le_pipeline_manager_destroy( le_pipeline_manager_o* self ) {
 	    },
 	    nullptr );
 
-	// Destroy Pipeline Cache
+	// Destroy Pipeline Cache - but persist it first, so that the next launch may re-use it.
 
 	if ( self->vulkanCache ) {
+		if ( self->num_pipelines_since_cache_store > 0 ) {
+			le_pipeline_manager_store_pipeline_cache( self );
+		}
 		vkDestroyPipelineCache( self->device, self->vulkanCache, nullptr );
 	}
 
@@ -2552,14 +3213,26 @@ void register_le_pipeline_vk_api( void* api_ ) {
 
 		i.create_shader_module              = le_pipeline_manager_create_shader_module;
 		i.update_shader_modules             = le_pipeline_manager_update_shader_modules;
+		i.update_pipeline_cache             = le_pipeline_manager_update_pipeline_cache;
+		i.set_graphics_pipeline_fallback    = le_pipeline_manager_set_graphics_pipeline_fallback;
+		i.prewarm_compute_pipelines         = le_pipeline_manager_prewarm_compute_pipelines;
+		i.get_num_pending_pipelines         = le_pipeline_manager_get_num_pending_pipelines;
+		i.wait_for_pending_pipelines        = le_pipeline_manager_wait_for_pending_pipelines;
+		i.release_render_pass               = le_pipeline_manager_release_render_pass;
 		i.introduce_graphics_pipeline_state = le_pipeline_manager_introduce_graphics_pipeline_state;
 		i.introduce_compute_pipeline_state  = le_pipeline_manager_introduce_compute_pipeline_state;
 		i.introduce_rtx_pipeline_state      = le_pipeline_manager_introduce_rtx_pipeline_state;
 		i.get_pipeline_layout               = le_pipeline_manager_get_pipeline_layout_public;
 		i.get_descriptor_set_layout         = le_pipeline_manager_get_descriptor_set_layout;
+		i.get_bindless_descriptor_set_layout = le_pipeline_manager_get_bindless_descriptor_set_layout;
 		i.produce_graphics_pipeline         = le_pipeline_manager_produce_graphics_pipeline;
 		i.produce_rtx_pipeline              = le_pipeline_manager_produce_rtx_pipeline;
 		i.produce_compute_pipeline          = le_pipeline_manager_produce_compute_pipeline;
+
+		i.serialize_graphics_pipeline_state   = le_pipeline_manager_serialize_graphics_pipeline_state;
+		i.serialize_compute_pipeline_state    = le_pipeline_manager_serialize_compute_pipeline_state;
+		i.deserialize_graphics_pipeline_state = le_pipeline_manager_deserialize_graphics_pipeline_state;
+		i.deserialize_compute_pipeline_state  = le_pipeline_manager_deserialize_compute_pipeline_state;
 	}
 	{
 		auto& i = le_backend_vk_api_i->le_shader_module_i;
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+// ----------------------------------------------------------------------
+// A map from `key` -> `object*`, used for pipeline manager caches.
+//
+// Access is internally synchronised:
+//
+// + Lookups are lock-free: they never block, and never wait for writers.
+// + Insertions are striped: keys are distributed over a number of shards,
+//   each of which has its own writer lock, so that concurrent writers only
+//   contend if they write to the same shard.
+//
+// Each shard is an open-addressing hash table with linear probing, which
+// we keep at most half-full. Lookups are therefore O(1), and touch few
+// cache lines.
+//
+// Objects are copied on insertion, and never move afterwards: pointers
+// returned by try_find stay valid until clear() is called. Entries cannot
+// be removed individually.
+//
+// Keys must be integers or pointers (opaque handles), and must not be 0,
+// as 0 marks an empty slot.
+//
+// When a shard grows, its previous table is retired, not freed, since
+// lock-free readers may still be probing it. Retired tables are freed on
+// clear(). Because tables double in size when they grow, this costs at
+// most as much memory again as the current tables.
+//
+// NOTE: iterator() and clear() lock all shards, but they are not safe to
+// call while other threads may be calling try_find().
+template <typename K, typename T, uint32_t NUM_SHARDS = 16>
+class ConcurrentHashMap {
+
+	static_assert( std::is_integral_v<K> || std::is_pointer_v<K>, "keys must be integers or pointers" );
+	static_assert( NUM_SHARDS != 0 && ( NUM_SHARDS & ( NUM_SHARDS - 1 ) ) == 0, "number of shards must be a power of two" );
+
+	static constexpr uint64_t INITIAL_CAPACITY = 16; // number of slots in a shard's first table - must be a power of two
+
+	struct Slot {
+		std::atomic<uint64_t> key   = 0;       // 0 means: slot is empty
+		std::atomic<T*>       value = nullptr; // owning, published before key
+	};
+
+	struct Table {
+		uint64_t                mask     = 0;       // number of slots - 1
+		std::unique_ptr<Slot[]> slots    = nullptr; //
+		Table*                  previous = nullptr; // owning: retired table which this table replaced
+	};
+
+	struct alignas( 64 ) Shard {
+		std::atomic<Table*> table = nullptr; // owning
+		std::mutex          writer_mtx;      // protects all writes to this shard
+		uint64_t            count = 0;       // number of occupied slots, only accessed with writer_mtx held
+	};
+
+	Shard shards[ NUM_SHARDS ];
+
+	static uint64_t key_bits( K const& key ) {
+		if constexpr ( std::is_pointer_v<K> ) {
+			return uint64_t( reinterpret_cast<uintptr_t>( key ) );
+		} else {
+			return uint64_t( key );
+		}
+	}
+
+	// Keys are often hashes already, but handles may be pointers with zeroes in their
+	// low bits - we mix all bits so that both shard and slot indices are well distributed.
+	static uint64_t mix( uint64_t k ) {
+		k ^= k >> 33;
+		k *= 0xff51afd7ed558ccdull;
+		k ^= k >> 33;
+		k *= 0xc4ceb9fe1a85ec53ull;
+		k ^= k >> 33;
+		return k;
+	}
+
+	static Shard& shard_for( Shard* shards, uint64_t h ) {
+		// We use the high bits of the hash to select the shard, and the low bits to select the slot.
+		return shards[ ( h >> 32 ) & ( NUM_SHARDS - 1 ) ];
+	}
+
+	static Table* table_create( uint64_t capacity ) {
+		auto t   = new Table{};
+		t->mask  = capacity - 1;
+		t->slots = std::make_unique<Slot[]>( capacity );
+		return t;
+	}
+
+	// Places an entry into a table which is not yet visible to readers - no synchronisation needed.
+	static void table_place_unpublished( Table* t, uint64_t k, T* value ) {
+		for ( uint64_t i = mix( k ) & t->mask;; i = ( i + 1 ) & t->mask ) {
+			if ( t->slots[ i ].key.load( std::memory_order_relaxed ) == 0 ) {
+				t->slots[ i ].value.store( value, std::memory_order_relaxed );
+				t->slots[ i ].key.store( k, std::memory_order_relaxed );
+				return;
+			}
+		}
+	}
+
+	// Replaces the table of a shard with a table of twice the capacity.
+	// Must be called with writer_mtx held.
+	static Table* shard_grow( Shard& s ) {
+		Table* old_table = s.table.load( std::memory_order_relaxed );
+		Table* new_table = table_create( old_table ? ( old_table->mask + 1 ) * 2 : INITIAL_CAPACITY );
+
+		if ( old_table ) {
+			for ( uint64_t i = 0; i <= old_table->mask; i++ ) {
+				uint64_t k = old_table->slots[ i ].key.load( std::memory_order_relaxed );
+				if ( k ) {
+					table_place_unpublished( new_table, k, old_table->slots[ i ].value.load( std::memory_order_relaxed ) );
+				}
+			}
+		}
+
+		new_table->previous = old_table;
+
+		// Publish new table - readers which see it will also see its contents.
+		s.table.store( new_table, std::memory_order_release );
+
+		return new_table;
+	}
+
+  public:
+	ConcurrentHashMap()                                      = default;
+	ConcurrentHashMap( ConcurrentHashMap const& )            = delete;
+	ConcurrentHashMap( ConcurrentHashMap&& )                 = delete;
+	ConcurrentHashMap& operator=( ConcurrentHashMap const& ) = delete;
+	ConcurrentHashMap& operator=( ConcurrentHashMap&& )      = delete;
+
+	// Looks up entry under `needle`, returns nullptr if not found.
+	// This method is lock-free.
+	T* try_find( K const& needle ) {
+		uint64_t k = key_bits( needle );
+		assert( k != 0 && "key must not be 0" );
+
+		uint64_t h = mix( k );
+		Table*   t = shard_for( shards, h ).table.load( std::memory_order_acquire );
+
+		if ( nullptr == t ) {
+			return nullptr;
+		}
+
+		// Tables are never more than half full, so that we are guaranteed to find an empty slot.
+		for ( uint64_t i = h & t->mask;; i = ( i + 1 ) & t->mask ) {
+			uint64_t slot_key = t->slots[ i ].key.load( std::memory_order_acquire );
+			if ( slot_key == k ) {
+				return t->slots[ i ].value.load( std::memory_order_acquire );
+			}
+			if ( slot_key == 0 ) {
+				return nullptr;
+			}
+		}
+	}
+
+	// Inserts a copy of `obj` under `key`.
+	// Returns true if successful, false if an entry already existed for `key`.
+	// In case return value is false, object was not copied.
+	bool try_insert( K const& key, T* obj ) {
+		uint64_t k = key_bits( key );
+		assert( k != 0 && "key must not be 0" );
+
+		uint64_t h    = mix( k );
+		Shard&   s    = shard_for( shards, h );
+		auto     lock = std::unique_lock( s.writer_mtx );
+
+		Table* t = s.table.load( std::memory_order_relaxed );
+
+		if ( t ) {
+			for ( uint64_t i = h & t->mask;; i = ( i + 1 ) & t->mask ) {
+				uint64_t slot_key = t->slots[ i ].key.load( std::memory_order_relaxed );
+				if ( slot_key == k ) {
+					return false; // entry already existed
+				}
+				if ( slot_key == 0 ) {
+					break;
+				}
+			}
+		}
+
+		// ---------| invariant: key is not in table
+
+		if ( nullptr == t || ( s.count + 1 ) * 2 > t->mask + 1 ) {
+			t = shard_grow( s );
+		}
+
+		for ( uint64_t i = h & t->mask;; i = ( i + 1 ) & t->mask ) {
+			if ( t->slots[ i ].key.load( std::memory_order_relaxed ) == 0 ) {
+				// Value must be visible before key, so that readers who find the key also find the value.
+				t->slots[ i ].value.store( new T( *obj ), std::memory_order_relaxed ); // make a copy
+				t->slots[ i ].key.store( k, std::memory_order_release );
+				break;
+			}
+		}
+
+		s.count++;
+
+		return true;
+	}
+
+	typedef void ( *iterator_fun )( T* e, void* user_data );
+
+	// do something on all objects
+	void iterator( iterator_fun fun, void* user_data ) {
+		for ( auto& s : shards ) {
+			auto   lock = std::unique_lock( s.writer_mtx );
+			Table* t    = s.table.load( std::memory_order_relaxed );
+			if ( nullptr == t ) {
+				continue;
+			}
+			for ( uint64_t i = 0; i <= t->mask; i++ ) {
+				if ( t->slots[ i ].key.load( std::memory_order_relaxed ) ) {
+					fun( t->slots[ i ].value.load( std::memory_order_relaxed ), user_data );
+				}
+			}
+		}
+	}
+
+	void clear() {
+		for ( auto& s : shards ) {
+			auto   lock = std::unique_lock( s.writer_mtx );
+			Table* t    = s.table.exchange( nullptr, std::memory_order_relaxed );
+
+			if ( t ) {
+				// Only the current table owns objects - retired tables hold copies of the same pointers.
+				for ( uint64_t i = 0; i <= t->mask; i++ ) {
+					delete t->slots[ i ].value.load( std::memory_order_relaxed );
+				}
+			}
+
+			while ( t ) {
+				Table* previous = t->previous;
+				delete t;
+				t = previous;
+			}
+
+			s.count = 0;
+		}
+	}
+
+	~ConcurrentHashMap() {
+		clear();
+	}
+};
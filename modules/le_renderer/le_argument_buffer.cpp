@@ -0,0 +1,297 @@
+#include "le_renderer.h"
+#include "le_log.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <assert.h>
+
+static constexpr auto LOGGER_LABEL = "le_argument_buffer";
+
+// ----------------------------------------------------------------------
+// Retained argument buffer
+//
+// A persistent GPU buffer which is divided into fixed-size slots, each of
+// which holds data for one shader argument (e.g. the parameters of one
+// material). Slot offsets are stable for the lifetime of the argument buffer.
+//
+// We keep a CPU copy of all slots. Slots which have changed are marked dirty,
+// and only dirty slots get uploaded, via a transfer pass which this argument
+// buffer adds to the rendergraph. Data which does not change is therefore
+// uploaded once, instead of once per draw, per frame, as is the case with
+// encoder_i.set_argument_data.
+//
+// Uploads only take effect once the frame which recorded them is dispatched.
+// We therefore keep track of uploaded slots per frame, and mark them dirty
+// again if it turns out that their frame was dropped (e.g. because swapchain
+// acquisition failed).
+//
+// Passes which bind slots must declare the argument buffer resource with
+// read access (e.g. eUniformRead); the rendergraph then orders them after
+// the upload pass, and the backend inserts barriers as needed.
+
+// Slot offsets must satisfy minUniformBufferOffsetAlignment, and
+// minStorageBufferOffsetAlignment, which are at most 256 bytes on any device.
+static constexpr uint32_t LE_ARGUMENT_BUFFER_SLOT_ALIGNMENT = 256;
+
+struct le_argument_buffer_o {
+	struct SlotRun {
+		uint32_t first_slot; //
+		uint32_t end_slot;   // one past last slot
+	};
+
+	struct PendingUpload {
+		size_t               frame_number; // frame which recorded this upload
+		std::vector<SlotRun> runs;         // slots uploaded by this frame
+	};
+
+	le_renderer_o*             renderer;         // non-owning
+	le_buf_resource_handle     resource;         // persistent buffer resource
+	le_resource_info_t         resource_info;    //
+	std::string                upload_pass_name; //
+	uint32_t                   slot_size;        // number of bytes available to each slot
+	uint32_t                   slot_stride;      // slot_size, rounded up to slot alignment
+	uint32_t                   slot_count;       //
+	std::vector<char>          data;             // cpu copy of buffer contents
+	std::vector<bool>          dirty_slots;      // one entry per slot, true if slot needs uploading
+	uint32_t                   num_dirty_slots;  //
+	std::vector<PendingUpload> pending_uploads;  // uploads whose frame has not yet been dispatched, oldest first
+};
+
+// ----------------------------------------------------------------------
+
+static le_argument_buffer_o* le_argument_buffer_create( le_renderer_o* renderer, char const* debug_name, uint32_t slot_size, uint32_t slot_count ) {
+
+	using namespace le_renderer;
+
+	assert( slot_size != 0 && slot_count != 0 && "argument buffer must have at least one slot of non-zero size" );
+
+	auto self = new le_argument_buffer_o{};
+
+	self->renderer         = renderer;
+	self->slot_size        = slot_size;
+	self->slot_stride      = ( slot_size + LE_ARGUMENT_BUFFER_SLOT_ALIGNMENT - 1 ) & ~( LE_ARGUMENT_BUFFER_SLOT_ALIGNMENT - 1 );
+	self->slot_count       = slot_count;
+	self->resource         = renderer_i.produce_buf_resource_handle( debug_name, 0, 0 );
+	self->upload_pass_name = std::string( debug_name ) + "-upload";
+
+	self->resource_info              = helpers_i.get_default_resource_info_for_buffer();
+	self->resource_info.buffer.size  = self->slot_stride * slot_count;
+	self->resource_info.buffer.usage = le::BufferUsageFlagBits::eTransferDst |
+	                                   le::BufferUsageFlagBits::eUniformBuffer |
+	                                   le::BufferUsageFlagBits::eStorageBuffer;
+
+	self->data.resize( size_t( self->slot_stride ) * slot_count, 0 );
+
+	// All slots start out dirty, so that the first upload initialises the whole buffer.
+	self->dirty_slots.resize( slot_count, true );
+	self->num_dirty_slots = slot_count;
+
+	return self;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_argument_buffer_destroy( le_argument_buffer_o* self ) {
+	delete self;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_argument_buffer_mark_slot_dirty( le_argument_buffer_o* self, uint32_t slot ) {
+	assert( slot < self->slot_count );
+	if ( !self->dirty_slots[ slot ] ) {
+		self->dirty_slots[ slot ] = true;
+		self->num_dirty_slots++;
+	}
+}
+
+// ----------------------------------------------------------------------
+// Copies data into slot - the slot only gets marked dirty if its contents change.
+// Returns false if data does not fit into a slot.
+static bool le_argument_buffer_set_slot_data( le_argument_buffer_o* self, uint32_t slot, void const* data, size_t num_bytes ) {
+
+	if ( slot >= self->slot_count || num_bytes > self->slot_size ) {
+		static auto logger = LeLog( LOGGER_LABEL );
+		logger.error( "Cannot set %zu bytes for slot %u of argument buffer '%s' (slot size: %u, slot count: %u)",
+		              num_bytes, slot, self->upload_pass_name.c_str(), self->slot_size, self->slot_count );
+		return false;
+	}
+
+	// ---------| invariant: data fits into slot
+
+	char* slot_data = self->data.data() + size_t( slot ) * self->slot_stride;
+
+	if ( 0 == memcmp( slot_data, data, num_bytes ) ) {
+		return true;
+	}
+
+	memcpy( slot_data, data, num_bytes );
+	le_argument_buffer_mark_slot_dirty( self, slot );
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Returns cpu copy of slot data - if you change data via this pointer, you must mark the slot dirty.
+static void* le_argument_buffer_map_slot( le_argument_buffer_o* self, uint32_t slot ) {
+	assert( slot < self->slot_count );
+	return self->data.data() + size_t( slot ) * self->slot_stride;
+}
+
+// ----------------------------------------------------------------------
+
+static le_buf_resource_handle le_argument_buffer_get_resource( le_argument_buffer_o const* self ) {
+	return self->resource;
+}
+
+// ----------------------------------------------------------------------
+
+static uint64_t le_argument_buffer_get_slot_offset( le_argument_buffer_o const* self, uint32_t slot ) {
+	assert( slot < self->slot_count );
+	return uint64_t( slot ) * self->slot_stride;
+}
+
+// ----------------------------------------------------------------------
+
+static uint32_t le_argument_buffer_get_slot_count( le_argument_buffer_o const* self ) {
+	return self->slot_count;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_argument_buffer_bind_slot( le_argument_buffer_o const* self, le_command_buffer_encoder_o* encoder, uint64_t argument_name_id, uint32_t slot ) {
+	using namespace le_renderer;
+	assert( slot < self->slot_count );
+	encoder_i.bind_argument_buffer( encoder, self->resource, argument_name_id, uint64_t( slot ) * self->slot_stride, self->slot_size );
+}
+
+// ----------------------------------------------------------------------
+
+// Checks uploads of previous frames: uploads whose frame was dispatched are
+// done with, slots of uploads whose frame was dropped are marked dirty again.
+static void le_argument_buffer_resolve_pending_uploads( le_argument_buffer_o* self ) {
+	using namespace le_renderer;
+
+	size_t num_resolved = 0;
+
+	for ( auto const& upload : self->pending_uploads ) {
+
+		bool was_dispatched = false;
+
+		if ( !renderer_i.get_frame_outcome( self->renderer, upload.frame_number, &was_dispatched ) ) {
+			break; // frames resolve in order - any later uploads are pending, too.
+		}
+
+		if ( !was_dispatched ) {
+			for ( auto const& run : upload.runs ) {
+				for ( uint32_t slot = run.first_slot; slot != run.end_slot; slot++ ) {
+					le_argument_buffer_mark_slot_dirty( self, slot );
+				}
+			}
+		}
+
+		num_resolved++;
+	}
+
+	self->pending_uploads.erase( self->pending_uploads.begin(), self->pending_uploads.begin() + num_resolved );
+}
+
+// ----------------------------------------------------------------------
+
+static bool pass_upload_setup( le_renderpass_o* rp, void* user_data ) {
+	using namespace le_renderer;
+	auto self = static_cast<le_argument_buffer_o*>( user_data );
+
+	le_argument_buffer_resolve_pending_uploads( self );
+
+	if ( self->num_dirty_slots == 0 ) {
+		return false; // nothing to upload - don't add this pass.
+	}
+
+	renderpass_i.use_resource( rp, self->resource, le::AccessFlags2( le::AccessFlagBits2::eTransferWrite ) );
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+static void pass_upload_execute( le_command_buffer_encoder_o* encoder, void* user_data ) {
+	using namespace le_renderer;
+	auto self = static_cast<le_argument_buffer_o*>( user_data );
+
+	// Upload contiguous runs of dirty slots with one write each. Uploaded slots
+	// are remembered until we know whether this frame was dispatched.
+
+	le_argument_buffer_o::PendingUpload upload;
+	upload.frame_number = renderer_i.get_current_frame_number( self->renderer );
+
+	for ( uint32_t slot = 0; slot < self->slot_count; ) {
+
+		if ( !self->dirty_slots[ slot ] ) {
+			slot++;
+			continue;
+		}
+
+		uint32_t run_end = slot;
+
+		while ( run_end < self->slot_count && self->dirty_slots[ run_end ] ) {
+			self->dirty_slots[ run_end ] = false;
+			run_end++;
+		}
+
+		size_t offset = size_t( slot ) * self->slot_stride;
+		size_t size   = size_t( run_end - slot ) * self->slot_stride;
+
+		encoder_i.write_to_buffer( encoder, self->resource, offset, self->data.data() + offset, size );
+
+		upload.runs.push_back( { slot, run_end } );
+
+		slot = run_end;
+	}
+
+	self->num_dirty_slots = 0;
+	self->pending_uploads.emplace_back( std::move( upload ) );
+}
+
+// ----------------------------------------------------------------------
+// Declares the argument buffer resource with the rendergraph, and adds a pass
+// which uploads dirty slots. Call this once per frame, before adding passes
+// which bind slots of this argument buffer.
+static void le_argument_buffer_update_rendergraph( le_argument_buffer_o* self, le_rendergraph_o* rendergraph ) {
+
+	using namespace le_renderer;
+
+	rendergraph_i.declare_resource( rendergraph, self->resource, self->resource_info );
+
+	le_renderpass_o* rp = renderpass_i.create( self->upload_pass_name.c_str(), le::QueueFlagBits::eTransfer );
+
+	renderpass_i.set_setup_callback( rp, self, pass_upload_setup );
+	renderpass_i.set_execute_callback( rp, self, pass_upload_execute );
+
+	// Upload must happen even if no pass reads from this buffer in this frame,
+	// because we clear dirty flags once the upload has been recorded.
+	renderpass_i.set_is_root( rp, true );
+
+	rendergraph_i.add_renderpass( rendergraph, rp );
+	renderpass_i.ref_dec( rp );
+}
+
+// ----------------------------------------------------------------------
+
+void register_le_argument_buffer_api( void* api_ ) {
+
+	auto  le_renderer_api_i    = static_cast<le_renderer_api*>( api_ );
+	auto& le_argument_buffer_i = le_renderer_api_i->le_argument_buffer_i;
+
+	le_argument_buffer_i.create             = le_argument_buffer_create;
+	le_argument_buffer_i.destroy            = le_argument_buffer_destroy;
+	le_argument_buffer_i.set_slot_data      = le_argument_buffer_set_slot_data;
+	le_argument_buffer_i.map_slot           = le_argument_buffer_map_slot;
+	le_argument_buffer_i.mark_slot_dirty    = le_argument_buffer_mark_slot_dirty;
+	le_argument_buffer_i.get_resource       = le_argument_buffer_get_resource;
+	le_argument_buffer_i.get_slot_offset    = le_argument_buffer_get_slot_offset;
+	le_argument_buffer_i.get_slot_count     = le_argument_buffer_get_slot_count;
+	le_argument_buffer_i.bind_slot          = le_argument_buffer_bind_slot;
+	le_argument_buffer_i.update_rendergraph = le_argument_buffer_update_rendergraph;
+}
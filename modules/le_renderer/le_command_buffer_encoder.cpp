@@ -44,7 +44,116 @@ static inline le_allocator_o* fetch_allocator( le_allocator_o** ppAlloc ) {
 
 // ----------------------------------------------------------------------
 
-#define EMPLACE_CMD( x ) new ( &self->mCommandStream[ 0 ] + self->mCommandStreamSize )( x )
+// Placement-new a command into the command stream. Reserves enough space for the command
+// (and optionally its inline payload) - space only counts as used once the command has
+// been committed via cbe_commit().
+#define EMPLACE_CMD( x ) new ( cbe_reserve( self, sizeof( x ) ) )( x )
+#define EMPLACE_CMD_WITH_PAYLOAD( x, payload_size ) new ( cbe_reserve( self, sizeof( x ) + ( payload_size ) ) )( x )
+
+// ----------------------------------------------------------------------
+// Command stream memory is organised in pages. A command, together with its
+// inline payload, is always stored contiguously within a single page.
+//
+// Pages are handed out by a page pool, which is owned by the rendergraph of
+// a frame. Once an encoder gets destroyed (at the latest when its frame is
+// cleared), its pages are returned to the pool so that they may be recycled
+// by encoders recording into the same frame in the next cycle.
+//
+// Commands which are larger than the default page capacity get a dedicated
+// page which is sized to fit, and which is freed instead of recycled.
+//
+// The pool also recycles encoder objects: a destroyed encoder keeps the
+// capacity of its containers, and is handed out again by the next call to
+// create which uses the same pool.
+//
+// Note that the pool is not protected by a mutex: a frame is only ever
+// recorded or cleared by one thread at a time, and passes are recorded in
+// sequence.
+
+static constexpr size_t LE_COMMAND_STREAM_PAGE_CAPACITY = 4096 * 16; // 64KB per page
+
+struct le_command_stream_page_t {
+	size_t capacity;     // number of bytes available for commands - page data follows directly after this header
+	size_t size;         // number of bytes used by committed commands
+	size_t num_commands; // number of committed commands
+	size_t padding;      // keep page data 16-byte aligned
+};
+
+struct le_command_stream_page_pool_o {
+	std::vector<le_command_stream_page_t*>    free_pages;              // pages of default capacity, ready for re-use
+	std::vector<le_command_buffer_encoder_o*> free_encoders;           // owning: destroyed encoders, ready for re-use
+	size_t                                    num_pages_allocated = 0; // number of default-capacity pages allocated via this pool, for stats
+};
+
+// ----------------------------------------------------------------------
+// ffdecl.
+static void cbe_free( le_command_buffer_encoder_o* self );
+
+static inline char* command_stream_page_get_data( le_command_stream_page_t* page ) {
+	return reinterpret_cast<char*>( page + 1 );
+}
+
+// ----------------------------------------------------------------------
+
+static le_command_stream_page_pool_o* command_stream_page_pool_create() {
+	auto self = new le_command_stream_page_pool_o{};
+	return self;
+}
+
+// ----------------------------------------------------------------------
+
+static void command_stream_page_pool_destroy( le_command_stream_page_pool_o* self ) {
+	assert( self->free_pages.size() == self->num_pages_allocated && "all pages must have been returned to the pool before it is destroyed" );
+	for ( auto& p : self->free_pages ) {
+		free( p );
+	}
+	for ( auto& e : self->free_encoders ) {
+		cbe_free( e );
+	}
+	delete self;
+}
+
+// ----------------------------------------------------------------------
+// Returns a page which can hold at least `min_capacity` bytes.
+// `self` may be nullptr, in which case pages are not pooled.
+static le_command_stream_page_t* command_stream_page_pool_acquire( le_command_stream_page_pool_o* self, size_t min_capacity ) {
+
+	le_command_stream_page_t* page = nullptr;
+
+	if ( min_capacity <= LE_COMMAND_STREAM_PAGE_CAPACITY ) {
+		if ( self && !self->free_pages.empty() ) {
+			page = self->free_pages.back();
+			self->free_pages.pop_back();
+		} else {
+			page           = static_cast<le_command_stream_page_t*>( malloc( sizeof( le_command_stream_page_t ) + LE_COMMAND_STREAM_PAGE_CAPACITY ) );
+			page->capacity = LE_COMMAND_STREAM_PAGE_CAPACITY;
+			if ( self ) {
+				self->num_pages_allocated++;
+			}
+		}
+	} else {
+		// Oversized command: allocate a dedicated page just for this command.
+		page           = static_cast<le_command_stream_page_t*>( malloc( sizeof( le_command_stream_page_t ) + min_capacity ) );
+		page->capacity = min_capacity;
+	}
+
+	assert( page && "could not allocate command stream page" );
+
+	page->size         = 0;
+	page->num_commands = 0;
+
+	return page;
+}
+
+// ----------------------------------------------------------------------
+
+static void command_stream_page_pool_release( le_command_stream_page_pool_o* self, le_command_stream_page_t* page ) {
+	if ( self && page->capacity == LE_COMMAND_STREAM_PAGE_CAPACITY ) {
+		self->free_pages.push_back( page );
+	} else {
+		free( page );
+	}
+}
 
 // ----------------------------------------------------------------------
 
@@ -73,36 +182,150 @@ struct le_shader_binding_table_o {
 
 // ----------------------------------------------------------------------
 
+// ----------------------------------------------------------------------
+// State which has been bound by commands previously recorded into this encoder.
+// We track this so that we can drop commands which would re-bind identical state.
+//
+// Tracked state mirrors what the backend keeps while it processes the command
+// stream of a pass: viewports, scissors and vertex buffers persist across pipeline
+// binds (viewport and scissor are always dynamic state), whereas argument buffers
+// get reset whenever the backend binds a different pipeline.
+struct cbe_bound_state_t {
+	static constexpr uint32_t MAX_VIEWPORTS       = 16;
+	static constexpr uint32_t MAX_VERTEX_BINDINGS = 32;
+
+	struct argument_buffer_t {
+		uint64_t               argument_name_id;
+		le_buf_resource_handle buffer_id;
+		uint64_t               offset;
+		uint64_t               range;
+		std::vector<char>      data; // copy of data if bound via set_argument_data, empty otherwise
+	};
+
+	le_gpso_handle graphics_pipeline = nullptr;
+
+	uint32_t     first_viewport = 0;
+	uint32_t     viewport_count = 0; // 0 means: no viewport state tracked
+	le::Viewport viewports[ MAX_VIEWPORTS ];
+
+	uint32_t   first_scissor = 0;
+	uint32_t   scissor_count = 0; // 0 means: no scissor state tracked
+	le::Rect2D scissors[ MAX_VIEWPORTS ];
+
+	uint32_t               vertex_bindings_valid = 0; // bitfield, one bit per binding index
+	le_buf_resource_handle vertex_buffers[ MAX_VERTEX_BINDINGS ];
+	uint64_t               vertex_offsets[ MAX_VERTEX_BINDINGS ];
+
+	std::vector<argument_buffer_t> argument_buffers; // one entry per argument name, argument names per pipeline are few - linear search is fine
+};
+
 struct le_command_buffer_encoder_o {
-	char                                    mCommandStream[ 4096 * 512 ]; // 512 pages of memory = 2MB
-	size_t                                  mCommandStreamSize = 0;
-	size_t                                  mCommandCount      = 0;
-	le_allocator_o**                        ppAllocator        = nullptr; // allocator list is owned by backend, externally
-	le_pipeline_manager_o*                  pipelineManager    = nullptr; // non-owning: owned by backend.
-	le_staging_allocator_o*                 stagingAllocator   = nullptr; // Borrowed from backend - used for larger, permanent resources, shared amongst encoders
-	le::Extent2D                            extent             = {};      // Renderpass extent, otherwise swapchain extent inferred via renderer, this may be queried by users of encoder.
-	std::vector<le_shader_binding_table_o*> shader_binding_tables;        // owning
+	std::vector<le_command_stream_page_t*>  mCommandStreamPages;                  // owning (returned to page pool on destroy), in recording order, last page is current
+	size_t                                  mCommandStreamSize       = 0;        // total number of bytes over all pages
+	size_t                                  mCommandCount            = 0;        // total number of commands over all pages
+	le_command_stream_page_pool_o*          pagePool                 = nullptr; // non-owning: owned by rendergraph of current frame.
+	le_allocator_o**                        ppAllocator              = nullptr; // allocator list is owned by backend, externally
+	le_pipeline_manager_o*                  pipelineManager          = nullptr; // non-owning: owned by backend.
+	le_staging_allocator_o*                 stagingAllocator         = nullptr; // Borrowed from backend - used for larger, permanent resources, shared amongst encoders
+	le::Extent2D                            extent                   = {};      // Renderpass extent, otherwise swapchain extent inferred via renderer, this may be queried by users of encoder.
+	std::vector<le_shader_binding_table_o*> shader_binding_tables;               // owning
+	cbe_bound_state_t                       bound_state;                         // state bound by commands recorded so far
+	bool                                    elide_redundant_commands = true;    // whether to drop commands which would re-bind identical state
+	uint32_t                                num_elided_commands      = 0;       // number of commands which were dropped because they were redundant
 };
 
 // ----------------------------------------------------------------------
 
-static le_command_buffer_encoder_o* cbe_create( le_allocator_o** allocator, le_pipeline_manager_o* pipelineManager, le_staging_allocator_o* stagingAllocator, le::Extent2D const& extent = {} ) {
-	auto self              = new le_command_buffer_encoder_o;
+static le_command_buffer_encoder_o* cbe_create( le_allocator_o** allocator, le_pipeline_manager_o* pipelineManager, le_staging_allocator_o* stagingAllocator, le_command_stream_page_pool_o* pagePool, le::Extent2D const& extent = {} ) {
+
+	le_command_buffer_encoder_o* self = nullptr;
+
+	if ( pagePool && !pagePool->free_encoders.empty() ) {
+		// Recycled encoders have been reset on destroy, but kept the capacity of their containers.
+		self = pagePool->free_encoders.back();
+		pagePool->free_encoders.pop_back();
+	} else {
+		self = new le_command_buffer_encoder_o;
+	}
+
 	self->ppAllocator      = allocator;
 	self->pipelineManager  = pipelineManager;
 	self->stagingAllocator = stagingAllocator;
+	self->pagePool         = pagePool;
 	self->extent           = extent;
+
+	LE_SETTING( bool, LE_SETTING_ENCODER_ELIDE_REDUNDANT_COMMANDS, true );
+	self->elide_redundant_commands = *LE_SETTING_ENCODER_ELIDE_REDUNDANT_COMMANDS;
+
 	return self;
 };
 
 // ----------------------------------------------------------------------
 
+static void cbe_free( le_command_buffer_encoder_o* self ) {
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
 static void cbe_destroy( le_command_buffer_encoder_o* self ) {
 	for ( auto sbt : self->shader_binding_tables ) {
 		delete ( sbt );
 	}
 
-	delete ( self );
+	for ( auto page : self->mCommandStreamPages ) {
+		command_stream_page_pool_release( self->pagePool, page );
+	}
+
+	auto pagePool = self->pagePool;
+
+	if ( nullptr == pagePool ) {
+		cbe_free( self );
+		return;
+	}
+
+	// ---------| invariant: encoder goes back to its pool - reset it, but keep the capacity of its containers.
+
+	le_command_buffer_encoder_o recycled{};
+
+	recycled.mCommandStreamPages.swap( self->mCommandStreamPages );
+	recycled.shader_binding_tables.swap( self->shader_binding_tables );
+	recycled.bound_state.argument_buffers.swap( self->bound_state.argument_buffers );
+
+	recycled.mCommandStreamPages.clear();
+	recycled.shader_binding_tables.clear();
+	recycled.bound_state.argument_buffers.clear();
+
+	*self = std::move( recycled );
+
+	pagePool->free_encoders.push_back( self );
+}
+
+// ----------------------------------------------------------------------
+// Returns address of at least `num_bytes` contiguous bytes of command stream memory.
+// Chains a new page to the command stream if the current page cannot fit `num_bytes`.
+static void* cbe_reserve( le_command_buffer_encoder_o* self, size_t num_bytes ) {
+
+	le_command_stream_page_t* page = self->mCommandStreamPages.empty() ? nullptr : self->mCommandStreamPages.back();
+
+	if ( nullptr == page || page->size + num_bytes > page->capacity ) [[unlikely]] {
+		page = command_stream_page_pool_acquire( self->pagePool, num_bytes );
+		self->mCommandStreamPages.push_back( page );
+	}
+
+	return command_stream_page_get_data( page ) + page->size;
+}
+
+// ----------------------------------------------------------------------
+// Marks the command most recently placed via EMPLACE_CMD as used.
+// `num_bytes` must include any inline payload.
+static inline void cbe_commit( le_command_buffer_encoder_o* self, size_t num_bytes ) {
+	auto page = self->mCommandStreamPages.back();
+	assert( page->size + num_bytes <= page->capacity && "command must fit into its page - did you reserve space for its payload?" );
+	page->size += num_bytes;
+	page->num_commands++;
+	self->mCommandStreamSize += num_bytes;
+	self->mCommandCount++;
 }
 
 // ----------------------------------------------------------------------
@@ -118,8 +341,7 @@ static void cbe_set_line_width( le_command_buffer_encoder_o* self, float lineWid
 	auto cmd        = EMPLACE_CMD( le::CommandSetLineWidth ); // placement new into data array
 	cmd->info.width = lineWidth;
 
-	self->mCommandStreamSize += sizeof( le::CommandSetLineWidth );
-	self->mCommandCount++;
+	cbe_commit( self, sizeof( le::CommandSetLineWidth ) );
 }
 
 // ----------------------------------------------------------------------
@@ -129,8 +351,7 @@ static void cbe_dispatch( le_command_buffer_encoder_o* self, uint32_t groupCount
 	auto cmd  = EMPLACE_CMD( le::CommandDispatch ); // placement new!
 	cmd->info = { groupCountX, groupCountY, groupCountZ, 0 };
 
-	self->mCommandStreamSize += sizeof( le::CommandDispatch );
-	self->mCommandCount++;
+	cbe_commit( self, sizeof( le::CommandDispatch ) );
 }
 
 static void cbe_buffer_memory_barrier( le_command_buffer_encoder_o*   self,
@@ -150,8 +371,7 @@ static void cbe_buffer_memory_barrier( le_command_buffer_encoder_o*   self,
 	cmd->info.offset        = offset;
 	cmd->info.range         = range;
 
-	self->mCommandStreamSize += sizeof( le::CommandBufferMemoryBarrier );
-	self->mCommandCount++;
+	cbe_commit( self, sizeof( le::CommandBufferMemoryBarrier ) );
 }
 
 // ----------------------------------------------------------------------
@@ -160,8 +380,7 @@ static void cbe_trace_rays( le_command_buffer_encoder_o* self, uint32_t width, u
 	auto cmd  = EMPLACE_CMD( le::CommandTraceRays ); // placement new!
 	cmd->info = { width, height, depth, 0 };
 
-	self->mCommandStreamSize += sizeof( le::CommandTraceRays );
-	self->mCommandCount++;
+	cbe_commit( self, sizeof( le::CommandTraceRays ) );
 }
 // ----------------------------------------------------------------------
 
@@ -174,8 +393,7 @@ static void cbe_draw( le_command_buffer_encoder_o* self,
 	auto cmd  = EMPLACE_CMD( le::CommandDraw ); // placement new!
 	cmd->info = { vertexCount, instanceCount, firstVertex, firstInstance };
 
-	self->mCommandStreamSize += sizeof( le::CommandDraw );
-	self->mCommandCount++;
+	cbe_commit( self, sizeof( le::CommandDraw ) );
 }
 
 // ----------------------------------------------------------------------
@@ -197,8 +415,70 @@ static void cbe_draw_indexed( le_command_buffer_encoder_o* self,
 	    0 // padding must be set to zero
 	};
 
-	self->mCommandStreamSize += sizeof( le::CommandDrawIndexed );
-	self->mCommandCount++;
+	cbe_commit( self, sizeof( le::CommandDrawIndexed ) );
+}
+
+// ----------------------------------------------------------------------
+// Draws `drawCount` times, with draw parameters read from `buffer`, which must be
+// used by the pass with access flag eIndirectCommandRead. A `stride` of 0 means
+// that draw parameters are tightly packed.
+static void cbe_draw_indirect( le_command_buffer_encoder_o* self,
+                               le_buf_resource_handle const buffer,
+                               uint64_t                     offset,
+                               uint32_t                     drawCount,
+                               uint32_t                     stride ) {
+
+	auto cmd  = EMPLACE_CMD( le::CommandDrawIndirect ); // placement new!
+	cmd->info = { buffer, offset, drawCount, stride ? stride : uint32_t( sizeof( le::DrawIndirectCommand ) ) };
+
+	cbe_commit( self, sizeof( le::CommandDrawIndirect ) );
+}
+
+// ----------------------------------------------------------------------
+
+static void cbe_draw_indexed_indirect( le_command_buffer_encoder_o* self,
+                                       le_buf_resource_handle const buffer,
+                                       uint64_t                     offset,
+                                       uint32_t                     drawCount,
+                                       uint32_t                     stride ) {
+
+	auto cmd  = EMPLACE_CMD( le::CommandDrawIndexedIndirect ); // placement new!
+	cmd->info = { buffer, offset, drawCount, stride ? stride : uint32_t( sizeof( le::DrawIndexedIndirectCommand ) ) };
+
+	cbe_commit( self, sizeof( le::CommandDrawIndexedIndirect ) );
+}
+
+// ----------------------------------------------------------------------
+// Like draw_indirect, but the number of draws is read from `count_buffer` at
+// execution time - it is clamped to `maxDrawCount`.
+static void cbe_draw_indirect_count( le_command_buffer_encoder_o* self,
+                                     le_buf_resource_handle const buffer,
+                                     uint64_t                     offset,
+                                     le_buf_resource_handle const count_buffer,
+                                     uint64_t                     count_offset,
+                                     uint32_t                     maxDrawCount,
+                                     uint32_t                     stride ) {
+
+	auto cmd  = EMPLACE_CMD( le::CommandDrawIndirectCount ); // placement new!
+	cmd->info = { buffer, offset, count_buffer, count_offset, maxDrawCount, stride ? stride : uint32_t( sizeof( le::DrawIndirectCommand ) ) };
+
+	cbe_commit( self, sizeof( le::CommandDrawIndirectCount ) );
+}
+
+// ----------------------------------------------------------------------
+
+static void cbe_draw_indexed_indirect_count( le_command_buffer_encoder_o* self,
+                                             le_buf_resource_handle const buffer,
+                                             uint64_t                     offset,
+                                             le_buf_resource_handle const count_buffer,
+                                             uint64_t                     count_offset,
+                                             uint32_t                     maxDrawCount,
+                                             uint32_t                     stride ) {
+
+	auto cmd  = EMPLACE_CMD( le::CommandDrawIndexedIndirectCount ); // placement new!
+	cmd->info = { buffer, offset, count_buffer, count_offset, maxDrawCount, stride ? stride : uint32_t( sizeof( le::DrawIndexedIndirectCommand ) ) };
+
+	cbe_commit( self, sizeof( le::CommandDrawIndexedIndirectCount ) );
 }
 
 // ----------------------------------------------------------------------
@@ -209,8 +489,7 @@ static void cbe_draw_mesh_tasks( le_command_buffer_encoder_o* self,
 	auto cmd  = EMPLACE_CMD( le::CommandDrawMeshTasks ); // placement new!
 	cmd->info = { taskCount, firstTask };
 
-	self->mCommandStreamSize += sizeof( le::CommandDrawMeshTasks );
-	self->mCommandCount++;
+	cbe_commit( self, sizeof( le::CommandDrawMeshTasks ) );
 }
 // ----------------------------------------------------------------------
 
@@ -219,12 +498,31 @@ static void cbe_set_viewport( le_command_buffer_encoder_o* self,
                               const uint32_t               viewportCount,
                               const le::Viewport*          pViewports ) {
 
-	auto cmd = EMPLACE_CMD( le::CommandSetViewport ); // placement new!
+	size_t dataSize = sizeof( le::Viewport ) * viewportCount;
+
+	auto& state = self->bound_state;
+
+	if ( self->elide_redundant_commands ) {
+		if ( state.viewport_count == viewportCount &&
+		     state.first_viewport == firstViewport &&
+		     0 == memcmp( state.viewports, pViewports, dataSize ) ) {
+			self->num_elided_commands++;
+			return;
+		}
+		if ( viewportCount <= cbe_bound_state_t::MAX_VIEWPORTS ) {
+			state.first_viewport = firstViewport;
+			state.viewport_count = viewportCount;
+			memcpy( state.viewports, pViewports, dataSize );
+		} else {
+			state.viewport_count = 0; // too many viewports to track
+		}
+	}
+
+	auto cmd = EMPLACE_CMD_WITH_PAYLOAD( le::CommandSetViewport, dataSize ); // placement new!
 
 	// We point data to the next available position in the data stream
 	// so that we can store the data for viewports inline.
-	void*  data     = ( cmd + 1 ); // note: this increments a le::CommandSetViewport pointer by one time its object size, then gets the address
-	size_t dataSize = sizeof( le::Viewport ) * viewportCount;
+	void* data = ( cmd + 1 ); // note: this increments a le::CommandSetViewport pointer by one time its object size, then gets the address
 
 	cmd->info = { firstViewport, viewportCount };
 	cmd->header.info.size += dataSize; // we must increase the size of this command by its payload size
@@ -252,8 +550,7 @@ static void cbe_set_viewport( le_command_buffer_encoder_o* self,
 		}
 	}
 
-	self->mCommandStreamSize += cmd->header.info.size;
-	self->mCommandCount++;
+	cbe_commit( self, cmd->header.info.size );
 };
 
 // ----------------------------------------------------------------------
@@ -263,20 +560,38 @@ static void cbe_set_scissor( le_command_buffer_encoder_o* self,
                              const uint32_t               scissorCount,
                              le::Rect2D const*            pScissors ) {
 
-	auto cmd = EMPLACE_CMD( le::CommandSetScissor ); // placement new!
+	size_t dataSize = sizeof( le::Rect2D ) * scissorCount;
+
+	auto& state = self->bound_state;
+
+	if ( self->elide_redundant_commands ) {
+		if ( state.scissor_count == scissorCount &&
+		     state.first_scissor == firstScissor &&
+		     0 == memcmp( state.scissors, pScissors, dataSize ) ) {
+			self->num_elided_commands++;
+			return;
+		}
+		if ( scissorCount <= cbe_bound_state_t::MAX_VIEWPORTS ) {
+			state.first_scissor = firstScissor;
+			state.scissor_count = scissorCount;
+			memcpy( state.scissors, pScissors, dataSize );
+		} else {
+			state.scissor_count = 0; // too many scissors to track
+		}
+	}
+
+	auto cmd = EMPLACE_CMD_WITH_PAYLOAD( le::CommandSetScissor, dataSize ); // placement new!
 
 	// We point to the next available position in the data stream
 	// so that we can store the data for scissors inline.
-	void*  data     = ( cmd + 1 );
-	size_t dataSize = sizeof( le::Rect2D ) * scissorCount;
+	void* data = ( cmd + 1 );
 
 	cmd->info = { firstScissor, scissorCount };
 	cmd->header.info.size += dataSize; // we must increase the size of this command by its payload size
 
 	memcpy( data, pScissors, dataSize );
 
-	self->mCommandStreamSize += cmd->header.info.size;
-	self->mCommandCount++;
+	cbe_commit( self, cmd->header.info.size );
 }
 
 // ----------------------------------------------------------------------
@@ -291,11 +606,44 @@ static void cbe_bind_vertex_buffers( le_command_buffer_encoder_o*  self,
 	// in the backend to actual vulkan buffer ids.
 	// Buffer must be annotated whether it is transient or not
 
-	auto cmd = EMPLACE_CMD( le::CommandBindVertexBuffers ); // placement new!
+	if ( self->elide_redundant_commands ) {
+
+		auto& state = self->bound_state;
+
+		if ( uint64_t( firstBinding ) + bindingCount <= cbe_bound_state_t::MAX_VERTEX_BINDINGS ) {
+
+			bool is_redundant = true;
+
+			for ( uint32_t i = 0; i != bindingCount; i++ ) {
+				uint32_t b = firstBinding + i;
+				if ( 0 == ( state.vertex_bindings_valid & ( 1u << b ) ) ||
+				     state.vertex_buffers[ b ] != pBuffers[ i ] ||
+				     state.vertex_offsets[ b ] != pOffsets[ i ] ) {
+					is_redundant              = false;
+					state.vertex_buffers[ b ] = pBuffers[ i ];
+					state.vertex_offsets[ b ] = pOffsets[ i ];
+					state.vertex_bindings_valid |= ( 1u << b );
+				}
+			}
+
+			if ( is_redundant ) {
+				self->num_elided_commands++;
+				return;
+			}
+
+		} else {
+			// Bindings out of tracked range - we must forget about all bindings which this command touches.
+			for ( uint32_t b = firstBinding; b < cbe_bound_state_t::MAX_VERTEX_BINDINGS; b++ ) {
+				state.vertex_bindings_valid &= ~( 1u << b );
+			}
+		}
+	}
 
 	size_t dataBuffersSize = ( sizeof( le_resource_handle ) ) * bindingCount;
 	size_t dataOffsetsSize = ( sizeof( uint64_t ) ) * bindingCount;
 
+	auto cmd = EMPLACE_CMD_WITH_PAYLOAD( le::CommandBindVertexBuffers, dataBuffersSize + dataOffsetsSize ); // placement new!
+
 	void* dataBuffers = ( cmd + 1 );
 	void* dataOffsets = ( static_cast<char*>( dataBuffers ) + dataBuffersSize ); // start address for offset data
 
@@ -305,8 +653,7 @@ static void cbe_bind_vertex_buffers( le_command_buffer_encoder_o*  self,
 	memcpy( dataBuffers, pBuffers, dataBuffersSize );
 	memcpy( dataOffsets, pOffsets, dataOffsetsSize );
 
-	self->mCommandStreamSize += cmd->header.info.size;
-	self->mCommandCount++;
+	cbe_commit( self, cmd->header.info.size );
 }
 
 // ----------------------------------------------------------------------
@@ -320,8 +667,7 @@ static void cbe_bind_index_buffer( le_command_buffer_encoder_o* self,
 	// Note: indexType==0 means uint16, indexType==1 means uint32
 	cmd->info = { buffer, offset, indexType, 0 };
 
-	self->mCommandStreamSize += cmd->header.info.size;
-	self->mCommandCount++;
+	cbe_commit( self, cmd->header.info.size );
 }
 
 // ----------------------------------------------------------------------
@@ -411,8 +757,39 @@ static void cbe_set_index_data( le_command_buffer_encoder_o*
 
 // ----------------------------------------------------------------------
 
+// Returns tracked binding for argument with given name, nullptr if no such binding is tracked.
+static cbe_bound_state_t::argument_buffer_t* cbe_find_argument_buffer( le_command_buffer_encoder_o* self, uint64_t argumentName ) {
+	for ( auto& a : self->bound_state.argument_buffers ) {
+		if ( a.argument_name_id == argumentName ) {
+			return &a;
+		}
+	}
+	return nullptr;
+}
+
+// ----------------------------------------------------------------------
+
 static void cbe_bind_argument_buffer( le_command_buffer_encoder_o* self, le_buf_resource_handle const bufferId, uint64_t argumentName, uint64_t offset, uint64_t range ) {
 
+	if ( self->elide_redundant_commands ) {
+
+		auto a = cbe_find_argument_buffer( self, argumentName );
+
+		if ( a == nullptr ) {
+			a = &self->bound_state.argument_buffers.emplace_back();
+
+			a->argument_name_id = argumentName;
+		} else if ( a->buffer_id == bufferId && a->offset == offset && a->range == range ) {
+			self->num_elided_commands++;
+			return;
+		}
+
+		a->buffer_id = bufferId;
+		a->offset    = offset;
+		a->range     = range;
+		a->data.clear();
+	}
+
 	auto cmd = EMPLACE_CMD( le::CommandBindArgumentBuffer );
 
 	cmd->info.argument_name_id = argumentName;
@@ -420,8 +797,7 @@ static void cbe_bind_argument_buffer( le_command_buffer_encoder_o* self, le_buf_
 	cmd->info.offset           = offset;
 	cmd->info.range            = range;
 
-	self->mCommandStreamSize += sizeof( le::CommandBindArgumentBuffer );
-	self->mCommandCount++;
+	cbe_commit( self, sizeof( le::CommandBindArgumentBuffer ) );
 }
 
 // ----------------------------------------------------------------------
@@ -437,6 +813,19 @@ static void cbe_set_argument_data( le_command_buffer_encoder_o* self,
 
 	// --------| invariant: there are some bytes to set
 
+	if ( self->elide_redundant_commands ) {
+
+		// If the argument is still bound to data identical to what we have been given,
+		// there is no need to allocate and bind again.
+
+		auto a = cbe_find_argument_buffer( self, argumentNameId );
+
+		if ( a && a->data.size() == numBytes && 0 == memcmp( a->data.data(), data, numBytes ) ) {
+			self->num_elided_commands++;
+			return;
+		}
+	}
+
 	void*    memAddr;
 	uint64_t bufferOffset = 0;
 
@@ -455,6 +844,13 @@ static void cbe_set_argument_data( le_command_buffer_encoder_o* self,
 
 		cbe_bind_argument_buffer( self, allocatorBuffer, argumentNameId, uint32_t( bufferOffset ), uint32_t( numBytes ) );
 
+		if ( self->elide_redundant_commands ) {
+			// Keep a copy of the data, so that we may detect if the same data gets set again.
+			auto a = cbe_find_argument_buffer( self, argumentNameId );
+			assert( a && "argument buffer binding must be tracked" );
+			a->data.assign( static_cast<char const*>( data ), static_cast<char const*>( data ) + numBytes );
+		}
+
 	} else {
 		std::cerr << "ERROR " << __PRETTY_FUNCTION__ << " could not allocate " << numBytes << " Bytes." << std::endl
 		          << std::flush;
@@ -472,8 +868,7 @@ static void cbe_set_argument_texture( le_command_buffer_encoder_o* self, le_text
 	cmd->info.texture_id       = textureId;
 	cmd->info.array_index      = arrayIndex;
 
-	self->mCommandStreamSize += sizeof( le::CommandSetArgumentTexture );
-	self->mCommandCount++;
+	cbe_commit( self, sizeof( le::CommandSetArgumentTexture ) );
 }
 
 // ----------------------------------------------------------------------
@@ -486,8 +881,7 @@ static void cbe_set_argument_image( le_command_buffer_encoder_o* self, le_img_re
 	cmd->info.image_id         = imageId;
 	cmd->info.array_index      = arrayIndex;
 
-	self->mCommandStreamSize += sizeof( le::CommandSetArgumentImage );
-	self->mCommandCount++;
+	cbe_commit( self, sizeof( le::CommandSetArgumentImage ) );
 }
 
 // ----------------------------------------------------------------------
@@ -500,27 +894,40 @@ static void cbe_set_argument_tlas( le_command_buffer_encoder_o* self, le_tlas_re
 	cmd->info.tlas_id          = tlasId;
 	cmd->info.array_index      = arrayIndex;
 
-	self->mCommandStreamSize += sizeof( le::CommandSetArgumentTlas );
-	self->mCommandCount++;
+	cbe_commit( self, sizeof( le::CommandSetArgumentTlas ) );
 }
 
 // ----------------------------------------------------------------------
 
 static void cbe_bind_graphics_pipeline( le_command_buffer_encoder_o* self, le_gpso_handle gpsoHandle ) {
 
+	if ( self->elide_redundant_commands ) {
+		if ( self->bound_state.graphics_pipeline == gpsoHandle ) {
+			// Pipeline is already bound - the backend keeps argument state for
+			// the bound pipeline, so argument bindings remain valid as well.
+			self->num_elided_commands++;
+			return;
+		}
+		self->bound_state.graphics_pipeline = gpsoHandle;
+		self->bound_state.argument_buffers.clear(); // binding a different pipeline resets arguments
+	}
+
 	// -- insert graphics PSO pointer into command stream
 	auto cmd = EMPLACE_CMD( le::CommandBindGraphicsPipeline );
 
 	cmd->info.gpsoHandle = gpsoHandle;
 
-	self->mCommandStreamSize += sizeof( le::CommandBindGraphicsPipeline );
-	self->mCommandCount++;
+	cbe_commit( self, sizeof( le::CommandBindGraphicsPipeline ) );
 }
 
 // ----------------------------------------------------------------------
 
 static void cbe_bind_rtx_pipeline( le_command_buffer_encoder_o* self, le_shader_binding_table_o* sbt ) {
 
+	// -- binding a pipeline resets arguments
+	self->bound_state.graphics_pipeline = nullptr;
+	self->bound_state.argument_buffers.clear();
+
 	// -- insert rtx PSO pointer into command stream
 	auto cmd = EMPLACE_CMD( le::CommandBindRtxPipeline );
 
@@ -712,21 +1119,23 @@ static void cbe_bind_rtx_pipeline( le_command_buffer_encoder_o* self, le_shader_
 	// query handles from pipeline manager.
 	// allocate data, point to data.
 
-	self->mCommandStreamSize += sizeof( le::CommandBindRtxPipeline );
-	self->mCommandCount++;
+	cbe_commit( self, sizeof( le::CommandBindRtxPipeline ) );
 }
 
 // ----------------------------------------------------------------------
 
 static void cbe_bind_compute_pipeline( le_command_buffer_encoder_o* self, le_cpso_handle cpsoHandle ) {
 
+	// -- binding a pipeline resets arguments
+	self->bound_state.graphics_pipeline = nullptr;
+	self->bound_state.argument_buffers.clear();
+
 	// -- insert compute PSO pointer into command stream
 	auto cmd = EMPLACE_CMD( le::CommandBindComputePipeline );
 
 	cmd->info.cpsoHandle = cpsoHandle;
 
-	self->mCommandStreamSize += sizeof( le::CommandBindComputePipeline );
-	self->mCommandCount++;
+	cbe_commit( self, sizeof( le::CommandBindComputePipeline ) );
 }
 
 // ----------------------------------------------------------------------
@@ -751,7 +1160,7 @@ static void cbe_write_to_buffer( le_command_buffer_encoder_o* self, le_buf_resou
 		memcpy( memAddr, data, numBytes );
 
 		cmd->info.src_buffer_id = srcResourceId;
-		cmd->info.src_offset    = 0; // staging allocator will give us a fresh buffer, and src memory will be placed at its start
+		cmd->info.src_offset    = 0; // relative to the start of staging memory - the backend adds the offset of staging memory into its buffer
 		cmd->info.dst_offset    = dst_offset;
 		cmd->info.numBytes      = numBytes;
 		cmd->info.dst_buffer_id = dst_buffer;
@@ -761,8 +1170,7 @@ static void cbe_write_to_buffer( le_command_buffer_encoder_o* self, le_buf_resou
 		return;
 	}
 
-	self->mCommandStreamSize += sizeof( le::CommandWriteToBuffer );
-	self->mCommandCount++;
+	cbe_commit( self, sizeof( le::CommandWriteToBuffer ) );
 }
 
 // ----------------------------------------------------------------------
@@ -814,14 +1222,13 @@ static void cbe_write_to_image( le_command_buffer_encoder_o*        self,
 		return;
 	}
 	// increase command stream size by size of command, plus size of regions attached to command.
-	self->mCommandStreamSize += cmd->header.info.size;
-	self->mCommandCount++;
+	cbe_commit( self, cmd->header.info.size );
 }
 
 // ----------------------------------------------------------------------
 static void cbe_set_push_constant_data( le_command_buffer_encoder_o* self, void const* src_data, uint64_t num_bytes ) {
 
-	auto cmd = EMPLACE_CMD( le::CommandSetPushConstantData ); // placement new!
+	auto cmd = EMPLACE_CMD_WITH_PAYLOAD( le::CommandSetPushConstantData, num_bytes ); // placement new!
 
 	// We point data to the next available position in the data stream
 	// so that we can store the data for push constants inline.
@@ -833,8 +1240,7 @@ static void cbe_set_push_constant_data( le_command_buffer_encoder_o* self, void
 	// copy data into command stream
 	memcpy( data, src_data, num_bytes );
 
-	self->mCommandStreamSize += cmd->header.info.size;
-	self->mCommandCount++;
+	cbe_commit( self, cmd->header.info.size );
 }
 // ----------------------------------------------------------------------
 
@@ -848,9 +1254,9 @@ static void cbe_build_rtx_blas( le_command_buffer_encoder_o*         self,
 		return;
 	}
 
-	auto   cmd       = EMPLACE_CMD( le::CommandBuildRtxBlas );
-	void*  data      = cmd + 1;
 	size_t data_size = sizeof( le_resource_handle ) * handles_count;
+	auto   cmd       = EMPLACE_CMD_WITH_PAYLOAD( le::CommandBuildRtxBlas, data_size );
+	void*  data      = cmd + 1;
 
 	cmd->info                    = {};
 	cmd->info.blas_handles_count = handles_count;
@@ -858,8 +1264,7 @@ static void cbe_build_rtx_blas( le_command_buffer_encoder_o*         self,
 
 	memcpy( data, p_blas_handles, data_size );
 
-	self->mCommandStreamSize += cmd->header.info.size;
-	self->mCommandCount++;
+	cbe_commit( self, cmd->header.info.size );
 }
 
 // ----------------------------------------------------------------------
@@ -870,7 +1275,10 @@ void cbe_build_rtx_tlas( le_command_buffer_encoder_o*      self,
                          le_blas_resource_handle const*    blas_handles,
                          uint32_t                          instances_count ) {
 
-	auto cmd = EMPLACE_CMD( le::CommandBuildRtxTlas );
+	// We store the blas handles inline with the command - see below.
+	size_t payload_size = sizeof( le_resource_handle ) * instances_count;
+
+	auto cmd = EMPLACE_CMD_WITH_PAYLOAD( le::CommandBuildRtxTlas, payload_size );
 
 	cmd->info                          = {};
 	cmd->info.tlas_handle              = *tlas_handle;
@@ -913,26 +1321,43 @@ void cbe_build_rtx_tlas( le_command_buffer_encoder_o*      self,
 	// VkAccelerationStructureHandles in the backend, where the names of the actual objects
 	// are known.
 
-	size_t payload_size = sizeof( le_resource_handle ) * instances_count;
 	cmd->header.info.size += payload_size;
 
 	void* memAddr = cmd + 1; // move to position just after command
 	memcpy( memAddr, blas_handles, payload_size );
 
-	self->mCommandStreamSize += cmd->header.info.size;
-	self->mCommandCount++;
+	cbe_commit( self, cmd->header.info.size );
 }
 
 // ----------------------------------------------------------------------
 
-static void cbe_get_encoded_data( le_command_buffer_encoder_o* self,
+// Fetches encoded command stream data for page with index `page_index`.
+// Returns false if there is no page with this index.
+static bool cbe_get_encoded_data( le_command_buffer_encoder_o* self,
+                                  size_t                       page_index,
                                   void**                       data,
                                   size_t*                      numBytes,
                                   size_t*                      numCommands ) {
 
-	*data        = self->mCommandStream;
-	*numBytes    = self->mCommandStreamSize;
-	*numCommands = self->mCommandCount;
+	if ( page_index >= self->mCommandStreamPages.size() ) {
+		return false;
+	}
+
+	// ---------| invariant: page with given index exists
+
+	auto page    = self->mCommandStreamPages[ page_index ];
+	*data        = command_stream_page_get_data( page );
+	*numBytes    = page->size;
+	*numCommands = page->num_commands;
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+// Returns the number of commands which were not recorded because they would have re-bound identical state.
+static uint32_t cbe_get_num_elided_commands( le_command_buffer_encoder_o* self ) {
+	return self->num_elided_commands;
 }
 
 // ----------------------------------------------------------------------
@@ -994,6 +1419,8 @@ void register_le_command_buffer_encoder_api( void* api_ ) {
 
 	cbe_i.create                 = cbe_create;
 	cbe_i.destroy                = cbe_destroy;
+	cbe_i.create_page_pool       = command_stream_page_pool_create;
+	cbe_i.destroy_page_pool      = command_stream_page_pool_destroy;
 	cbe_i.draw                   = cbe_draw;
 	cbe_i.draw_indexed           = cbe_draw_indexed;
 	cbe_i.draw_mesh_tasks        = cbe_draw_mesh_tasks;
@@ -1024,6 +1451,13 @@ void register_le_command_buffer_encoder_api( void* api_ ) {
 	cbe_i.build_rtx_tlas         = cbe_build_rtx_tlas;
 	cbe_i.get_pipeline_manager   = cbe_get_pipeline_manager;
 
+	cbe_i.get_num_elided_commands = cbe_get_num_elided_commands;
+
+	cbe_i.draw_indirect               = cbe_draw_indirect;
+	cbe_i.draw_indexed_indirect       = cbe_draw_indexed_indirect;
+	cbe_i.draw_indirect_count         = cbe_draw_indirect_count;
+	cbe_i.draw_indexed_indirect_count = cbe_draw_indexed_indirect_count;
+
 	cbe_i.build_sbt         = cbe_build_shader_binding_table;
 	cbe_i.sbt_set_ray_gen   = sbt_set_ray_gen;
 	cbe_i.sbt_add_hit       = sbt_add_hit;
@@ -0,0 +1,1327 @@
+#include "le_renderer.h"
+#include "le_backend_vk.h"
+#include "le_log.h"
+
+#include "private/le_renderer/le_resource_handle_t.inl"
+#include "private/le_renderer/le_rendergraph.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+static constexpr auto LOGGER_LABEL = "le_frame_capture";
+
+// ----------------------------------------------------------------------
+// Frame capture
+//
+// A frame capture stores everything the backend receives for a frame: the
+// rendergraph's passes, their encoded command streams, declared resources,
+// and any data which commands reference indirectly - i.e. encoder scratch
+// (virtual) buffer contents, staging buffer contents, and pipeline state.
+//
+// A capture can be replayed without the app which recorded it: replay turns
+// each captured pass back into a renderpass, and re-encodes its command
+// stream via the encoder api. Resource, texture, and pipeline handles are
+// translated into handles which are valid in the replaying process.
+//
+// Scratch buffer contents are uploaded into persistent replay buffers by an
+// extra transfer pass at the start of each replayed frame, so that all
+// offsets into scratch buffers stay valid.
+//
+// Limitations:
+// + Shader modules are recreated from their original source paths.
+// + Ray tracing commands, and any other commands which replay does not handle,
+//   are skipped.
+// + Captures are only meant to be read by the same build which wrote them.
+//
+// File layout: header, followed by one chunk per frame. Each chunk starts
+// with its size in bytes, so that a reader may skip frames.
+
+static constexpr char     LE_FRAME_CAPTURE_MAGIC[ 8 ] = { 'L', 'E', 'C', 'A', 'P', 'T', 'U', 'R' };
+static constexpr uint32_t LE_FRAME_CAPTURE_VERSION    = 1;
+
+struct capture_file_header_t {
+	char     magic[ 8 ];
+	uint32_t version;
+	uint32_t reserved;
+};
+
+// Description of a resource handle, enough to re-create an equivalent handle.
+struct captured_resource_t {
+	uint64_t id;           // value of resource handle in capturing process
+	uint64_t reference_id; // id of reference handle, 0 if none
+	uint32_t type;         // LeResourceType
+	uint8_t  num_samples;  //
+	uint8_t  flags;        //
+	uint16_t index;        //
+	char     debug_name[ 48 ];
+};
+
+// ----------------------------------------------------------------------
+
+static void blob_append( std::vector<char>& blob, void const* data, size_t num_bytes ) {
+	blob.insert( blob.end(), static_cast<char const*>( data ), static_cast<char const*>( data ) + num_bytes );
+}
+
+template <typename T>
+static void blob_append_value( std::vector<char>& blob, T const& value ) {
+	blob_append( blob, &value, sizeof( T ) );
+}
+
+// Appends u64 byte count, followed by bytes, padded to a multiple of 8 bytes so that
+// anything which follows keeps its alignment.
+static void blob_append_bytes( std::vector<char>& blob, void const* data, uint64_t num_bytes ) {
+	blob_append_value( blob, num_bytes );
+	blob_append( blob, data, num_bytes );
+	blob.resize( blob.size() + ( ( 8 - ( num_bytes % 8 ) ) % 8 ), 0 );
+}
+
+struct blob_reader_t {
+	char const* pos;
+	char const* end;
+
+	bool read( void* dst, size_t num_bytes ) {
+		if ( size_t( end - pos ) < num_bytes ) {
+			return false;
+		}
+		memcpy( dst, pos, num_bytes );
+		pos += num_bytes;
+		return true;
+	}
+
+	template <typename T>
+	bool read_value( T& value ) {
+		return read( &value, sizeof( T ) );
+	}
+
+	// Reads bytes written via blob_append_bytes
+	bool read_bytes( std::vector<char>& dst ) {
+		uint64_t num_bytes;
+		if ( !read_value( num_bytes ) ) {
+			return false;
+		}
+		uint64_t const padded_num_bytes = num_bytes + ( ( 8 - ( num_bytes % 8 ) ) % 8 );
+		if ( uint64_t( end - pos ) < padded_num_bytes ) {
+			return false;
+		}
+		dst.assign( pos, pos + num_bytes );
+		pos += padded_num_bytes;
+		return true;
+	}
+};
+
+template <typename T>
+static void push_back_unique( std::vector<T>& vec, T const& value ) {
+	if ( std::find( vec.begin(), vec.end(), value ) == vec.end() ) {
+		vec.push_back( value );
+	}
+}
+
+template <typename T>
+static uint64_t handle_to_id( T const& handle ) {
+	return uint64_t( reinterpret_cast<uintptr_t>( handle ) );
+}
+
+// ----------------------------------------------------------------------
+// Calls `fn( header )` for each command in all pages of a command stream.
+template <typename Fn>
+static void for_each_command( std::vector<std::vector<char>> const& pages, Fn const& fn ) {
+	for ( auto const& page : pages ) {
+		char const* cmd = page.data();
+		char const* end = page.data() + page.size();
+		while ( cmd < end ) {
+			auto header = reinterpret_cast<le::CommandHeader const*>( cmd );
+			fn( header );
+			cmd += header->info.size;
+		}
+	}
+}
+
+static bool command_is_rtx( le::CommandType const& type ) {
+	return type == le::CommandType::eBuildRtxBlas ||
+	       type == le::CommandType::eBuildRtxTlas ||
+	       type == le::CommandType::eBindRtxPipeline ||
+	       type == le::CommandType::eTraceRays ||
+	       type == le::CommandType::eSetArgumentTlas;
+}
+
+// ----------------------------------------------------------------------
+// Writer
+// ----------------------------------------------------------------------
+
+struct le_frame_capture_writer_o {
+	FILE*    file               = nullptr; // owning
+	uint32_t num_frames_written = 0;
+	bool     did_warn_about_rtx = false;
+};
+
+// Handles and data referenced by a frame - collected while walking the frame's command streams.
+struct frame_capture_references_t {
+	std::vector<le_resource_handle>     resources;
+	std::vector<le_texture_handle>      textures;
+	std::vector<le_gpso_handle>         gpsos;
+	std::vector<le_cpso_handle>         cpsos;
+	std::vector<le_buf_resource_handle> virtual_buffers; // encoder scratch buffers
+	std::vector<le_buf_resource_handle> staging_buffers;
+	bool                                has_rtx_commands = false;
+};
+
+// ----------------------------------------------------------------------
+
+static void references_add_resource( frame_capture_references_t& refs, le_resource_handle resource ) {
+	if ( resource == nullptr ) {
+		return;
+	}
+	if ( std::find( refs.resources.begin(), refs.resources.end(), resource ) != refs.resources.end() ) {
+		return;
+	}
+	refs.resources.push_back( resource );
+	references_add_resource( refs, resource->data->reference_handle );
+}
+
+// ----------------------------------------------------------------------
+
+static void references_add_buffer( frame_capture_references_t& refs, le_buf_resource_handle buffer ) {
+	if ( buffer == nullptr ) {
+		return;
+	}
+	if ( buffer->data->flags == uint8_t( le_buf_resource_usage_flags_t::eIsVirtual ) ) {
+		push_back_unique( refs.virtual_buffers, buffer );
+	} else if ( buffer->data->flags == uint8_t( le_buf_resource_usage_flags_t::eIsStaging ) ) {
+		push_back_unique( refs.staging_buffers, buffer );
+	}
+	references_add_resource( refs, buffer );
+}
+
+// ----------------------------------------------------------------------
+
+static void references_add_command( frame_capture_references_t& refs, le::CommandHeader const* header ) {
+
+	switch ( header->info.type ) {
+	case le::CommandType::eBindGraphicsPipeline:
+		push_back_unique( refs.gpsos, reinterpret_cast<le::CommandBindGraphicsPipeline const*>( header )->info.gpsoHandle );
+		break;
+	case le::CommandType::eBindComputePipeline:
+		push_back_unique( refs.cpsos, reinterpret_cast<le::CommandBindComputePipeline const*>( header )->info.cpsoHandle );
+		break;
+	case le::CommandType::eBindVertexBuffers: {
+		auto cmd      = reinterpret_cast<le::CommandBindVertexBuffers const*>( header );
+		auto pBuffers = reinterpret_cast<le_buf_resource_handle const*>( cmd + 1 ); // don't trust pointers: payload is stored inline
+		for ( uint32_t i = 0; i != cmd->info.bindingCount; i++ ) {
+			references_add_buffer( refs, pBuffers[ i ] );
+		}
+	} break;
+	case le::CommandType::eBindIndexBuffer:
+		references_add_buffer( refs, reinterpret_cast<le::CommandBindIndexBuffer const*>( header )->info.buffer );
+		break;
+	case le::CommandType::eBindArgumentBuffer:
+		references_add_buffer( refs, reinterpret_cast<le::CommandBindArgumentBuffer const*>( header )->info.buffer_id );
+		break;
+	case le::CommandType::eBufferMemoryBarrier:
+		references_add_buffer( refs, reinterpret_cast<le::CommandBufferMemoryBarrier const*>( header )->info.buffer );
+		break;
+	case le::CommandType::eDrawIndirect:
+		references_add_buffer( refs, reinterpret_cast<le::CommandDrawIndirect const*>( header )->info.buffer );
+		break;
+	case le::CommandType::eDrawIndexedIndirect:
+		references_add_buffer( refs, reinterpret_cast<le::CommandDrawIndexedIndirect const*>( header )->info.buffer );
+		break;
+	case le::CommandType::eDrawIndirectCount: {
+		auto cmd = reinterpret_cast<le::CommandDrawIndirectCount const*>( header );
+		references_add_buffer( refs, cmd->info.buffer );
+		references_add_buffer( refs, cmd->info.count_buffer );
+	} break;
+	case le::CommandType::eDrawIndexedIndirectCount: {
+		auto cmd = reinterpret_cast<le::CommandDrawIndexedIndirectCount const*>( header );
+		references_add_buffer( refs, cmd->info.buffer );
+		references_add_buffer( refs, cmd->info.count_buffer );
+	} break;
+	case le::CommandType::eSetArgumentTexture:
+		push_back_unique( refs.textures, reinterpret_cast<le::CommandSetArgumentTexture const*>( header )->info.texture_id );
+		break;
+	case le::CommandType::eSetArgumentImage:
+		references_add_resource( refs, reinterpret_cast<le::CommandSetArgumentImage const*>( header )->info.image_id );
+		break;
+	case le::CommandType::eWriteToBuffer: {
+		auto cmd = reinterpret_cast<le::CommandWriteToBuffer const*>( header );
+		references_add_buffer( refs, cmd->info.src_buffer_id );
+		references_add_buffer( refs, cmd->info.dst_buffer_id );
+	} break;
+	case le::CommandType::eWriteToImage: {
+		auto cmd = reinterpret_cast<le::CommandWriteToImage const*>( header );
+		references_add_buffer( refs, cmd->info.src_buffer_id );
+		references_add_resource( refs, cmd->info.dst_image_id );
+	} break;
+	default:
+		refs.has_rtx_commands |= command_is_rtx( header->info.type );
+		break;
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static le_frame_capture_writer_o* frame_capture_writer_create( char const* path ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	FILE* file = fopen( path, "wb" );
+
+	if ( nullptr == file ) {
+		logger.error( "Could not open file for frame capture: '%s'", path );
+		return nullptr;
+	}
+
+	capture_file_header_t header{};
+	memcpy( header.magic, LE_FRAME_CAPTURE_MAGIC, sizeof( header.magic ) );
+	header.version = LE_FRAME_CAPTURE_VERSION;
+	fwrite( &header, sizeof( header ), 1, file );
+
+	auto self  = new le_frame_capture_writer_o{};
+	self->file = file;
+
+	logger.info( "Capturing frames to: '%s'", path );
+
+	return self;
+}
+
+// ----------------------------------------------------------------------
+
+static void frame_capture_writer_destroy( le_frame_capture_writer_o* self ) {
+	static auto logger = LeLog( LOGGER_LABEL );
+	if ( self->file ) {
+		fclose( self->file );
+	}
+	logger.info( "Frame capture complete: %u frames captured.", self->num_frames_written );
+	delete self;
+}
+
+// ----------------------------------------------------------------------
+// Writes a frame to the capture file - this must be called once the rendergraph has been
+// executed, but before the backend has acquired physical resources for the frame, as the
+// backend takes ownership of encoders when it acquires physical resources.
+static bool frame_capture_writer_write_frame( le_frame_capture_writer_o* self, le_rendergraph_o const* rendergraph, le_backend_o* backend, size_t frame_index, uint64_t frame_number ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	using namespace le_backend_vk;
+	using namespace le_renderer;
+
+	// -- Collect command stream pages for all passes, and any handles referenced by passes and commands.
+
+	frame_capture_references_t                  refs;
+	std::vector<std::vector<std::vector<char>>> pass_pages( rendergraph->passes.size() );
+
+	for ( size_t i = 0; i != rendergraph->passes.size(); i++ ) {
+		le_renderpass_o const* pass = rendergraph->passes[ i ];
+
+		for ( auto const& r : pass->resources ) {
+			references_add_resource( refs, r );
+		}
+		for ( size_t j = 0; j != pass->textureIds.size(); j++ ) {
+			push_back_unique( refs.textures, pass->textureIds[ j ] );
+			references_add_resource( refs, pass->textureInfos[ j ].imageView.imageId );
+		}
+
+		if ( pass->encoder == nullptr ) {
+			continue;
+		}
+
+		void*  data;
+		size_t num_bytes;
+		size_t num_commands;
+		for ( size_t page_index = 0; encoder_i.get_encoded_data( pass->encoder, page_index, &data, &num_bytes, &num_commands ); page_index++ ) {
+			pass_pages[ i ].emplace_back( static_cast<char*>( data ), static_cast<char*>( data ) + num_bytes );
+		}
+
+		for_each_command( pass_pages[ i ], [ &refs ]( le::CommandHeader const* header ) { references_add_command( refs, header ); } );
+	}
+
+	for ( auto const& r : rendergraph->declared_resources_id ) {
+		references_add_resource( refs, r );
+	}
+
+	if ( refs.has_rtx_commands && !self->did_warn_about_rtx ) {
+		logger.warn( "Frame contains ray tracing commands - these will not be replayed." );
+		self->did_warn_about_rtx = true;
+	}
+
+	// -- Serialise frame
+
+	std::vector<char> blob;
+
+	uint32_t swapchain_width  = 0;
+	uint32_t swapchain_height = 0;
+	{
+		uint32_t                            num_swapchains = 1;
+		std::vector<uint32_t>               widths;
+		std::vector<uint32_t>               heights;
+		std::vector<le_img_resource_handle> images;
+		do {
+			widths.resize( num_swapchains );
+			heights.resize( num_swapchains );
+			images.resize( num_swapchains );
+		} while ( false == vk_backend_i.get_swapchains_infos( backend, uint32_t( frame_index ), &num_swapchains, widths.data(), heights.data(), images.data() ) );
+		if ( num_swapchains > 0 ) {
+			swapchain_width  = widths[ 0 ];
+			swapchain_height = heights[ 0 ];
+		}
+	}
+
+	blob_append_value( blob, frame_number );
+	blob_append_value( blob, swapchain_width );
+	blob_append_value( blob, swapchain_height );
+
+	// Resources
+
+	blob_append_value( blob, uint64_t( refs.resources.size() ) );
+	for ( auto const& r : refs.resources ) {
+		captured_resource_t res{};
+		res.id           = handle_to_id( r );
+		res.reference_id = handle_to_id( r->data->reference_handle );
+		res.type         = uint32_t( r->data->type );
+		res.num_samples  = r->data->num_samples;
+		res.flags        = r->data->flags;
+		res.index        = r->data->index;
+		memcpy( res.debug_name, r->data->debug_name, sizeof( res.debug_name ) );
+		blob_append_value( blob, res );
+	}
+
+	// Textures
+
+	blob_append_value( blob, uint64_t( refs.textures.size() ) );
+	for ( auto const& t : refs.textures ) {
+		char const* name = renderer_i.texture_handle_get_name( t );
+		blob_append_value( blob, handle_to_id( t ) );
+		blob_append_bytes( blob, name, name ? strlen( name ) : 0 );
+	}
+
+	// Pipeline state objects
+
+	le_pipeline_manager_o* pipeline_manager = vk_backend_i.get_pipeline_cache( backend );
+	std::vector<char>      pso_data;
+
+	blob_append_value( blob, uint64_t( refs.gpsos.size() ) );
+	for ( auto const& h : refs.gpsos ) {
+		pso_data.resize( le_pipeline_manager_i.serialize_graphics_pipeline_state( pipeline_manager, h, nullptr, 0 ) );
+		le_pipeline_manager_i.serialize_graphics_pipeline_state( pipeline_manager, h, pso_data.data(), pso_data.size() );
+		blob_append_value( blob, handle_to_id( h ) );
+		blob_append_bytes( blob, pso_data.data(), pso_data.size() );
+	}
+
+	blob_append_value( blob, uint64_t( refs.cpsos.size() ) );
+	for ( auto const& h : refs.cpsos ) {
+		pso_data.resize( le_pipeline_manager_i.serialize_compute_pipeline_state( pipeline_manager, h, nullptr, 0 ) );
+		le_pipeline_manager_i.serialize_compute_pipeline_state( pipeline_manager, h, pso_data.data(), pso_data.size() );
+		blob_append_value( blob, handle_to_id( h ) );
+		blob_append_bytes( blob, pso_data.data(), pso_data.size() );
+	}
+
+	// Buffer contents: encoder scratch buffers, and staging buffers.
+	// Each block stores the offset into its buffer at which its data starts.
+
+	auto staging_allocator = vk_backend_i.get_staging_allocator( backend, frame_index );
+
+	blob_append_value( blob, uint64_t( refs.virtual_buffers.size() + refs.staging_buffers.size() ) );
+
+	for ( auto const& b : refs.virtual_buffers ) {
+		void const* data          = nullptr;
+		uint64_t    buffer_offset = 0;
+		uint64_t    num_bytes     = 0;
+		if ( !vk_backend_i.get_transient_buffer_used_data( backend, frame_index, b, &data, &buffer_offset, &num_bytes ) ) {
+			logger.error( "Could not find transient data for buffer '%s' [%d]", b->data->debug_name, b->data->index );
+			num_bytes = 0;
+		}
+		blob_append_value( blob, handle_to_id( b ) );
+		blob_append_value( blob, buffer_offset );
+		blob_append_bytes( blob, data, num_bytes );
+	}
+
+	for ( auto const& b : refs.staging_buffers ) {
+		void const* data      = nullptr;
+		uint64_t    num_bytes = 0;
+		if ( !le_staging_allocator_i.get_mapped_data( staging_allocator, b, &data, &num_bytes ) ) {
+			logger.error( "Could not find staging data for buffer '%s' [%d]", b->data->debug_name, b->data->index );
+			num_bytes = 0;
+		}
+		blob_append_value( blob, handle_to_id( b ) );
+		blob_append_value( blob, uint64_t( 0 ) ); // relative to this handle's sub-allocation - its offset within the staging ring is added by the backend
+		blob_append_bytes( blob, data, num_bytes );
+	}
+
+	// Declared resources
+
+	blob_append_value( blob, uint64_t( rendergraph->declared_resources_id.size() ) );
+	for ( size_t i = 0; i != rendergraph->declared_resources_id.size(); i++ ) {
+		blob_append_value( blob, handle_to_id( rendergraph->declared_resources_id[ i ] ) );
+		blob_append_value( blob, rendergraph->declared_resources_info[ i ] );
+	}
+
+	// Passes
+
+	blob_append_value( blob, uint64_t( rendergraph->passes.size() ) );
+	for ( size_t i = 0; i != rendergraph->passes.size(); i++ ) {
+		le_renderpass_o const* pass = rendergraph->passes[ i ];
+
+		blob_append_value( blob, pass->debugName );
+		blob_append_value( blob, uint32_t( pass->type ) );
+		blob_append_value( blob, uint32_t( pass->is_root ) );
+		blob_append_value( blob, pass->width );
+		blob_append_value( blob, pass->height );
+		blob_append_value( blob, uint32_t( pass->sample_count ) );
+		blob_append_value( blob, uint32_t( pass->encoder != nullptr ) );
+
+		blob_append_value( blob, uint64_t( pass->resources.size() ) );
+		for ( size_t j = 0; j != pass->resources.size(); j++ ) {
+			blob_append_value( blob, handle_to_id( pass->resources[ j ] ) );
+			blob_append_value( blob, uint64_t( pass->resources_read_write_flags[ j ] ) );
+			blob_append_value( blob, pass->resources_access_flags[ j ] );
+		}
+
+		blob_append_value( blob, uint64_t( pass->attachmentResources.size() ) );
+		for ( size_t j = 0; j != pass->attachmentResources.size(); j++ ) {
+			blob_append_value( blob, handle_to_id( pass->attachmentResources[ j ] ) );
+			blob_append_value( blob, pass->imageAttachments[ j ] );
+		}
+
+		blob_append_value( blob, uint64_t( pass->textureIds.size() ) );
+		for ( size_t j = 0; j != pass->textureIds.size(); j++ ) {
+			blob_append_value( blob, handle_to_id( pass->textureIds[ j ] ) );
+			blob_append_value( blob, pass->textureInfos[ j ] ); // note: imageView.imageId is stored as an id
+		}
+
+		blob_append_value( blob, uint64_t( pass_pages[ i ].size() ) );
+		for ( auto const& page : pass_pages[ i ] ) {
+			blob_append_bytes( blob, page.data(), page.size() );
+		}
+	}
+
+	uint64_t const chunk_size = blob.size();
+
+	bool result = ( 1 == fwrite( &chunk_size, sizeof( chunk_size ), 1, self->file ) ) &&
+	              ( 1 == fwrite( blob.data(), blob.size(), 1, self->file ) );
+
+	if ( result ) {
+		self->num_frames_written++;
+	} else {
+		logger.error( "Could not write frame %llu to capture file.", (unsigned long long)frame_number );
+	}
+
+	return result;
+}
+
+// ----------------------------------------------------------------------
+// Reader / Replay
+// ----------------------------------------------------------------------
+
+struct captured_frame_t;
+
+struct captured_pass_t {
+	le_frame_capture_o* capture; // non-owning, back-reference for execute callback
+	captured_frame_t*   frame;   // non-owning, back-reference for execute callback
+
+	char                    debug_name[ 256 ];
+	le::QueueFlagBits       type;
+	uint32_t                is_root;
+	uint32_t                width;
+	uint32_t                height;
+	le::SampleCountFlagBits sample_count;
+	bool                    has_encoder;
+
+	std::vector<uint64_t>         resources; // resource ids
+	std::vector<le::RWFlags>      resources_read_write_flags;
+	std::vector<le::AccessFlags2> resources_access_flags;
+
+	std::vector<uint64_t>                   attachment_resources; // resource ids
+	std::vector<le_image_attachment_info_t> image_attachments;
+
+	std::vector<uint64_t>                texture_ids;
+	std::vector<le_image_sampler_info_t> texture_infos; // imageView.imageId holds a resource id
+
+	std::vector<std::vector<char>> pages;           // command stream
+	std::vector<uint64_t>          virtual_buffers; // ids of scratch buffers referenced by commands in this pass
+};
+
+struct captured_frame_t {
+	le_frame_capture_o* capture; // non-owning, back-reference for upload callback
+
+	uint64_t frame_number;
+	uint32_t swapchain_width;
+	uint32_t swapchain_height;
+
+	std::unordered_map<uint64_t, std::pair<uint64_t, std::vector<char>>> buffer_data; // buffer id -> (buffer offset, data)
+
+	std::vector<uint64_t>           declared_resources_id;
+	std::vector<le_resource_info_t> declared_resources_info;
+
+	std::vector<captured_pass_t> passes;
+};
+
+struct le_frame_capture_o {
+	std::unordered_map<uint64_t, captured_resource_t> resources;   // all resources over all frames, by id
+	std::unordered_map<uint64_t, std::string>         textures;    // all texture names over all frames, by id
+	std::unordered_map<uint64_t, std::vector<char>>   gpso_blobs;  // serialised graphics pipeline state, by id
+	std::unordered_map<uint64_t, std::vector<char>>   cpso_blobs;  // serialised compute pipeline state, by id
+	std::unordered_map<uint64_t, uint32_t>            replay_buffer_sizes; // scratch buffer id -> size of replay buffer
+
+	std::vector<captured_frame_t> frames;
+
+	// -- Translation of captured ids into handles for the replaying process - filled lazily
+
+	std::unordered_map<uint64_t, le_resource_handle> resource_handles;
+	std::unordered_map<uint64_t, le_texture_handle>  texture_handles;
+	std::unordered_map<uint64_t, le_gpso_handle>     gpso_handles;
+	std::unordered_map<uint64_t, le_cpso_handle>     cpso_handles;
+
+	le_img_resource_handle swapchain_image                   = nullptr; // replaying process swapchain image, set via add_frame_to_rendergraph
+	bool                   did_warn_about_unhandled_commands = false;   // we only warn about the first command which can't be replayed
+};
+
+// ----------------------------------------------------------------------
+
+static bool read_pass( blob_reader_t& reader, captured_pass_t& pass ) {
+
+	uint32_t type, sample_count, has_encoder;
+	uint64_t count;
+
+	if ( !reader.read_value( pass.debug_name ) ||
+	     !reader.read_value( type ) ||
+	     !reader.read_value( pass.is_root ) ||
+	     !reader.read_value( pass.width ) ||
+	     !reader.read_value( pass.height ) ||
+	     !reader.read_value( sample_count ) ||
+	     !reader.read_value( has_encoder ) ) {
+		return false;
+	}
+
+	pass.debug_name[ sizeof( pass.debug_name ) - 1 ] = '\0';
+	pass.type                                        = le::QueueFlagBits( type );
+	pass.sample_count                                = le::SampleCountFlagBits( sample_count );
+	pass.has_encoder                                 = has_encoder != 0;
+
+	if ( !reader.read_value( count ) ) {
+		return false;
+	}
+	for ( uint64_t i = 0; i != count; i++ ) {
+		uint64_t         id, rw_flags;
+		le::AccessFlags2 access_flags;
+		if ( !reader.read_value( id ) || !reader.read_value( rw_flags ) || !reader.read_value( access_flags ) ) {
+			return false;
+		}
+		pass.resources.push_back( id );
+		pass.resources_read_write_flags.push_back( le::RWFlags( rw_flags ) );
+		pass.resources_access_flags.push_back( access_flags );
+	}
+
+	if ( !reader.read_value( count ) ) {
+		return false;
+	}
+	for ( uint64_t i = 0; i != count; i++ ) {
+		uint64_t                   id;
+		le_image_attachment_info_t info;
+		if ( !reader.read_value( id ) || !reader.read_value( info ) ) {
+			return false;
+		}
+		pass.attachment_resources.push_back( id );
+		pass.image_attachments.push_back( info );
+	}
+
+	if ( !reader.read_value( count ) ) {
+		return false;
+	}
+	for ( uint64_t i = 0; i != count; i++ ) {
+		uint64_t                id;
+		le_image_sampler_info_t info;
+		if ( !reader.read_value( id ) || !reader.read_value( info ) ) {
+			return false;
+		}
+		pass.texture_ids.push_back( id );
+		pass.texture_infos.push_back( info );
+	}
+
+	if ( !reader.read_value( count ) ) {
+		return false;
+	}
+	pass.pages.resize( count );
+	for ( auto& page : pass.pages ) {
+		if ( !reader.read_bytes( page ) ) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+static bool read_frame( le_frame_capture_o* self, blob_reader_t& reader, captured_frame_t& frame ) {
+
+	uint64_t count;
+
+	if ( !reader.read_value( frame.frame_number ) ||
+	     !reader.read_value( frame.swapchain_width ) ||
+	     !reader.read_value( frame.swapchain_height ) ) {
+		return false;
+	}
+
+	if ( !reader.read_value( count ) ) {
+		return false;
+	}
+	for ( uint64_t i = 0; i != count; i++ ) {
+		captured_resource_t res;
+		if ( !reader.read_value( res ) ) {
+			return false;
+		}
+		res.debug_name[ sizeof( res.debug_name ) - 1 ] = '\0';
+		self->resources[ res.id ]                      = res;
+	}
+
+	if ( !reader.read_value( count ) ) {
+		return false;
+	}
+	for ( uint64_t i = 0; i != count; i++ ) {
+		uint64_t          id;
+		std::vector<char> name;
+		if ( !reader.read_value( id ) || !reader.read_bytes( name ) ) {
+			return false;
+		}
+		self->textures[ id ] = std::string( name.begin(), name.end() );
+	}
+
+	for ( auto blobs : { &self->gpso_blobs, &self->cpso_blobs } ) {
+		if ( !reader.read_value( count ) ) {
+			return false;
+		}
+		for ( uint64_t i = 0; i != count; i++ ) {
+			uint64_t          id;
+			std::vector<char> data;
+			if ( !reader.read_value( id ) || !reader.read_bytes( data ) ) {
+				return false;
+			}
+			( *blobs )[ id ] = std::move( data );
+		}
+	}
+
+	if ( !reader.read_value( count ) ) {
+		return false;
+	}
+	for ( uint64_t i = 0; i != count; i++ ) {
+		uint64_t          id, buffer_offset;
+		std::vector<char> data;
+		if ( !reader.read_value( id ) || !reader.read_value( buffer_offset ) || !reader.read_bytes( data ) ) {
+			return false;
+		}
+		frame.buffer_data[ id ] = { buffer_offset, std::move( data ) };
+	}
+
+	if ( !reader.read_value( count ) ) {
+		return false;
+	}
+	for ( uint64_t i = 0; i != count; i++ ) {
+		uint64_t           id;
+		le_resource_info_t info;
+		if ( !reader.read_value( id ) || !reader.read_value( info ) ) {
+			return false;
+		}
+		frame.declared_resources_id.push_back( id );
+		frame.declared_resources_info.push_back( info );
+	}
+
+	if ( !reader.read_value( count ) ) {
+		return false;
+	}
+	frame.passes.resize( count );
+	for ( auto& pass : frame.passes ) {
+		if ( !read_pass( reader, pass ) ) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+static bool resource_is_virtual_buffer( captured_resource_t const& res ) {
+	return res.type == uint32_t( LeResourceType::eBuffer ) && res.flags == uint8_t( le_buf_resource_usage_flags_t::eIsVirtual );
+}
+
+// ----------------------------------------------------------------------
+// Collects ids of buffers which are bound by a command from a captured command stream.
+// Captured handles are only compared by value, as they are not valid in the replaying process.
+static void command_get_bound_buffer_ids( le::CommandHeader const* header, std::vector<uint64_t>& ids ) {
+
+	switch ( header->info.type ) {
+	case le::CommandType::eBindVertexBuffers: {
+		auto cmd      = reinterpret_cast<le::CommandBindVertexBuffers const*>( header );
+		auto pBuffers = reinterpret_cast<le_buf_resource_handle const*>( cmd + 1 );
+		for ( uint32_t i = 0; i != cmd->info.bindingCount; i++ ) {
+			push_back_unique( ids, handle_to_id( pBuffers[ i ] ) );
+		}
+	} break;
+	case le::CommandType::eBindIndexBuffer:
+		push_back_unique( ids, handle_to_id( reinterpret_cast<le::CommandBindIndexBuffer const*>( header )->info.buffer ) );
+		break;
+	case le::CommandType::eBindArgumentBuffer:
+		push_back_unique( ids, handle_to_id( reinterpret_cast<le::CommandBindArgumentBuffer const*>( header )->info.buffer_id ) );
+		break;
+	case le::CommandType::eBufferMemoryBarrier:
+		push_back_unique( ids, handle_to_id( reinterpret_cast<le::CommandBufferMemoryBarrier const*>( header )->info.buffer ) );
+		break;
+	case le::CommandType::eDrawIndirect:
+		push_back_unique( ids, handle_to_id( reinterpret_cast<le::CommandDrawIndirect const*>( header )->info.buffer ) );
+		break;
+	case le::CommandType::eDrawIndexedIndirect:
+		push_back_unique( ids, handle_to_id( reinterpret_cast<le::CommandDrawIndexedIndirect const*>( header )->info.buffer ) );
+		break;
+	case le::CommandType::eDrawIndirectCount: {
+		auto cmd = reinterpret_cast<le::CommandDrawIndirectCount const*>( header );
+		push_back_unique( ids, handle_to_id( cmd->info.buffer ) );
+		push_back_unique( ids, handle_to_id( cmd->info.count_buffer ) );
+	} break;
+	case le::CommandType::eDrawIndexedIndirectCount: {
+		auto cmd = reinterpret_cast<le::CommandDrawIndexedIndirectCount const*>( header );
+		push_back_unique( ids, handle_to_id( cmd->info.buffer ) );
+		push_back_unique( ids, handle_to_id( cmd->info.count_buffer ) );
+	} break;
+	default:
+		break;
+	}
+}
+
+// ----------------------------------------------------------------------
+// Once all frames are loaded, find out which scratch buffers each pass references,
+// and how large replay buffers for scratch buffers must be to fit all frames.
+static void frame_capture_gather_virtual_buffers( le_frame_capture_o* self ) {
+
+	for ( auto& frame : self->frames ) {
+
+		for ( auto const& [ id, data ] : frame.buffer_data ) {
+			auto res = self->resources.find( id );
+			if ( res != self->resources.end() && resource_is_virtual_buffer( res->second ) ) {
+				uint32_t& size = self->replay_buffer_sizes[ id ];
+				size           = std::max( size, uint32_t( data.first + data.second.size() ) );
+			}
+		}
+
+		for ( auto& pass : frame.passes ) {
+			std::vector<uint64_t> ids;
+			for_each_command( pass.pages, [ &ids ]( le::CommandHeader const* header ) { command_get_bound_buffer_ids( header, ids ); } );
+			for ( auto const& id : ids ) {
+				auto res = self->resources.find( id );
+				if ( res != self->resources.end() && resource_is_virtual_buffer( res->second ) ) {
+					pass.virtual_buffers.push_back( id );
+				}
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static le_frame_capture_o* frame_capture_load( char const* path ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	FILE* file = fopen( path, "rb" );
+
+	if ( nullptr == file ) {
+		logger.error( "Could not open frame capture: '%s'", path );
+		return nullptr;
+	}
+
+	capture_file_header_t header{};
+
+	if ( 1 != fread( &header, sizeof( header ), 1, file ) ||
+	     0 != memcmp( header.magic, LE_FRAME_CAPTURE_MAGIC, sizeof( header.magic ) ) ||
+	     header.version != LE_FRAME_CAPTURE_VERSION ) {
+		logger.error( "Not a frame capture, or unsupported version: '%s'", path );
+		fclose( file );
+		return nullptr;
+	}
+
+	auto self = new le_frame_capture_o{};
+
+	uint64_t          chunk_size;
+	std::vector<char> chunk;
+
+	while ( 1 == fread( &chunk_size, sizeof( chunk_size ), 1, file ) ) {
+
+		chunk.resize( chunk_size );
+
+		if ( 1 != fread( chunk.data(), chunk_size, 1, file ) ) {
+			logger.warn( "Frame capture '%s' is truncated - ignoring last frame.", path );
+			break;
+		}
+
+		blob_reader_t reader{ chunk.data(), chunk.data() + chunk.size() };
+
+		self->frames.emplace_back();
+
+		if ( !read_frame( self, reader, self->frames.back() ) ) {
+			logger.warn( "Could not read frame %zu of capture '%s' - ignoring it, and any following frames.", self->frames.size() - 1, path );
+			self->frames.pop_back();
+			break;
+		}
+	}
+
+	fclose( file );
+
+	frame_capture_gather_virtual_buffers( self );
+
+	// Set back-references once the frames vector won't move anymore.
+	for ( auto& frame : self->frames ) {
+		frame.capture = self;
+		for ( auto& pass : frame.passes ) {
+			pass.capture = self;
+			pass.frame   = &frame;
+		}
+	}
+
+	logger.info( "Loaded frame capture '%s': %zu frames.", path, self->frames.size() );
+
+	return self;
+}
+
+// ----------------------------------------------------------------------
+
+static void frame_capture_destroy( le_frame_capture_o* self ) {
+	delete self;
+}
+
+// ----------------------------------------------------------------------
+
+static uint32_t frame_capture_get_num_frames( le_frame_capture_o const* self ) {
+	return uint32_t( self->frames.size() );
+}
+
+// ----------------------------------------------------------------------
+// Returns swapchain extent at the time of capture for the frame with given index.
+static bool frame_capture_get_swapchain_extent( le_frame_capture_o const* self, uint32_t frame, uint32_t* width, uint32_t* height ) {
+	if ( frame >= self->frames.size() ) {
+		return false;
+	}
+	*width  = self->frames[ frame ].swapchain_width;
+	*height = self->frames[ frame ].swapchain_height;
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Translates a captured resource id into a resource handle for the replaying process.
+static le_resource_handle frame_capture_get_resource( le_frame_capture_o* self, uint64_t id ) {
+
+	using namespace le_renderer;
+
+	if ( id == 0 ) {
+		return nullptr;
+	}
+
+	auto found = self->resource_handles.find( id );
+	if ( found != self->resource_handles.end() ) {
+		return found->second;
+	}
+
+	auto res_it = self->resources.find( id );
+
+	if ( res_it == self->resources.end() ) {
+		static auto logger = LeLog( LOGGER_LABEL );
+		logger.error( "Frame capture references unknown resource id: %p", reinterpret_cast<void*>( id ) );
+		return nullptr;
+	}
+
+	// ---------| invariant: we have a description for this resource
+
+	captured_resource_t const& res  = res_it->second;
+	char const*                name = res.debug_name[ 0 ] ? res.debug_name : nullptr;
+	le_resource_handle         handle;
+
+	if ( res.type == uint32_t( LeResourceType::eImage ) &&
+	     res.flags == uint8_t( le_img_resource_usage_flags_t::eIsRoot ) ) {
+		// Swapchain images are substituted with the replaying process swapchain image - we don't
+		// store these, as the swapchain image may change from frame to frame.
+		return self->swapchain_image;
+	}
+
+	switch ( LeResourceType( res.type ) ) {
+	case LeResourceType::eImage:
+		handle = renderer_i.produce_img_resource_handle(
+		    name, res.num_samples,
+		    static_cast<le_img_resource_handle>( frame_capture_get_resource( self, res.reference_id ) ),
+		    res.flags );
+		break;
+	case LeResourceType::eBuffer:
+		if ( resource_is_virtual_buffer( res ) ) {
+			// Scratch buffers are substituted with persistent replay buffers, which get filled
+			// at the start of each frame via an upload pass.
+			char replay_name[ 48 ];
+			snprintf( replay_name, sizeof( replay_name ), "Le-Capture-Replay-Buffer-%d", res.index );
+			handle = renderer_i.produce_buf_resource_handle( replay_name, 0, 0 );
+		} else {
+			handle = renderer_i.produce_buf_resource_handle( name, res.flags, res.index );
+		}
+		break;
+	case LeResourceType::eRtxTlas:
+		handle = renderer_i.produce_tlas_resource_handle( name );
+		break;
+	case LeResourceType::eRtxBlas:
+		handle = renderer_i.produce_blas_resource_handle( name );
+		break;
+	default:
+		handle = nullptr;
+		break;
+	}
+
+	self->resource_handles[ id ] = handle;
+	return handle;
+}
+
+template <typename T>
+static T frame_capture_get_resource_as( le_frame_capture_o* self, T const& captured ) {
+	return static_cast<T>( frame_capture_get_resource( self, handle_to_id( captured ) ) );
+}
+
+// ----------------------------------------------------------------------
+
+static le_texture_handle frame_capture_get_texture( le_frame_capture_o* self, uint64_t id ) {
+
+	auto found = self->texture_handles.find( id );
+	if ( found != self->texture_handles.end() ) {
+		return found->second;
+	}
+
+	auto              name   = self->textures.find( id );
+	le_texture_handle handle = le_renderer::renderer_i.produce_texture_handle(
+	    ( name != self->textures.end() && !name->second.empty() ) ? name->second.c_str() : nullptr );
+
+	self->texture_handles[ id ] = handle;
+	return handle;
+}
+
+// ----------------------------------------------------------------------
+// Pipelines are re-introduced lazily, the first time they are bound.
+static le_gpso_handle frame_capture_get_gpso( le_frame_capture_o* self, le_pipeline_manager_o* pipeline_manager, uint64_t id ) {
+
+	auto found = self->gpso_handles.find( id );
+	if ( found != self->gpso_handles.end() ) {
+		return found->second;
+	}
+
+	using namespace le_backend_vk;
+	le_gpso_handle handle = nullptr;
+	auto           blob   = self->gpso_blobs.find( id );
+
+	if ( blob != self->gpso_blobs.end() ) {
+		handle = le_pipeline_manager_i.deserialize_graphics_pipeline_state( pipeline_manager, blob->second.data(), blob->second.size() );
+	}
+
+	self->gpso_handles[ id ] = handle;
+	return handle;
+}
+
+// ----------------------------------------------------------------------
+
+static le_cpso_handle frame_capture_get_cpso( le_frame_capture_o* self, le_pipeline_manager_o* pipeline_manager, uint64_t id ) {
+
+	auto found = self->cpso_handles.find( id );
+	if ( found != self->cpso_handles.end() ) {
+		return found->second;
+	}
+
+	using namespace le_backend_vk;
+	le_cpso_handle handle = nullptr;
+	auto           blob   = self->cpso_blobs.find( id );
+
+	if ( blob != self->cpso_blobs.end() ) {
+		handle = le_pipeline_manager_i.deserialize_compute_pipeline_state( pipeline_manager, blob->second.data(), blob->second.size() );
+	}
+
+	self->cpso_handles[ id ] = handle;
+	return handle;
+}
+
+// ----------------------------------------------------------------------
+// Execute callback for the upload pass: fills replay buffers with scratch buffer contents for this frame.
+static void frame_capture_upload_pass_execute( le_command_buffer_encoder_o* encoder, void* user_data ) {
+
+	using namespace le_renderer;
+
+	auto frame = static_cast<captured_frame_t*>( user_data );
+	auto self  = frame->capture;
+
+	for ( auto const& [ id, data ] : frame->buffer_data ) {
+		if ( self->replay_buffer_sizes.count( id ) && !data.second.empty() ) {
+			auto buffer = static_cast<le_buf_resource_handle>( frame_capture_get_resource( self, id ) );
+			encoder_i.write_to_buffer( encoder, buffer, data.first, data.second.data(), data.second.size() );
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+// Execute callback for a replayed pass: re-encodes captured commands, translating handles.
+static void frame_capture_pass_execute( le_command_buffer_encoder_o* encoder, void* user_data ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	using namespace le_renderer;
+
+	auto pass  = static_cast<captured_pass_t*>( user_data );
+	auto self  = pass->capture;
+	auto frame = pass->frame;
+
+	le_pipeline_manager_o* pipeline_manager = encoder_i.get_pipeline_manager( encoder );
+
+	auto get_staging_data = [ frame ]( le_buf_resource_handle const& staging_buffer, size_t num_bytes ) -> void const* {
+		auto found = frame->buffer_data.find( handle_to_id( staging_buffer ) );
+		if ( found == frame->buffer_data.end() || found->second.second.size() < num_bytes ) {
+			return nullptr;
+		}
+		return found->second.second.data();
+	};
+
+	for_each_command( pass->pages, [ & ]( le::CommandHeader const* header ) {
+		switch ( header->info.type ) {
+		case le::CommandType::eDrawIndexed: {
+			auto const& info = reinterpret_cast<le::CommandDrawIndexed const*>( header )->info;
+			encoder_i.draw_indexed( encoder, info.indexCount, info.instanceCount, info.firstIndex, info.vertexOffset, info.firstInstance );
+		} break;
+		case le::CommandType::eDraw: {
+			auto const& info = reinterpret_cast<le::CommandDraw const*>( header )->info;
+			encoder_i.draw( encoder, info.vertexCount, info.instanceCount, info.firstVertex, info.firstInstance );
+		} break;
+		case le::CommandType::eDrawMeshTasks: {
+			auto const& info = reinterpret_cast<le::CommandDrawMeshTasks const*>( header )->info;
+			encoder_i.draw_mesh_tasks( encoder, info.taskCount, info.firstTask );
+		} break;
+		case le::CommandType::eDrawIndirect: {
+			auto const& info = reinterpret_cast<le::CommandDrawIndirect const*>( header )->info;
+			encoder_i.draw_indirect( encoder, frame_capture_get_resource_as( self, info.buffer ), info.offset, info.drawCount, info.stride );
+		} break;
+		case le::CommandType::eDrawIndexedIndirect: {
+			auto const& info = reinterpret_cast<le::CommandDrawIndexedIndirect const*>( header )->info;
+			encoder_i.draw_indexed_indirect( encoder, frame_capture_get_resource_as( self, info.buffer ), info.offset, info.drawCount, info.stride );
+		} break;
+		case le::CommandType::eDrawIndirectCount: {
+			auto const& info = reinterpret_cast<le::CommandDrawIndirectCount const*>( header )->info;
+			encoder_i.draw_indirect_count( encoder, frame_capture_get_resource_as( self, info.buffer ), info.offset,
+			                               frame_capture_get_resource_as( self, info.count_buffer ), info.count_offset, info.maxDrawCount, info.stride );
+		} break;
+		case le::CommandType::eDrawIndexedIndirectCount: {
+			auto const& info = reinterpret_cast<le::CommandDrawIndexedIndirectCount const*>( header )->info;
+			encoder_i.draw_indexed_indirect_count( encoder, frame_capture_get_resource_as( self, info.buffer ), info.offset,
+			                                       frame_capture_get_resource_as( self, info.count_buffer ), info.count_offset, info.maxDrawCount, info.stride );
+		} break;
+		case le::CommandType::eDispatch: {
+			auto const& info = reinterpret_cast<le::CommandDispatch const*>( header )->info;
+			encoder_i.dispatch( encoder, info.groupCountX, info.groupCountY, info.groupCountZ );
+		} break;
+		case le::CommandType::eBufferMemoryBarrier: {
+			auto const& info = reinterpret_cast<le::CommandBufferMemoryBarrier const*>( header )->info;
+			encoder_i.buffer_memory_barrier( encoder, info.srcStageMask, info.dstStageMask, info.dstAccessMask,
+			                                 frame_capture_get_resource_as( self, info.buffer ), info.offset, info.range );
+		} break;
+		case le::CommandType::eSetLineWidth: {
+			encoder_i.set_line_width( encoder, reinterpret_cast<le::CommandSetLineWidth const*>( header )->info.width );
+		} break;
+		case le::CommandType::eSetViewport: {
+			auto cmd = reinterpret_cast<le::CommandSetViewport const*>( header );
+			encoder_i.set_viewport( encoder, cmd->info.firstViewport, cmd->info.viewportCount, reinterpret_cast<le::Viewport const*>( cmd + 1 ) );
+		} break;
+		case le::CommandType::eSetScissor: {
+			auto cmd = reinterpret_cast<le::CommandSetScissor const*>( header );
+			encoder_i.set_scissor( encoder, cmd->info.firstScissor, cmd->info.scissorCount, reinterpret_cast<le::Rect2D const*>( cmd + 1 ) );
+		} break;
+		case le::CommandType::eSetPushConstantData: {
+			auto cmd = reinterpret_cast<le::CommandSetPushConstantData const*>( header );
+			encoder_i.set_push_constant_data( encoder, cmd + 1, cmd->info.num_bytes );
+		} break;
+		case le::CommandType::eBindArgumentBuffer: {
+			auto const& info = reinterpret_cast<le::CommandBindArgumentBuffer const*>( header )->info;
+			encoder_i.bind_argument_buffer( encoder, frame_capture_get_resource_as( self, info.buffer_id ), info.argument_name_id, info.offset, info.range );
+		} break;
+		case le::CommandType::eSetArgumentTexture: {
+			auto const& info = reinterpret_cast<le::CommandSetArgumentTexture const*>( header )->info;
+			encoder_i.set_argument_texture( encoder, frame_capture_get_texture( self, handle_to_id( info.texture_id ) ), info.argument_name_id, info.array_index );
+		} break;
+		case le::CommandType::eSetArgumentImage: {
+			auto const& info = reinterpret_cast<le::CommandSetArgumentImage const*>( header )->info;
+			encoder_i.set_argument_image( encoder, frame_capture_get_resource_as( self, info.image_id ), info.argument_name_id, info.array_index );
+		} break;
+		case le::CommandType::eBindIndexBuffer: {
+			auto const& info = reinterpret_cast<le::CommandBindIndexBuffer const*>( header )->info;
+			encoder_i.bind_index_buffer( encoder, frame_capture_get_resource_as( self, info.buffer ), info.offset, info.indexType );
+		} break;
+		case le::CommandType::eBindVertexBuffers: {
+			auto cmd      = reinterpret_cast<le::CommandBindVertexBuffers const*>( header );
+			auto pBuffers = reinterpret_cast<le_buf_resource_handle const*>( cmd + 1 );
+			auto pOffsets = reinterpret_cast<uint64_t const*>( pBuffers + cmd->info.bindingCount );
+
+			std::vector<le_buf_resource_handle> buffers( pBuffers, pBuffers + cmd->info.bindingCount );
+			for ( auto& b : buffers ) {
+				b = frame_capture_get_resource_as( self, b );
+			}
+			encoder_i.bind_vertex_buffers( encoder, cmd->info.firstBinding, cmd->info.bindingCount, buffers.data(), pOffsets );
+		} break;
+		case le::CommandType::eBindGraphicsPipeline: {
+			auto const& info = reinterpret_cast<le::CommandBindGraphicsPipeline const*>( header )->info;
+			if ( auto gpso = frame_capture_get_gpso( self, pipeline_manager, handle_to_id( info.gpsoHandle ) ) ) {
+				encoder_i.bind_graphics_pipeline( encoder, gpso );
+			}
+		} break;
+		case le::CommandType::eBindComputePipeline: {
+			auto const& info = reinterpret_cast<le::CommandBindComputePipeline const*>( header )->info;
+			if ( auto cpso = frame_capture_get_cpso( self, pipeline_manager, handle_to_id( info.cpsoHandle ) ) ) {
+				encoder_i.bind_compute_pipeline( encoder, cpso );
+			}
+		} break;
+		case le::CommandType::eWriteToBuffer: {
+			auto const& info = reinterpret_cast<le::CommandWriteToBuffer const*>( header )->info;
+			if ( void const* data = get_staging_data( info.src_buffer_id, info.numBytes ) ) {
+				encoder_i.write_to_buffer( encoder, frame_capture_get_resource_as( self, info.dst_buffer_id ), info.dst_offset, data, info.numBytes );
+			}
+		} break;
+		case le::CommandType::eWriteToImage: {
+			auto const& info = reinterpret_cast<le::CommandWriteToImage const*>( header )->info;
+			if ( void const* data = get_staging_data( info.src_buffer_id, info.numBytes ) ) {
+				le_write_to_image_settings_t settings{};
+				settings.image_w         = info.image_w;
+				settings.image_h         = info.image_h;
+				settings.image_d         = info.image_d;
+				settings.offset_x        = info.offset_x;
+				settings.offset_y        = info.offset_y;
+				settings.offset_z        = info.offset_z;
+				settings.dst_array_layer = info.dst_array_layer;
+				settings.dst_miplevel    = info.dst_miplevel;
+				settings.num_miplevels   = info.num_miplevels;
+				encoder_i.write_to_image( encoder, frame_capture_get_resource_as( self, info.dst_image_id ), settings, data, info.numBytes );
+			}
+		} break;
+		default:
+			if ( !self->did_warn_about_unhandled_commands ) {
+				logger.warn( "Skipping command of type %u in pass '%s' - it can't be replayed.", uint32_t( header->info.type ), pass->debug_name );
+				self->did_warn_about_unhandled_commands = true;
+			}
+			break;
+		}
+	} );
+}
+
+// ----------------------------------------------------------------------
+// Adds passes and resource declarations for a captured frame to a rendergraph. Any
+// swapchain images used in the captured frame get substituted with `swapchain_image`.
+static bool frame_capture_add_frame_to_rendergraph( le_frame_capture_o* self, uint32_t frame_index, le_rendergraph_o* rendergraph, le_img_resource_handle swapchain_image ) {
+
+	using namespace le_renderer;
+
+	if ( frame_index >= self->frames.size() ) {
+		return false;
+	}
+
+	// ---------| invariant: frame exists
+
+	captured_frame_t& frame = self->frames[ frame_index ];
+
+	self->swapchain_image = swapchain_image;
+
+	for ( size_t i = 0; i != frame.declared_resources_id.size(); i++ ) {
+		le_resource_info_t const& info = frame.declared_resources_info[ i ];
+		if ( info.type == LeResourceType::eRtxBlas || info.type == LeResourceType::eRtxTlas ) {
+			continue; // acceleration structure infos refer to objects which only exist in the capturing process.
+		}
+		rendergraph_i.declare_resource( rendergraph, frame_capture_get_resource( self, frame.declared_resources_id[ i ] ), info );
+	}
+
+	// -- Declare replay buffers, and add a pass which uploads this frame's scratch buffer contents.
+
+	bool has_scratch_data = false;
+
+	for ( auto const& [ id, size ] : self->replay_buffer_sizes ) {
+		le_resource_info_t info = helpers_i.get_default_resource_info_for_buffer();
+		info.buffer.size        = size;
+		info.buffer.usage       = le::BufferUsageFlagBits::eTransferDst |
+		                    le::BufferUsageFlagBits::eVertexBuffer | le::BufferUsageFlagBits::eIndexBuffer | le::BufferUsageFlagBits::eIndirectBuffer |
+		                    le::BufferUsageFlagBits::eUniformBuffer | le::BufferUsageFlagBits::eStorageBuffer;
+		rendergraph_i.declare_resource( rendergraph, frame_capture_get_resource( self, id ), info );
+		has_scratch_data |= ( frame.buffer_data.count( id ) != 0 );
+	}
+
+	if ( has_scratch_data ) {
+		le_renderpass_o* rp = renderpass_i.create( "Le-Capture-Replay-Upload", le::QueueFlagBits::eTransfer );
+		for ( auto const& [ id, size ] : self->replay_buffer_sizes ) {
+			if ( frame.buffer_data.count( id ) ) {
+				renderpass_i.use_resource( rp, frame_capture_get_resource( self, id ), le::AccessFlags2( le::AccessFlagBits2::eTransferWrite ) );
+			}
+		}
+		renderpass_i.set_execute_callback( rp, &frame, frame_capture_upload_pass_execute );
+		rendergraph_i.add_renderpass( rendergraph, rp );
+		renderpass_i.ref_dec( rp );
+	}
+
+	// -- Re-create captured passes
+
+	for ( auto& pass : frame.passes ) {
+
+		le_renderpass_o* rp = renderpass_i.create( pass.debug_name, pass.type );
+
+		rp->is_root      = pass.is_root;
+		rp->width        = pass.width;
+		rp->height       = pass.height;
+		rp->sample_count = pass.sample_count;
+
+		for ( size_t i = 0; i != pass.resources.size(); i++ ) {
+			rp->resources.push_back( frame_capture_get_resource( self, pass.resources[ i ] ) );
+			rp->resources_read_write_flags.push_back( pass.resources_read_write_flags[ i ] );
+			rp->resources_access_flags.push_back( pass.resources_access_flags[ i ] );
+		}
+
+		// Replay buffers are not part of the captured pass, as scratch buffers are implicit.
+		for ( auto const& id : pass.virtual_buffers ) {
+			le::AccessFlags2 access = le::AccessFlagBits2::eUniformRead | le::AccessFlagBits2::eShaderStorageRead;
+			if ( pass.type == le::QueueFlagBits::eGraphics ) {
+				access = access | le::AccessFlagBits2::eVertexAttributeRead | le::AccessFlagBits2::eIndexRead | le::AccessFlagBits2::eIndirectCommandRead;
+			}
+			rp->resources.push_back( frame_capture_get_resource( self, id ) );
+			rp->resources_read_write_flags.push_back( le::RWFlags( le::ResourceAccessFlagBits::eRead ) );
+			rp->resources_access_flags.push_back( access );
+		}
+
+		for ( size_t i = 0; i != pass.attachment_resources.size(); i++ ) {
+			rp->attachmentResources.push_back( static_cast<le_img_resource_handle>( frame_capture_get_resource( self, pass.attachment_resources[ i ] ) ) );
+			rp->imageAttachments.push_back( pass.image_attachments[ i ] );
+		}
+
+		for ( size_t i = 0; i != pass.texture_ids.size(); i++ ) {
+			le_image_sampler_info_t info = pass.texture_infos[ i ];
+			info.imageView.imageId       = frame_capture_get_resource_as( self, info.imageView.imageId );
+			rp->textureIds.push_back( frame_capture_get_texture( self, pass.texture_ids[ i ] ) );
+			rp->textureInfos.push_back( info );
+		}
+
+		if ( pass.has_encoder ) {
+			renderpass_i.set_execute_callback( rp, &pass, frame_capture_pass_execute );
+		}
+
+		rendergraph_i.add_renderpass( rendergraph, rp );
+		renderpass_i.ref_dec( rp );
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+void register_le_frame_capture_api( void* api_ ) {
+
+	auto  le_renderer_api_i  = static_cast<le_renderer_api*>( api_ );
+	auto& le_frame_capture_i = le_renderer_api_i->le_frame_capture_i;
+
+	le_frame_capture_i.create_writer            = frame_capture_writer_create;
+	le_frame_capture_i.destroy_writer           = frame_capture_writer_destroy;
+	le_frame_capture_i.write_frame              = frame_capture_writer_write_frame;
+	le_frame_capture_i.load                     = frame_capture_load;
+	le_frame_capture_i.destroy                  = frame_capture_destroy;
+	le_frame_capture_i.get_num_frames           = frame_capture_get_num_frames;
+	le_frame_capture_i.get_swapchain_extent     = frame_capture_get_swapchain_extent;
+	le_frame_capture_i.add_frame_to_rendergraph = frame_capture_add_frame_to_rendergraph;
+}
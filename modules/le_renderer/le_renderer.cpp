@@ -18,9 +18,13 @@
 #include <string>
 #include <cstring> // for memcpy
 #include <bitset>
+#include <atomic>
+#include <new>
+#include <cstdlib>
 
 #include "private/le_renderer/le_resource_handle_t.inl"
 #include "private/le_renderer/le_rendergraph.h"
+#include "private/le_renderer/le_interned_handle_table.h"
 
 const uint64_t LE_RENDERPASS_MARKER_EXTERNAL = hash_64_fnv1a_const( "rp-external" );
 
@@ -63,6 +67,10 @@ struct FrameData {
 
 		NanoTime time_dispatch_frame_start;
 		NanoTime time_dispatch_frame_end;
+
+		NanoTime time_clear_frame_start;
+		NanoTime time_fence_reached;
+		NanoTime time_clear_frame_end;
 	};
 
 	State state = State::eInitial;
@@ -74,17 +82,22 @@ struct FrameData {
 };
 
 struct le_texture_handle_t {
+	uint64_t    hash; // precomputed hash of debug_name
 	std::string debug_name;
 };
 
 struct le_texture_handle_store_t {
-	std::unordered_multimap<std::string, le_texture_handle_t> texture_handles;
-	std::mutex                                                mtx;
+	InternedHandleTable<le_texture_handle_t> texture_handles;
+};
+
+struct le_resource_handle_entry_t {
+	uint64_t                  hash;   // precomputed hash of data
+	le_resource_handle_data_t data;   //
+	le_resource_handle_t      handle; // handle.data points to data - a pointer to handle is what we hand out as le_resource_handle
 };
 
 struct le_resource_handle_store_t {
-	std::unordered_multimap<le_resource_handle_data_t, le_resource_handle_t, le_resource_handle_data_hash> resource_handles;
-	std::mutex                                                                                             mtx;
+	InternedHandleTable<le_resource_handle_entry_t> resource_handles;
 };
 
 static le_texture_handle_store_t* get_texture_handle_library( bool erase = false ) {
@@ -157,11 +170,112 @@ struct le_renderer_o {
 	std::vector<FrameData> frames;
 	size_t                 backendDataFramesCount = 0;
 	size_t                 currentFrameNumber = size_t( ~0 ); // ever increasing number of current frame
+	size_t                 dispatchDelay      = 0;            // number of updates between record and dispatch for a frame, always < frames.size() - 1
 	le_renderer_settings_t settings;
+
+	// Ring of cpu timings for recently completed frames - only written to if
+	// LE_SETTING_RENDERER_ENABLE_FRAME_TIMINGS is set.
+	struct FrameTimingRecord {
+		le_renderer_frame_timing_t             timing;
+		std::vector<le_renderer_pass_timing_t> pass_timings;
+	};
+	static constexpr size_t        FRAME_TIMINGS_HISTORY_SIZE = 64;
+	std::vector<FrameTimingRecord> frameTimings;          // ring buffer, FRAME_TIMINGS_HISTORY_SIZE entries once used
+	size_t                         frameTimingsCount = 0; // total number of frame timing records written
+
+	struct PipelineStats {
+		NanoTime window_start;              // time at which we started accumulating
+		size_t   num_frames         = 0;    // number of frames which reached their fence since window_start
+		double   sum_latency_ms     = 0;    // sum over frame latencies: record start until fence reached
+		double   sum_cpu_latency_ms = 0;    // sum over cpu latencies: record start until dispatch end
+	} pipelineStats;
+
+	struct FrameCapture {
+		std::mutex                 mtx;                            // protects all FrameCapture elements
+		le_frame_capture_writer_o* writer               = nullptr; // owning, non-null while a capture is in progress
+		uint32_t                   num_frames_remaining = 0;       // number of frames still to capture
+	} frameCapture;
+
+	// Ring of dispatch outcomes for recent frames, indexed by frame number - lets modules which
+	// record one-off work (e.g. argument buffer uploads) find out whether that work reached the gpu.
+	// Frames get resolved in order of their frame number, once their dispatch stage has run.
+	struct FrameOutcomes {
+		static constexpr size_t HISTORY_SIZE = 64;
+		std::mutex              mtx;                                // protects all FrameOutcomes elements
+		bool                    was_dispatched[ HISTORY_SIZE ] = {}; // indexed by frame number % HISTORY_SIZE
+		size_t                  num_resolved                   = 0;  // frames with frame number < num_resolved have been resolved
+	} frameOutcomes;
 };
 
 static void renderer_clear_frame( le_renderer_o* self, size_t frameIndex ); // ffdecl
 
+// ----------------------------------------------------------------------
+// Debug counter for heap allocations made while renderer_update runs.
+//
+// If LE_SETTING_PRINT_FRAME_ARENA_STATS is set, renderer_update counts all calls
+// to global operator new - made on any thread - from when it begins until it
+// ends, and logs this count once per frame. Once the renderer has warmed up,
+// this count should be zero.
+//
+// Global operator new may only be replaced once per program, which is why
+// we only count if modules are linked statically.
+#if !defined( PLUGINS_DYNAMIC )
+
+static std::atomic<bool>     g_should_count_heap_allocations = false;
+static std::atomic<uint64_t> g_num_heap_allocations          = 0;
+
+void* operator new( size_t num_bytes ) {
+	if ( g_should_count_heap_allocations.load( std::memory_order_relaxed ) ) [[unlikely]] {
+		g_num_heap_allocations.fetch_add( 1, std::memory_order_relaxed );
+	}
+	void* p = malloc( num_bytes ? num_bytes : 1 );
+	if ( nullptr == p ) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[]( size_t num_bytes ) {
+	return operator new( num_bytes );
+}
+
+void operator delete( void* p ) noexcept {
+	free( p );
+}
+
+void operator delete[]( void* p ) noexcept {
+	free( p );
+}
+
+void operator delete( void* p, size_t ) noexcept {
+	free( p );
+}
+
+void operator delete[]( void* p, size_t ) noexcept {
+	free( p );
+}
+
+#endif
+
+static void renderer_heap_allocation_counter_begin() {
+#if !defined( PLUGINS_DYNAMIC )
+	g_num_heap_allocations.store( 0, std::memory_order_relaxed );
+	g_should_count_heap_allocations.store( true, std::memory_order_release );
+#endif
+}
+
+// Returns false if heap allocations cannot be counted in this build.
+static bool renderer_heap_allocation_counter_end( uint64_t* num_allocations ) {
+#if !defined( PLUGINS_DYNAMIC )
+	g_should_count_heap_allocations.store( false, std::memory_order_release );
+	*num_allocations = g_num_heap_allocations.load( std::memory_order_relaxed );
+	return true;
+#else
+	*num_allocations = 0;
+	return false;
+#endif
+}
+
 // ----------------------------------------------------------------------
 
 static le_renderer_o* renderer_create() {
@@ -180,37 +294,27 @@ static le_renderer_o* renderer_create() {
 // ----------------------------------------------------------------------
 
 // creates a new handle if no name was given, or given name was not found in list of current handles.
+//
+// Looking up a handle for a name which has been seen before is lock-free, and does not allocate.
 static le_texture_handle renderer_produce_texture_handle( char const* maybe_name ) {
 
-	// lock handle library for reading/writing
 	static le_texture_handle_store_t* texture_handle_library = get_texture_handle_library();
-	std::scoped_lock                  lock( texture_handle_library->mtx );
-
-	le_texture_handle handle;
 
 	if ( maybe_name ) {
-		// if a string was given, search for multimap and see if we can find something.
-		auto it = texture_handle_library->texture_handles.find( maybe_name );
-		if ( it == texture_handle_library->texture_handles.end() ) {
-			// not found, insert a new element
-			handle = &texture_handle_library->texture_handles.emplace( maybe_name, le_texture_handle_t( { maybe_name } ) )->second;
-		} else {
-			// found, return a pointer to the found element
-			handle = &it->second;
-		}
+		uint64_t const hash = hash_64_fnv1a( maybe_name );
+		// If a string was given, look up whether we have seen it before - if not, insert a new element.
+		return texture_handle_library->texture_handles.find_or_insert(
+		    hash,
+		    [ maybe_name ]( le_texture_handle_t const& e ) { return e.debug_name == maybe_name; },
+		    [ hash, maybe_name ]() { return new le_texture_handle_t{ hash, maybe_name }; } );
 	} else {
 		// no name given: handle is set to address of newly inserted element
-		// As this is a multimap, there can be any number of textures with the same
-		// key "unnamed" in the map.
-		handle = &texture_handle_library->texture_handles.emplace( "unnamed", le_texture_handle_t{} )->second;
+		// There can be any number of unnamed textures - these can't be looked up by name.
+		return texture_handle_library->texture_handles.insert_unique( new le_texture_handle_t{} );
 	}
 
-	// handle is a pointer to the element in the container, and as such it is
-	// guaranteed to stay valid, even through rehashes of the texture_handles
-	// container, because that's a guarantee that maps give us in c++, until
-	// the element gets erased.
-
-	return handle;
+	// handle is a pointer to an element owned by the handle table, and as such it is
+	// guaranteed to stay valid, even when the table grows.
 }
 
 // ----------------------------------------------------------------------
@@ -224,6 +328,8 @@ static char const* texture_handle_get_name( le_texture_handle texture ) {
 }
 
 // creates a new resource if no name was given, or given name was not found in list of current handles.
+//
+// Looking up a handle which has been seen before is lock-free, and does not allocate.
 le_resource_handle renderer_produce_resource_handle(
     char const*           maybe_name,
     LeResourceType const& resource_type,
@@ -233,43 +339,40 @@ le_resource_handle renderer_produce_resource_handle(
     le_resource_handle    reference_handle = nullptr ) {
 
 	static le_resource_handle_store_t* resource_handle_library = get_resource_handle_library();
-	// lock handle library for reading/writing
-	std::scoped_lock lock( resource_handle_library->mtx );
 
-	le_resource_handle handle;
-
-	le_resource_handle_data_t* p_data = new le_resource_handle_data_t{};
-	p_data->flags                     = flags;
-	p_data->num_samples               = num_samples;
-	p_data->reference_handle          = reference_handle;
-	p_data->type                      = resource_type;
-	p_data->index                     = index;
+	le_resource_handle_data_t key{};
+	key.flags            = flags;
+	key.num_samples      = num_samples;
+	key.reference_handle = reference_handle;
+	key.type             = resource_type;
+	key.index            = index;
 
 	if ( maybe_name && maybe_name[ 0 ] != '\0' ) {
-		memcpy( p_data->debug_name, maybe_name, sizeof( p_data->debug_name ) );
-		// if a string was given, search for multimap and see if we can find something.
-		auto it = resource_handle_library->resource_handles.find( *p_data );
-		if ( it == resource_handle_library->resource_handles.end() ) {
-			// not found, insert a new element
-			handle = &resource_handle_library->resource_handles.emplace( *p_data, le_resource_handle_t{ p_data } )->second;
-		} else {
-			// found, return a pointer to the found element
-			handle = &it->second;
-			delete ( p_data );
-		}
+		strncpy( key.debug_name, maybe_name, sizeof( key.debug_name ) - 1 );
+
+		uint64_t const hash = le_resource_handle_data_hash()( key );
+
+		// If a string was given, look up whether we have seen this handle before - if not, insert a new element.
+		le_resource_handle_entry_t* entry = resource_handle_library->resource_handles.find_or_insert(
+		    hash,
+		    [ &key ]( le_resource_handle_entry_t const& e ) { return e.data == key; },
+		    [ hash, &key ]() {
+			    auto e         = new le_resource_handle_entry_t{ hash, key };
+			    e->handle.data = &e->data;
+			    return e;
+		    } );
+
+		return &entry->handle;
 	} else {
 		// no name given: handle is set to address of newly inserted element
-		// As this is a multimap, there can be any number of textures with the same
-		// key "unnamed" in the map.
-		handle = &resource_handle_library->resource_handles.emplace( *p_data, le_resource_handle_t{ p_data } )->second;
+		// There can be any number of unnamed resources - these can't be looked up by name.
+		auto e         = new le_resource_handle_entry_t{ 0, key };
+		e->handle.data = &e->data;
+		return &resource_handle_library->resource_handles.insert_unique( e )->handle;
 	}
 
-	// handle is a pointer to the element in the container, and as such it is
-	// guaranteed to stay valid, even through rehashes of the resource_handle_library
-	// container, because that's a guarantee that maps give us in c++, until
-	// the element gets erased.
-
-	return handle;
+	// handle is a pointer into an element owned by the handle table, and as such it is
+	// guaranteed to stay valid, even when the table grows.
 }
 
 static le_img_resource_handle renderer_produce_img_resource_handle( char const* maybe_name, uint8_t num_samples,
@@ -308,17 +411,21 @@ static void renderer_destroy( le_renderer_o* self ) {
 
 	self->frames.clear();
 
+	// All passes have been destroyed by now - free any passes which were kept for re-use.
+	le_renderer::api->le_rendergraph_private_i.destroy_renderpass_pool();
+
+	if ( self->frameCapture.writer ) {
+		frame_capture_i.destroy_writer( self->frameCapture.writer );
+		self->frameCapture.writer = nullptr;
+	}
+
 	// Delete texture handle library
 	get_texture_handle_library( false );
 
 	{
 		le_resource_handle_store_t* resource_handle_library = get_resource_handle_library();
 		if ( resource_handle_library ) {
-			// we must deallocate manually allocated data for resource handles
-			for ( auto& e : resource_handle_library->resource_handles ) {
-				delete ( e.second.data );
-			}
-			// Delete static pointer to resource handle library
+			// Delete static pointer to resource handle library - this deletes all resource handles.
 			get_resource_handle_library( true );
 		}
 	}
@@ -420,6 +527,11 @@ static void renderer_setup( le_renderer_o* self, le_renderer_settings_t const* s
 		le_backend_vk::settings_i.set_concurrency_count( LE_MT );
 #endif
 
+		if ( self->settings.num_frames_in_flight != 0 ) {
+			// An explicit pipeline depth overrides any frame count which was derived from swapchains.
+			le_backend_vk::settings_i.set_data_frames_count( std::max<uint32_t>( 2, self->settings.num_frames_in_flight ) );
+		}
+
 		le_backend_vk::vk_backend_i.setup( self->backend );
 	}
 
@@ -436,7 +548,16 @@ static void renderer_setup( le_renderer_o* self, le_renderer_settings_t const* s
 
 	self->currentFrameNumber = 0;
 
+	// Frame slots are used round-robin: each update records into one slot, dispatches the slot
+	// which was recorded `dispatchDelay` updates ago, and clears the oldest slot. Clear must not
+	// touch the same slot as dispatch, which is why the delay must be less than the number of
+	// frames minus one.
+	self->dispatchDelay = std::min<size_t>( self->settings.dispatch_delay, self->frames.size() - 2 );
 
+	static auto logger = LeLog( "le_renderer" );
+	logger.info( "Renderer pipeline: %zu frames in flight, dispatch delay: %zu", self->frames.size(), self->dispatchDelay );
+
+	self->pipelineStats = {};
 }
 // ----------------------------------------------------------------------
 
@@ -444,6 +565,112 @@ static le_renderer_settings_t const* renderer_get_settings( le_renderer_o* self
 	return &self->settings;
 }
 
+// ----------------------------------------------------------------------
+// Accumulates latency for a frame which has reached its fence, and - if requested via
+// LE_SETTING_RENDERER_PRINT_PIPELINE_STATS - prints latency and throughput for the
+// current pipeline configuration every n frames.
+static void renderer_update_pipeline_stats( le_renderer_o* self, FrameData const& frame ) {
+
+	LE_SETTING( uint32_t, LE_SETTING_RENDERER_PRINT_PIPELINE_STATS, 0 ); // print stats every n frames, 0 means never
+
+	if ( 0 == *LE_SETTING_RENDERER_PRINT_PIPELINE_STATS ) [[likely]] {
+		return;
+	}
+
+	using ms_t = std::chrono::duration<double, std::milli>;
+
+	auto& stats = self->pipelineStats;
+
+	if ( stats.num_frames == 0 ) {
+		stats.window_start = frame.meta.time_record_frame_start;
+	}
+
+	stats.sum_latency_ms += ms_t( frame.meta.time_fence_reached - frame.meta.time_record_frame_start ).count();
+	stats.sum_cpu_latency_ms += ms_t( frame.meta.time_dispatch_frame_end - frame.meta.time_record_frame_start ).count();
+	stats.num_frames++;
+
+	if ( stats.num_frames >= *LE_SETTING_RENDERER_PRINT_PIPELINE_STATS ) {
+
+		static auto logger     = LeLog( "le_renderer" );
+		double      elapsed_ms = ms_t( frame.meta.time_fence_reached - stats.window_start ).count();
+
+		logger.info( "Pipeline [ %zu frames in flight, dispatch delay %zu ] latency: %8.3fms (cpu: %8.3fms), throughput: %8.2f frames/s",
+		             self->frames.size(), self->dispatchDelay,
+		             stats.sum_latency_ms / stats.num_frames,
+		             stats.sum_cpu_latency_ms / stats.num_frames,
+		             elapsed_ms > 0 ? stats.num_frames * 1000.0 / elapsed_ms : 0.0 );
+
+		stats = {};
+	}
+}
+
+// ----------------------------------------------------------------------
+// Stores cpu timings for a frame which has completed into the renderer's ring of frame timings.
+static void renderer_store_frame_timings( le_renderer_o* self, FrameData const& frame ) {
+
+	using ms_t = std::chrono::duration<double, std::milli>;
+
+	if ( self->frameTimings.size() < le_renderer_o::FRAME_TIMINGS_HISTORY_SIZE ) {
+		self->frameTimings.resize( le_renderer_o::FRAME_TIMINGS_HISTORY_SIZE );
+	}
+
+	auto& record = self->frameTimings[ self->frameTimingsCount % le_renderer_o::FRAME_TIMINGS_HISTORY_SIZE ];
+	auto& meta   = frame.meta;
+
+	record.timing = {
+	    .frame_number  = frame.frameNumber,
+	    .record_ms     = ms_t( meta.time_record_frame_end - meta.time_record_frame_start ).count(),
+	    .acquire_ms    = ms_t( meta.time_acquire_frame_end - meta.time_acquire_frame_start ).count(),
+	    .process_ms    = ms_t( meta.time_process_frame_end - meta.time_process_frame_start ).count(),
+	    .dispatch_ms   = ms_t( meta.time_dispatch_frame_end - meta.time_dispatch_frame_start ).count(),
+	    .fence_wait_ms = ms_t( meta.time_fence_reached - meta.time_clear_frame_start ).count(),
+	    .clear_ms      = ms_t( meta.time_clear_frame_end - meta.time_fence_reached ).count(),
+	};
+
+	record.pass_timings.assign( frame.rendergraph->pass_timings.begin(), frame.rendergraph->pass_timings.end() );
+
+	self->frameTimingsCount++;
+
+	LE_SETTING( uint32_t, LE_SETTING_RENDERER_PRINT_FRAME_TIMINGS, 0 ); // print timings every n frames, 0 means never
+
+	if ( *LE_SETTING_RENDERER_PRINT_FRAME_TIMINGS && ( self->frameTimingsCount % *LE_SETTING_RENDERER_PRINT_FRAME_TIMINGS ) == 0 ) {
+		static auto logger = LeLog( "le_renderer" );
+		auto const& t      = record.timing;
+		logger.info( "Frame %8lu: record %8.3fms, acquire %8.3fms, process %8.3fms, dispatch %8.3fms, fence wait %8.3fms, clear %8.3fms",
+		             t.frame_number, t.record_ms, t.acquire_ms, t.process_ms, t.dispatch_ms, t.fence_wait_ms, t.clear_ms );
+		for ( auto const& p : record.pass_timings ) {
+			logger.info( "\tPass %-40s: setup %8.3fms, execute %8.3fms, elided commands %6u", p.debug_name, p.setup_ms, p.execute_ms, p.num_elided_commands );
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static bool renderer_get_frame_timings( le_renderer_o* self, uint32_t history_index, le_renderer_frame_timing_t* timing, le_renderer_pass_timing_t const** pass_timings, size_t* num_pass_timings ) {
+
+	size_t const num_available = std::min( self->frameTimingsCount, le_renderer_o::FRAME_TIMINGS_HISTORY_SIZE );
+
+	if ( history_index >= num_available ) {
+		return false;
+	}
+
+	// ----------| invariant: requested frame is available in the ring
+
+	auto const& record = self->frameTimings[ ( self->frameTimingsCount - 1 - history_index ) % le_renderer_o::FRAME_TIMINGS_HISTORY_SIZE ];
+
+	if ( timing ) {
+		*timing = record.timing;
+	}
+	if ( pass_timings ) {
+		*pass_timings = record.pass_timings.data();
+	}
+	if ( num_pass_timings ) {
+		*num_pass_timings = record.pass_timings.size();
+	}
+
+	return true;
+}
+
 // ----------------------------------------------------------------------
 
 static void renderer_clear_frame( le_renderer_o* self, size_t frameIndex ) {
@@ -459,6 +686,10 @@ static void renderer_clear_frame( le_renderer_o* self, size_t frameIndex ) {
 
 	// ----------| invariant: frame was not yet cleared
 
+	frame.meta.time_clear_frame_start = std::chrono::high_resolution_clock::now();
+
+	bool const was_dispatched = ( frame.state == FrameData::State::eDispatched );
+
 	// + ensure frame fence has been reached
 	if ( frame.state == FrameData::State::eDispatched ||
 	     frame.state == FrameData::State::eFailedDispatch ||
@@ -471,6 +702,12 @@ static void renderer_clear_frame( le_renderer_o* self, size_t frameIndex ) {
 #endif
 		}
 
+		frame.meta.time_fence_reached = std::chrono::high_resolution_clock::now();
+
+		if ( frame.state == FrameData::State::eDispatched ) {
+			renderer_update_pipeline_stats( self, frame );
+		}
+
 		bool result = vk_backend_i.clear_frame( self->backend, frameIndex );
 
 		if ( result != true ) {
@@ -479,6 +716,13 @@ static void renderer_clear_frame( le_renderer_o* self, size_t frameIndex ) {
 		}
 	}
 
+	frame.meta.time_clear_frame_end = std::chrono::high_resolution_clock::now();
+
+	if ( was_dispatched && frame.rendergraph->record_timings ) [[unlikely]] {
+		// Must happen before rendergraph reset, as reset discards pass timings.
+		renderer_store_frame_timings( self, frame );
+	}
+
 	rendergraph_i.reset( frame.rendergraph );
 
 	//	std::cout << "CLEAR FRAME " << frameIndex << std::endl
@@ -507,6 +751,10 @@ static void renderer_record_frame( le_renderer_o* self, size_t frameIndex, le_re
 
 	frame.meta.time_record_frame_start = std::chrono::high_resolution_clock::now();
 
+	// Timings are sampled once per frame, so that changing the setting mid-frame has no effect on the current frame.
+	LE_SETTING( bool, LE_SETTING_RENDERER_ENABLE_FRAME_TIMINGS, false );
+	frame.rendergraph->record_timings = *LE_SETTING_RENDERER_ENABLE_FRAME_TIMINGS;
+
 	// - build up dependencies for graph, create table of unique resources for graph
 
 	// setup passes calls `setup` callback on all passes - this initalises virtual resources,
@@ -563,7 +811,21 @@ static const FrameData::State& renderer_acquire_backend_resources( le_renderer_o
 	le_resource_info_t const* declared_resources_infos = frame.rendergraph->declared_resources_info.data();
 	size_t                    declared_resources_count = frame.rendergraph->declared_resources_id.size();
 
-	    vk_backend_i.acquire_physical_resources(
+	{
+		// If a frame capture was requested, we must write the frame before the backend
+		// acquires physical resources, as the backend takes ownership of encoders.
+		auto lock = std::scoped_lock( self->frameCapture.mtx );
+
+		if ( self->frameCapture.writer ) [[unlikely]] {
+			frame_capture_i.write_frame( self->frameCapture.writer, frame.rendergraph, self->backend, frameIndex, frame.frameNumber );
+			if ( --self->frameCapture.num_frames_remaining == 0 ) {
+				frame_capture_i.destroy_writer( self->frameCapture.writer );
+				self->frameCapture.writer = nullptr;
+			}
+		}
+	}
+
+	vk_backend_i.acquire_physical_resources(
 	        self->backend,
 	        frameIndex,
 	        passes,
@@ -620,6 +882,51 @@ static const FrameData::State& renderer_process_frame( le_renderer_o* self, size
 	return frame.state;
 }
 
+// ----------------------------------------------------------------------
+// Called once per frame number, from the dispatch stage of the frame.
+static void renderer_resolve_frame_outcome( le_renderer_o* self, size_t frameNumber, bool was_dispatched ) {
+
+	if ( frameNumber == size_t( ~0 ) ) {
+		// Frame slot has not been recorded yet - this happens for the first few
+		// frames if dispatch is delayed.
+		return;
+	}
+
+	auto& outcomes = self->frameOutcomes;
+	auto  lock     = std::scoped_lock( outcomes.mtx );
+
+	outcomes.was_dispatched[ frameNumber % outcomes.HISTORY_SIZE ] = was_dispatched;
+	outcomes.num_resolved                                          = frameNumber + 1;
+}
+
+// ----------------------------------------------------------------------
+// Returns false if the frame with the given frame number has not yet reached its dispatch stage.
+// Frames which are older than the history of outcomes are reported as not dispatched.
+static bool renderer_get_frame_outcome( le_renderer_o* self, size_t frame_number, bool* was_dispatched ) {
+
+	auto& outcomes = self->frameOutcomes;
+	auto  lock     = std::scoped_lock( outcomes.mtx );
+
+	if ( frame_number >= outcomes.num_resolved ) {
+		return false;
+	}
+
+	if ( outcomes.num_resolved - frame_number > outcomes.HISTORY_SIZE ) {
+		*was_dispatched = false;
+		return true;
+	}
+
+	*was_dispatched = outcomes.was_dispatched[ frame_number % outcomes.HISTORY_SIZE ];
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Returns the frame number of the frame which is currently being recorded - valid
+// from within setup and execute callbacks of render passes.
+static size_t renderer_get_current_frame_number( le_renderer_o const* self ) {
+	return self->currentFrameNumber;
+}
+
 // ----------------------------------------------------------------------
 
 static void renderer_dispatch_frame( le_renderer_o* self, size_t frameIndex ) {
@@ -628,6 +935,7 @@ static void renderer_dispatch_frame( le_renderer_o* self, size_t frameIndex ) {
 	auto& frame = self->frames[ frameIndex ];
 
 	if ( frame.state != FrameData::State::eProcessed ) {
+		renderer_resolve_frame_outcome( self, frame.frameNumber, false );
 		return;
 	}
 
@@ -640,6 +948,8 @@ static void renderer_dispatch_frame( le_renderer_o* self, size_t frameIndex ) {
 	frame.meta.time_dispatch_frame_end = std::chrono::high_resolution_clock::now();
 
 	frame.state = FrameData::State::eDispatched;
+
+	renderer_resolve_frame_outcome( self, frame.frameNumber, true );
 	//		std::cout << "DISP FRAME " << frameIndex << std::endl
 	//		          << std::flush;
 
@@ -647,7 +957,29 @@ static void renderer_dispatch_frame( le_renderer_o* self, size_t frameIndex ) {
 
 // ----------------------------------------------------------------------
 
+static bool renderer_request_frame_capture( le_renderer_o* self, char const* path, uint32_t num_frames ) {
+
+	using namespace le_renderer; // for frame_capture_i
+
+	auto lock = std::scoped_lock( self->frameCapture.mtx );
+
+	if ( self->frameCapture.writer ) {
+		// finish any capture which is still in progress.
+		frame_capture_i.destroy_writer( self->frameCapture.writer );
+		self->frameCapture.writer = nullptr;
+	}
+
+	if ( num_frames == 0 ) {
+		return false;
+	}
+
+	self->frameCapture.writer               = frame_capture_i.create_writer( path );
+	self->frameCapture.num_frames_remaining = num_frames;
 
+	return self->frameCapture.writer != nullptr;
+}
+
+// ----------------------------------------------------------------------
 
 static le_img_resource_handle renderer_get_swapchain_resource( le_renderer_o* self, le_swapchain_handle swapchain ) {
 	using namespace le_backend_vk;
@@ -696,6 +1028,19 @@ static void renderer_update( le_renderer_o* self, le_rendergraph_o* graph_ ) {
 	const auto& index     = self->currentFrameNumber;
 	const auto& numFrames = self->frames.size();
 
+	// Frame slots for each stage of the pipeline - see renderer_setup.
+	const size_t recordFrameIndex   = ( index + 0 ) % numFrames;
+	const size_t dispatchFrameIndex = ( index + numFrames - self->dispatchDelay ) % numFrames;
+	const size_t clearFrameIndex    = ( index + 1 ) % numFrames; // oldest frame
+
+	// Heap allocations are sampled once per frame, so that changing the setting mid-frame has no effect on the current frame.
+	LE_SETTING( bool, LE_SETTING_PRINT_FRAME_ARENA_STATS, false );
+	bool const should_count_heap_allocations = *LE_SETTING_PRINT_FRAME_ARENA_STATS;
+
+	if ( should_count_heap_allocations ) [[unlikely]] {
+		renderer_heap_allocation_counter_begin();
+	}
+
 	// If necessary, recompile and reload shader modules
 	// - this must be complete before the record_frame step
 
@@ -753,18 +1098,18 @@ static void renderer_update( le_renderer_o* self, le_rendergraph_o* graph_ ) {
 
 		record_params_t record_frame_params;
 		record_frame_params.renderer             = self;
-		record_frame_params.frame_index          = ( index + 0 ) % numFrames;
+		record_frame_params.frame_index          = recordFrameIndex;
 		record_frame_params.rendergraph          = graph_;
 		record_frame_params.current_frame_number = self->currentFrameNumber;
 		record_frame_params.shader_counter       = shader_counter;
 
 		frame_params_t process_frame_params;
 		process_frame_params.renderer    = self;
-		process_frame_params.frame_index = ( index + 2 ) % numFrames;
+		process_frame_params.frame_index = dispatchFrameIndex;
 
 		frame_params_t clear_frame_params;
 		clear_frame_params.renderer    = self;
-		clear_frame_params.frame_index = ( index + 1 ) % numFrames;
+		clear_frame_params.frame_index = clearFrameIndex;
 
 		jobs[ 0 ] = { process_frame_fun, &process_frame_params };
 		jobs[ 1 ] = { clear_frame_fun, &clear_frame_params };
@@ -774,7 +1119,15 @@ static void renderer_update( le_renderer_o* self, le_rendergraph_o* graph_ ) {
 
 		assert( self->backend );
 
-		le_jobs::run_jobs( jobs, 3, &counter );
+		if ( self->dispatchDelay == 0 ) {
+			// Record and dispatch operate on the same frame: we must record before we may dispatch.
+			le_jobs::counter_t* record_counter;
+			le_jobs::run_jobs( &jobs[ 2 ], 1, &record_counter );
+			le_jobs::wait_for_counter_and_free( record_counter, 0 );
+			le_jobs::run_jobs( jobs, 2, &counter );
+		} else {
+			le_jobs::run_jobs( jobs, 3, &counter );
+		}
 
 		// we could theoretically do some more work on the main thread here...
 
@@ -787,7 +1140,7 @@ static void renderer_update( le_renderer_o* self, le_rendergraph_o* graph_ ) {
 
 		{
 			// RECORD FRAME
-			auto frameIndex = ( index + 0 ) % numFrames;
+			auto frameIndex = recordFrameIndex;
 			// logger.info( "+++ [%5d] RECO", frameIndex );
 			renderer_record_frame( self, frameIndex, graph_, self->currentFrameNumber ); // generate an intermediary, api-agnostic, representation of the frame
 		}
@@ -796,7 +1149,7 @@ static void renderer_update( le_renderer_o* self, le_rendergraph_o* graph_ ) {
 			// DISPATCH FRAME
 			// acquire external backend resources such as swapchain
 			// and create any temporary resources
-			auto frameIndex = ( index + 2 ) % numFrames;
+			auto frameIndex = dispatchFrameIndex;
 			// logger.info( "+++ [%5d] DISP", frameIndex );
 			renderer_acquire_backend_resources( self, frameIndex ); //
 			renderer_process_frame( self, frameIndex );             // generate api commands for the frame
@@ -806,12 +1159,25 @@ static void renderer_update( le_renderer_o* self, le_rendergraph_o* graph_ ) {
 		{
 			// CLEAR FRAME
 			// wait for frame to come back (important to do this last, as it may block...)
-			auto frameIndex = ( index + 1 ) % numFrames;
+			auto frameIndex = clearFrameIndex;
 			// logger.info( "+++ [%5d] CLEA", frameIndex );
 			renderer_clear_frame( self, frameIndex );
 		}
 	}
 
+	if ( should_count_heap_allocations ) [[unlikely]] {
+		uint64_t num_heap_allocations = 0;
+		if ( renderer_heap_allocation_counter_end( &num_heap_allocations ) ) {
+			logger.info( "Frame %8zu: %llu heap allocations during renderer_update", self->currentFrameNumber, ( unsigned long long )num_heap_allocations );
+		} else {
+			static bool was_warned = false;
+			if ( !was_warned ) {
+				logger.warn( "Cannot count heap allocations during renderer_update: global operator new is only replaced if modules are linked statically" );
+				was_warned = true;
+			}
+		}
+	}
+
 	// logger.info( "+++ NEXT FRAME\n" );
 	++self->currentFrameNumber;
 }
@@ -857,6 +1223,8 @@ static le_resource_info_t get_default_resource_info_for_buffer() {
 
 extern void register_le_rendergraph_api( void* api );            // in le_rendergraph.cpp
 extern void register_le_command_buffer_encoder_api( void* api ); // in le_command_buffer_encoder.cpp
+extern void register_le_frame_capture_api( void* api );          // in le_frame_capture.cpp
+extern void register_le_argument_buffer_api( void* api );        // in le_argument_buffer.cpp
 
 // ----------------------------------------------------------------------
 
@@ -887,6 +1255,12 @@ LE_MODULE_REGISTER_IMPL( le_renderer, api ) {
 	le_renderer_i.create_rtx_blas_info = renderer_create_rtx_blas_info_handle;
 	le_renderer_i.create_rtx_tlas_info = renderer_create_rtx_tlas_info_handle;
 
+	le_renderer_i.get_frame_timings     = renderer_get_frame_timings;
+	le_renderer_i.request_frame_capture = renderer_request_frame_capture;
+
+	le_renderer_i.get_current_frame_number = renderer_get_current_frame_number;
+	le_renderer_i.get_frame_outcome        = renderer_get_frame_outcome;
+
 	auto& helpers_i = le_renderer_api_i->helpers_i;
 
 	helpers_i.get_default_resource_info_for_buffer = get_default_resource_info_for_buffer;
@@ -901,4 +1275,8 @@ LE_MODULE_REGISTER_IMPL( le_renderer, api ) {
 	register_le_rendergraph_api( api );
 
 	register_le_command_buffer_encoder_api( api );
+
+	register_le_frame_capture_api( api );
+
+	register_le_argument_buffer_api( api );
 }
@@ -10,6 +10,7 @@ struct le_renderer_o;
 struct le_renderpass_o;
 struct le_rendergraph_o;
 struct le_command_buffer_encoder_o;
+struct le_command_stream_page_pool_o; ///< recycles command stream memory pages for encoders, one pool per frame
 struct le_backend_o;
 struct le_shader_module_o; ///< shader module, 1:1 relationship with a shader source file
 struct le_pipeline_manager_o;
@@ -17,6 +18,10 @@ struct le_pipeline_manager_o;
 struct le_allocator_o;         // from backend
 struct le_staging_allocator_o; // from backend
 
+struct le_frame_capture_o;        ///< frame capture loaded for replay
+struct le_frame_capture_writer_o; ///< writes frames to a frame capture file
+struct le_argument_buffer_o;       ///< persistent buffer of shader argument data, uploaded only when changed
+
 LE_OPAQUE_HANDLE( le_shader_module_handle );
 LE_OPAQUE_HANDLE( le_swapchain_handle );
 
@@ -26,6 +31,11 @@ LE_OPAQUE_HANDLE( le_swapchain_handle );
 #define LE_IMG_RESOURCE( x ) \
 	le_renderer::renderer_i.produce_img_resource_handle( ( x ), 0, 0, 0 )
 
+// Transient images don't keep their contents between frames - the backend may alias
+// their memory with other transient images whose lifetimes within a frame don't overlap.
+#define LE_TRANSIENT_IMG_RESOURCE( x ) \
+	le_renderer::renderer_i.produce_img_resource_handle( ( x ), 0, 0, le_img_resource_usage_flags_t::eIsTransient )
+
 struct le_shader_binding_table_o;
 
 // clang-format off
@@ -66,6 +76,20 @@ struct le_renderer_api {
 		le_rtx_blas_info_handle        ( *create_rtx_blas_info ) (le_renderer_o* self, le_rtx_geometry_t* geometries, uint32_t geometries_count, le::BuildAccelerationStructureFlagsKHR const * flags);
 		le_rtx_tlas_info_handle        ( *create_rtx_tlas_info ) (le_renderer_o* self, uint32_t instances_count, le::BuildAccelerationStructureFlagsKHR const* flags);
 
+		// Returns cpu timings for a recently completed frame, 0 being the most recent frame - only available if
+		// LE_SETTING_RENDERER_ENABLE_FRAME_TIMINGS is set. Pass timings remain valid until the next call to update.
+		bool                           ( *get_frame_timings    ) (le_renderer_o* self, uint32_t history_index, le_renderer_frame_timing_t* timing, le_renderer_pass_timing_t const** pass_timings, size_t* num_pass_timings);
+
+		// Captures the next `num_frames` frames, including their command streams, to a file at `path`, so that
+		// they may be replayed via le_frame_capture_i. Replaces any capture which is still in progress.
+		bool                           ( *request_frame_capture) (le_renderer_o* self, char const* path, uint32_t num_frames);
+
+		// Frame number of the frame which is being recorded - valid from within render pass setup and execute callbacks.
+		size_t                         ( *get_current_frame_number ) (le_renderer_o const* self);
+		// Returns false if frame has not yet reached its dispatch stage, otherwise sets `was_dispatched` to whether the
+		// frame was submitted to the gpu. Frames older than the last 64 frames are reported as not dispatched.
+		bool                           ( *get_frame_outcome    ) (le_renderer_o* self, size_t frame_number, bool* was_dispatched);
+
 	};
 
 
@@ -99,6 +123,7 @@ struct le_renderer_api {
 		const char*                     ( *get_debug_name       )( const le_renderpass_o* obj );
 		uint64_t                        ( *get_id               )( const le_renderpass_o* obj );
 		void                            ( *get_queue_sumbission_info)( const le_renderpass_o* obj, le::QueueFlagBits* pass_type, le::RootPassesField * queue_submission_id);
+		void                            ( *get_async_compute_info)( const le_renderpass_o* obj, bool* is_async_compute, bool* waits_for_async_compute); // set by rendergraph build: whether pass may run on an async compute queue, and whether it must wait for async compute passes
 		le_command_buffer_encoder_o*    ( *steal_encoder        )( le_renderpass_o* obj );
 		void                            ( *get_image_attachments)(const le_renderpass_o* obj, const le_image_attachment_info_t** pAttachments, const le_img_resource_handle ** pResourceIds, size_t* numAttachments);
 
@@ -127,6 +152,7 @@ struct le_renderer_api {
 		void                 ( *build                  ) ( le_rendergraph_o *self, size_t frameNumber );
 		void                 ( *execute                ) ( le_rendergraph_o *self, size_t frameIndex, le_backend_o *backend );
 		void                 ( *setup_passes           ) ( le_rendergraph_o *self, le_rendergraph_o *gb );
+		void                 ( *destroy_renderpass_pool) ( );  // frees renderpasses which are kept for re-use
     };
 
 	struct command_buffer_encoder_interface_t {
@@ -137,13 +163,24 @@ struct le_renderer_api {
    	         uint64_t             offset;
         };
 
-		le_command_buffer_encoder_o *( *create                 )( le_allocator_o **allocator, le_pipeline_manager_o* pipeline_cache, le_staging_allocator_o* stagingAllocator, le::Extent2D const& extent );
+		le_command_buffer_encoder_o *( *create                 )( le_allocator_o **allocator, le_pipeline_manager_o* pipeline_cache, le_staging_allocator_o* stagingAllocator, le_command_stream_page_pool_o* page_pool, le::Extent2D const& extent );
 		void                         ( *destroy                )( le_command_buffer_encoder_o *obj );
 
+		le_command_stream_page_pool_o*( *create_page_pool      )();
+		void                         ( *destroy_page_pool      )( le_command_stream_page_pool_o* pool );
+
 		void                         ( *draw                   )( le_command_buffer_encoder_o *self, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance );
 		void                         ( *draw_indexed           )( le_command_buffer_encoder_o *self, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
 		void                         ( *draw_mesh_tasks        )( le_command_buffer_encoder_o *self, uint32_t taskCount, uint32_t fistTask);
 
+		// Indirect draws read draw parameters (see le::DrawIndirectCommand, le::DrawIndexedIndirectCommand) from `buffer`,
+		// which must be used by the current pass with access eIndirectCommandRead. A stride of 0 means tightly packed.
+		// `_count` variants read the number of draws from `count_buffer`, clamped to maxDrawCount.
+		void                         ( *draw_indirect                )( le_command_buffer_encoder_o *self, le_buf_resource_handle const buffer, uint64_t offset, uint32_t drawCount, uint32_t stride );
+		void                         ( *draw_indexed_indirect        )( le_command_buffer_encoder_o *self, le_buf_resource_handle const buffer, uint64_t offset, uint32_t drawCount, uint32_t stride );
+		void                         ( *draw_indirect_count          )( le_command_buffer_encoder_o *self, le_buf_resource_handle const buffer, uint64_t offset, le_buf_resource_handle const count_buffer, uint64_t count_offset, uint32_t maxDrawCount, uint32_t stride );
+		void                         ( *draw_indexed_indirect_count  )( le_command_buffer_encoder_o *self, le_buf_resource_handle const buffer, uint64_t offset, le_buf_resource_handle const count_buffer, uint64_t count_offset, uint32_t maxDrawCount, uint32_t stride );
+
 		void                         (* dispatch               )( le_command_buffer_encoder_o *self, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ );
 		void                         (* buffer_memory_barrier  )( le_command_buffer_encoder_o *self, le::PipelineStageFlags2 const &srcStageMask, le::PipelineStageFlags2 const &dstStageMask, le::AccessFlags2 const & dstAccessMask, le_buf_resource_handle const &buffer, uint64_t const & offset, uint64_t const & range );
 
@@ -195,7 +232,46 @@ struct le_renderer_api {
         void                         ( *trace_rays             )( le_command_buffer_encoder_o* self, uint32_t width, uint32_t height, uint32_t depth);
 
 		le_pipeline_manager_o*       ( *get_pipeline_manager   )( le_command_buffer_encoder_o *self );
-		void                         ( *get_encoded_data       )( le_command_buffer_encoder_o *self, void **data, size_t *numBytes, size_t *numCommands );
+		/// Command stream data is organised in pages - returns false if there is no page with index `page_index`.
+		bool                         ( *get_encoded_data       )( le_command_buffer_encoder_o *self, size_t page_index, void **data, size_t *numBytes, size_t *numCommands );
+		/// Number of commands which were dropped because they would have re-bound identical state.
+		uint32_t                     ( *get_num_elided_commands)( le_command_buffer_encoder_o *self );
+	};
+
+	struct frame_capture_interface_t {
+		le_frame_capture_writer_o* ( *create_writer           )( char const* path );
+		void                       ( *destroy_writer          )( le_frame_capture_writer_o* self );
+		bool                       ( *write_frame             )( le_frame_capture_writer_o* self, le_rendergraph_o const* rendergraph, le_backend_o* backend, size_t frame_index, uint64_t frame_number );
+
+		le_frame_capture_o*        ( *load                    )( char const* path );
+		void                       ( *destroy                 )( le_frame_capture_o* self );
+		uint32_t                   ( *get_num_frames          )( le_frame_capture_o const* self );
+		bool                       ( *get_swapchain_extent    )( le_frame_capture_o const* self, uint32_t frame, uint32_t* width, uint32_t* height );
+
+		// Adds passes and resources of a captured frame to `rendergraph`, swapchain images get substituted with `swapchain_image`.
+		bool                       ( *add_frame_to_rendergraph)( le_frame_capture_o* self, uint32_t frame, le_rendergraph_o* rendergraph, le_img_resource_handle swapchain_image );
+	};
+
+	// Retained argument buffers hold shader argument data (e.g. per-material parameters) which changes
+	// rarely. Data lives in fixed-size slots with stable offsets, only slots which changed get uploaded.
+	struct argument_buffer_interface_t {
+		le_argument_buffer_o*      ( *create                  )( le_renderer_o* renderer, char const* debug_name, uint32_t slot_size, uint32_t slot_count );
+		void                       ( *destroy                 )( le_argument_buffer_o* self );
+
+		// Copies data into slot, marks slot dirty if its contents changed. Returns false if data does not fit into slot.
+		bool                       ( *set_slot_data           )( le_argument_buffer_o* self, uint32_t slot, void const* data, size_t num_bytes );
+		// Returns cpu copy of slot - you must call mark_slot_dirty after changing data via this pointer.
+		void*                      ( *map_slot                )( le_argument_buffer_o* self, uint32_t slot );
+		void                       ( *mark_slot_dirty         )( le_argument_buffer_o* self, uint32_t slot );
+
+		le_buf_resource_handle     ( *get_resource            )( le_argument_buffer_o const* self );
+		uint64_t                   ( *get_slot_offset         )( le_argument_buffer_o const* self, uint32_t slot );
+		uint32_t                   ( *get_slot_count          )( le_argument_buffer_o const* self );
+
+		// Declares buffer resource, and adds a transfer pass which uploads dirty slots - call once per frame.
+		// Passes which bind slots must use the resource returned by get_resource with read access.
+		void                       ( *update_rendergraph      )( le_argument_buffer_o* self, le_rendergraph_o* rendergraph );
+		void                       ( *bind_slot               )( le_argument_buffer_o const* self, le_command_buffer_encoder_o* encoder, uint64_t argument_name_id, uint32_t slot );
 	};
 
 	renderer_interface_t               le_renderer_i;
@@ -204,6 +280,8 @@ struct le_renderer_api {
 	rendergraph_private_interface_t    le_rendergraph_private_i;
 	command_buffer_encoder_interface_t le_command_buffer_encoder_i;
 	helpers_interface_t                helpers_i;
+	frame_capture_interface_t          le_frame_capture_i;
+	argument_buffer_interface_t        le_argument_buffer_i;
 };
 // clang-format on
 
@@ -215,11 +293,13 @@ LE_MODULE_LOAD_DEFAULT( le_renderer );
 namespace le_renderer {
 static const auto& api = le_renderer_api_i;
 
-static const auto& renderer_i    = api->le_renderer_i;
-static const auto& renderpass_i  = api->le_renderpass_i;
-static const auto& rendergraph_i = api->le_rendergraph_i;
-static const auto& encoder_i     = api->le_command_buffer_encoder_i;
-static const auto& helpers_i     = api->helpers_i;
+static const auto& renderer_i        = api->le_renderer_i;
+static const auto& renderpass_i      = api->le_renderpass_i;
+static const auto& rendergraph_i     = api->le_rendergraph_i;
+static const auto& encoder_i         = api->le_command_buffer_encoder_i;
+static const auto& helpers_i         = api->helpers_i;
+static const auto& frame_capture_i   = api->le_frame_capture_i;
+static const auto& argument_buffer_i = api->le_argument_buffer_i;
 
 } // namespace le_renderer
 
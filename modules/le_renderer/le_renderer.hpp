@@ -117,6 +117,13 @@ class RendererInfoBuilder {
 				return *this;
 			}
 
+			/// Rendered images are not written out - no pipe is opened. Use this to run
+			/// headless, e.g. for benchmarks.
+			ImgSwapchainInfoBuilder& setDiscardOutput( bool discard_output = true ) {
+				parent.parent.swapchain_settings->img_settings.discard_output = discard_output;
+				return *this;
+			}
+
 			SwapchainInfoBuilder& end() {
 				parent.parent.swapchain_settings->type = le_swapchain_settings_t::Type::LE_IMG_SWAPCHAIN;
 				return parent;
@@ -164,6 +171,14 @@ class RendererInfoBuilder {
 		return mSwapchainInfoBuilder;
 	}
 
+	/// Sets the number of frames which the renderer keeps in flight - fewer frames mean lower latency,
+	/// more frames mean higher throughput. See le_renderer_settings_t for details.
+	RendererInfoBuilder& setFramesInFlight( uint32_t num_frames_in_flight, uint32_t dispatch_delay = 1 ) {
+		info.num_frames_in_flight = num_frames_in_flight;
+		info.dispatch_delay       = dispatch_delay;
+		return *this;
+	}
+
 	le_renderer_settings_t const& build() {
 		// if an initial window was given and nothing else,
 		// we must make sure that the setting still counts.
@@ -369,6 +384,11 @@ class Renderer {
 		return le_renderer::renderer_i.get_pipeline_manager( self );
 	}
 
+	/// Captures the next `num_frames` frames to a file, which may be replayed without the app - see le_frame_capture_i.
+	bool requestFrameCapture( char const* path, uint32_t num_frames = 1 ) {
+		return le_renderer::renderer_i.request_frame_capture( self, path, num_frames );
+	}
+
 	static le_texture_handle produceTextureHandle( char const* maybe_name ) {
 		return le_renderer::renderer_i.produce_texture_handle( maybe_name );
 	}
@@ -377,6 +397,12 @@ class Renderer {
 		return le_renderer::renderer_i.produce_img_resource_handle( maybe_name, 0, nullptr, 0 );
 	}
 
+	// Contents of transient images are undefined at the start of each frame - in exchange,
+	// the backend may alias their memory with other transient images.
+	static le_img_resource_handle produceTransientImageHandle( char const* maybe_name ) {
+		return LE_TRANSIENT_IMG_RESOURCE( maybe_name );
+	}
+
 	static le_buf_resource_handle produceBufferHandle( char const* maybe_name ) {
 		return le_renderer::renderer_i.produce_buf_resource_handle( maybe_name, 0, 0 );
 	}
@@ -720,6 +746,26 @@ class Encoder {
 		return *this;
 	}
 
+	Encoder& drawIndirect( le_buf_resource_handle const& buffer, uint64_t const& offset = 0, uint32_t const& drawCount = 1, uint32_t const& stride = 0 ) {
+		le_renderer::encoder_i.draw_indirect( self, buffer, offset, drawCount, stride );
+		return *this;
+	}
+
+	Encoder& drawIndexedIndirect( le_buf_resource_handle const& buffer, uint64_t const& offset = 0, uint32_t const& drawCount = 1, uint32_t const& stride = 0 ) {
+		le_renderer::encoder_i.draw_indexed_indirect( self, buffer, offset, drawCount, stride );
+		return *this;
+	}
+
+	Encoder& drawIndirectCount( le_buf_resource_handle const& buffer, uint64_t const& offset, le_buf_resource_handle const& countBuffer, uint64_t const& countOffset, uint32_t const& maxDrawCount, uint32_t const& stride = 0 ) {
+		le_renderer::encoder_i.draw_indirect_count( self, buffer, offset, countBuffer, countOffset, maxDrawCount, stride );
+		return *this;
+	}
+
+	Encoder& drawIndexedIndirectCount( le_buf_resource_handle const& buffer, uint64_t const& offset, le_buf_resource_handle const& countBuffer, uint64_t const& countOffset, uint32_t const& maxDrawCount, uint32_t const& stride = 0 ) {
+		le_renderer::encoder_i.draw_indexed_indirect_count( self, buffer, offset, countBuffer, countOffset, maxDrawCount, stride );
+		return *this;
+	}
+
 	Encoder& traceRays( uint32_t const& width, uint32_t const& height, uint32_t const& depth = 1 ) {
 		le_renderer::encoder_i.trace_rays( self, width, height, depth );
 		return *this;
@@ -819,6 +865,11 @@ class Encoder {
 		return *this;
 	}
 
+	Encoder& bindArgumentBufferSlot( le_argument_buffer_o const* argumentBuffer, uint64_t const& argumentName, uint32_t const& slot ) {
+		le_renderer::argument_buffer_i.bind_slot( argumentBuffer, self, argumentName, slot );
+		return *this;
+	}
+
 	class ShaderBindingTableBuilder {
 		Encoder const&             parent;
 		le_shader_binding_table_o* sbt = nullptr;
@@ -867,6 +918,10 @@ class Encoder {
 	le_pipeline_manager_o* getPipelineManager() {
 		return le_renderer::encoder_i.get_pipeline_manager( self );
 	}
+
+	uint32_t getNumElidedCommands() {
+		return le_renderer::encoder_i.get_num_elided_commands( self );
+	}
 };
 // ----------------------------------------------------------------------
 
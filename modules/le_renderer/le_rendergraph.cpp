@@ -11,6 +11,8 @@
 #include <sstream>
 #include <array>
 #include <bitset>
+#include <chrono>
+#include <mutex>
 
 #include "le_renderer.h"
 #include "le_backend_vk.h"
@@ -31,10 +33,114 @@ static constexpr auto LOGGER_LABEL = "le_rendergraph";
 
 #include "le_log.h"
 
+// ----------------------------------------------------------------------
+// Renderpasses get created, cloned, and destroyed for every pass, every frame.
+// Instead of deleting passes, we return them to a pool, from which create and
+// clone hand them out again - pooled passes keep the capacity of their vectors,
+// so that once the pool has warmed up, setting up passes does not allocate.
+//
+// Passes may get destroyed on any thread, which is why the pool is protected
+// by a mutex. The pool is stored in the global dictionary, so that it survives
+// this module being hot-reloaded.
+struct le_renderpass_pool_t {
+	std::mutex                    mtx;
+	std::vector<le_renderpass_o*> free_passes; // owning, protected by mtx
+};
+
+static le_renderpass_pool_t* get_renderpass_pool( bool erase = false ) {
+
+	static le_renderpass_pool_t* renderpass_pool = nullptr;
+
+	if ( erase ) {
+		void** renderpass_pool_ptr = le_core_produce_dictionary_entry( hash_64_fnv1a_const( "renderpass_pool" ) );
+		renderpass_pool            = static_cast<le_renderpass_pool_t*>( *renderpass_pool_ptr );
+		if ( renderpass_pool ) {
+			for ( auto p : renderpass_pool->free_passes ) {
+				delete p;
+			}
+			delete renderpass_pool;
+		}
+		*renderpass_pool_ptr = nullptr; // null pointer stored in global store
+		renderpass_pool      = nullptr; // null pointer stored in local store
+		return nullptr;
+	}
+
+	if ( renderpass_pool ) {
+		return renderpass_pool;
+	}
+
+	// ----------| Invariant: not yet in local store
+	void** renderpass_pool_ptr = le_core_produce_dictionary_entry( hash_64_fnv1a_const( "renderpass_pool" ) );
+
+	if ( *renderpass_pool_ptr ) {
+		// Found in global store
+		renderpass_pool = static_cast<le_renderpass_pool_t*>( *renderpass_pool_ptr );
+	} else {
+		// Not yet available in global store - create & make available
+		renderpass_pool      = new le_renderpass_pool_t{};
+		*renderpass_pool_ptr = renderpass_pool;
+	}
+
+	return renderpass_pool;
+}
+
+// ----------------------------------------------------------------------
+// Returns a pass in default state - recycled from the pool if possible.
+static le_renderpass_o* renderpass_pool_acquire() {
+	auto pool = get_renderpass_pool();
+	{
+		std::scoped_lock lock( pool->mtx );
+		if ( !pool->free_passes.empty() ) {
+			auto pass = pool->free_passes.back();
+			pool->free_passes.pop_back();
+			return pass;
+		}
+	}
+	return new le_renderpass_o();
+}
+
+// ----------------------------------------------------------------------
+// Resets pass to default state, keeping the capacity of its vectors, and returns it to the pool.
+static void renderpass_pool_release( le_renderpass_o* self ) {
+
+	le_renderpass_o recycled{};
+
+	recycled.resources.swap( self->resources );
+	recycled.resources_read_write_flags.swap( self->resources_read_write_flags );
+	recycled.resources_access_flags.swap( self->resources_access_flags );
+	recycled.imageAttachments.swap( self->imageAttachments );
+	recycled.attachmentResources.swap( self->attachmentResources );
+	recycled.textureIds.swap( self->textureIds );
+	recycled.textureInfos.swap( self->textureInfos );
+	recycled.executeCallbacks.swap( self->executeCallbacks );
+
+	recycled.resources.clear();
+	recycled.resources_read_write_flags.clear();
+	recycled.resources_access_flags.clear();
+	recycled.imageAttachments.clear();
+	recycled.attachmentResources.clear();
+	recycled.textureIds.clear();
+	recycled.textureInfos.clear();
+	recycled.executeCallbacks.clear();
+
+	*self = std::move( recycled );
+
+	auto pool = get_renderpass_pool();
+
+	std::scoped_lock lock( pool->mtx );
+	pool->free_passes.push_back( self );
+}
+
+// ----------------------------------------------------------------------
+// Deletes all passes which are currently in the pool.
+static void renderpass_pool_destroy() {
+	get_renderpass_pool( true );
+}
+
 // ----------------------------------------------------------------------
 
 static le_renderpass_o* renderpass_create( const char* renderpass_name, const le::QueueFlagBits& type_ ) {
-	auto self  = new le_renderpass_o();
+	auto self  = renderpass_pool_acquire();
 	self->id   = hash_64_fnv1a( renderpass_name );
 	self->type = type_;
 	strncpy( self->debugName, renderpass_name, sizeof( self->debugName ) );
@@ -45,8 +151,8 @@ static le_renderpass_o* renderpass_create( const char* renderpass_name, const le
 // ----------------------------------------------------------------------
 
 static le_renderpass_o* renderpass_clone( le_renderpass_o const* rhs ) {
-	auto self       = new le_renderpass_o();
-	*self           = *rhs;
+	auto self       = renderpass_pool_acquire();
+	*self           = *rhs; // copy-assignment re-uses the capacity of pooled vectors
 	self->ref_count = 1;
 	return self;
 }
@@ -60,7 +166,7 @@ static void renderpass_destroy( le_renderpass_o* self ) {
 		encoder_i.destroy( self->encoder );
 	}
 
-	delete self;
+	renderpass_pool_release( self );
 }
 
 static void renderpass_ref_inc( le_renderpass_o* self ) {
@@ -292,6 +398,15 @@ static void renderpass_get_queue_submission_info( const le_renderpass_o* self, l
 	}
 }
 
+static void renderpass_get_async_compute_info( le_renderpass_o const* self, bool* is_async_compute, bool* waits_for_async_compute ) {
+	if ( is_async_compute ) {
+		*is_async_compute = self->is_async_compute;
+	}
+	if ( waits_for_async_compute ) {
+		*waits_for_async_compute = self->waits_for_async;
+	}
+}
+
 static void renderpass_get_used_resources( le_renderpass_o const* self, le_resource_handle const** pResources, le::AccessFlags2 const** pResourcesAccess, size_t* count ) {
 	assert( self->resources_access_flags.size() == self->resources.size() );
 
@@ -344,7 +459,9 @@ le_command_buffer_encoder_o* renderpass_steal_encoder( le_renderpass_o* self ) {
 // ----------------------------------------------------------------------
 
 static le_rendergraph_o* rendergraph_create() {
-	auto obj = new le_rendergraph_o();
+	using namespace le_renderer;
+	auto obj                      = new le_rendergraph_o();
+	obj->command_stream_page_pool = encoder_i.create_page_pool();
 	return obj;
 }
 
@@ -361,12 +478,32 @@ static void rendergraph_reset( le_rendergraph_o* self ) {
 	self->root_passes_affinity_masks.clear();
 	self->declared_resources_id.clear();
 	self->declared_resources_info.clear();
+	self->pass_timings.clear();
+
+	// All temporary containers which used the frame arena have gone out of scope
+	// by now, which means that we may recycle the arena's memory.
+	self->frame_arena.reset();
+
+	LE_SETTING( bool, LE_SETTING_PRINT_FRAME_ARENA_STATS, false );
+
+	if ( *LE_SETTING_PRINT_FRAME_ARENA_STATS ) [[unlikely]] {
+		static auto logger = LeLog( LOGGER_LABEL );
+		logger.info( "Rendergraph frame arena: %8zu Bytes used, %8zu Bytes capacity, %zu arena block allocations",
+		             self->frame_arena.get_num_bytes_used(),
+		             self->frame_arena.get_capacity(),
+		             self->frame_arena.get_num_heap_allocations() );
+	}
 }
 
 // ----------------------------------------------------------------------
 
 static void rendergraph_destroy( le_rendergraph_o* self ) {
+	using namespace le_renderer;
 	rendergraph_reset( self );
+	// Note: all encoders which used pages from this pool must have been destroyed by now -
+	// encoders held by passes are destroyed in reset, and encoders which were stolen by the
+	// backend are destroyed when the backend clears the frame.
+	encoder_i.destroy_page_pool( self->command_stream_page_pool );
 	delete self;
 }
 
@@ -433,7 +570,10 @@ static bool generate_dot_file_for_rendergraph(
 			   << ( nodes[ i ].is_root ? "10" : "0" )
 			   << "' sides='b' cellpadding='3'><b>"
 			   << ( nodes[ i ].is_root ? "⊥ " : "" )
-			   << p->debugName << "</b></td>";
+			   << p->debugName << "</b>"
+			   << ( nodes[ i ].is_async_compute ? "<br/><font point-size='9'>async compute</font>" : "" )
+			   << ( nodes[ i ].waits_for_async ? "<br/><font point-size='9'>waits for async compute</font>" : "" )
+			   << "</td>";
 		} else {
 			os << "\"" << p->debugName << "\""
 			   << "[label = <<table bgcolor='gray' border='0' cellborder='1' cellspacing='0'><tr><td border='"
@@ -515,11 +655,8 @@ static bool generate_dot_file_for_rendergraph(
 
 			// now we must find any subsequent nodes which read from this resource.
 
-			ResourceField res_filter = uint64_t( 1 ) << res_idx;
-
 			for ( size_t k = i + 1; k != self->passes.size(); k++ ) {
-				if ( ( nodes[ k ].reads & res_filter ).any() ||
-				     ( nodes[ k ].writes & nodes[ k ].reads & res_filter ).any() ) {
+				if ( nodes[ k ].reads.test( res_idx ) ) {
 
 					os << "\"" << p->debugName << "\":"
 					   << "\"" << needle->data->debug_name << "\""
@@ -530,7 +667,7 @@ static bool generate_dot_file_for_rendergraph(
 					   << ( nodes[ k ].is_contributing == false ? "[style=dashed]" : "" )
 					   << ";" << std::endl;
 				}
-				if ( ( nodes[ k ].writes & res_filter ).any() ) {
+				if ( nodes[ k ].writes.test( res_idx ) ) {
 					break;
 				}
 			}
@@ -580,13 +717,13 @@ static bool generate_dot_file_for_rendergraph(
 /// \brief Tag any nodes which contribute to any root nodes
 /// \details We do this so that we can weed out any nodes which are provably
 ///          not contributing - these don't need to be executed at all.
-static void node_tag_contributing( Node* const nodes, const size_t num_nodes, uint32_t* count_roots = nullptr ) {
+static void node_tag_contributing( Node* const nodes, const size_t num_nodes, ResourceField::allocator_type const& allocator, uint32_t* count_roots = nullptr ) {
 
 	// We iterate bottom to top - from last layer to first layer
 	Node*             node      = nodes + num_nodes;
 	Node const* const node_rend = nodes;
 
-	ResourceField read_accum;
+	ResourceField read_accum( allocator );
 
 	if ( count_roots ) {
 		*count_roots = 0;
@@ -605,7 +742,7 @@ static void node_tag_contributing( Node* const nodes, const size_t num_nodes, ui
 		// If it's not a root node, first see if there are any writes to currently monitored reads
 		//      if yes, add all reads to monitored reads
 
-		bool writes_to_any_monitored_read = ( node->writes & read_accum ).any();
+		bool writes_to_any_monitored_read = node->writes.intersects( read_accum );
 
 		if ( node->is_root || writes_to_any_monitored_read ) {
 
@@ -618,8 +755,8 @@ static void node_tag_contributing( Node* const nodes, const size_t num_nodes, ui
 			// be implicitly discarded by a write-only operation onto this place. (Any previous writes
 			// are never read, and we will need a new read to make this resource active again)
 
-			read_accum = ( read_accum & ( ~node->writes ) ) // Anything written in this node will be extinguished (consumed)
-			             | node->reads;                     // Anything read in this node will be lit up.
+			read_accum -= node->writes; // Anything written in this node will be extinguished (consumed)
+			read_accum |= node->reads;  // Anything read in this node will be lit up.
 
 			node->is_contributing = true;
 
@@ -635,33 +772,242 @@ static void node_tag_contributing( Node* const nodes, const size_t num_nodes, ui
 	} // end for all nodes, backwards iteration
 }
 
+// ----------------------------------------------------------------------
+/// \brief Tag compute nodes which may execute on an async compute queue
+/// \details A contributing compute node may run asynchronously if it does not
+///          conflict with any earlier non-async node: it must not read anything
+///          which such a node writes, and it must not write, or access as an image
+///          (which might need a layout transition), anything which such a node
+///          accesses. In other words, we could hoist it above all non-async nodes.
+///
+///          Non-async nodes which conflict in the same way with any earlier async
+///          node are tagged as having to wait for async compute to complete.
+///
+///          Subgraphs are resource-isolated, which is why we can accumulate
+///          accesses over all subgraphs.
+static void node_tag_async_compute( le_rendergraph_o const* self, Node* const nodes, std::pmr::unordered_map<le_resource_handle, uint32_t> const& unique_handle_indices, ResourceField::allocator_type const& allocator ) {
+
+	ResourceField main_reads( allocator );   // accumulated reads of all earlier non-async nodes
+	ResourceField main_writes( allocator );  // accumulated writes of all earlier non-async nodes
+	ResourceField async_reads( allocator );  // accumulated reads of all earlier async nodes
+	ResourceField async_writes( allocator ); // accumulated writes of all earlier async nodes
+
+	// Returns true if any resource used by pass conflicts with accumulated reads and writes
+	auto conflicts_with = [ & ]( le_renderpass_o const* p, ResourceField const& reads, ResourceField const& writes ) -> bool {
+		for ( size_t j = 0; j != p->resources.size(); j++ ) {
+			uint32_t const res_idx  = unique_handle_indices.at( p->resources[ j ] );
+			bool const     is_write = ( le::ResourceAccessFlagBits( p->resources_read_write_flags[ j ] ) & le::ResourceAccessFlagBits::eWrite );
+			bool const     is_image = ( p->resources[ j ]->data->type == LeResourceType::eImage );
+			if ( writes.test( res_idx ) ||
+			     ( reads.test( res_idx ) && ( is_write || is_image ) ) ) {
+				return true;
+			}
+		}
+		return false;
+	};
+
+	for ( size_t i = 0; i != self->passes.size(); i++ ) {
+
+		Node&                  node = nodes[ i ];
+		le_renderpass_o const* p    = self->passes[ i ];
+
+		if ( !node.is_contributing ) {
+			continue;
+		}
+
+		if ( p->type == le::QueueFlagBits::eCompute &&
+		     !conflicts_with( p, main_reads, main_writes ) ) {
+			node.is_async_compute = true;
+			async_reads |= node.reads;
+			async_writes |= node.writes;
+		} else {
+			node.waits_for_async = conflicts_with( p, async_reads, async_writes );
+			main_reads |= node.reads;
+			main_writes |= node.writes;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+// Calculates a hash over everything that rendergraph_build depends upon:
+// the sequence of passes, whether each pass was declared root, its queue
+// type, and for each pass, the resources it uses, and how it accesses them.
+//
+// Note that resource handles are interned, which means that we may hash
+// their addresses.
+static uint64_t rendergraph_calculate_structure_hash( le_rendergraph_o const* self ) {
+
+	uint64_t hash = self->passes.size();
+
+	for ( auto const& p : self->passes ) {
+		uint64_t const num_resources = p->resources.size();
+		hash                         = SpookyHash::Hash64( &p->is_root, sizeof( p->is_root ), hash );
+		hash                         = SpookyHash::Hash64( &p->type, sizeof( p->type ), hash );
+		hash                         = SpookyHash::Hash64( &num_resources, sizeof( num_resources ), hash );
+		hash                         = SpookyHash::Hash64( p->resources.data(), sizeof( le_resource_handle ) * num_resources, hash );
+		hash                         = SpookyHash::Hash64( p->resources_read_write_flags.data(), sizeof( le::RWFlags ) * num_resources, hash );
+		hash                         = SpookyHash::Hash64( p->resources_access_flags.data(), sizeof( le::AccessFlags2 ) * num_resources, hash );
+	}
+
+	return hash;
+}
+
+// ----------------------------------------------------------------------
+// Applies a cached build result to the current list of passes - this has the
+// same effect as rendergraph_build, as long as structure hashes match.
+static void rendergraph_apply_build_cache( le_rendergraph_o* self, RendergraphBuildCache const& cache ) {
+
+	size_t const num_passes       = self->passes.size();
+	size_t const num_contributing = cache.contributing_pass_indices.size();
+
+	// Consolidate passes in-place: contributing pass indices are sorted in ascending
+	// order, which means that we can compact the list of passes front-to-back.
+	//
+	// Passes which contribute are tagged with cached root flags, affinities, and async compute flags.
+	// Passes which don't contribute are deleted, as we own them.
+
+	size_t next_contributing = 0;
+
+	for ( size_t i = 0; i != num_passes; i++ ) {
+		auto pass = self->passes[ i ];
+		if ( next_contributing != num_contributing && cache.contributing_pass_indices[ next_contributing ] == i ) {
+			pass->is_root                       = cache.contributing_pass_is_root[ next_contributing ];
+			pass->root_passes_affinity          = cache.contributing_pass_affinity[ next_contributing ];
+			pass->is_async_compute              = cache.contributing_pass_is_async[ next_contributing ];
+			pass->waits_for_async               = cache.contributing_pass_waits[ next_contributing ];
+			self->passes[ next_contributing++ ] = pass;
+		} else {
+			renderpass_destroy( pass );
+		}
+	}
+
+	self->passes.resize( num_contributing );
+
+	// Debug names for roots point into the new set of passes
+
+	self->root_debug_names.clear();
+	self->root_debug_names.reserve( cache.root_pass_indices.size() );
+
+	for ( auto const& idx : cache.root_pass_indices ) {
+		self->root_debug_names.push_back( self->passes[ idx ]->debugName );
+	}
+
+	self->root_passes_affinity_masks = cache.root_passes_affinity_masks;
+}
+
+// ----------------------------------------------------------------------
+// Stores result of the build which has just completed with the cache, so
+// that subsequent builds may re-use it.
+static void rendergraph_update_build_cache( le_rendergraph_o* self, uint64_t structure_hash, std::pmr::vector<uint32_t> const& contributing_pass_indices ) {
+
+	auto& cache = self->build_cache;
+
+	cache.structure_hash = structure_hash;
+	cache.contributing_pass_indices.assign( contributing_pass_indices.begin(), contributing_pass_indices.end() );
+
+	cache.contributing_pass_is_root.clear();
+	cache.contributing_pass_affinity.clear();
+	cache.contributing_pass_is_async.clear();
+	cache.contributing_pass_waits.clear();
+	cache.root_pass_indices.clear();
+
+	for ( size_t i = 0; i != self->passes.size(); i++ ) {
+		auto const& p = self->passes[ i ];
+		cache.contributing_pass_is_root.push_back( p->is_root );
+		cache.contributing_pass_affinity.push_back( p->root_passes_affinity );
+		cache.contributing_pass_is_async.push_back( p->is_async_compute );
+		cache.contributing_pass_waits.push_back( p->waits_for_async );
+	}
+
+	for ( auto const& root_debug_name : self->root_debug_names ) {
+		// Root debug names are pointers into passes - we translate them into pass indices
+		uint32_t idx = 0;
+		for ( ; idx != self->passes.size(); idx++ ) {
+			if ( self->passes[ idx ]->debugName == root_debug_name ) {
+				break;
+			}
+		}
+		assert( idx != self->passes.size() && "root pass must be a contributing pass" );
+		cache.root_pass_indices.push_back( idx );
+	}
+
+	cache.root_passes_affinity_masks = self->root_passes_affinity_masks;
+	cache.is_valid                   = true;
+}
+
+// ----------------------------------------------------------------------
 // We assume that passes arrive in partial-order (i.e. the order
 // of adding passes to a module is meaningful)
 //
 // As a side-effect, this method removes (and deletes) any
 // passes which do not contribute to the rendergraph
 //
+// If the structure of the rendergraph is identical to the structure of the
+// rendergraph that was last built on this object, we re-use the previous
+// build result instead of building again.
+//
 static void rendergraph_build( le_rendergraph_o* self, size_t frame_number ) {
 
 	static auto logger = LeLog( LOGGER_LABEL );
 
 	LE_SETTING( bool, LE_SETTING_RENDERGRAPH_PRINT_EXTENDED_DEBUG_MESSAGES, false );
+	LE_SETTING( uint32_t, LE_SETTING_RENDERGRAPH_GENERATE_DOT_FILES, 0 );
+	LE_SETTING( bool, LE_SETTING_RENDERGRAPH_ENABLE_BUILD_CACHE, true );
+	LE_SETTING( bool, LE_SETTING_RENDERGRAPH_ENABLE_ASYNC_COMPUTE, true );
+
+	bool const enable_async_compute = *LE_SETTING_RENDERGRAPH_ENABLE_ASYNC_COMPUTE;
+	bool const enable_build_cache   = *LE_SETTING_RENDERGRAPH_ENABLE_BUILD_CACHE;
+
+	// We only need the structure hash if the build cache is enabled.
+	// Whether async compute is enabled changes the build result, which is why it must contribute to the hash.
+	uint64_t const structure_hash =
+	    enable_build_cache
+	        ? SpookyHash::Hash64( &enable_async_compute, sizeof( enable_async_compute ), rendergraph_calculate_structure_hash( self ) )
+	        : 0;
+
+	if ( enable_build_cache &&
+	     self->build_cache.is_valid &&
+	     self->build_cache.structure_hash == structure_hash &&
+	     *LE_SETTING_RENDERGRAPH_GENERATE_DOT_FILES == 0 ) {
+
+		// Structure is unchanged: we may re-use the previous build result.
+		// Note that we don't re-use it if we must generate a dot file, as
+		// this needs intermediary data from a full build.
+
+		rendergraph_apply_build_cache( self, self->build_cache );
+
+		if ( *LE_SETTING_RENDERGRAPH_PRINT_EXTENDED_DEBUG_MESSAGES ) [[unlikely]] {
+			logger.info( "Re-using cached rendergraph build result, structure hash: %016llx", ( unsigned long long )structure_hash );
+		}
+
+		return;
+	}
+
+	// ---------| invariant: we must do a full build
+
 	// We must express our list of passes as a list of nodes.
 	// A node holds two bitfields, the bitfield names are: `read` and `write`.
 	// Each bit in the bitfield represents a possible resource.
 	// This means we must create a list of unique resources, so that we can use the resource index as the
 	// offset value for a bit representing this particular resource in the bitfields.
 
-	std::vector<Node>                                          nodes;
-	std::array<le_resource_handle, LE_MAX_NUM_GRAPH_RESOURCES> uniqueHandles; // lookup for resource handles.
-	size_t                                                     numUniqueResources = 0;
+	ResourceField::allocator_type const allocator( &self->frame_arena );
+
+	std::pmr::vector<Node>                                nodes( &self->frame_arena );
+	std::pmr::vector<le_resource_handle>                  uniqueHandles( &self->frame_arena );       // lookup for resource handles: resource index -> handle
+	std::pmr::unordered_map<le_resource_handle, uint32_t> uniqueHandleIndices( &self->frame_arena ); // lookup for resource index: handle -> resource index
+
+	nodes.reserve( self->passes.size() );
 
 	// Translate all passes into a node
 	//   Get list of resources per pass and build node from this
 
 	for ( auto const& p : self->passes ) {
 
-		Node node{};
+		Node node{
+		    .reads  = ResourceField( allocator ),
+		    .writes = ResourceField( allocator ),
+		};
 
 		const size_t numResources = p->resources.size();
 
@@ -669,21 +1015,16 @@ static void rendergraph_build( le_rendergraph_o* self, size_t frame_number ) {
 			auto const&        resource_handle = p->resources[ i ];
 			le::RWFlags const& access_flags    = p->resources_read_write_flags[ i ];
 
-			size_t res_idx = 0; // unique resource id (monotonic, non-sparse, index into bitfield)
-			for ( auto r = uniqueHandles.data(); res_idx != numUniqueResources; res_idx++, r++ ) {
-				if ( *r == resource_handle ) {
-					// found matching resource, res_idx is index into uniqueHandles for resource
-					break;
-				}
-			}
+			// unique resource id (monotonic, non-sparse, index into bitfield) - if resource
+			// was not found, we add a new resource
+			auto [ it, was_inserted ] = uniqueHandleIndices.try_emplace( resource_handle, uint32_t( uniqueHandles.size() ) );
 
-			if ( res_idx == numUniqueResources ) {
-				// resource was not found, we must add a new resource
-				uniqueHandles[ res_idx ] = resource_handle;
-				numUniqueResources++;
-				assert( numUniqueResources < LE_MAX_NUM_GRAPH_RESOURCES && "bitfield must be large enough to provide one field for each unique resource" );
+			if ( was_inserted ) {
+				uniqueHandles.push_back( resource_handle );
 			}
 
+			size_t const res_idx = it->second;
+
 			// --------| invariant: uniqueHandles[res_idx] is valid
 
 			node.reads.set( res_idx, ( le::ResourceAccessFlagBits( access_flags ) & le::ResourceAccessFlagBits::eRead ) );
@@ -703,16 +1044,17 @@ static void rendergraph_build( le_rendergraph_o* self, size_t frame_number ) {
 	// Tasks which don't contribute to any root node
 	// can be disposed, as their products will never be used.
 	uint32_t root_count = 0; // gets set to number of found root nodes as a side-effect of node_tag_contributing
-	node_tag_contributing( nodes.data(), nodes.size(), &root_count );
+	node_tag_contributing( nodes.data(), nodes.size(), allocator, &root_count );
 
 	// non-owning pointers to debug names within passes which are root, in the same order as RootPassesField is constructed
-	std::vector<char const*> root_debug_names( root_count );
+	auto& root_debug_names = self->root_debug_names;
+	root_debug_names.assign( root_count, nullptr );
 
 	assert( root_count <= LE_MAX_NUM_GRAPH_ROOTS && "number of nodes must fit LE_MAX_NUM_TREES, otherwise we can't express tree affinity as a bitfield" );
 
 	{
-		std::vector<ResourceField> root_reads_accum( root_count );
-		std::vector<ResourceField> root_writes_accum( root_count );
+		std::pmr::vector<ResourceField> root_reads_accum( root_count, &self->frame_arena );
+		std::pmr::vector<ResourceField> root_writes_accum( root_count, &self->frame_arena );
 
 		// for each root node, accumulate all reads, and writes from contributing nodes.
 		// we do this so that we can test whether each tree is isolated.
@@ -745,7 +1087,7 @@ static void rendergraph_build( le_rendergraph_o* self, size_t frame_number ) {
 					}
 					// if this earlier node writes to any of our subsequent reads, we add it to our
 					// current tree of nodes.
-					if ( ( n->writes & read_accum ).any() ) {
+					if ( n->writes.intersects( read_accum ) ) {
 						read_accum |= n->reads;
 						write_accum |= n->writes;
 						// tag resource as belonging to this particular root node.
@@ -760,7 +1102,7 @@ static void rendergraph_build( le_rendergraph_o* self, size_t frame_number ) {
 		if ( *LE_SETTING_RENDERGRAPH_PRINT_EXTENDED_DEBUG_MESSAGES ) [[unlikely]] {
 			{
 				logger.info( "Unique resources:" );
-				for ( size_t i = 0; i != numUniqueResources; i++ ) {
+				for ( size_t i = 0; i != uniqueHandles.size(); i++ ) {
 					logger.info( "%3d : %s", i, uniqueHandles[ i ]->data->debug_name );
 				}
 			}
@@ -800,8 +1142,8 @@ static void rendergraph_build( le_rendergraph_o* self, size_t frame_number ) {
 		//
 		// By the end ot this process we get a list of unique subgraph_ids which have no overlap.
 		//
-		std::vector<le::RootPassesField> subgraph_id( root_count );     // queue id per root - starting out with a single bit
-		std::vector<int>                 subgraph_id_idx( root_count ); // queue id index per root
+		std::pmr::vector<le::RootPassesField> subgraph_id( root_count, &self->frame_arena );     // queue id per root - starting out with a single bit
+		std::pmr::vector<int>                 subgraph_id_idx( root_count, &self->frame_arena ); // queue id index per root
 		for ( size_t i = 0; i != root_count; i++ ) {
 			subgraph_id[ i ] |= ( 1ULL << i ); // initialise to single bit at bitfield position corresponding to queue id
 			subgraph_id_idx[ i ] = i;          // initialise queue id index to be direct mapping
@@ -812,8 +1154,8 @@ static void rendergraph_build( le_rendergraph_o* self, size_t frame_number ) {
 				// compare i <-> j
 				// compare j <-> i
 				// If any reads appear in writes, tag both as being part of the same batch.
-				if ( ( root_reads_accum[ i ] & root_writes_accum[ j ] ).any() || // writes from j touch reads from i
-				     ( root_reads_accum[ j ] & root_writes_accum[ i ] ).any() )  // or writes from i touch reads from j
+				if ( root_reads_accum[ i ].intersects( root_writes_accum[ j ] ) || // writes from j touch reads from i
+				     root_reads_accum[ j ].intersects( root_writes_accum[ i ] ) )  // or writes from i touch reads from j
 				{
 
 					// Overlap detectd:
@@ -865,10 +1207,14 @@ static void rendergraph_build( le_rendergraph_o* self, size_t frame_number ) {
 		}
 	}
 
-	LE_SETTING( uint32_t, LE_SETTING_RENDERGRAPH_GENERATE_DOT_FILES, 0 );
+	if ( enable_async_compute ) {
+		// Find compute passes which don't sit on the critical path of their subgraph,
+		// so that the backend may submit them to an async compute queue.
+		node_tag_async_compute( self, nodes.data(), uniqueHandleIndices, allocator );
+	}
 
 	if ( *LE_SETTING_RENDERGRAPH_GENERATE_DOT_FILES > 0 ) [[unlikely]] {
-		generate_dot_file_for_rendergraph( self, uniqueHandles.data(), numUniqueResources, nodes.data(), frame_number );
+		generate_dot_file_for_rendergraph( self, uniqueHandles.data(), uniqueHandles.size(), nodes.data(), frame_number );
 		( *LE_SETTING_RENDERGRAPH_GENERATE_DOT_FILES )--;
 	}
 
@@ -878,29 +1224,32 @@ static void rendergraph_build( le_rendergraph_o* self, size_t frame_number ) {
 		//
 		size_t num_passes = self->passes.size();
 
-		std::vector<le_renderpass_o*> consolidated_passes;
-		consolidated_passes.reserve( num_passes );
+		std::pmr::vector<uint32_t> contributing_pass_indices( &self->frame_arena ); // for build cache
+		contributing_pass_indices.reserve( num_passes );
+
+		// We consolidate passes in-place, front-to-back.
+		size_t num_contributing = 0;
 
 		for ( size_t i = 0; i != num_passes; i++ ) {
 			if ( nodes[ i ].is_contributing ) {
 				// Pass contributes, add it to consolidated passes
 				self->passes[ i ]->is_root              = nodes[ i ].is_root;
 				self->passes[ i ]->root_passes_affinity = nodes[ i ].root_nodes_affinity;
-				consolidated_passes.push_back( self->passes[ i ] );
+				self->passes[ i ]->is_async_compute     = nodes[ i ].is_async_compute;
+				self->passes[ i ]->waits_for_async      = nodes[ i ].waits_for_async;
+				self->passes[ num_contributing++ ]      = self->passes[ i ];
+				contributing_pass_indices.push_back( uint32_t( i ) );
 			} else {
 				// Pass is not contributing, we will not keep it.
 				// Since the rendergraph owns this pass at this point,
-				// we must explicitly delete it.
-				delete self->passes[ i ];
+				// we must explicitly destroy it.
+				renderpass_destroy( self->passes[ i ] );
 				self->passes[ i ] = nullptr;
 			}
 		}
 
 		// Update self->passes
-		std::swap( self->passes, consolidated_passes );
-
-		// Update debug root names
-		std::swap( self->root_debug_names, root_debug_names );
+		self->passes.resize( num_contributing );
 
 		if ( *LE_SETTING_RENDERGRAPH_PRINT_EXTENDED_DEBUG_MESSAGES ) [[unlikely]] {
 			logger.info( "* Consolidated Pass List *" );
@@ -911,6 +1260,10 @@ static void rendergraph_build( le_rendergraph_o* self, size_t frame_number ) {
 			}
 			logger.info( "" );
 		}
+
+		if ( enable_build_cache ) {
+			rendergraph_update_build_cache( self, structure_hash, contributing_pass_indices );
+		}
 	}
 }
 
@@ -969,9 +1322,9 @@ static void rendergraph_execute( le_rendergraph_o* self, size_t frameIndex, le_b
 
 	uint32_t num_swapchain_images = 1; // gets updated as a side-effect of backend_i.get_swapchain_info()
 
-	std::vector<le_img_resource_handle> swapchain_images;
-	std::vector<uint32_t>               swapchain_image_width;
-	std::vector<uint32_t>               swapchain_image_height;
+	std::pmr::vector<le_img_resource_handle> swapchain_images( &self->frame_arena );
+	std::pmr::vector<uint32_t>               swapchain_image_width( &self->frame_arena );
+	std::pmr::vector<uint32_t>               swapchain_image_height( &self->frame_arena );
 
 	do {
 		swapchain_images.resize( num_swapchain_images );
@@ -990,9 +1343,9 @@ static void rendergraph_execute( le_rendergraph_o* self, size_t frameIndex, le_b
 	//                      - swapchain image info is available in swapchain_image[s|_width|_height]
 
 	auto find_matching_resource =
-	    []( std::vector<le_img_resource_handle> const& attachments,
-	        std::vector<le_img_resource_handle> const& resources,
-	        const uint32_t&                            num_resources ) -> uint32_t {
+	    []( std::vector<le_img_resource_handle> const&      attachments,
+	        std::pmr::vector<le_img_resource_handle> const& resources,
+	        const uint32_t&                                 num_resources ) -> uint32_t {
 		for ( auto const& attachment : attachments ) {
 			for ( uint32_t j = 0; j != num_resources; j++ ) {
 				if ( resources[ j ] == attachment ) {
@@ -1028,7 +1381,7 @@ static void rendergraph_execute( le_rendergraph_o* self, size_t frameIndex, le_b
 				pass->height = pass_extents.height = swapchain_image_height[ matching_swapchain_idx ];
 			}
 
-			pass->encoder = encoder_i.create( ppAllocators, pipelineCache, stagingAllocator, pass_extents ); // NOTE: we must manually track the lifetime of encoder!
+			pass->encoder = encoder_i.create( ppAllocators, pipelineCache, stagingAllocator, self->command_stream_page_pool, pass_extents ); // NOTE: we must manually track the lifetime of encoder!
 
 			if ( pass->type == le::QueueFlagBits::eGraphics ) {
 
@@ -1047,7 +1400,15 @@ static void rendergraph_execute( le_rendergraph_o* self, size_t frameIndex, le_b
 				encoder_i.set_viewport( pass->encoder, 0, 1, default_viewport );
 			}
 
-			renderpass_run_execute_callbacks( pass ); // record draw commands into encoder
+			if ( self->record_timings && pass->timing_index < self->pass_timings.size() ) [[unlikely]] {
+				auto t_start = std::chrono::high_resolution_clock::now();
+				renderpass_run_execute_callbacks( pass ); // record draw commands into encoder
+				self->pass_timings[ pass->timing_index ].execute_ms =
+				    std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - t_start ).count();
+				self->pass_timings[ pass->timing_index ].num_elided_commands = encoder_i.get_num_elided_commands( pass->encoder );
+			} else {
+				renderpass_run_execute_callbacks( pass ); // record draw commands into encoder
+			}
 		}
 	}
 
@@ -1069,8 +1430,29 @@ static void rendergraph_setup_passes( le_rendergraph_o* src_rendergraph, le_rend
 		// + populate output attachments
 		// + (optionally) add renderpass to graph builder.
 
+		if ( dst_rendergraph->record_timings ) [[unlikely]] {
+			// Pass timings are recorded for all passes, so that passes which were
+			// discarded in setup, or which did not contribute, show up too.
+			le_renderer_pass_timing_t timing{};
+			strncpy( timing.debug_name, pass->debugName, sizeof( timing.debug_name ) - 1 );
+			pass->timing_index = uint32_t( dst_rendergraph->pass_timings.size() );
+			dst_rendergraph->pass_timings.push_back( timing );
+		}
+
 		if ( renderpass_has_setup_callback( pass ) ) {
-			if ( renderpass_run_setup_callback( pass ) ) {
+
+			bool setup_result;
+
+			if ( dst_rendergraph->record_timings ) [[unlikely]] {
+				auto t_start = std::chrono::high_resolution_clock::now();
+				setup_result = renderpass_run_setup_callback( pass );
+				dst_rendergraph->pass_timings.back().setup_ms =
+				    std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - t_start ).count();
+			} else {
+				setup_result = renderpass_run_setup_callback( pass );
+			}
+
+			if ( setup_result ) {
 				// if pass.setup() returns true, this means we shall add this pass to the graph
 				// This means a transfer of ownership for pass: pass moves from into graph_builder
 				dst_rendergraph->passes.push_back( pass );
@@ -1085,9 +1467,11 @@ static void rendergraph_setup_passes( le_rendergraph_o* src_rendergraph, le_rend
 		}
 	}
 
-	// Move any resource ids and resource infos from module into rendergraph
-	dst_rendergraph->declared_resources_id   = std::move( src_rendergraph->declared_resources_id );
-	dst_rendergraph->declared_resources_info = std::move( src_rendergraph->declared_resources_info );
+	// Move any resource ids and resource infos from module into rendergraph - we swap,
+	// so that dst_rendergraph hands its (empty) vectors' capacity to src_rendergraph.
+	assert( dst_rendergraph->declared_resources_id.empty() && dst_rendergraph->declared_resources_info.empty() );
+	dst_rendergraph->declared_resources_id.swap( src_rendergraph->declared_resources_id );
+	dst_rendergraph->declared_resources_info.swap( src_rendergraph->declared_resources_info );
 
 	src_rendergraph->passes.clear();
 };
@@ -1117,6 +1501,8 @@ void register_le_rendergraph_api( void* api_ ) {
 	le_rendergraph_private_i.build        = rendergraph_build;
 	le_rendergraph_private_i.execute      = rendergraph_execute;
 
+	le_rendergraph_private_i.destroy_renderpass_pool = renderpass_pool_destroy;
+
 	auto& le_renderpass_i                        = le_renderer_api_i->le_renderpass_i;
 	le_renderpass_i.create                       = renderpass_create;
 	le_renderpass_i.clone                        = renderpass_clone;
@@ -1124,6 +1510,7 @@ void register_le_rendergraph_api( void* api_ ) {
 	le_renderpass_i.get_id                       = renderpass_get_id;
 	le_renderpass_i.get_debug_name               = renderpass_get_debug_name;
 	le_renderpass_i.get_queue_sumbission_info    = renderpass_get_queue_submission_info;
+	le_renderpass_i.get_async_compute_info       = renderpass_get_async_compute_info;
 	le_renderpass_i.get_framebuffer_settings     = renderpass_get_framebuffer_settings;
 	le_renderpass_i.set_width                    = renderpass_set_width;
 	le_renderpass_i.set_sample_count             = renderpass_set_sample_count;
@@ -0,0 +1,152 @@
+#ifndef LE_INTERNED_HANDLE_TABLE_H
+#define LE_INTERNED_HANDLE_TABLE_H
+
+#include "le_core.h" // for NoCopy, NoMove
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <cassert>
+
+// ----------------------------------------------------------------------
+// Insert-only hash table which interns entries, so that there is exactly
+// one entry for each key. Pointers to entries are stable for the lifetime
+// of the table, which means that they can be used as handles.
+//
+// Lookups are lock-free: the table is an open-addressing array of atomic
+// pointers to entries, and entries are only ever published once they have
+// been fully constructed. Inserts are serialised via a mutex.
+//
+// When the table grows, it publishes a new, larger array of slots. Old slot
+// arrays are kept alive until the table is destroyed, so that readers which
+// still probe an old array are safe - if they miss an entry which has been
+// added to the new array only, they fall back to the locked insertion path,
+// which finds the entry in the current array.
+//
+// `Entry` must have a member `uint64_t hash` which holds the precomputed hash
+// of its key. The table owns its entries, and deletes them on destruction.
+//
+template <typename Entry>
+class InternedHandleTable : NoCopy, NoMove {
+
+	struct Slots {
+		size_t               capacity; // always a power of two
+		std::atomic<Entry*>* entries;  // owning
+	};
+
+	std::atomic<Slots*> current_slots;        // slots used for lookups and inserts
+	std::vector<Slots*> retired_slots;        // protected by mtx. kept alive so that concurrent readers may still probe them
+	std::vector<Entry*> entries;              // protected by mtx. owning, includes entries which are not in slots (unnamed)
+	size_t              num_slotted_entries;  // protected by mtx. number of entries stored in current slots
+	std::mutex          mtx;                  //
+	static constexpr size_t INITIAL_CAPACITY = 256; //
+
+	static Slots* slots_create( size_t capacity ) {
+		return new Slots{ capacity, new std::atomic<Entry*>[ capacity ]() };
+	}
+
+	static void slots_destroy( Slots* slots ) {
+		delete[] slots->entries;
+		delete slots;
+	}
+
+	template <typename Matches>
+	static Entry* slots_find( Slots const* slots, uint64_t hash, Matches const& matches ) {
+		size_t const mask = slots->capacity - 1;
+		for ( size_t i = hash & mask;; i = ( i + 1 ) & mask ) {
+			Entry* e = slots->entries[ i ].load( std::memory_order_acquire );
+			if ( e == nullptr ) {
+				return nullptr;
+			}
+			if ( e->hash == hash && matches( *e ) ) {
+				return e;
+			}
+		}
+	}
+
+	static void slots_insert( Slots* slots, Entry* entry ) {
+		size_t const mask = slots->capacity - 1;
+		size_t       i    = entry->hash & mask;
+		while ( slots->entries[ i ].load( std::memory_order_relaxed ) != nullptr ) {
+			i = ( i + 1 ) & mask;
+		}
+		// Release, so that readers which see this pointer also see a fully constructed entry.
+		slots->entries[ i ].store( entry, std::memory_order_release );
+	}
+
+  public:
+	InternedHandleTable()
+	    : current_slots( slots_create( INITIAL_CAPACITY ) )
+	    , num_slotted_entries( 0 ) {
+	}
+
+	~InternedHandleTable() {
+		for ( auto& e : entries ) {
+			delete e;
+		}
+		for ( auto& s : retired_slots ) {
+			slots_destroy( s );
+		}
+		slots_destroy( current_slots.load() );
+	}
+
+	// Lock-free. Returns nullptr if no entry matches.
+	template <typename Matches>
+	Entry* find( uint64_t hash, Matches const& matches ) const {
+		return slots_find( current_slots.load( std::memory_order_acquire ), hash, matches );
+	}
+
+	// Returns the entry which matches - if there is no such entry, creates one by calling `create()`,
+	// which must return a pointer to a new entry with matching hash.
+	template <typename Matches, typename Create>
+	Entry* find_or_insert( uint64_t hash, Matches const& matches, Create const& create ) {
+
+		if ( Entry* e = find( hash, matches ) ) {
+			return e;
+		}
+
+		// ---------| invariant: entry was not found - we must lock, and check again,
+		// as another thread may have inserted a matching entry in the meantime.
+
+		std::scoped_lock lock( mtx );
+
+		Slots* slots = current_slots.load( std::memory_order_relaxed );
+
+		if ( Entry* e = slots_find( slots, hash, matches ) ) {
+			return e;
+		}
+
+		Entry* entry = create();
+		assert( entry->hash == hash && "entry hash must match lookup hash" );
+
+		entries.push_back( entry );
+
+		// Keep load factor below one half, so that probe sequences stay short.
+		if ( ( num_slotted_entries + 1 ) * 2 > slots->capacity ) {
+			Slots* grown = slots_create( slots->capacity * 2 );
+			for ( size_t i = 0; i != slots->capacity; i++ ) {
+				if ( Entry* e = slots->entries[ i ].load( std::memory_order_relaxed ) ) {
+					slots_insert( grown, e );
+				}
+			}
+			current_slots.store( grown, std::memory_order_release );
+			retired_slots.push_back( slots );
+			slots = grown;
+		}
+
+		slots_insert( slots, entry );
+		num_slotted_entries++;
+
+		return entry;
+	}
+
+	// Takes ownership of an entry which can't be looked up - use this for unnamed handles.
+	Entry* insert_unique( Entry* entry ) {
+		std::scoped_lock lock( mtx );
+		entries.push_back( entry );
+		return entry;
+	}
+};
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef LE_LINEAR_ARENA_H
+#define LE_LINEAR_ARENA_H
+
+#include "le_core.h" // for NoCopy, NoMove
+
+#include <memory_resource>
+#include <vector>
+#include <cstdlib>
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
+
+// ----------------------------------------------------------------------
+// Linear (bump) allocator for short-lived, per-frame allocations.
+//
+// Use this as the memory resource for std::pmr containers: allocations are
+// served by bumping an offset into a block of memory, deallocation is a no-op.
+// All memory is recycled at once when the arena gets reset, which must only
+// happen once all containers which use the arena have been cleared.
+//
+// If the arena runs out of space, it chains an additional block. On reset,
+// chained blocks are consolidated into a single block large enough to hold
+// everything that was allocated since the last reset. This means that once
+// the arena has seen its largest frame, it will not touch the heap anymore.
+//
+// `get_num_heap_allocations()` tells how often the arena had to go to the
+// heap for its own blocks during the last cycle. For steady-state frames this
+// should be zero. Note that this does not count allocations made by
+// containers which don't use the arena - to count all heap allocations made
+// while a frame is processed, set LE_SETTING_PRINT_FRAME_ARENA_STATS, which
+// makes renderer_update log the number of calls to global operator new.
+//
+// Hash maps keep their buckets when cleared - a hash map which uses the arena
+// must be destroyed (or re-created) before the arena gets reset.
+//
+// Note: not thread-safe - an arena must only be used by one thread at a time.
+//
+class LinearArena : public std::pmr::memory_resource, NoCopy, NoMove {
+
+	struct Block {
+		char*  data;
+		size_t capacity;
+	};
+
+	std::vector<Block> blocks;                         // blocks.back() is the block we currently allocate from
+	size_t             offset                  = 0;    // offset into current block
+	size_t             num_bytes_used          = 0;    // bytes allocated since last reset, over all blocks
+	size_t             num_heap_allocations    = 0;    // number of heap allocations since last reset
+	size_t             last_num_bytes_used     = 0;    // stats from previous cycle
+	size_t             last_num_heap_allocs    = 0;    // stats from previous cycle
+	size_t             total_capacity          = 0;    // sum of capacities over all blocks
+	static constexpr size_t MIN_BLOCK_CAPACITY = 4096; //
+
+	void add_block( size_t capacity ) {
+		capacity = capacity < MIN_BLOCK_CAPACITY ? MIN_BLOCK_CAPACITY : capacity;
+		blocks.push_back( { static_cast<char*>( malloc( capacity ) ), capacity } );
+		assert( blocks.back().data && "could not allocate arena block" );
+		total_capacity += capacity;
+		offset = 0;
+		num_heap_allocations++;
+	}
+
+	void free_blocks() {
+		for ( auto& b : blocks ) {
+			free( b.data );
+		}
+		blocks.clear();
+		total_capacity = 0;
+		offset         = 0;
+	}
+
+  protected:
+	void* do_allocate( size_t num_bytes, size_t alignment ) override {
+
+		if ( !blocks.empty() ) {
+			auto&     block   = blocks.back();
+			uintptr_t base    = reinterpret_cast<uintptr_t>( block.data );
+			size_t    aligned = ( ( base + offset + alignment - 1 ) & ~( uintptr_t( alignment ) - 1 ) ) - base;
+
+			if ( aligned + num_bytes <= block.capacity ) [[likely]] {
+				offset = aligned + num_bytes;
+				num_bytes_used += num_bytes;
+				return block.data + aligned;
+			}
+		}
+
+		// ---------| invariant: current block cannot fit allocation: we must chain a new block.
+
+		// Grow geometrically so that the number of blocks stays small.
+		add_block( std::max( num_bytes + alignment, total_capacity ) );
+
+		auto&     block   = blocks.back();
+		uintptr_t base    = reinterpret_cast<uintptr_t>( block.data );
+		size_t    aligned = ( ( base + alignment - 1 ) & ~( uintptr_t( alignment ) - 1 ) ) - base;
+
+		offset = aligned + num_bytes;
+		num_bytes_used += num_bytes;
+		return block.data + aligned;
+	}
+
+	void do_deallocate( void*, size_t, size_t ) override {
+		// no-op: memory gets recycled when the arena is reset.
+	}
+
+	bool do_is_equal( std::pmr::memory_resource const& other ) const noexcept override {
+		return this == &other;
+	}
+
+  public:
+	explicit LinearArena( size_t initial_capacity = 64 * 1024 ) {
+		add_block( initial_capacity );
+		num_heap_allocations = 0; // initial block does not count
+	}
+
+	~LinearArena() override {
+		free_blocks();
+	}
+
+	// Recycles all memory - any containers which used this arena must have been cleared or destroyed before.
+	void reset() {
+
+		last_num_bytes_used  = num_bytes_used;
+		last_num_heap_allocs = num_heap_allocations;
+
+		if ( blocks.size() > 1 ) {
+			// Consolidate chained blocks into one block which is large enough to hold all allocations of the last cycle.
+			size_t const capacity = total_capacity;
+			free_blocks();
+			add_block( capacity );
+		}
+
+		offset               = 0;
+		num_bytes_used       = 0;
+		num_heap_allocations = 0;
+	}
+
+	size_t get_num_heap_allocations() const {
+		return last_num_heap_allocs;
+	}
+	size_t get_num_bytes_used() const {
+		return last_num_bytes_used;
+	}
+	size_t get_capacity() const {
+		return total_capacity;
+	}
+};
+
+#endif
@@ -5,8 +5,7 @@
 
 #include "le_hash_util.h"
 
-constexpr size_t LE_MAX_NUM_GRAPH_RESOURCES = 2048; // Maximum number of unique resources in a Rendergraph. Set this to larger value if you want to deal with a larger number of distinct resources.
-constexpr size_t LE_MAX_NUM_GRAPH_ROOTS     = 64;   // Maximum number of root nodes in a given RenderGraph. We assume this is much smaller than LE_MAX_NUM_GRAPH_RESOURCES, but worst case it would need to be the same size.
+constexpr size_t LE_MAX_NUM_GRAPH_ROOTS = 64; // Maximum number of root nodes in a given RenderGraph - each root is represented by a bit in le::RootPassesField.
 
 namespace le {
 using RootPassesField = uint64_t; // used to express affinity to a root pass - each bit may represent a root pass
@@ -55,6 +54,22 @@ struct le_blas_resource_handle_t : le_resource_handle_t {
 struct le_tlas_resource_handle_t : le_resource_handle_t {
 };
 
+struct le_buf_resource_usage_flags_t {
+	enum FlagBits : uint8_t {
+		eIsUnset   = 0,
+		eIsVirtual = 1u << 0,
+		eIsStaging = 1u << 1,
+	};
+};
+
+struct le_img_resource_usage_flags_t {
+	enum FlagBits : uint8_t {
+		eIsUnset     = 0,
+		eIsRoot      = 1u << 0, // whether image, when used as a render target, is flagged as a root resource to the rendergraph
+		eIsTransient = 1u << 1, // whether image contents may be discarded between frames - allows backend to alias its memory with other transient images
+	};
+};
+
 // A graphics pipeline handle is an opaque handle to a *pipeline state* object.
 // Note that the pipeline state is different from the actual pipeline, as the
 // pipeline is created, based on a pipeline state and a renderpass.
@@ -134,6 +149,23 @@ struct Extent2D {
 	uint32_t height;
 };
 
+// Layout of draw parameters in buffers used for indirect draws - matches VkDrawIndirectCommand
+struct DrawIndirectCommand {
+	uint32_t vertexCount;
+	uint32_t instanceCount;
+	uint32_t firstVertex;
+	uint32_t firstInstance;
+};
+
+// Layout of draw parameters in buffers used for indexed indirect draws - matches VkDrawIndexedIndirectCommand
+struct DrawIndexedIndirectCommand {
+	uint32_t indexCount;
+	uint32_t instanceCount;
+	uint32_t firstIndex;
+	int32_t  vertexOffset;
+	uint32_t firstInstance;
+};
+
 struct Extent3D {
 	uint32_t width;
 	uint32_t height;
@@ -243,7 +275,8 @@ struct le_swapchain_settings_t {
 		char const*                 display_name; // will be matched against display name
 	};
 	struct img_settings_t {
-		char const* pipe_cmd; // command used to save images - will receive stream of images via stdin
+		char const* pipe_cmd;       // command used to save images - will receive stream of images via stdin
+		uint32_t    discard_output; // if non-zero, rendered images are not written anywhere - use this for headless benchmarks
 	};
 
 	Type       type            = LE_KHR_SWAPCHAIN;
@@ -270,14 +303,36 @@ struct le_swapchain_settings_t {
 		this->khr_direct_mode_settings.vk_surface       = nullptr;
 	}
 	void init_img_settings() {
-		this->img_settings.pipe_cmd = "";
+		this->img_settings.pipe_cmd       = "";
+		this->img_settings.discard_output = 0;
 	}
 };
 
 struct le_renderer_settings_t {
 	le_swapchain_settings_t swapchain_settings[ 16 ] = {};
 	size_t                  num_swapchain_settings   = 0;
-	// TODO: add a hint for number of swapchain frames
+	uint32_t                num_frames_in_flight     = 0; // pipeline depth: number of renderer data frames (min 2). 0 means: derive from swapchain image count (2..3)
+	uint32_t                dispatch_delay           = 1; // number of updates between recording and dispatching a frame - clamped to num_frames_in_flight - 2.
+	                                                      // 0: dispatch right after recording (lowest latency), 1+: dispatch overlaps with recording of later frames (higher throughput)
+};
+
+// CPU timings for a renderpass, in milliseconds - see renderer_i.get_frame_timings
+struct le_renderer_pass_timing_t {
+	char     debug_name[ 64 ];    // pass debug name, may be truncated
+	double   setup_ms;            // time spent in pass setup callback
+	double   execute_ms;          // time spent in pass execute callbacks - zero if pass did not contribute to the frame
+	uint32_t num_elided_commands; // number of redundant state commands which the encoder dropped for this pass
+};
+
+// CPU timings for each stage of a frame, in milliseconds - see renderer_i.get_frame_timings
+struct le_renderer_frame_timing_t {
+	uint64_t frame_number;
+	double   record_ms;     // record: setup, build, and execute rendergraph
+	double   acquire_ms;    // acquire backend resources
+	double   process_ms;    // translate encoded commands into vk command buffers
+	double   dispatch_ms;   // submit to queues, and present
+	double   fence_wait_ms; // wait for frame fence, on clear
+	double   clear_ms;      // recycle backend frame resources, on clear
 };
 
 // specifies parameters for an image write operation.
@@ -577,6 +632,10 @@ enum class CommandType : uint32_t {
 	eBindRtxPipeline,
 	eWriteToBuffer,
 	eWriteToImage,
+	eDrawIndirect,
+	eDrawIndexedIndirect,
+	eDrawIndirectCount,
+	eDrawIndexedIndirectCount,
 };
 
 struct CommandHeader {
@@ -611,6 +670,53 @@ struct CommandDraw {
 	} info;
 };
 
+// Draw parameters are read from `buffer`, starting at `offset`, in the layout of
+// VkDrawIndirectCommand, or VkDrawIndexedIndirectCommand for indexed draws.
+struct CommandDrawIndirect {
+	CommandHeader header = { { { CommandType::eDrawIndirect, sizeof( CommandDrawIndirect ) } } };
+	struct {
+		le_buf_resource_handle buffer; // buffer holding draw parameters
+		uint64_t               offset;
+		uint32_t               drawCount;
+		uint32_t               stride; // in bytes, between successive sets of draw parameters
+	} info;
+};
+
+struct CommandDrawIndexedIndirect {
+	CommandHeader header = { { { CommandType::eDrawIndexedIndirect, sizeof( CommandDrawIndexedIndirect ) } } };
+	struct {
+		le_buf_resource_handle buffer; // buffer holding draw parameters
+		uint64_t               offset;
+		uint32_t               drawCount;
+		uint32_t               stride; // in bytes, between successive sets of draw parameters
+	} info;
+};
+
+// Number of draws is read from `count_buffer` at `count_offset`, and clamped to `maxDrawCount`.
+struct CommandDrawIndirectCount {
+	CommandHeader header = { { { CommandType::eDrawIndirectCount, sizeof( CommandDrawIndirectCount ) } } };
+	struct {
+		le_buf_resource_handle buffer; // buffer holding draw parameters
+		uint64_t               offset;
+		le_buf_resource_handle count_buffer; // buffer holding number of draws as uint32_t
+		uint64_t               count_offset;
+		uint32_t               maxDrawCount;
+		uint32_t               stride; // in bytes, between successive sets of draw parameters
+	} info;
+};
+
+struct CommandDrawIndexedIndirectCount {
+	CommandHeader header = { { { CommandType::eDrawIndexedIndirectCount, sizeof( CommandDrawIndexedIndirectCount ) } } };
+	struct {
+		le_buf_resource_handle buffer; // buffer holding draw parameters
+		uint64_t               offset;
+		le_buf_resource_handle count_buffer; // buffer holding number of draws as uint32_t
+		uint64_t               count_offset;
+		uint32_t               maxDrawCount;
+		uint32_t               stride; // in bytes, between successive sets of draw parameters
+	} info;
+};
+
 struct CommandDrawMeshTasks {
 	CommandHeader header = { { { CommandType::eDrawMeshTasks, sizeof( CommandDrawMeshTasks ) } } };
 	struct {
@@ -1,7 +1,190 @@
 #ifndef LE_RENDERGRAPH_H
 #define LE_RENDERGRAPH_H
 
-using ResourceField = std::bitset<LE_MAX_NUM_GRAPH_RESOURCES>; // Each bit represents a distinct resource
+#include "private/le_renderer/le_linear_arena.h"
+
+#include <memory_resource>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+// ----------------------------------------------------------------------
+// Sparse bitset - each bit represents a distinct resource, addressed by the
+// resource's index into the list of unique resources for a rendergraph.
+//
+// Bits are stored in 64-bit words, and we only store words which have at
+// least one bit set, sorted by word index. Operations on two fields therefore
+// scale with the number of resources actually used by a pass, and not with the
+// total number of resources in the graph - and there is no upper limit to the
+// number of resources a graph may hold.
+//
+// ResourceField is allocator-aware, so that it may be allocated from a frame
+// arena when placed in a std::pmr container.
+//
+class ResourceField {
+
+	struct Word {
+		uint32_t index; // word index: bit index / 64
+		uint64_t bits;  // invariant: never zero
+	};
+
+	std::pmr::vector<Word> words; // sorted by Word::index
+
+	static bool word_less( Word const& lhs, uint32_t index ) {
+		return lhs.index < index;
+	}
+
+  public:
+	using allocator_type = std::pmr::polymorphic_allocator<Word>;
+
+	ResourceField() = default;
+	explicit ResourceField( allocator_type const& alloc )
+	    : words( alloc ) {
+	}
+	ResourceField( ResourceField const& other, allocator_type const& alloc )
+	    : words( other.words, alloc ) {
+	}
+	ResourceField( ResourceField&& other, allocator_type const& alloc )
+	    : words( std::move( other.words ), alloc ) {
+	}
+	ResourceField( ResourceField const& )            = default;
+	ResourceField( ResourceField&& )                 = default;
+	ResourceField& operator=( ResourceField const& ) = default;
+	ResourceField& operator=( ResourceField&& )      = default;
+
+	allocator_type get_allocator() const {
+		return words.get_allocator();
+	}
+
+	void set( size_t bit, bool value = true ) {
+		uint32_t const index = uint32_t( bit >> 6 );
+		uint64_t const mask  = uint64_t( 1 ) << ( bit & 63 );
+
+		auto it = std::lower_bound( words.begin(), words.end(), index, word_less );
+
+		if ( it != words.end() && it->index == index ) {
+			if ( value ) {
+				it->bits |= mask;
+			} else {
+				it->bits &= ~mask;
+				if ( it->bits == 0 ) {
+					words.erase( it );
+				}
+			}
+		} else if ( value ) {
+			words.insert( it, { index, mask } );
+		}
+	}
+
+	bool test( size_t bit ) const {
+		uint32_t const index = uint32_t( bit >> 6 );
+		auto           it    = std::lower_bound( words.begin(), words.end(), index, word_less );
+		return ( it != words.end() && it->index == index && ( it->bits & ( uint64_t( 1 ) << ( bit & 63 ) ) ) );
+	}
+
+	bool operator[]( size_t bit ) const {
+		return test( bit );
+	}
+
+	bool any() const {
+		return !words.empty();
+	}
+
+	void clear() {
+		words.clear();
+	}
+
+	// Same as ( *this & other ).any() would be for a std::bitset.
+	bool intersects( ResourceField const& other ) const {
+		auto a = words.begin();
+		auto b = other.words.begin();
+		while ( a != words.end() && b != other.words.end() ) {
+			if ( a->index < b->index ) {
+				a++;
+			} else if ( b->index < a->index ) {
+				b++;
+			} else {
+				if ( a->bits & b->bits ) {
+					return true;
+				}
+				a++;
+				b++;
+			}
+		}
+		return false;
+	}
+
+	ResourceField& operator|=( ResourceField const& other ) {
+
+		// Count words which we don't have yet, so that we can merge in-place, back to front.
+		size_t num_new_words = 0;
+		{
+			auto a = words.begin();
+			for ( auto const& w : other.words ) {
+				a = std::lower_bound( a, words.end(), w.index, word_less );
+				if ( a == words.end() || a->index != w.index ) {
+					num_new_words++;
+				}
+			}
+		}
+
+		size_t const old_size = words.size();
+		words.resize( old_size + num_new_words );
+
+		auto a   = words.begin() + old_size; // one past last old word
+		auto b   = other.words.end();        // one past last word to merge
+		auto dst = words.end();
+
+		while ( b != other.words.begin() ) {
+			if ( a != words.begin() && ( a - 1 )->index > ( b - 1 )->index ) {
+				*--dst = *--a;
+			} else if ( a != words.begin() && ( a - 1 )->index == ( b - 1 )->index ) {
+				--a;
+				--b;
+				*--dst = { a->index, a->bits | b->bits };
+			} else {
+				*--dst = *--b;
+			}
+		}
+		// any remaining old words are already in place.
+
+		return *this;
+	}
+
+	// Clears all bits which are set in `other` - same as `*this &= ~other` for a std::bitset.
+	ResourceField& operator-=( ResourceField const& other ) {
+		auto a = words.begin();
+		for ( auto const& w : other.words ) {
+			a = std::lower_bound( a, words.end(), w.index, word_less );
+			if ( a == words.end() ) {
+				break;
+			}
+			if ( a->index == w.index ) {
+				a->bits &= ~w.bits;
+			}
+		}
+		words.erase( std::remove_if( words.begin(), words.end(), []( Word const& w ) { return w.bits == 0; } ), words.end() );
+		return *this;
+	}
+
+	// Returns a list of set bit indices, for debug printouts.
+	std::string to_string() const {
+		std::string result = "{";
+		for ( auto const& w : words ) {
+			for ( uint32_t i = 0; i != 64; i++ ) {
+				if ( w.bits & ( uint64_t( 1 ) << i ) ) {
+					if ( result.size() > 1 ) {
+						result += ", ";
+					}
+					result += std::to_string( uint64_t( w.index ) * 64 + i );
+				}
+			}
+		}
+		result += "}";
+		return result;
+	}
+};
+
 // ----------------------------------------------------------------------
 
 namespace le {
@@ -95,11 +278,13 @@ static std::string to_string_le_access_flags2( const le::AccessFlags2& tp ) {
 // ----------------------------------------------------------------------
 
 struct Node {
-	ResourceField       reads               = 0;
-	ResourceField       writes              = 0;
+	ResourceField       reads;                             // resources read by this node
+	ResourceField       writes;                            // resources written by this node
 	le::RootPassesField root_nodes_affinity = 0;       // association of node with root node(s) - each bit represents a root node, if set, this pass contributes to that particular root node
 	bool                is_root             = false;   // whether this node is a root node
 	bool                is_contributing     = false;   // whether this node contributes to a root node
+	bool                is_async_compute    = false;   // whether this node may execute on an async compute queue
+	bool                waits_for_async     = false;   // whether this node depends on (or conflicts with) any earlier async compute node
 	char const*         debug_name          = nullptr; // non-owning pointer to char[256]
 };
 
@@ -124,6 +309,8 @@ struct le_renderpass_o {
 	le::RootPassesField root_passes_affinity; // Association of this renderpass with one or more root passes that it contributes to -
 	                                          // this needs to be communicated to backend, so that you may create queue submissions
 	                                          // by filtering via root_passes_affinity_masks
+	bool                is_async_compute = false; // Whether this pass may execute on an async compute queue, concurrently with non-async passes of its subgraph
+	bool                waits_for_async  = false; // Whether this pass must wait for async compute passes of its subgraph to complete
 
 	std::vector<le_resource_handle> resources;                  // all resources used in this pass, contains info about resource type
 	std::vector<le::RWFlags>        resources_read_write_flags; // TODO: get rid of this: we can use resources_access_flags instead. read/write flags for all resources, in sync with resources
@@ -141,10 +328,25 @@ struct le_renderpass_o {
 
 	le_command_buffer_encoder_o* encoder = nullptr;
 	char                         debugName[ 256 ];
+	uint32_t                     timing_index = ~0u; // index into rendergraph pass_timings, if timings are recorded
 };
 
 // ----------------------------------------------------------------------
 
+// Result of rendergraph_build - we keep this around so that we can re-use it
+// if the next graph built on the same rendergraph object has identical structure.
+struct RendergraphBuildCache {
+	uint64_t                         structure_hash = 0;     // hash over all passes, in order: root flag, resources, and resource access flags
+	bool                             is_valid       = false; // whether there is a previous build result
+	std::vector<uint32_t>            contributing_pass_indices;  // indices into unconsolidated list of passes, in consolidated order
+	std::vector<bool>                contributing_pass_is_root;  // in sync with contributing_pass_indices
+	std::vector<le::RootPassesField> contributing_pass_affinity; // in sync with contributing_pass_indices
+	std::vector<bool>                contributing_pass_is_async; // in sync with contributing_pass_indices
+	std::vector<bool>                contributing_pass_waits;    // in sync with contributing_pass_indices
+	std::vector<uint32_t>            root_pass_indices;          // indices into consolidated list of passes, one per root, in order of RootPassesField bits
+	std::vector<le::RootPassesField> root_passes_affinity_masks; //
+};
+
 struct le_rendergraph_o : NoCopy, NoMove {
 	std::vector<le_renderpass_o*>    passes;                     //
 	std::vector<le_resource_handle>  declared_resources_id;      // | pre-declared resources (declared via module)
@@ -156,5 +358,11 @@ struct le_rendergraph_o : NoCopy, NoMove {
 	                                                             // separate (and resource-isolated) queue submission.
 	                                                             //
 	std::vector<char const*> root_debug_names;                   // not owning: pointers to debug_names for root passes held within passes, in same order as RootPassesField indices
+	le_command_stream_page_pool_o* command_stream_page_pool = nullptr; // owning: recycles command stream pages for encoders of this frame
+	RendergraphBuildCache          build_cache;                        // persists across resets, so that we may skip rebuilding if structure did not change
+	LinearArena                    frame_arena;                        // for temporary allocations while building and executing the graph, recycled on reset
+
+	bool                                   record_timings = false; // set by renderer before setup: whether to record cpu timings for pass callbacks
+	std::vector<le_renderer_pass_timing_t> pass_timings;           // cpu timings per pass, in order of setup - cleared on reset
 };
 #endif
@@ -47,6 +47,7 @@ struct img_data_o {
 	std::vector<TransferFrame> transferFrames;        //
 	FILE*                      pipe = nullptr;        // Pipe to ffmpeg. Owned. must be closed if opened
 	std::string                pipe_cmd;              // command line
+	bool                       discard_output;        // if set, images are neither piped nor written to disk
 	BackendQueueInfo*          queue_info = nullptr;  // Non-owning. Present-enabled queue, initially null, set at create
 };
 
@@ -334,6 +335,7 @@ static le_swapchain_o* swapchain_img_create( const le_swapchain_vk_api::swapchai
 	self->windowSurfaceFormat.colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
 	self->mImageIndex                    = uint32_t( ~0 );
 	self->pipe_cmd                       = std::string( settings->img_settings.pipe_cmd );
+	self->discard_output                 = settings->img_settings.discard_output != 0;
 	{
 
 		using namespace le_backend_vk;
@@ -357,6 +359,11 @@ static le_swapchain_o* swapchain_img_create( const le_swapchain_vk_api::swapchai
 
 	swapchain_img_reset( base, settings );
 
+	if ( self->discard_output ) {
+		logger.info( "Image swapchain discards its output." );
+		return base;
+	}
+
 	{
 		// Generate a timestamp string so that we can generate unique filenames,
 		// making sure that output files generated by successive runs are not
@@ -499,7 +506,7 @@ static bool swapchain_img_acquire_next_image( le_swapchain_o* base, VkSemaphore
 
 	// We only want to write out images which have made the round-trip
 	// the first n images will be black...
-	if ( self->totalImages > self->mImagecount ) {
+	if ( self->totalImages > self->mImagecount && !self->discard_output ) {
 		if ( self->pipe ) {
 			// TODO: we should be able to do the write on the back thread.
 			// the back thread must signal that it is complete with writing
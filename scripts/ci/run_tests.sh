@@ -13,6 +13,8 @@ apps_list=("
 	examples/imgui_example:Island-ImguiExample
 	examples/asterisks:Island-Asterisks
 	examples/bitonic_merge_sort_example:Island-BitonicMergeSortExample
+	examples/frame_capture_replay:Island-FrameCaptureReplay
+	benchmarks/frame_time_benchmark:Island-FrameTimeBenchmark
 ")
 
 tempfiles=( )